@@ -0,0 +1,140 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file bench.h
+ * @brief Helpers shared by the benchmarks: timing and the synthetic configs.
+ */
+
+#ifndef LRC_BENCH_H
+#define LRC_BENCH_H
+
+#include <time.h>
+#include <sys/resource.h>
+#include "libreadconfig.h"
+
+static unsigned long bench_seed = 12345;
+
+/* Deterministic pseudo-random numbers (31 bits) */
+static inline unsigned long bench_random(void){
+  bench_seed = bench_seed * 6364136223846793005UL + 1442695040888963407UL;
+  return bench_seed >> 33;
+}
+
+static inline double bench_elapsed(struct timespec* a, struct timespec* b){
+  return (b->tv_sec - a->tv_sec) * 1e9 + (b->tv_nsec - a->tv_nsec);
+}
+
+/* Peak RSS of the process so far, in kB */
+static inline long bench_peak_rss(void){
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) < 0) return -1;
+  return usage.ru_maxrss;
+}
+
+/* Options per namespace */
+static inline long bench_per_space(long options, long namespaces){
+  return (options + namespaces - 1) / namespaces;
+}
+
+/* The defaults: space<k>/option_<i>, a third integers, a third doubles, the
+ * rest strings of vlen characters. The namespaces are contiguous, as in the
+ * usual defaults tables */
+static inline LRC_configDefaults* bench_defaults(long options, long namespaces, long vlen){
+
+  LRC_configDefaults* cd = NULL;
+  long i, k, per;
+  int c;
+
+  cd = calloc(options + 1, sizeof(LRC_configDefaults));
+  if (!cd) return NULL;
+
+  per = bench_per_space(options, namespaces);
+
+  for (i = 0; i < options; i++) {
+    sprintf(cd[i].space, "space%ld", i / per);
+    sprintf(cd[i].name, "option_%ld", i);
+
+    switch (i % 3) {
+      case 0:
+        cd[i].type = LRC_INT;
+        sprintf(cd[i].value, "%lu", bench_random() % 100000);
+        break;
+      case 1:
+        cd[i].type = LRC_DOUBLE;
+        LRC_double2str(cd[i].value, (double)bench_random() / 4096.0);
+        break;
+      default:
+        cd[i].type = LRC_STRING;
+        for (k = 0; k < vlen && k < LRC_CONFIG_LEN - 1; k++) {
+          c = (int)(bench_random() % 36);
+          cd[i].value[k] = (char)(c < 10 ? '0' + c : 'a' + c - 10);
+        }
+        cd[i].value[k] = LRC_NULL;
+        break;
+    }
+  }
+
+  return cd;
+}
+
+/* The config file of the defaults. The comment density (0..1) is the
+ * fraction of the options with an inline comment, and of the full-line
+ * comments */
+static inline int bench_file(FILE* file, LRC_configDefaults* cd, long options,
+    long namespaces, double comments){
+
+  long i, per;
+
+  per = bench_per_space(options, namespaces);
+
+  for (i = 0; i < options; i++) {
+    if (i % per == 0) fprintf(file, "[%s]\n", cd[i].space);
+    if ((double)bench_random() / 2147483648.0 < comments) {
+      fprintf(file, "# comment on %s\n", cd[i].name);
+    }
+    fprintf(file, "%s = %s", cd[i].name, cd[i].value);
+    if ((double)bench_random() / 2147483648.0 < comments) fprintf(file, " # inline comment");
+    fprintf(file, "\n");
+  }
+
+  return fflush(file);
+}
+
+#endif
@@ -0,0 +1,380 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file hdf5.c
+ * @brief Benchmark of the HDF5 config layouts, file drivers and dataset
+ * settings.
+ *
+ * Usage: lrc-bench-hdf5 [-n sizes] [-s namespaces] [-a array length]
+ *                       [-c chunk] [-r repetitions] [-f file]
+ *
+ * For every size (default 100,1000,10000) the config is written and read
+ * back through:
+ *  - layouts: "config" (LRC_HDF5WriterDcpl/LRC_HDF5Parser, namespace tables
+ *    and array datasets) and "history" (LRC_HDF5HistoryWriter/Parser,
+ *    with its own chunking)
+ *  - drivers: sec2, core (in memory, written out at close) and, with
+ *    parallel HDF5, mpio (LRC_HDF5ParallelWriter/Parser on all ranks)
+ *  - settings: contiguous, chunked, deflate and shuffle+deflate (the chunk is
+ *    limited to the dataset size by the writer)
+ *
+ * Every tenth option is a double array of the given length (default 0, no
+ * arrays). The results are printed as JSON: the mean latency of the write
+ * (create, write, close) and of the read (open, parse, close), the size of
+ * the file and the number of the main HDF5 calls of each phase. The calls are
+ * counted by interposing the HDF5 functions, which requires the shared HDF5
+ * library.
+ */
+
+/* dlsym, RTLD_NEXT */
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include "bench.h"
+#include "libreadconfig_hdf5.h"
+
+typedef struct{
+  unsigned long dcreate;
+  unsigned long dopen;
+  unsigned long dwrite;
+  unsigned long dread;
+  unsigned long gcreate;
+  unsigned long gopen;
+  unsigned long lexists;
+  unsigned long select;
+} bench_calls;
+
+static bench_calls calls;
+
+/* Counts the call and forwards it to the HDF5 library */
+#define BENCH_WRAP(type, name, params, args, counter) \
+  type name params { \
+    static type (*real) params = NULL; \
+    void* sym; \
+    if (!real) { \
+      sym = dlsym(RTLD_NEXT, #name); \
+      memcpy(&real, &sym, sizeof(real)); \
+    } \
+    counter++; \
+    return real args; \
+  }
+
+BENCH_WRAP(hid_t, H5Dcreate2, (hid_t loc, const char* name, hid_t type, hid_t space,
+      hid_t lcpl, hid_t dcpl, hid_t dapl), (loc, name, type, space, lcpl, dcpl, dapl), calls.dcreate)
+BENCH_WRAP(hid_t, H5Dopen2, (hid_t loc, const char* name, hid_t dapl),
+    (loc, name, dapl), calls.dopen)
+BENCH_WRAP(herr_t, H5Dwrite, (hid_t dset, hid_t mtype, hid_t mspace, hid_t fspace,
+      hid_t dxpl, const void* buf), (dset, mtype, mspace, fspace, dxpl, buf), calls.dwrite)
+BENCH_WRAP(herr_t, H5Dread, (hid_t dset, hid_t mtype, hid_t mspace, hid_t fspace,
+      hid_t dxpl, void* buf), (dset, mtype, mspace, fspace, dxpl, buf), calls.dread)
+BENCH_WRAP(hid_t, H5Gcreate2, (hid_t loc, const char* name, hid_t lcpl, hid_t gcpl,
+      hid_t gapl), (loc, name, lcpl, gcpl, gapl), calls.gcreate)
+BENCH_WRAP(hid_t, H5Gopen2, (hid_t loc, const char* name, hid_t gapl),
+    (loc, name, gapl), calls.gopen)
+BENCH_WRAP(htri_t, H5Lexists, (hid_t loc, const char* name, hid_t lapl),
+    (loc, name, lapl), calls.lexists)
+BENCH_WRAP(herr_t, H5Sselect_hyperslab, (hid_t space, H5S_seloper_t op, const hsize_t start[],
+      const hsize_t stride[], const hsize_t count[], const hsize_t block[]),
+    (space, op, start, stride, count, block), calls.select)
+
+enum {
+  BENCH_SEC2,
+  BENCH_CORE,
+  BENCH_MPIO,
+  BENCH_DRIVERS
+};
+
+enum {
+  BENCH_CONTIGUOUS,
+  BENCH_CHUNKED,
+  BENCH_DEFLATE,
+  BENCH_SHUFFLE_DEFLATE,
+  BENCH_SETTINGS
+};
+
+static char* drivers[] = {"sec2", "core", "mpio"};
+static char* settings[] = {"contiguous", "chunked", "deflate", "shuffle+deflate"};
+
+static void print_calls(char* name, bench_calls* c, long reps){
+  printf("\"%s\": {\"H5Dcreate\": %lu, \"H5Dopen\": %lu, \"H5Dwrite\": %lu, "
+      "\"H5Dread\": %lu, \"H5Gcreate\": %lu, \"H5Gopen\": %lu, \"H5Lexists\": %lu, "
+      "\"H5Sselect_hyperslab\": %lu}", name, c->dcreate / reps, c->dopen / reps,
+      c->dwrite / reps, c->dread / reps, c->gcreate / reps, c->gopen / reps,
+      c->lexists / reps, c->select / reps);
+}
+
+static hid_t file_access(int driver){
+
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+
+  switch (driver) {
+    case BENCH_CORE:
+      H5Pset_fapl_core(fapl, 1 << 20, 1);
+      break;
+#ifdef H5_HAVE_PARALLEL
+    case BENCH_MPIO:
+      H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
+      break;
+#endif
+    default:
+      H5Pset_fapl_sec2(fapl);
+      break;
+  }
+
+  return fapl;
+}
+
+static hid_t dataset_create(int setting, hsize_t chunk){
+
+  hid_t dcpl;
+
+  if (setting == BENCH_CONTIGUOUS) return H5P_DEFAULT;
+
+  dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(dcpl, 1, &chunk);
+  if (setting == BENCH_SHUFFLE_DEFLATE) H5Pset_shuffle(dcpl);
+  if (setting != BENCH_CHUNKED) H5Pset_deflate(dcpl, 6);
+
+  return dcpl;
+}
+
+/* Writes and reads the config reps times, prints the JSON record */
+static int run(LRC_configDefaults* cd, LRC_configNamespace* head, char* path,
+    int driver, int history, int setting, hsize_t chunk, long reps, int* first){
+
+  struct timespec t0, t1;
+  bench_calls wcalls, rcalls;
+  LRC_configNamespace* copy = NULL;
+  hid_t fapl, dcpl, file;
+  struct stat st;
+  long long size = 0;
+  double wns = 0.0, rns = 0.0;
+  long r;
+  int status = 0, rank = 0;
+
+#ifdef H5_HAVE_PARALLEL
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+
+  memset(&wcalls, 0, sizeof(bench_calls));
+  memset(&rcalls, 0, sizeof(bench_calls));
+
+  fapl = file_access(driver);
+  dcpl = dataset_create(setting, chunk);
+
+  for (r = 0; r < reps && status == 0; r++) {
+    memset(&calls, 0, sizeof(bench_calls));
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    file = H5Fcreate(path, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    if (file < 0) return -1;
+
+    if (history) {
+      /* Returns the number of the recorded changes */
+      if (LRC_HDF5HistoryWriter(file, "history", 0, head) < 0) status = -1;
+#ifdef H5_HAVE_PARALLEL
+    } else if (driver == BENCH_MPIO) {
+      status = LRC_HDF5ParallelWriter(file, "config", MPI_COMM_WORLD, head);
+#endif
+    } else {
+      status = LRC_HDF5WriterDcpl(file, "config", head, dcpl);
+    }
+
+    H5Fclose(file);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    wns += bench_elapsed(&t0, &t1);
+    wcalls = calls;
+
+    /* The core driver allocates the file in increments, take the size on disk */
+    if (stat(path, &st) == 0) size = (long long)st.st_size;
+
+    copy = LRC_assignDefaults(cd);
+    memset(&calls, 0, sizeof(bench_calls));
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    file = H5Fopen(path, H5F_ACC_RDONLY, fapl);
+    if (file < 0) return -1;
+
+    if (history) {
+      if (LRC_HDF5HistoryParser(file, "history", 0, copy) < 0) status = -1;
+#ifdef H5_HAVE_PARALLEL
+    } else if (driver == BENCH_MPIO) {
+      if (LRC_HDF5ParallelParser(file, "config", MPI_COMM_WORLD, copy) < 0) status = -1;
+#endif
+    } else {
+      if (LRC_HDF5Parser(file, "config", copy) < 0) status = -1;
+    }
+
+    H5Fclose(file);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    rns += bench_elapsed(&t0, &t1);
+    rcalls = calls;
+
+    LRC_cleanup(copy);
+  }
+
+  if (dcpl != H5P_DEFAULT) H5Pclose(dcpl);
+  H5Pclose(fapl);
+
+  if (rank == 0) {
+    printf("%s\n    {\"options\": %d, \"layout\": \"%s\", \"driver\": \"%s\", \"setting\": \"%s\", "
+        "\"status\": %d, \"write_ms\": %.3f, \"read_ms\": %.3f, \"file_bytes\": %lld,\n      ",
+        *first ? "" : ",", LRC_allOptions(head), history ? "history" : "config",
+        drivers[driver], history ? "default" : settings[setting], status,
+        wns / 1e6 / (double)r, rns / 1e6 / (double)r, size);
+    print_calls("write_calls", &wcalls, 1);
+    printf(",\n      ");
+    print_calls("read_calls", &rcalls, 1);
+    printf("}");
+  }
+
+  *first = 0;
+
+  return status;
+}
+
+int main(int argc, char** argv){
+
+  LRC_configDefaults* cd = NULL;
+  LRC_configNamespace* head = NULL;
+  char* sizes = "100,1000,10000";
+  char* path = "lrc-bench.h5";
+  char* p;
+  double* array = NULL;
+  long options, namespaces = 0, nspaces, alen = 0, reps = 5, i, per;
+  hsize_t chunk = 64;
+  int opt, first = 1, driver, setting, deflate, rank = 0;
+  char space[LRC_CONFIG_LEN];
+
+#ifdef H5_HAVE_PARALLEL
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+
+  while ((opt = getopt(argc, argv, "n:s:a:c:r:f:")) != -1) {
+    switch (opt) {
+      case 'n': sizes = optarg; break;
+      case 's': namespaces = atol(optarg); break;
+      case 'a': alen = atol(optarg); break;
+      case 'c': chunk = (hsize_t)atol(optarg); break;
+      case 'r': reps = atol(optarg); break;
+      case 'f': path = optarg; break;
+      default:
+        fprintf(stderr, "Usage: %s [-n sizes] [-s namespaces] [-a array length] "
+            "[-c chunk] [-r repetitions] [-f file]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  if (reps < 1 || chunk < 1 || alen < 0) {
+    fprintf(stderr, "%s: wrong arguments\n", argv[0]);
+    return 1;
+  }
+
+  deflate = H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0;
+
+  array = malloc((alen + 1) * sizeof(double));
+  if (!array) {
+    perror("lrc-bench-hdf5: alloc failed");
+    return 1;
+  }
+  for (i = 0; i < alen; i++) array[i] = (double)bench_random() / 4096.0;
+
+  if (rank == 0) printf("{\"benchmark\": \"lrc-bench-hdf5\", \"runs\": [");
+
+  for (p = sizes; p && *p; p = strchr(p, ',') ? strchr(p, ',') + 1 : NULL) {
+    options = atol(p);
+    if (options < 1) continue;
+
+    nspaces = namespaces > 0 ? namespaces : (long)sqrt((double)options);
+    if (nspaces < 1) nspaces = 1;
+    if (nspaces > options) nspaces = options;
+
+    cd = bench_defaults(options, nspaces, 16);
+    if (!cd) {
+      perror("lrc-bench-hdf5: alloc failed");
+      return 1;
+    }
+
+    head = LRC_assignDefaults(cd);
+    per = bench_per_space(options, nspaces);
+    if (alen > 0) {
+      for (i = 0; i < options; i += 10) {
+        sprintf(space, "space%ld", i / per);
+        LRC_setDoubleArray(space, cd[i].name, array, (size_t)alen, head);
+      }
+    }
+
+    for (driver = 0; driver < BENCH_DRIVERS; driver++) {
+#ifndef H5_HAVE_PARALLEL
+      if (driver == BENCH_MPIO) continue;
+#else
+      /* The serial drivers run on the first rank only */
+      if (driver != BENCH_MPIO && rank != 0) continue;
+#endif
+      for (setting = 0; setting < BENCH_SETTINGS; setting++) {
+        if (setting >= BENCH_DEFLATE && !deflate) continue;
+
+        /* The parallel writer has no dataset settings */
+        if (driver == BENCH_MPIO && setting != BENCH_CONTIGUOUS) continue;
+
+        run(cd, head, path, driver, 0, setting, chunk, reps, &first);
+      }
+
+      if (driver != BENCH_MPIO) run(cd, head, path, driver, 1, 0, chunk, reps, &first);
+    }
+
+    LRC_cleanup(head);
+    free(cd);
+  }
+
+  if (rank == 0) {
+    printf("\n  ]\n}\n");
+    remove(path);
+  }
+
+  free(array);
+
+#ifdef H5_HAVE_PARALLEL
+  MPI_Finalize();
+#endif
+
+  return 0;
+}
@@ -0,0 +1,354 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file lrc-bench.c
+ * @brief Benchmark of the core API on synthetic configs.
+ *
+ * Usage: lrc-bench [-n sizes] [-s namespaces] [-v value length]
+ *                  [-c comment density] [-r minimum ops]
+ *
+ * For every size (number of options, comma separated, default
+ * 10,100,1000,10000,100000) the generator creates the defaults and the
+ * matching config file, with the options spread over the namespaces (default
+ * sqrt(size)). A third of the options are integers, a third doubles, the
+ * rest strings of the given length. The comment density (0..1) is the
+ * fraction of options with an inline comment and of full-line comments.
+ *
+ * Each operation is repeated until at least the minimum number of ops
+ * (default 100000) is done. The results are printed as JSON: ns/op, bytes/s
+ * for the parser and the writer, allocations per op and the peak RSS of the
+ * process so far (in kB). Allocations are counted with glibc only (null
+ * otherwise).
+ *
+ * 10^6 options need a few GB of memory (the defaults and the tree hold
+ * LRC_CONFIG_LEN strings).
+ */
+
+/* clock_gettime, getopt */
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench.h"
+
+#ifdef __GLIBC__
+/* Count the allocations of the library (and of the C library for it) by
+ * replacing the allocator entry points, as allowed by glibc */
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* p, size_t size);
+extern void __libc_free(void* p);
+
+static unsigned long allocations = 0;
+
+void* malloc(size_t size){
+  allocations++;
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size){
+  allocations++;
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, size_t size){
+  allocations++;
+  return __libc_realloc(p, size);
+}
+
+void free(void* p){
+  __libc_free(p);
+}
+#define ALLOCATIONS 1
+#else
+static unsigned long allocations = 0;
+#define ALLOCATIONS 0
+#endif
+
+typedef struct{
+  long options;
+  long namespaces;
+  long vlen;
+  double comments;
+} bench_config;
+
+/* One JSON record; bytes is the amount of data processed (0 if it does not
+ * apply) */
+static void report(int* first, char* name, long ops, double ns, long bytes,
+    unsigned long allocs){
+
+  printf("%s\n        {\"name\": \"%s\", \"ops\": %ld, \"ns_per_op\": %.2f, ",
+      *first ? "" : ",", name, ops, ns / (double)ops);
+
+  if (bytes > 0) {
+    printf("\"bytes_per_s\": %.0f, ", (double)bytes * 1e9 / ns);
+  } else {
+    printf("\"bytes_per_s\": null, ");
+  }
+
+  if (ALLOCATIONS) {
+    printf("\"allocations_per_op\": %.3f, ", (double)allocs / (double)ops);
+  } else {
+    printf("\"allocations_per_op\": null, ");
+  }
+
+  printf("\"peak_rss_kb\": %ld}", bench_peak_rss());
+  *first = 0;
+}
+
+static int run(bench_config* bc, long minops, int first){
+
+  struct timespec t0, t1;
+  LRC_configDefaults* cd = NULL;
+  LRC_configDefaults* copy = NULL;
+  LRC_configNamespace* head = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  FILE* file = NULL;
+  FILE* out = NULL;
+  double ns, sum = 0.0;
+  long rounds, r, i, k, bytes, lookups, per;
+  unsigned long allocs, a;
+  char space[LRC_CONFIG_LEN], name[LRC_CONFIG_LEN];
+  int f = 1;
+
+  file = tmpfile();
+  out = tmpfile();
+  if (!file || !out) {
+    perror("lrc-bench: tmpfile failed");
+    return -1;
+  }
+
+  cd = bench_defaults(bc->options, bc->namespaces, bc->vlen);
+  if (!cd) {
+    perror("lrc-bench: alloc failed");
+    return -1;
+  }
+  bench_file(file, cd, bc->options, bc->namespaces, bc->comments);
+  bytes = ftell(file);
+  per = bench_per_space(bc->options, bc->namespaces);
+
+  rounds = (minops + bc->options - 1) / bc->options;
+  lookups = bc->options < minops ? minops : bc->options;
+
+  printf("%s\n    {\"options\": %ld, \"namespaces\": %ld, \"value_length\": %ld, "
+      "\"comment_density\": %g, \"file_bytes\": %ld, \"rounds\": %ld,\n"
+      "      \"results\": [", first ? "" : ",", bc->options, bc->namespaces,
+      bc->vlen, bc->comments, bytes, rounds);
+
+  /* LRC_assignDefaults (the last tree is kept for the other benchmarks) */
+  ns = 0.0;
+  allocs = 0;
+  for (r = 0; r < rounds; r++) {
+    a = allocations;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    head = LRC_assignDefaults(cd);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns += bench_elapsed(&t0, &t1);
+    allocs += allocations - a;
+    if (r + 1 < rounds) LRC_cleanup(head);
+  }
+  report(&f, "LRC_assignDefaults", bc->options * rounds, ns, 0, allocs);
+
+  /* LRC_ASCIIParser (the file is in the page cache) */
+  ns = 0.0;
+  allocs = allocations;
+  for (r = 0; r < rounds; r++) {
+    rewind(file);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (LRC_ASCIIParser(file, "=", "#", head) < 0) {
+      fprintf(stderr, "lrc-bench: parser failed\n");
+      return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns += bench_elapsed(&t0, &t1);
+  }
+  report(&f, "LRC_ASCIIParser", bc->options * rounds, ns, bytes * rounds, allocations - allocs);
+
+  /* LRC_findOption, random keys (with the namespace lookup) */
+  allocs = allocations;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (i = 0; i < lookups; i++) {
+    k = (long)(bench_random() % (unsigned long)bc->options);
+    sprintf(name, "option_%ld", k);
+    sprintf(space, "space%ld", k / per);
+    current = LRC_findNamespace(space, head);
+    option = LRC_findOption(name, current);
+    if (option) sum += (double)option->type;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  report(&f, "LRC_findOption", lookups, bench_elapsed(&t0, &t1), 0, allocations - allocs);
+
+  /* LRC_option2* converters (integers are every third option, doubles
+   * follow them) */
+  allocs = allocations;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (i = 0; i < lookups; i++) {
+    k = (long)(bench_random() % (unsigned long)bc->options);
+    k -= k % 3;
+    sprintf(name, "option_%ld", k);
+    sprintf(space, "space%ld", k / per);
+    sum += LRC_option2int(space, name, head);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  report(&f, "LRC_option2int", lookups, bench_elapsed(&t0, &t1), 0, allocations - allocs);
+
+  if (bc->options > 1) {
+    allocs = allocations;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < lookups; i++) {
+      k = (long)(bench_random() % (unsigned long)bc->options);
+      k -= k % 3;
+      k = k + 1 < bc->options ? k + 1 : 1;
+      sprintf(name, "option_%ld", k);
+      sprintf(space, "space%ld", k / per);
+      sum += LRC_option2double(space, name, head);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    report(&f, "LRC_option2double", lookups, bench_elapsed(&t0, &t1), 0, allocations - allocs);
+
+    allocs = allocations;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < lookups; i++) {
+      k = (long)(bench_random() % (unsigned long)bc->options);
+      k -= k % 3;
+      k = k + 1 < bc->options ? k + 1 : 1;
+      sprintf(name, "option_%ld", k);
+      sprintf(space, "space%ld", k / per);
+      sum += LRC_option2float(space, name, head);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    report(&f, "LRC_option2float", lookups, bench_elapsed(&t0, &t1), 0, allocations - allocs);
+  }
+
+  /* LRC_ASCIIWriter */
+  ns = 0.0;
+  allocs = allocations;
+  for (r = 0; r < rounds; r++) {
+    rewind(out);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    LRC_ASCIIWriter(out, "=", "#", head);
+    fflush(out);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns += bench_elapsed(&t0, &t1);
+  }
+  report(&f, "LRC_ASCIIWriter", bc->options * rounds, ns, ftell(out) * rounds, allocations - allocs);
+
+  /* LRC_head2struct */
+  ns = 0.0;
+  allocs = allocations;
+  for (r = 0; r < rounds; r++) {
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    copy = LRC_head2struct(head);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns += bench_elapsed(&t0, &t1);
+    free(copy);
+  }
+  report(&f, "LRC_head2struct", bc->options * rounds, ns, 0, allocations - allocs);
+
+  /* LRC_cleanup (the last tree is freed in the loop, the others are built
+   * outside of the timed region) */
+  ns = 0.0;
+  allocs = 0;
+  for (r = 0; r < rounds; r++) {
+    if (r > 0) head = LRC_assignDefaults(cd);
+    a = allocations;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    LRC_cleanup(head);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns += bench_elapsed(&t0, &t1);
+    allocs += allocations - a;
+  }
+  report(&f, "LRC_cleanup", bc->options * rounds, ns, 0, allocs);
+
+  printf("\n      ],\n      \"checksum\": %g}", sum);
+
+  free(cd);
+  fclose(file);
+  fclose(out);
+
+  return 0;
+}
+
+int main(int argc, char** argv){
+
+  bench_config bc;
+  char* sizes = "10,100,1000,10000,100000";
+  char* p;
+  long namespaces = 0, minops = 100000;
+  int opt, first = 1;
+
+  bc.vlen = 16;
+  bc.comments = 0.1;
+
+  while ((opt = getopt(argc, argv, "n:s:v:c:r:")) != -1) {
+    switch (opt) {
+      case 'n': sizes = optarg; break;
+      case 's': namespaces = atol(optarg); break;
+      case 'v': bc.vlen = atol(optarg); break;
+      case 'c': bc.comments = atof(optarg); break;
+      case 'r': minops = atol(optarg); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n sizes] [-s namespaces] [-v value length] "
+            "[-c comment density] [-r minimum ops]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  if (minops < 1 || bc.vlen < 1) {
+    fprintf(stderr, "%s: wrong arguments\n", argv[0]);
+    return 1;
+  }
+
+  printf("{\"benchmark\": \"lrc-bench\", \"runs\": [");
+
+  for (p = sizes; p && *p; p = strchr(p, ',') ? strchr(p, ',') + 1 : NULL) {
+    bc.options = atol(p);
+    if (bc.options < 1) continue;
+
+    bc.namespaces = namespaces > 0 ? namespaces : (long)sqrt((double)bc.options);
+    if (bc.namespaces < 1) bc.namespaces = 1;
+    if (bc.namespaces > bc.options) bc.namespaces = bc.options;
+
+    if (run(&bc, minops, first) < 0) return 1;
+    first = 0;
+  }
+
+  printf("\n  ]\n}\n");
+
+  return 0;
+}
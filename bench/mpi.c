@@ -0,0 +1,300 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file mpi.c
+ * @brief Startup scaling of the config loading with MPI.
+ *
+ * Usage: mpirun -np N lrc-bench-mpi [-n options] [-s namespaces]
+ *                                   [-v value length] [-r repetitions] [-f file]
+ *
+ * The config file is written by rank 0 (on a file system shared by the nodes)
+ * and loaded by 1, 2, 4, ... N ranks (sub-communicators of MPI_COMM_WORLD):
+ *  - "parse": every rank opens the file and calls LRC_ASCIIParser()
+ *  - "bcast": rank 0 parses, the others rebuild from LRC_MPI_Bcast()
+ *  - "node": rank 0 parses, the others rebuild from the copy shared by the
+ *    node, LRC_MPI_NodeBcast()
+ *
+ * The results are printed as JSON: the mean (over the repetitions) of the wall
+ * time of the slowest rank, and the file system operations summed over the
+ * ranks, i.e. the opens, the read calls and the bytes read from the file. The
+ * reads are counted through a glibc stdio cookie wrapping the file; elsewhere
+ * only the opens are reported. The file is in the page cache after the first
+ * load, as for a job started right after the config was written.
+ */
+
+/* fopencookie */
+#define _GNU_SOURCE
+
+#include <unistd.h>
+#include <fcntl.h>
+#include "bench.h"
+#include "libreadconfig_mpi.h"
+
+typedef struct{
+  long opens;
+  long reads;
+  long bytes;
+} bench_io;
+
+static bench_io io;
+
+#ifdef __GLIBC__
+static ssize_t cookie_read(void* cookie, char* buf, size_t size){
+
+  ssize_t n;
+
+  n = read(*(int*)cookie, buf, size);
+  io.reads++;
+  if (n > 0) io.bytes += n;
+
+  return n;
+}
+
+static int cookie_close(void* cookie){
+  return close(*(int*)cookie);
+}
+
+/* Opens the file for reading, counting the read calls */
+static FILE* bench_open(char* path, int* fd){
+
+  cookie_io_functions_t funcs = {cookie_read, NULL, NULL, cookie_close};
+  FILE* file;
+
+  *fd = open(path, O_RDONLY);
+  if (*fd < 0) return NULL;
+  io.opens++;
+
+  file = fopencookie(fd, "r", funcs);
+  if (!file) close(*fd);
+
+  return file;
+}
+#else
+static FILE* bench_open(char* path, int* fd){
+
+  FILE* file;
+
+  (void)fd;
+  file = fopen(path, "r");
+  if (file) io.opens++;
+
+  return file;
+}
+#endif
+
+enum {
+  BENCH_PARSE,
+  BENCH_BCAST,
+  BENCH_NODE,
+  BENCH_STRATEGIES
+};
+
+static char* strategies[] = {"parse", "bcast", "node"};
+
+/* Loads the config with the strategy, returns 0 on success */
+static int load(int strategy, char* path, MPI_Comm comm, LRC_configNamespace* head){
+
+  FILE* file = NULL;
+  int rank, fd, status = 0;
+
+  MPI_Comm_rank(comm, &rank);
+
+  if (strategy == BENCH_PARSE || rank == 0) {
+    file = bench_open(path, &fd);
+    if (!file || LRC_ASCIIParser(file, "=", "#", head) < 0) status = -1;
+    if (file) fclose(file);
+  }
+
+  switch (strategy) {
+    case BENCH_BCAST:
+      if (LRC_MPI_Bcast(comm, 0, head) < 0) status = -1;
+      break;
+    case BENCH_NODE:
+      if (LRC_MPI_NodeBcast(comm, 0, head) < 0) status = -1;
+      break;
+    default:
+      break;
+  }
+
+  return status;
+}
+
+/* Number of nodes of the communicator */
+static int count_nodes(MPI_Comm comm){
+
+  MPI_Comm node;
+  int noderank, leader, nodes;
+
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+  MPI_Comm_rank(node, &noderank);
+  leader = (noderank == 0);
+  MPI_Allreduce(&leader, &nodes, 1, MPI_INT, MPI_SUM, comm);
+  MPI_Comm_free(&node);
+
+  return nodes;
+}
+
+int main(int argc, char** argv){
+
+  LRC_configDefaults* cd = NULL;
+  LRC_configNamespace* head = NULL;
+  MPI_Comm comm;
+  FILE* file = NULL;
+  struct timespec t0, t1;
+  char* path = "lrc-bench-mpi.conf";
+  long options = 10000, namespaces = 0, vlen = 16, reps = 5, r, size = 0;
+  long counts[3];
+  double ns, wall, sum;
+  int rank, ranks, n, strategy, status, nodes, opt, first = 1;
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+
+  while ((opt = getopt(argc, argv, "n:s:v:r:f:")) != -1) {
+    switch (opt) {
+      case 'n': options = atol(optarg); break;
+      case 's': namespaces = atol(optarg); break;
+      case 'v': vlen = atol(optarg); break;
+      case 'r': reps = atol(optarg); break;
+      case 'f': path = optarg; break;
+      default:
+        if (rank == 0) {
+          fprintf(stderr, "Usage: %s [-n options] [-s namespaces] [-v value length] "
+              "[-r repetitions] [-f file]\n", argv[0]);
+        }
+        MPI_Finalize();
+        return 1;
+    }
+  }
+
+  if (options < 1 || reps < 1 || vlen < 0) {
+    if (rank == 0) fprintf(stderr, "%s: wrong arguments\n", argv[0]);
+    MPI_Finalize();
+    return 1;
+  }
+
+  if (namespaces < 1) namespaces = (long)sqrt((double)options);
+  if (namespaces < 1) namespaces = 1;
+  if (namespaces > options) namespaces = options;
+
+  /* The same defaults on all ranks */
+  cd = bench_defaults(options, namespaces, vlen);
+  if (!cd) {
+    perror("lrc-bench-mpi: alloc failed");
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+
+  if (rank == 0) {
+    file = fopen(path, "w");
+    if (!file || bench_file(file, cd, options, namespaces, 0.1) != 0) {
+      perror("lrc-bench-mpi: cannot write the config file");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    size = ftell(file);
+    fclose(file);
+
+    printf("{\"benchmark\": \"lrc-bench-mpi\", \"options\": %ld, \"namespaces\": %ld, "
+        "\"value_length\": %ld, \"file_bytes\": %ld, \"repetitions\": %ld, \"runs\": [",
+        options, namespaces, vlen, size, reps);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  for (n = 1; ; n = (2 * n < ranks) ? 2 * n : ranks) {
+    MPI_Comm_split(MPI_COMM_WORLD, rank < n ? 0 : MPI_UNDEFINED, rank, &comm);
+
+    if (comm != MPI_COMM_NULL) {
+      nodes = count_nodes(comm);
+
+      for (strategy = 0; strategy < BENCH_STRATEGIES; strategy++) {
+        sum = 0.0;
+        status = 0;
+        memset(&io, 0, sizeof(bench_io));
+
+        for (r = 0; r < reps; r++) {
+          head = LRC_assignDefaults(cd);
+
+          MPI_Barrier(comm);
+          clock_gettime(CLOCK_MONOTONIC, &t0);
+          if (load(strategy, path, comm, head) < 0) status = -1;
+          clock_gettime(CLOCK_MONOTONIC, &t1);
+
+          ns = bench_elapsed(&t0, &t1);
+          MPI_Reduce(&ns, &wall, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+          sum += wall;
+
+          LRC_cleanup(head);
+        }
+
+        counts[0] = io.opens;
+        counts[1] = io.reads;
+        counts[2] = io.bytes;
+        MPI_Allreduce(MPI_IN_PLACE, counts, 3, MPI_LONG, MPI_SUM, comm);
+        MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+
+        if (rank == 0) {
+          printf("%s\n    {\"ranks\": %d, \"nodes\": %d, \"strategy\": \"%s\", \"status\": %d, "
+              "\"wall_ms\": %.3f, \"opens\": %ld, ", first ? "" : ",", n, nodes,
+              strategies[strategy], status, sum / 1e6 / (double)reps, counts[0] / reps);
+#ifdef __GLIBC__
+          printf("\"reads\": %ld, \"bytes_read\": %ld}", counts[1] / reps, counts[2] / reps);
+#else
+          printf("\"reads\": null, \"bytes_read\": null}");
+#endif
+          first = 0;
+        }
+      }
+
+      MPI_Comm_free(&comm);
+    }
+
+    if (n == ranks) break;
+  }
+
+  if (rank == 0) {
+    printf("\n  ]\n}\n");
+    remove(path);
+  }
+
+  free(cd);
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file numeric.c
+ * @brief Benchmark of the number parsers against the C library.
+ *
+ * Usage: lrc-bench-numeric [values] [rounds]
+ *
+ * The input mimics config files: small integers, short decimals with and
+ * without exponents, and doubles written by LRC_double2str().
+ */
+
+/* clock_gettime */
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "libreadconfig.h"
+
+static char* samples[] = {
+  "4", "39", "2000", "1024", "0", "-1", "23.47", "2507.23", "928.91234e+2",
+  "0.001", "1e-10", "6.67430e-11", "299792458", "3.141592653589793", "0.5",
+  "1.0e+06", "-273.15", "0.3333333333333333", "100.0", "2.5e-05"
+};
+
+static double elapsed(struct timespec* a, struct timespec* b){
+  return (b->tv_sec - a->tv_sec) * 1e9 + (b->tv_nsec - a->tv_nsec);
+}
+
+int main(int argc, char** argv){
+
+  struct timespec t0, t1;
+  char** values;
+  double v, sum = 0.0, tlibc, tlrc;
+  long nvalues = 100000, rounds = 20, i, r, mismatches = 0, nsamples;
+  unsigned long seed = 12345;
+
+  if (argc > 1) nvalues = atol(argv[1]);
+  if (argc > 2) rounds = atol(argv[2]);
+  if (nvalues < 1 || rounds < 1) {
+    fprintf(stderr, "Usage: %s [values] [rounds]\n", argv[0]);
+    return 1;
+  }
+
+  nsamples = sizeof(samples) / sizeof(samples[0]);
+
+  values = malloc(nvalues * sizeof(char*));
+  if (!values) {
+    perror("lrc-bench-numeric: alloc failed");
+    return 1;
+  }
+
+  /* Half of the values are typical hand-written ones, half are random doubles
+   * in the shortest form */
+  for (i = 0; i < nvalues; i++) {
+    values[i] = malloc(LRC_NUMBER_LEN);
+    if (!values[i]) {
+      perror("lrc-bench-numeric: alloc failed");
+      return 1;
+    }
+    seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+    if (i % 2 == 0) {
+      strcpy(values[i], samples[(seed >> 33) % nsamples]);
+    } else {
+      LRC_double2str(values[i], ldexp((double)(seed >> 11), (int)((seed >> 3) % 80) - 93));
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (r = 0; r < rounds; r++) {
+    for (i = 0; i < nvalues; i++) sum += strtod(values[i], NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  tlibc = elapsed(&t0, &t1) / (double)(nvalues * rounds);
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (r = 0; r < rounds; r++) {
+    for (i = 0; i < nvalues; i++) {
+      LRC_str2double(values[i], &v);
+      sum -= v;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  tlrc = elapsed(&t0, &t1) / (double)(nvalues * rounds);
+
+  for (i = 0; i < nvalues; i++) {
+    LRC_str2double(values[i], &v);
+    if (v != strtod(values[i], NULL)) mismatches++;
+  }
+
+  printf("values:          %ld x %ld rounds\n", nvalues, rounds);
+  printf("strtod:          %.2f ns/op\n", tlibc);
+  printf("LRC_str2double:  %.2f ns/op\n", tlrc);
+  printf("speedup:         %.2fx\n", tlibc / tlrc);
+  printf("mismatches:      %ld\n", mismatches);
+  printf("checksum:        %g\n", sum);
+
+  for (i = 0; i < nvalues; i++) free(values[i]);
+  free(values);
+
+  return mismatches != 0;
+}
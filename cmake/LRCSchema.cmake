@@ -0,0 +1,34 @@
+# LRC_ADD_SCHEMA (output schema prefix)
+#
+# Generates the header with the typed config struct, the perfect hash of the
+# keys and the specialized parser and writer for the schema (see
+# src/lrc-schema.c for the schema syntax):
+#
+#   lrc_add_schema (${CMAKE_CURRENT_BINARY_DIR}/sim_config.h sim.schema sim)
+#   add_executable (sim sim.c ${CMAKE_CURRENT_BINARY_DIR}/sim_config.h)
+#   include_directories (${CMAKE_CURRENT_BINARY_DIR})
+#
+# The header is regenerated whenever the schema changes. Inside the
+# libreadconfig tree the lrc-schema target is used, otherwise the installed
+# program (LRC_SCHEMA_EXECUTABLE).
+
+function (lrc_add_schema output schema prefix)
+  if (TARGET lrc-schema)
+    set (generator lrc-schema)
+  else (TARGET lrc-schema)
+    find_program (LRC_SCHEMA_EXECUTABLE lrc-schema)
+    if (NOT LRC_SCHEMA_EXECUTABLE)
+      message (FATAL_ERROR "lrc_add_schema: lrc-schema not found")
+    endif (NOT LRC_SCHEMA_EXECUTABLE)
+    set (generator ${LRC_SCHEMA_EXECUTABLE})
+  endif (TARGET lrc-schema)
+
+  get_filename_component (schema_path ${schema} ABSOLUTE)
+
+  add_custom_command (
+    OUTPUT ${output}
+    COMMAND ${generator} ${schema_path} ${prefix} ${output}
+    DEPENDS ${generator} ${schema_path}
+    COMMENT "Generating ${prefix} config schema"
+  )
+endfunction (lrc_add_schema)
@@ -46,7 +46,29 @@
  * Features:
  * - inline/full-line comments
  * - simple error checking, input value checking
+ * - structured diagnostics (handler, rate limit, deduplication, all errors in one pass)
  * - ASCII and HDF5 config file read/write support
+ * - layout-preserving update of ASCII config files
+ * - typed setters with shortest round-trip number formatting
+ * - locale independent number parsing with error and overflow checking
+ * - int and double array options (native datasets in HDF5)
+ * - code generator for fixed schemas (typed struct, perfect hash of the keys)
+ * - parallel validator of many config files against the schema (lrc-check)
+ * - hash index and overlays (sparse overrides of a shared base config)
+ * - linear-time diff of configs and compact, portable patch files
+ * - canonical fingerprint of the config, kept up to date (LRC_hash())
+ * - loading of the config in the background (LRC_loadAsync(), LRC_loadAsyncHDF5(),
+ *   LRC_wait())
+ * - columnar store of parameter sweeps (typed columns, scans, HDF5 table export)
+ * - lazy sweep expansion from range (100:2000:10) and list ({a, b}) values
+ * - layered config (defaults, files, environment, command line) with provenance
+ * - popt table generated from the defaults (--namespace-name options)
+ * - ${namespace.name} interpolation of the values (dependency graph, memoized)
+ * - header-only C++17 binding (lrc.hpp)
+ * - HDF5 config history (append-only deltas keyed by step)
+ * - MPI broadcast of the config, once per node through shared memory
+ * - check that all MPI ranks run with the same config (LRC_MPI_Verify())
+ * - opt-in counters and phase timers (LRC_STATS), see LRC_getStats()
  * - customizable separator and comment marks
  * - namespaces
  * 
@@ -59,6 +81,9 @@
  * - better trim
  */
 
+/* fsync and fchmod */
+#define _POSIX_C_SOURCE 200809L
+
 #include "libreadconfig.h"
 #if HAVE_HDF5_H
   #include "libreadconfig_hdf5.h"
@@ -66,6 +91,8 @@
 
 #include "libreadconfig_internals.h"
 
+enum LRC_messages_type LRC_messages;
+
 /**
  * @defgroup LRC_internals Helper functions
  * @{
@@ -73,7 +100,9 @@
 
 /**
  * @fn void LRC_message(int j, int type, char* message)
- * @brief Prints error messages.
+ * @brief Reports errors with no config at hand to the global diagnostic
+ * handler, @see LRC_setDiagnostics(). Also used by the parsers generated by
+ * lrc-schema.
  * 
  * @param j
  *  The line in the config file where the error exist.
@@ -85,21 +114,7 @@
  *  Error message to print.
  */
 void LRC_message(int line, int type, char* message){
-
-  switch(type){
-    case LRC_ERR_CONFIG_SYNTAX:
-      printf("%s at line %d: %s\n", LRC_MSG_CONFIG_SYNTAX, line, message);
-      break;
-    case LRC_ERR_FILE_OPEN:
-      printf("%s at line %d: %s\n", LRC_MSG_FILE_OPEN, line, message);
-      break;
-    case LRC_ERR_HDF:
-      printf("%s at line %d: %s\n", LRC_MSG_HDF, line, message);
-      break;
-    default:
-      break;
-  }
-
+  LRC_report(NULL, type, line, 0, NULL, NULL, message);
 }
 
 /**
@@ -199,6 +214,45 @@ int LRC_charCount(char* l, char* s){
   return sep;
 }
 
+/**
+ * @fn void LRC_valueSpan(char* l, char* s, char* c, size_t* start, size_t* len)
+ * @brief Finds the value in the raw (untrimmed) line.
+ *
+ * The value is everything between the separator and the inline comment (or the
+ * end of the line), without the surrounding white spaces.
+ *
+ * @param l
+ *   Current line.
+ *
+ * @param s
+ *   The separator.
+ *
+ * @param c
+ *   The comment mark.
+ *
+ * @param start
+ *   On return, the offset of the value in the line.
+ *
+ * @param len
+ *   On return, the length of the value, 0 if there is no value.
+ */
+void LRC_valueSpan(char* l, char* s, char* c, size_t* start, size_t* len){
+
+  size_t i = 0, end = 0;
+
+  /* The value ends at the inline comment */
+  end = strcspn(l, c);
+
+  while (i < end && l[i] != *s) i++;
+  i++;
+
+  while (i < end && isspace((unsigned char)l[i])) i++;
+  while (end > i && isspace((unsigned char)l[end-1])) end--;
+
+  *start = i;
+  *len = end > i ? end - i : 0;
+}
+
 /**
  * @fn int LRC_checkName(char* varname, LRC_configDefaults* ct, int numCT)
  * @brief Checks if variable is allowed.
@@ -371,11 +425,12 @@ LRC_configNamespace* LRC_newNamespace(char* cfg) {
 
   LRC_configNamespace* newNM = NULL;
 
-  newNM = calloc(sizeof(LRC_configNamespace), sizeof(LRC_configNamespace));
+  newNM = calloc(1, sizeof(LRC_configNamespace));
   if (!newNM) {
     perror("LRC_newNamespace: line 374 alloc failed.");
     return NULL;
   }
+  LRC_COUNT_ALLOC(newNM, sizeof(LRC_configNamespace));
 
   strncpy(newNM->space, cfg, strlen(cfg));
   newNM->space[strlen(cfg)] = LRC_NULL;
@@ -428,36 +483,74 @@ LRC_configNamespace* LRC_newNamespace(char* cfg) {
  *  @return
  *    Number of namespaces found in the config file on success, -1 otherwise.
  *
+ *  The parser is reentrant, different configs may be parsed in parallel
+ *  threads (with LRC_STATS, the global statistics are updated atomically).
+ *
+ *  The value spans of all options are reset first, so that they always
+ *  describe the file parsed last (e.g. the user file of a layered config).
  */
 
 int LRC_ASCIIParser(FILE* read, char* SEP, char* COMM, LRC_configNamespace* head){
   
   int j = 0; int sepc = 0; int n = 0;
-  char* line; char l[LRC_MAX_LINE_LENGTH]; char* b; char* c;
-  char* value; 
+  int errors = 0, skip = 0, indent = 0;
+  char* line; char* l = NULL; char* b; char* c;
+  char* value; char* saveptr = NULL;
 
   LRC_configOptions* newOP = NULL;
   LRC_configNamespace* nextNM = NULL;
   LRC_configNamespace* current = NULL;
 
-  size_t valuelen = 0;
+  size_t lsize = 0;
+  ssize_t nread = 0;
+  size_t spanstart = 0, spanlen = 0;
+  long linepos = 0, pos = 0;
+  LRC_TIMER(t);
 
   if (!head) {
     perror("LRC_ASCIIParser: No config assigned");
     return -1;
   }
 
+  LRC_changed(head, NULL, NULL);
+
+  /* The spans describe the last parsed file only, see LRC_ASCIIUpdateFile() */
+  for (nextNM = head; nextNM; nextNM = nextNM->next) {
+    for (newOP = nextNM->options; newOP; newOP = newOP->next) {
+      newOP->offset = 0;
+      newOP->length = 0;
+    }
+  }
+
   current = head;
 
+  pos = ftell(read);
+  if (pos < 0) pos = 0;
+
+  /* The time of blank and comment lines goes to the read phase */
+  LRC_CLOCK(t);
+
   while (!feof(read)) {
     
     /* Count lines */
     j++; 
   
-    line = fgets(l, LRC_MAX_LINE_LENGTH, read);
+    /* Lines are not limited in length (long arrays) */
+    nread = getline(&l, &lsize, read);
     
     /* Skip blank lines and any NULL */
-    if (line == NULL) break;
+    if (nread < 0) break;
+    line = l;
+    LRC_COUNT(head, lines, 1);
+    LRC_COUNT(head, bytes, nread);
+    LRC_PHASE(head, LRC_PHASE_READ, t);
+
+    /* Keep track of the file layout, before the line is trimmed */
+    linepos = pos;
+    pos += (long)nread;
+    LRC_valueSpan(line, SEP, COMM, &spanstart, &spanlen);
+    indent = (int)strspn(line, " \t") + 1;
+
     if (line[0] == '\n') continue;
     
     /* Now we have to trim leading and trailing spaces etc */
@@ -468,30 +561,44 @@ int LRC_ASCIIParser(FILE* read, char* SEP, char* COMM, LRC_configNamespace* head
     
     /* Check for the separator at the beginning */
     if (strspn(line, SEP) > 0) {
-      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_MISSING_VAR); 
-      goto failure;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, indent, current ? current->space : NULL, NULL,
+          LRC_MSG_MISSING_VAR);
+      goto error;
     }
 
     /* First split var/value and inline comments.
      * Trim leading and trailing spaces */
-    b = LRC_trim(strtok(line,COMM));
+    b = strtok_r(line, COMM, &saveptr);
+
+    /* Lines of whitespace only */
+    if (!b) continue;
+    b = LRC_trim(b);
+    if (b[0] == LRC_NULL) continue;
 
     /* Check for namespaces */
     if (b[0] == '[') {
+
+      /* In the collect mode, the options of a wrong namespace are skipped */
+      current = NULL;
+      skip = 1;
+
       if (b[strlen(b)-1] != ']') {
-        LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_MISSING_BRACKET); 
-        goto failure;
+        LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, indent, NULL, NULL, LRC_MSG_MISSING_BRACKET);
+        goto error;
       }
 
       b = LRC_nameTrim(b);
+      LRC_PHASE(head, LRC_PHASE_TOKENIZE, t);
 			
 			nextNM = LRC_findNamespace(b, head);
+      LRC_PHASE(head, LRC_PHASE_LOOKUP, t);
 			
 			if (nextNM == NULL) {
-				LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_UNKNOWN_NAMESPACE);
-				goto failure;
+        LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, indent, b, NULL, LRC_MSG_UNKNOWN_NAMESPACE);
+        goto error;
 			} else {
 				current = nextNM;
+        skip = 0;
 			}
       
       n++;
@@ -501,67 +608,115 @@ int LRC_ASCIIParser(FILE* read, char* SEP, char* COMM, LRC_configNamespace* head
   
     /* If no namespace was specified return failure */
     if (current == NULL) {
-      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_NONAMESPACE);
-      goto failure;
+      if (skip) continue;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, indent, NULL, NULL, LRC_MSG_NONAMESPACE);
+      goto error;
     }
 
     /* Check if in the var/value string the separator exist.*/
     if (strstr(b,SEP) == NULL) {
-      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_MISSING_SEP); 
-      goto failure;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, indent, current->space, NULL, LRC_MSG_MISSING_SEP);
+      goto error;
     }
     
     /* Check some special case:
      * we have separator, but no value */
     if ((strlen(b) - 1) == strcspn(b,SEP)) {
-      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_MISSING_VAL); 
-      goto failure;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, (int)spanstart + 1, current->space, NULL,
+          LRC_MSG_MISSING_VAL);
+      goto error;
     }
 
     /* We allow to have only one separator in line */
     sepc = LRC_charCount(b, SEP);
     if (sepc > 1) {
-      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_TOOMANY_SEP); 
-      goto failure;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, (int)spanstart + 1, current->space, NULL,
+          LRC_MSG_TOOMANY_SEP);
+      goto error;
     }
     
     /* Ok, now we are prepared */
-    c = LRC_trim(strtok(b,SEP));
+    c = LRC_trim(strtok_r(b, SEP, &saveptr));
+    LRC_PHASE(head, LRC_PHASE_TOKENIZE, t);
 
 		newOP = LRC_findOption(c, current);
+    LRC_PHASE(head, LRC_PHASE_LOOKUP, t);
 		
 		if (newOP == NULL) {
-      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_UNKNOWN_VAR); 
-      goto failure;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, indent, current->space, c, LRC_MSG_UNKNOWN_VAR);
+      goto error;
 		}
 
-    while (c!=NULL) {
-      if (c[0] == '\n') break;
+    value = LRC_trim(strtok_r(NULL, "\n", &saveptr));
+    if (value == NULL) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, (int)spanstart + 1, current->space, newOP->name,
+          LRC_MSG_MISSING_VAL);
+      goto error;
+    }
 
-      valuelen = strlen(c);
-			value = calloc(valuelen+sizeof(char),sizeof(char));
-      if (!value) {
-        perror("LRC_ASCIIParser: line 542 alloc failed");
-        goto failure;
-      }
-			strncpy(value, c, valuelen);
-			value[valuelen] = LRC_NULL;
+    if (LRC_storeValue(newOP, value, newOP->type) < 0) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, j, (int)spanstart + 1, current->space, newOP->name,
+          strlen(value) >= LRC_CONFIG_LEN ? LRC_MSG_TOO_LONG : LRC_MSG_WRONG_INPUT);
+      goto error;
+    }
 
-			strncpy(newOP->value, value, valuelen);
-			newOP->value[valuelen] = LRC_NULL;
-			
-			c = LRC_trim(strtok(NULL,"\n"));
+    newOP->offset = linepos + (long)spanstart;
+    newOP->length = spanlen;
+    LRC_PHASE(head, LRC_PHASE_STORE, t);
+    continue;
 
-			if (value) free(value);
-    }  
-		
+error:
+    /* In the collect mode all errors of the file are reported */
+    errors++;
+    if (!LRC_diagCollect(head)) goto failure;
   }
-  return n;
+
+  if (l) free(l);
+  return errors > 0 ? -1 : n;
 
 failure:
+  if (l) free(l);
   return -1;
 }
 
+/**
+ * @fn int LRC_ASCIIParseFile(char* path, char* sep, char* comm, LRC_configNamespace* head)
+ * @brief Reads the ASCII config file, @see LRC_ASCIIParser().
+ *
+ * The errors are reported with the path of the file.
+ *
+ * @return
+ *  Number of namespaces found in the config file on success, -1 otherwise.
+ */
+int LRC_ASCIIParseFile(char* path, char* sep, char* comm, LRC_configNamespace* head){
+
+  LRC_configDiag* diag = NULL;
+  FILE* file = NULL;
+  char* previous = NULL;
+  int status;
+
+  if (!head || !path) return -1;
+
+  file = fopen(path, "r");
+  if (!file) {
+    LRC_report(head, LRC_ERR_FILE_OPEN, 0, 0, NULL, NULL, path);
+    return -1;
+  }
+
+  diag = LRC_diagOf(head);
+  if (diag) {
+    previous = diag->file;
+    diag->file = path;
+  }
+
+  status = LRC_ASCIIParser(file, sep, comm, head);
+
+  if (diag) diag->file = previous;
+  fclose(file);
+
+  return status;
+}
+
 /**
  * @fn void LRC_cleanup(LRC_configNamespace* head)
  * @brief Cleanup assign pointers. This is required for proper memory managment.
@@ -574,6 +729,14 @@ void LRC_cleanup(LRC_configNamespace* head){
   LRC_configNamespace* current = NULL;
 
   current = head;
+  if (head) {
+    LRC_freeInterp(head->interp);
+    LRC_freeDiag(head->diag);
+    LRC_freeHash(head->hash);
+#if HAVE_HDF5_H
+    LRC_freeHistory(head->history);
+#endif
+  }
 
   while (current) {
     nextNM = current->next;
@@ -581,10 +744,12 @@ void LRC_cleanup(LRC_configNamespace* head){
       
     while (currentOP) {
       nextOP = currentOP->next;
+      if (currentOP->array) free(currentOP->array);
       if (currentOP) free(currentOP);
       currentOP = nextOP;
     }
 
+    if (current->stats) free(current->stats);
     if (current) free(current);
     current=nextNM;
     
@@ -594,6 +759,226 @@ void LRC_cleanup(LRC_configNamespace* head){
 }
 
 #if HAVE_HDF5_H
+/**
+ * @fn hid_t LRC_HDF5DatasetDcpl(hid_t dcpl, hsize_t n)
+ * @brief Dataset creation properties for the 1-D dataset of n elements.
+ *
+ * Fixed size datasets may not have chunks larger than the dataset, so the
+ * chunk is limited to n. Empty datasets are not chunked.
+ *
+ * @return
+ *  The property list (a copy, to be closed by the caller, if it differs from
+ *  both dcpl and H5P_DEFAULT)
+ */
+hid_t LRC_HDF5DatasetDcpl(hid_t dcpl, hsize_t n){
+
+  hid_t copy;
+  hsize_t chunk[1];
+
+  if (dcpl == H5P_DEFAULT || H5Pget_layout(dcpl) != H5D_CHUNKED) return dcpl;
+  if (n == 0) return H5P_DEFAULT;
+  if (H5Pget_chunk(dcpl, 1, chunk) != 1 || chunk[0] <= n) return dcpl;
+
+  copy = H5Pcopy(dcpl);
+  if (copy < 0) return dcpl;
+
+  chunk[0] = n;
+  H5Pset_chunk(copy, 1, chunk);
+
+  return copy;
+}
+
+/**
+ * @fn int LRC_HDF5WriteArrays(hid_t group, LRC_configNamespace* head, long* shape, hid_t dcpl, hid_t gapl, hid_t dapl, hid_t dxpl, int root)
+ * @brief Writes the array options as native datasets.
+ *
+ * The elements of the array option are stored in the
+ * LRC_HDF5_ARRAYS/namespace/name dataset of the config group, as a 1-D integer
+ * or double dataset. The group is created only if there are any arrays.
+ *
+ * @param shape
+ *   Type and number of elements for each option (in the order of the config),
+ *   used by parallel writers, since the dataset creation is collective. If NULL,
+ *   the options of the head are used.
+ *
+ * @param dcpl
+ *   Dataset creation properties (chunking, filters), see LRC_HDF5DatasetDcpl().
+ *
+ * @param root
+ *   If 0, no data is contributed to the (collective) write.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_HDF5WriteArrays(hid_t group, LRC_configNamespace* head, long* shape,
+    hid_t dcpl, hid_t gapl, hid_t dapl, hid_t dxpl, int root){
+
+  hid_t arrays = -1, nsgroup, dataset, dataspace, dtype, plist;
+  hsize_t dims[1];
+  herr_t status;
+  int type, dummy = 0;
+  long idx = 0;
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* currentOP = NULL;
+
+  for (current = head; current; current = current->next) {
+    nsgroup = -1;
+
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next, idx++) {
+      type = shape ? (int)shape[2*idx] : currentOP->type;
+      dims[0] = shape ? (hsize_t)shape[2*idx+1] : (hsize_t)currentOP->count;
+
+      if (!LRC_isArray(type)) continue;
+
+      if (arrays < 0) {
+        arrays = H5Gcreate(group, LRC_HDF5_ARRAYS, H5P_DEFAULT, H5P_DEFAULT, gapl);
+        if (arrays < 0) goto failure;
+      }
+
+      if (nsgroup < 0) {
+        nsgroup = H5Gcreate(arrays, current->space, H5P_DEFAULT, H5P_DEFAULT, gapl);
+        if (nsgroup < 0) goto failure;
+      }
+
+      dtype = (type == LRC_INT_ARRAY) ? H5T_NATIVE_INT : H5T_NATIVE_DOUBLE;
+      dataspace = H5Screate_simple(1, dims, NULL);
+
+      plist = LRC_HDF5DatasetDcpl(dcpl, dims[0]);
+      dataset = H5Dcreate(nsgroup, currentOP->name, dtype, dataspace,
+          H5P_DEFAULT, plist, dapl);
+      if (plist != dcpl && plist != H5P_DEFAULT) H5Pclose(plist);
+      if (dataset < 0) goto failure;
+
+      if (dims[0] > 0) {
+        if (!root) H5Sselect_none(dataspace);
+        status = H5Dwrite(dataset, dtype, dataspace, dataspace, dxpl,
+            root ? currentOP->array : &dummy);
+        if (status < 0) goto failure;
+      }
+
+      H5Sclose(dataspace);
+      H5Dclose(dataset);
+    }
+
+    if (nsgroup >= 0) H5Gclose(nsgroup);
+  }
+
+  if (arrays >= 0) H5Gclose(arrays);
+
+  return 0;
+
+failure:
+  return -1;
+}
+
+/**
+ * @fn int LRC_HDF5ReadArrays(hid_t group, LRC_configNamespace* head, hid_t lapl, hid_t gapl, hid_t dapl)
+ * @brief Reads the array options written by LRC_HDF5WriteArrays().
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_HDF5ReadArrays(hid_t group, LRC_configNamespace* head, hid_t lapl, hid_t gapl, hid_t dapl){
+
+  hid_t arrays, nsgroup, dataset, dataspace, ftype, dtype;
+  H5G_info_t arrays_info, ns_info;
+  hssize_t npoints;
+  htri_t cctt;
+  herr_t status;
+  hsize_t i, k;
+  int type;
+  void* array = NULL;
+  char space_name[LRC_CONFIG_LEN];
+  char link_name[LRC_CONFIG_LEN];
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+
+  cctt = H5Lexists(group, LRC_HDF5_ARRAYS, lapl);
+  if (cctt < 0) goto failure;
+  if (!cctt) return 0;
+
+  arrays = H5Gopen(group, LRC_HDF5_ARRAYS, gapl);
+  if (arrays < 0) goto failure;
+
+  status = H5Gget_info(arrays, &arrays_info);
+  if (status < 0) goto failure;
+
+  for (i = 0; i < arrays_info.nlinks; i++) {
+    H5Lget_name_by_idx(arrays, ".", H5_INDEX_NAME, H5_ITER_INC, i,
+      space_name, LRC_CONFIG_LEN, lapl);
+
+    current = LRC_findNamespace(space_name, head);
+    if (!current) {
+      LRC_report(head, LRC_ERR_HDF, (int)i, 0, space_name, NULL, LRC_MSG_UNKNOWN_NAMESPACE);
+      goto failure;
+    }
+
+    nsgroup = H5Gopen(arrays, space_name, gapl);
+    if (nsgroup < 0) goto failure;
+
+    status = H5Gget_info(nsgroup, &ns_info);
+    if (status < 0) goto failure;
+
+    for (k = 0; k < ns_info.nlinks; k++) {
+      H5Lget_name_by_idx(nsgroup, ".", H5_INDEX_NAME, H5_ITER_INC, k,
+        link_name, LRC_CONFIG_LEN, lapl);
+
+      option = LRC_findOption(link_name, current);
+      if (!option) {
+        LRC_report(head, LRC_ERR_HDF, (int)k, 0, space_name, link_name, LRC_MSG_UNKNOWN_VAR);
+        goto failure;
+      }
+
+      dataset = H5Dopen(nsgroup, link_name, dapl);
+      if (dataset < 0) goto failure;
+
+      ftype = H5Dget_type(dataset);
+      if (H5Tget_class(ftype) == H5T_INTEGER) {
+        type = LRC_INT_ARRAY;
+        dtype = H5T_NATIVE_INT;
+      } else {
+        type = LRC_DOUBLE_ARRAY;
+        dtype = H5T_NATIVE_DOUBLE;
+      }
+      H5Tclose(ftype);
+
+      dataspace = H5Dget_space(dataset);
+      npoints = H5Sget_simple_extent_npoints(dataspace);
+      if (npoints < 0) goto failure;
+
+      if (npoints > 0) {
+        array = malloc((size_t)npoints * LRC_arrayElement(type));
+        if (!array) {
+          perror("LRC_HDF5ReadArrays: alloc failed");
+          goto failure;
+        }
+        LRC_COUNT_ALLOC(head, (size_t)npoints * LRC_arrayElement(type));
+
+        status = H5Dread(dataset, dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, array);
+        if (status < 0) goto failure;
+      }
+
+      LRC_storeArray(option, array, (size_t)npoints, type);
+      array = NULL;
+
+      H5Sclose(dataspace);
+      H5Dclose(dataset);
+    }
+
+    H5Gclose(nsgroup);
+  }
+
+  H5Gclose(arrays);
+
+  return 0;
+
+failure:
+  if (array) free(array);
+  return -1;
+}
+
 /**
  * HDF5 parser 
  * 
@@ -620,9 +1005,9 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
   herr_t status;
   H5G_info_t group_info;
 
-  int numOfNM = 0, i = 0, k = 0;
+  int numOfNM = 0, i = 0, k = 0, arrays = 0;
   char link_name[LRC_MAX_LINE_LENGTH];
-  ssize_t vlen, lname;
+  ssize_t lname;
   char tname[LRC_CONFIG_LEN];
   hsize_t edims[1], emaxdims[1];
 
@@ -630,8 +1015,11 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
   LRC_configOptions* newOP = NULL;
   LRC_configNamespace* current = NULL;
 
-  char value[LRC_CONFIG_LEN];
   ccd_t* rdata = NULL;
+  LRC_TIMER(t);
+
+  LRC_CLOCK(t);
+  LRC_changed(head, NULL, NULL);
 
   /* For future me: how to open compound data type and read it,
    * without rebuilding memtype? Is this possible? */
@@ -670,17 +1058,24 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
     H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i, 
       link_name, LRC_MAX_LINE_LENGTH, H5P_DEFAULT);
 
+    /* Array elements are read at the end */
+    if (strcmp(link_name, LRC_HDF5_ARRAYS) == 0) {
+      arrays = 1;
+      continue;
+    }
+
     /* Get size of the table with config data */
     dataset = H5Dopen(group, link_name, H5P_DEFAULT);
     dataspace = H5Dget_space(dataset);
     H5Sget_simple_extent_dims(dataspace, edims, emaxdims);
     
     /* We will get all data first */
-    rdata = calloc(((int)edims[0])*sizeof(ccd_t), sizeof(ccd_t));
+    rdata = calloc((size_t)edims[0], sizeof(ccd_t));
     if (!rdata) {
       perror("LRC_HDFParser: line 682 alloc failed");
       goto failure;
     }
+    LRC_COUNT_ALLOC(head, (size_t)edims[0] * sizeof(ccd_t));
     
     status = H5Dread(dataset, ccm_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
     if (status < 0) goto failure;
@@ -688,7 +1083,7 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
     /* Check if namespace exists */
     nextNM = LRC_findNamespace(link_name, head);
     if (nextNM == NULL) {
-				LRC_message(i, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_UNKNOWN_NAMESPACE);
+				LRC_report(head, LRC_ERR_CONFIG_SYNTAX, i, 0, link_name, NULL, LRC_MSG_UNKNOWN_NAMESPACE);
         goto failure;
     } else {
         current = nextNM;
@@ -705,18 +1100,14 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
       newOP = LRC_findOption(tname, current);
 
       if (newOP == NULL) {
-        LRC_message(i, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_UNKNOWN_VAR); 
+        LRC_report(head, LRC_ERR_CONFIG_SYNTAX, i, 0, current->space, tname, LRC_MSG_UNKNOWN_VAR);
         goto failure;
       }
 
-      vlen = strlen(rdata[k].value);
-      strncpy(value, rdata[k].value, vlen);
-      value[vlen] = LRC_NULL;
-
-      strncpy(newOP->value, value, vlen);
-      newOP->value[vlen] = LRC_NULL;
-    
-      newOP->type = rdata[k].type;
+      if (LRC_storeValue(newOP, rdata[k].value, rdata[k].type) < 0) {
+        LRC_report(head, LRC_ERR_HDF, i, 0, current->space, tname, LRC_MSG_WRONG_INPUT);
+        goto failure;
+      }
     }
 
     status = H5Dvlen_reclaim(ccm_tid, dataspace, H5P_DEFAULT, rdata);
@@ -731,6 +1122,11 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
     free(rdata);
   }
 
+  if (arrays) {
+    if (LRC_HDF5ReadArrays(group, head, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT) < 0) goto failure;
+    numOfNM--;
+  }
+
   status = H5Tclose(ccm_tid);
   if (status < 0) goto failure;
   
@@ -745,6 +1141,8 @@ int LRC_HDF5Parser(hid_t file, char* group_name, LRC_configNamespace* head){
   
   status = H5Gclose(master_group);
   if (status < 0) goto failure;
+
+  LRC_PHASE(head, LRC_PHASE_HDF5, t);
  
   return numOfNM;
 
@@ -758,97 +1156,596 @@ failure:
  */
 
 /**
- * @fn void LRC_ASCIIWriter(FILE*, char* sep, char* comm, LRC_configNamespace* head)
- * @brief Write ASCII config file.
+ * @fn int LRC_bufferAppend(LRC_buffer* buf, const char* str, size_t len)
+ * @brief Appends bytes to the growable buffer.
+ *
+ * The buffer grows geometrically and is always kept null-terminated.
+ *
  * @return
- *  Should return 0 on success, errcode otherwise
+ *  0 on success, -1 otherwise
  */
-int LRC_ASCIIWriter(FILE* write, char* sep, char* comm, LRC_configNamespace* head){
-
-  LRC_configOptions* currentOP = NULL;
-  LRC_configOptions* nextOP = NULL;
-  LRC_configNamespace* nextNM = NULL;
-  LRC_configNamespace* current = NULL;
-
-  if (!head) {
-    perror("LRC_ASCIIWriter: no config assigned");
-    return -1;
-  }
+int LRC_bufferAppend(LRC_buffer* buf, const char* str, size_t len) {
 
-  current = head;
+  size_t size;
+  char* data;
 
-  fprintf(write,"%s Written by LibReadConfig \n",comm);
+  if (buf->len + len + 1 > buf->size) {
+    size = buf->size > 0 ? buf->size : LRC_MAX_LINE_LENGTH;
+    while (buf->len + len + 1 > size) size *= 2;
 
-  do {
-    if (current) {
-      fprintf(write, "[%s]\n",current->space);
-      currentOP = current->options; 
-      do {
-        if (currentOP) {
-          fprintf(write, "%s %s %s\n", currentOP->name, sep, currentOP->value);
-          nextOP = currentOP->next;
-          currentOP = nextOP;
-        }
-      } while(currentOP);
-      
-      nextNM = current->next;
-      current = nextNM;
+    data = realloc(buf->data, size);
+    if (!data) {
+      perror("LRC_bufferAppend: alloc failed");
+      return -1;
     }
-    fprintf(write,"\n");
-  } while(current);
+    LRC_COUNT_ALLOC(NULL, size);
+    buf->data = data;
+    buf->size = size;
+  }
+
+  memcpy(buf->data + buf->len, str, len);
+  buf->len += len;
+  buf->data[buf->len] = LRC_NULL;
 
-  fprintf(write,"\n");
   return 0;
 }
 
-#if HAVE_HDF5_H
 /**
- * @fn void LRC_HDF5writer(hid_t file, LRC_configNamespace* head)
- * @brief Write config values to hdf file.
- * 
- * @param file
- *   The handler of the file.
+ * @fn int LRC_ASCIIFormat(LRC_buffer* buf, char* sep, char* comm, LRC_configNamespace* head)
+ * @brief Formats the ASCII config into the buffer.
  *
- * @return
- *  Should return 0 on success, errcode otherwise
+ * This is the formatter behind all ASCII writers, the output is the same for
+ * all of them.
  *
+ * @return
+ *  0 on success, -1 otherwise
  */
-int LRC_HDF5Writer(hid_t file, char* group_name, LRC_configNamespace* head){
-
-  hid_t master_group, group, dataset, dataspace, memspace;
-  hid_t ccm_tid, ccf_tid, name_dt, value_dt;
-  hsize_t dims[2], dimsm[2], offset[2], count[2], stride[2];
-  herr_t status;
-  htri_t cctt;
-  int k = 0;
-  size_t nlen, vlen;
+int LRC_ASCIIFormat(LRC_buffer* buf, char* sep, char* comm, LRC_configNamespace* head) {
 
   LRC_configOptions* currentOP = NULL;
-  LRC_configOptions* nextOP = NULL;
-  LRC_configNamespace* nextNM = NULL;
   LRC_configNamespace* current = NULL;
+  size_t seplen;
+  int status = 0;
+
+  seplen = strlen(sep);
+
+  status |= LRC_bufferAppend(buf, comm, strlen(comm));
+  status |= LRC_bufferAppend(buf, " Written by LibReadConfig \n", 27);
+
+  for (current = head; current; current = current->next) {
+    status |= LRC_bufferAppend(buf, "[", 1);
+    status |= LRC_bufferAppend(buf, current->space, strlen(current->space));
+    status |= LRC_bufferAppend(buf, "]\n", 2);
+
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      status |= LRC_bufferAppend(buf, currentOP->name, strlen(currentOP->name));
+      status |= LRC_bufferAppend(buf, " ", 1);
+      status |= LRC_bufferAppend(buf, sep, seplen);
+      status |= LRC_bufferAppend(buf, " ", 1);
+      if (LRC_isArray(currentOP->type)) {
+        status |= LRC_formatArray(buf, currentOP);
+      } else {
+        status |= LRC_bufferAppend(buf, currentOP->value, strlen(currentOP->value));
+      }
+      status |= LRC_bufferAppend(buf, "\n", 1);
+    }
 
-  ccd_t* ccd;
-  ccd = calloc(sizeof(ccd_t),sizeof(ccd_t));
-  if (!ccd) {
-    perror("LRC_HDFWriter: line 851 malloc failed");
-    goto failure;
-  }
-
-  cctt = H5Lexists(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
-  if (!cctt) {
-    master_group = H5Gcreate(file, LRC_CONFIG_GROUP, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-  } else {
-    master_group = H5Gopen(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+    status |= LRC_bufferAppend(buf, "\n", 1);
   }
-  group = H5Gcreate(master_group, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
 
-  if (!head) {
-    perror("LRC_HDFWriter: no config assigned");
-    goto failure;
-  }
+  status |= LRC_bufferAppend(buf, "\n", 1);
 
-  current = head;
+  return status ? -1 : 0;
+}
+
+/**
+ * @fn int LRC_writeAtomic(char* path, char* data, size_t len)
+ * @brief Replaces the file with the given content.
+ *
+ * The data is written to a temporary file in the same directory, flushed to
+ * the disk and renamed over the target, so that the file is never seen
+ * truncated, even after a crash. The replaced file keeps its permissions, a
+ * new one gets 0666 minus the umask, as with fopen().
+ *
+ * Any failure, including a failure to set the permissions of the replaced
+ * file, leaves the original file untouched and removes the temporary one.
+ * The error is reported once, to the global diagnostics.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_writeAtomic(char* path, char* data, size_t len) {
+
+  static unsigned int serial = 0;
+  char* tmp = NULL;
+  char* dir = NULL;
+  char* slash = NULL;
+  struct stat st;
+  ssize_t written;
+  size_t plen, done = 0;
+  int fd = -1, dirfd = -1, exists, tries;
+
+  plen = strlen(path);
+  tmp = malloc(plen + 32);
+  if (!tmp) {
+    perror("LRC_writeAtomic: alloc failed");
+    return -1;
+  }
+  memcpy(tmp, path, plen);
+
+  exists = stat(path, &st) == 0;
+
+  /* mkstemp() would give 0600 whatever the umask is, so the temporary file
+   * is created by hand. A new file gets 0666, less the umask */
+  for (tries = 0; tries < 100; tries++) {
+    sprintf(tmp + plen, ".%ld.%u", (long)getpid(), LRC_ATOMIC_ADD(serial, 1));
+    fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL, exists ? 0600 : 0666);
+    if (fd >= 0 || errno != EEXIST) break;
+  }
+
+  if (fd < 0) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, path);
+    free(tmp);
+    return -1;
+  }
+
+  /* Keep the permissions of the file we replace, or do not replace it */
+  if (exists && fchmod(fd, st.st_mode & 07777) < 0) goto failure;
+
+  /* A single write, unless the kernel returns early */
+  while (done < len) {
+    written = write(fd, data + done, len - done);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      goto failure;
+    }
+    done += (size_t)written;
+  }
+
+  if (fsync(fd) < 0) goto failure;
+  if (close(fd) < 0) {
+    fd = -1;
+    goto failure;
+  }
+  fd = -1;
+
+  if (rename(tmp, path) < 0) goto failure;
+
+  /* Make the rename itself durable */
+  dir = malloc(plen + 2);
+  if (dir) {
+    memcpy(dir, path, plen + 1);
+    slash = strrchr(dir, '/');
+    if (slash == dir) {
+      dir[1] = LRC_NULL;
+    } else if (slash) {
+      *slash = LRC_NULL;
+    } else {
+      dir[0] = '.';
+      dir[1] = LRC_NULL;
+    }
+    dirfd = open(dir, O_RDONLY);
+    if (dirfd >= 0) {
+      fsync(dirfd);
+      close(dirfd);
+    }
+    free(dir);
+  }
+
+  free(tmp);
+  return 0;
+
+failure:
+  LRC_message(0, LRC_ERR_FILE_CLOSE, path);
+  if (fd >= 0) close(fd);
+  unlink(tmp);
+  free(tmp);
+  return -1;
+}
+
+/**
+ * @fn void LRC_ASCIIWriter(FILE*, char* sep, char* comm, LRC_configNamespace* head)
+ * @brief Write ASCII config file.
+ *
+ * The whole config is formatted in memory and written with a single fwrite.
+ *
+ * @return
+ *  Should return 0 on success, errcode otherwise
+ */
+int LRC_ASCIIWriter(FILE* write, char* sep, char* comm, LRC_configNamespace* head){
+
+  LRC_buffer buf = {NULL, 0, 0};
+  int status = 0;
+  LRC_TIMER(t);
+
+  if (!head) {
+    perror("LRC_ASCIIWriter: no config assigned");
+    return -1;
+  }
+
+  LRC_CLOCK(t);
+  status = LRC_ASCIIFormat(&buf, sep, comm, head);
+  if (status == 0) {
+    if (fwrite(buf.data, 1, buf.len, write) != buf.len) status = -1;
+  }
+
+  free(buf.data);
+  LRC_PHASE(head, LRC_PHASE_WRITE, t);
+  return status;
+}
+
+/**
+ * @fn char* LRC_ASCIIWriteBuffer(char* sep, char* comm, LRC_configNamespace* head, size_t* len)
+ * @brief Formats the ASCII config in memory.
+ *
+ * @param len
+ *  On return, the length of the config (the buffer is also null-terminated)
+ *
+ * @return
+ *  The config, as written by LRC_ASCIIWriter() (you must free it) or NULL on failure
+ */
+char* LRC_ASCIIWriteBuffer(char* sep, char* comm, LRC_configNamespace* head, size_t* len){
+
+  LRC_buffer buf = {NULL, 0, 0};
+  LRC_TIMER(t);
+
+  if (!head) {
+    perror("LRC_ASCIIWriteBuffer: no config assigned");
+    return NULL;
+  }
+
+  LRC_CLOCK(t);
+  if (LRC_ASCIIFormat(&buf, sep, comm, head) < 0) {
+    free(buf.data);
+    return NULL;
+  }
+  LRC_PHASE(head, LRC_PHASE_WRITE, t);
+
+  if (len) *len = buf.len;
+  return buf.data;
+}
+
+/**
+ * @fn int LRC_ASCIIWriteFile(char* path, char* sep, char* comm, LRC_configNamespace* head)
+ * @brief Atomically writes the ASCII config file.
+ *
+ * The config is formatted in memory, written to a temporary file with a single
+ * write, flushed with fsync and renamed over the path. Readers see either the
+ * old or the new file, never a truncated one.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_ASCIIWriteFile(char* path, char* sep, char* comm, LRC_configNamespace* head){
+
+  LRC_buffer buf = {NULL, 0, 0};
+  int status = 0;
+  LRC_TIMER(t);
+
+  if (!head) {
+    perror("LRC_ASCIIWriteFile: no config assigned");
+    return -1;
+  }
+
+  LRC_CLOCK(t);
+  status = LRC_ASCIIFormat(&buf, sep, comm, head);
+  if (status == 0) status = LRC_writeAtomic(path, buf.data, buf.len);
+
+  free(buf.data);
+  LRC_PHASE(head, LRC_PHASE_WRITE, t);
+  return status;
+}
+
+/**
+ * @fn int LRC_compareOffsets(const void* a, const void* b)
+ * @brief Orders options by their offset in the ASCII config file (qsort helper).
+ */
+int LRC_compareOffsets(const void* a, const void* b){
+
+  const LRC_configOptions* x = *(LRC_configOptions* const*)a;
+  const LRC_configOptions* y = *(LRC_configOptions* const*)b;
+
+  if (x->offset < y->offset) return -1;
+  if (x->offset > y->offset) return 1;
+  return 0;
+}
+
+/**
+ * @fn int LRC_ASCIIUpdateFile(char* path, LRC_configNamespace* head)
+ * @brief Writes the changed values back into the original ASCII config file.
+ *
+ * Unlike LRC_ASCIIWriter(), the comments, the order and the formatting of the
+ * file are preserved. The parser records the byte span of every value, and
+ * only the values that differ from the text of the file are replaced.
+ *
+ * If all changed values keep their length, only these regions are rewritten
+ * in place. Otherwise, the patched text replaces the file atomically (as with
+ * LRC_ASCIIWriteFile()) and the recorded spans are shifted accordingly.
+ *
+ * Array options are compared by their elements, and rewritten in the form of
+ * LRC_ASCIIWriter() only if the elements differ.
+ *
+ * Options which do not appear in the file are not added, use LRC_ASCIIWriter()
+ * for a complete dump.
+ *
+ * @param path
+ *   The config file, the last one read with LRC_ASCIIParser() into the config.
+ *
+ * @param head
+ *   The config.
+ *
+ * @return
+ *  Number of updated values or -1 on failure
+ */
+int LRC_ASCIIUpdateFile(char* path, LRC_configNamespace* head){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* currentOP = NULL;
+  LRC_configOptions** spans = NULL;
+  LRC_buffer buf = {NULL, 0, 0};
+  LRC_buffer elements = {NULL, 0, 0};
+  char* old = NULL;
+  char* text = NULL;
+  char** repl = NULL;
+  void* array = NULL;
+  struct stat st;
+  ssize_t r;
+  size_t nspans = 0, i = 0, vlen, from = 0, oldsize = 0, count;
+  long shift = 0;
+  int fd = -1, changed = 0, inplace = 1, status = 0, same;
+  LRC_TIMER(t);
+
+  if (!head) {
+    perror("LRC_ASCIIUpdateFile: no config assigned");
+    return -1;
+  }
+
+  LRC_CLOCK(t);
+
+  /* Read the original text */
+  fd = open(path, O_RDONLY);
+  if (fd < 0 || fstat(fd, &st) < 0) {
+    LRC_report(head, LRC_ERR_FILE_OPEN, 0, 0, NULL, NULL, path);
+    goto failure;
+  }
+
+  text = malloc((size_t)st.st_size + 1);
+  if (!text) {
+    perror("LRC_ASCIIUpdateFile: alloc failed");
+    goto failure;
+  }
+
+  while (i < (size_t)st.st_size) {
+    r = read(fd, text + i, (size_t)st.st_size - i);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) goto failure;
+    i += (size_t)r;
+  }
+  close(fd);
+  fd = -1;
+
+  /* Collect the values read from the file, in the file order */
+  for (current = head; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      if (currentOP->length > 0) nspans++;
+    }
+  }
+
+  if (nspans == 0) goto finish;
+
+  spans = calloc(nspans, sizeof(LRC_configOptions*));
+  repl = calloc(nspans, sizeof(char*));
+  if (!spans || !repl) {
+    perror("LRC_ASCIIUpdateFile: alloc failed");
+    goto failure;
+  }
+
+  i = 0;
+  for (current = head; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      if (currentOP->length > 0) spans[i++] = currentOP;
+    }
+  }
+
+  qsort(spans, nspans, sizeof(LRC_configOptions*), LRC_compareOffsets);
+
+  /* Find the changed values and prepare their new text. The parser collapses
+   * white spaces, so the text of the file is compared the same way */
+  for (i = 0; i < nspans; i++) {
+    currentOP = spans[i];
+
+    /* Spans out of the file, or overlapping, come from another file */
+    if (currentOP->offset < 0
+        || (size_t)currentOP->offset + currentOP->length > (size_t)st.st_size
+        || (i > 0 && (size_t)currentOP->offset < (size_t)spans[i-1]->offset + spans[i-1]->length)) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, NULL, currentOP->name,
+          "The layout does not match the file");
+      goto failure;
+    }
+
+    if (currentOP->length + 1 > oldsize) {
+      oldsize = currentOP->length + 1;
+      free(old);
+      old = malloc(oldsize);
+      if (!old) {
+        perror("LRC_ASCIIUpdateFile: alloc failed");
+        goto failure;
+      }
+    }
+
+    memcpy(old, text + currentOP->offset, currentOP->length);
+    old[currentOP->length] = LRC_NULL;
+
+    if (LRC_isArray(currentOP->type)) {
+      same = LRC_parseArray(old, currentOP->type, &array, &count) == LRC_NUMBER_OK
+        && count == currentOP->count
+        && (count == 0
+            || memcmp(array, currentOP->array, count * LRC_arrayElement(currentOP->type)) == 0);
+      if (array) free(array);
+      array = NULL;
+      if (same) continue;
+
+      elements.len = 0;
+      if (elements.data) elements.data[0] = LRC_NULL;
+      if (LRC_formatArray(&elements, currentOP) < 0) goto failure;
+      repl[i] = strdup(elements.data ? elements.data : "");
+    } else {
+      vlen = strlen(currentOP->value);
+      if (vlen == currentOP->length
+          && memcmp(text + currentOP->offset, currentOP->value, vlen) == 0) continue;
+      if (strcmp(LRC_trim(old), currentOP->value) == 0) continue;
+
+      repl[i] = strdup(currentOP->value);
+    }
+
+    if (!repl[i]) {
+      perror("LRC_ASCIIUpdateFile: alloc failed");
+      goto failure;
+    }
+
+    if (strlen(repl[i]) != currentOP->length) inplace = 0;
+    changed++;
+  }
+
+  if (changed == 0) goto finish;
+
+  if (inplace) {
+
+    /* Rewrite only the affected regions */
+    fd = open(path, O_WRONLY);
+    if (fd < 0) {
+      LRC_report(head, LRC_ERR_FILE_OPEN, 0, 0, NULL, NULL, path);
+      goto failure;
+    }
+
+    for (i = 0; i < nspans; i++) {
+      if (!repl[i]) continue;
+      r = pwrite(fd, repl[i], spans[i]->length, (off_t)spans[i]->offset);
+      if (r != (ssize_t)spans[i]->length) goto failure;
+    }
+
+    if (fsync(fd) < 0) goto failure;
+    close(fd);
+    fd = -1;
+
+  } else {
+
+    /* Splice the new values into the original text */
+    for (i = 0; i < nspans; i++) {
+      if (!repl[i]) continue;
+      status |= LRC_bufferAppend(&buf, text + from, (size_t)spans[i]->offset - from);
+      status |= LRC_bufferAppend(&buf, repl[i], strlen(repl[i]));
+      from = (size_t)spans[i]->offset + spans[i]->length;
+    }
+    status |= LRC_bufferAppend(&buf, text + from, (size_t)st.st_size - from);
+    if (status != 0) goto failure;
+
+    if (LRC_writeAtomic(path, buf.data, buf.len) < 0) goto failure;
+
+    /* Move the spans to the new layout */
+    for (i = 0; i < nspans; i++) {
+      spans[i]->offset += shift;
+      if (!repl[i]) continue;
+
+      vlen = strlen(repl[i]);
+      shift += (long)vlen - (long)spans[i]->length;
+      spans[i]->length = vlen;
+    }
+  }
+
+finish:
+  if (repl) {
+    for (i = 0; i < nspans; i++) free(repl[i]);
+    free(repl);
+  }
+  if (spans) free(spans);
+  if (buf.data) free(buf.data);
+  if (elements.data) free(elements.data);
+  free(old);
+  free(text);
+  LRC_PHASE(head, LRC_PHASE_WRITE, t);
+  return changed;
+
+failure:
+  if (fd >= 0) close(fd);
+  if (repl) {
+    for (i = 0; i < nspans; i++) free(repl[i]);
+    free(repl);
+  }
+  if (spans) free(spans);
+  if (buf.data) free(buf.data);
+  if (elements.data) free(elements.data);
+  if (old) free(old);
+  if (text) free(text);
+  return -1;
+}
+
+#if HAVE_HDF5_H
+/**
+ * @fn void LRC_HDF5writer(hid_t file, LRC_configNamespace* head)
+ * @brief Write config values to hdf file.
+ * 
+ * @param file
+ *   The handler of the file.
+ *
+ * @return
+ *  Should return 0 on success, errcode otherwise
+ *
+ */
+int LRC_HDF5Writer(hid_t file, char* group_name, LRC_configNamespace* head){
+  return LRC_HDF5WriterDcpl(file, group_name, head, H5P_DEFAULT);
+}
+
+/**
+ * @fn int LRC_HDF5WriterDcpl(hid_t file, char* group_name, LRC_configNamespace* head, hid_t dcpl)
+ * @brief Writes the config with the given dataset creation properties.
+ *
+ * @param dcpl
+ *   Dataset creation properties of the namespace tables and the arrays, e.g.
+ *   1-D chunking and compression. The chunks are limited to the size of the
+ *   datasets.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_HDF5WriterDcpl(hid_t file, char* group_name, LRC_configNamespace* head, hid_t dcpl){
+
+  hid_t master_group, group, dataset, dataspace, memspace, plist;
+  hid_t ccm_tid, ccf_tid, name_dt, value_dt;
+  hsize_t dims[2], dimsm[2], offset[2], count[2], stride[2];
+  herr_t status;
+  htri_t cctt;
+  int k = 0;
+  size_t nlen, vlen;
+
+  LRC_configOptions* currentOP = NULL;
+  LRC_configOptions* nextOP = NULL;
+  LRC_configNamespace* nextNM = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_TIMER(t);
+
+  ccd_t* ccd;
+  LRC_CLOCK(t);
+  ccd = calloc(1, sizeof(ccd_t));
+  if (!ccd) {
+    perror("LRC_HDFWriter: line 851 malloc failed");
+    goto failure;
+  }
+
+  cctt = H5Lexists(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  if (!cctt) {
+    master_group = H5Gcreate(file, LRC_CONFIG_GROUP, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  } else {
+    master_group = H5Gopen(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  }
+  group = H5Gcreate(master_group, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+  if (!head) {
+    perror("LRC_HDFWriter: no config assigned");
+    goto failure;
+  }
+
+  current = head;
 
   /* Create variable length string datatype */
   name_dt = H5Tcopy(H5T_C_S1);
@@ -893,8 +1790,11 @@ int LRC_HDF5Writer(hid_t file, char* group_name, LRC_configNamespace* head){
       dims[1] = 1;
       dataspace = H5Screate_simple(1, dims, NULL);
     
+      plist = LRC_HDF5DatasetDcpl(dcpl, dims[0]);
       dataset = H5Dcreate(group, current->space, ccf_tid, dataspace, 
-          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+          H5P_DEFAULT, plist, H5P_DEFAULT);
+      if (plist != dcpl && plist != H5P_DEFAULT) H5Pclose(plist);
+      if (dataset < 0) goto failure;
 
     /* Write config data one by one in given namespace */
     k = 0;
@@ -953,6 +1853,8 @@ int LRC_HDF5Writer(hid_t file, char* group_name, LRC_configNamespace* head){
     }
   } while(current);
 
+  if (LRC_HDF5WriteArrays(group, head, NULL, dcpl, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT, 1) < 0) goto failure;
+
   status = H5Gclose(group);
   if (status < 0) goto failure;
   
@@ -973,358 +1875,2200 @@ int LRC_HDF5Writer(hid_t file, char* group_name, LRC_configNamespace* head){
 
   free(ccd);
 
+  LRC_PHASE(head, LRC_PHASE_HDF5, t);
+
   return 0;
 failure:
   return -1;
 }
-#endif
 
 /**
- * @fn void LRC_printAll(LRC_configNamespace* head)
- * @brief Prints all options.
+ * @fn hid_t LRC_HDF5HistoryType(void)
+ * @brief Creates the compound datatype of the history record.
+ *
+ * @return
+ *  The memory datatype of cch_t (close it with H5Tclose) or -1 on failure
  */
-void LRC_printAll(LRC_configNamespace* head){
+hid_t LRC_HDF5HistoryType(void) {
 
-  LRC_configOptions* currentOP = NULL;
-  LRC_configOptions* nextOP = NULL;
-  LRC_configNamespace* nextNM = NULL;
-  LRC_configNamespace* current = NULL;
+  hid_t cch_tid, string_dt;
+  herr_t status;
 
-  if (head) current = head;
+  string_dt = H5Tcopy(H5T_C_S1);
+  status = H5Tset_size(string_dt, LRC_CONFIG_LEN);
+  if (status < 0) return -1;
 
-  do {
-    if (current) {
-      nextNM = current->next;
-      printf("[%s][%d]\n",current->space, LRC_countOptions(current->space, current));
-      currentOP = current->options;
-      do {
-        if (currentOP) {
-          nextOP = currentOP->next;
-          printf("%s = %s [type %d]\n", currentOP->name, currentOP->value, currentOP->type);
-          currentOP = nextOP;
-        }
-      } while(currentOP);
-      
-      current=nextNM;
-    }
-		printf("\n");
-    
-  } while(current);
+  cch_tid = H5Tcreate(H5T_COMPOUND, sizeof(cch_t));
 
-  current = NULL;
+  H5Tinsert(cch_tid, "Step", HOFFSET(cch_t, step), H5T_NATIVE_LLONG);
+  H5Tinsert(cch_tid, "Space", HOFFSET(cch_t, space), string_dt);
+  H5Tinsert(cch_tid, "Name", HOFFSET(cch_t, name), string_dt);
+  H5Tinsert(cch_tid, "Value", HOFFSET(cch_t, value), string_dt);
+  H5Tinsert(cch_tid, "Type", HOFFSET(cch_t, type), H5T_NATIVE_INT);
+
+  status = H5Tclose(string_dt);
+  if (status < 0) return -1;
 
+  return cch_tid;
 }
 
 /**
- * @fn int LRC_assignDefaults(LRC_configDefaults* cd)
- * @brief Assign default values
+ * @fn int LRC_HDF5HistoryReplay(hid_t dataset, hid_t cch_tid, long long step, LRC_configNamespace* head, long long* last)
+ * @brief Applies the history records up to the given step.
+ *
+ * Records are read in blocks of LRC_HDF5_HISTORY_CHUNK, in the order they were
+ * appended. Since steps are increasing, reading stops at the first record past
+ * the requested step. The errors are reported with the number of the record
+ * (from 1) as the line.
+ *
+ * @param dataset
+ *  The history dataset
+ *
+ * @param cch_tid
+ *  The memory datatype of the history record
+ *
+ * @param step
+ *  The last step to apply
+ *
+ * @param head
+ *  The tree to apply the changes to
+ *
+ * @param last
+ *  On return, the step of the last record read (unchanged, if there are no records)
  *
  * @return
- *  Should return 0 on success, errcode otherwise
+ *  Number of applied records or -1 on failure
  */
+int LRC_HDF5HistoryReplay(hid_t dataset, hid_t cch_tid, long long step,
+    LRC_configNamespace* head, long long* last) {
 
-LRC_configNamespace* LRC_assignDefaults(LRC_configDefaults* cd){
+  hid_t dataspace = -1, memspace = -1;
+  hsize_t dims[1], offset[1], count[1];
+  herr_t status;
+  int applied = 0, k = 0, n = 0, record;
 
-  LRC_configNamespace* nextNM = NULL;
   LRC_configNamespace* current = NULL;
-  LRC_configNamespace* head = NULL;
-  LRC_configOptions* newOP = NULL;
-  LRC_configOptions* nextOP = NULL;
-  LRC_configOptions* currentOP = NULL;
-  size_t slen, nlen, vlen;
-  char space[LRC_CONFIG_LEN]; 
-  char name[LRC_CONFIG_LEN]; 
-  char value[LRC_CONFIG_LEN]; 
+  LRC_configOptions* option = NULL;
+  cch_t* rdata = NULL;
 
-  int i = 0;
+  rdata = calloc(LRC_HDF5_HISTORY_CHUNK, sizeof(cch_t));
+  if (!rdata) {
+    perror("LRC_HDF5HistoryReplay: alloc failed");
+    return -1;
+  }
 
-  head = NULL;
-  current = NULL;
+  dataspace = H5Dget_space(dataset);
+  if (dataspace < 0) goto failure;
+  H5Sget_simple_extent_dims(dataspace, dims, NULL);
 
-  while (cd[i].space[0] != LRC_NULL) {
+  for (offset[0] = 0; offset[0] < dims[0]; offset[0] += count[0]) {
 
-      /* Prepare namespace */
-      slen = strlen(cd[i].space);
-      strncpy(space,cd[i].space, slen);
-			space[slen] = LRC_NULL;
+    count[0] = dims[0] - offset[0];
+    if (count[0] > LRC_HDF5_HISTORY_CHUNK) count[0] = LRC_HDF5_HISTORY_CHUNK;
+    n = (int)count[0];
 
-      if (head == NULL) {
-        head = LRC_newNamespace(space);
-        current = head;
-      } else {
-        nextNM = LRC_findNamespace(space, head);
+    memspace = H5Screate_simple(1, count, NULL);
+    status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset, NULL, count, NULL);
+    if (status < 0) goto failure;
 
-        if (nextNM == NULL) {
-          current = LRC_lastLeaf(head);
-          current->next = LRC_newNamespace(space);
-          current = current->next;
-        } else {
-				  current = nextNM;
-          current->next = NULL;
-			  }
+    status = H5Dread(dataset, cch_tid, memspace, dataspace, H5P_DEFAULT, rdata);
+    if (status < 0) goto failure;
+
+    status = H5Sclose(memspace);
+    memspace = -1;
+    if (status < 0) goto failure;
+
+    for (k = 0; k < n; k++) {
+      if (rdata[k].step > step) goto finish;
+      *last = rdata[k].step;
+      record = (int)(offset[0] + (hsize_t)k + 1);
+
+      current = LRC_findNamespace(rdata[k].space, head);
+      if (current == NULL) {
+        LRC_report(head, LRC_ERR_HDF, record, 0, rdata[k].space, NULL, LRC_MSG_UNKNOWN_NAMESPACE);
+        goto failure;
       }
 
-      if (current) { 
+      option = LRC_findOption(rdata[k].name, current);
+      if (option == NULL) {
+        LRC_report(head, LRC_ERR_HDF, record, 0, rdata[k].space, rdata[k].name, LRC_MSG_UNKNOWN_VAR);
+        goto failure;
+      }
 
-				/* Prepare var name*/
-       	nlen = strlen(cd[i].name);
-       	strncpy(name, cd[i].name, nlen);
-				name[nlen] = LRC_NULL;
+      if (LRC_storeValue(option, rdata[k].value, rdata[k].type) < 0) {
+        LRC_report(head, LRC_ERR_HDF, record, 0, rdata[k].space, rdata[k].name, LRC_MSG_WRONG_INPUT);
+        goto failure;
+      }
 
-				currentOP = LRC_findOption(name, current);
+      applied++;
+    }
+  }
 
-        if (currentOP == NULL) {  	
-					newOP = calloc(sizeof(LRC_configOptions), sizeof(LRC_configOptions));
-          if (!newOP) {
-            perror("LRC_assignDefaults: line 1108 alloc failed");
-            return NULL;
-          }
-          newOP->type = LRC_INT;
-          newOP->next = NULL;
-				
-				  if (current->options == NULL) {
-         	  current->options = newOP;
-            current->options->next = NULL;
-					  currentOP = current->options;
-				  } else {
-					  currentOP = current->options;
-            nextOP = currentOP->next;
-					  if (nextOP) {
-              do {
-                if (!nextOP->next) currentOP = nextOP;
-                nextOP = nextOP->next;
-              } while (nextOP);
-					  }
-					  currentOP->next = newOP;
-					  currentOP = newOP;
-				  }
-				
-       	  strncpy(currentOP->name, name, nlen);
-				  currentOP->name[nlen] = LRC_NULL;
-				
-          /* Prepare the value */
-          vlen = strlen(cd[i].value);
-          strncpy(value, cd[i].value, vlen);
-          value[vlen] = LRC_NULL;
-            
-          strncpy(currentOP->value, value, vlen);
-          currentOP->value[vlen] = LRC_NULL;
-        
-          /* Assign type */
-          currentOP->type = cd[i].type;
-				} else {
-          LRC_modifyOption(current->space, currentOP->name, cd[i].value, cd[i].type, current);
-        }
+finish:
+  status = H5Sclose(dataspace);
+  dataspace = -1;
+  if (status < 0) goto failure;
+
+  free(rdata);
+  return applied;
+
+failure:
+  if (memspace >= 0) H5Sclose(memspace);
+  if (dataspace >= 0) H5Sclose(dataspace);
+  free(rdata);
+  return -1;
+}
+
+/**
+ * @fn int LRC_HDF5HistoryLast(hid_t dataset, hid_t cch_tid, hsize_t records, cch_t* record)
+ * @brief Reads the last record of the history.
+ *
+ * @return
+ *  0 on success, -1 on failure
+ */
+int LRC_HDF5HistoryLast(hid_t dataset, hid_t cch_tid, hsize_t records, cch_t* record) {
+
+  hid_t dataspace = -1, memspace = -1;
+  hsize_t offset[1], count[1];
+  herr_t status;
+
+  offset[0] = records - 1;
+  count[0] = 1;
+
+  dataspace = H5Dget_space(dataset);
+  if (dataspace < 0) goto failure;
+
+  memspace = H5Screate_simple(1, count, NULL);
+  if (memspace < 0) goto failure;
+
+  status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset, NULL, count, NULL);
+  if (status < 0) goto failure;
+
+  status = H5Dread(dataset, cch_tid, memspace, dataspace, H5P_DEFAULT, record);
+  if (status < 0) goto failure;
+
+  H5Sclose(memspace);
+  H5Sclose(dataspace);
+  return 0;
+
+failure:
+  if (memspace >= 0) H5Sclose(memspace);
+  if (dataspace >= 0) H5Sclose(dataspace);
+  return -1;
+}
+
+/**
+ * @fn int LRC_HDF5HistorySame(LRC_configNamespace* head, LRC_configNamespace* recorded)
+ * @brief Checks that both trees have the same namespaces and options, in the
+ * same order.
+ */
+int LRC_HDF5HistorySame(LRC_configNamespace* head, LRC_configNamespace* recorded) {
+
+  LRC_configOptions* a = NULL;
+  LRC_configOptions* b = NULL;
+
+  for (; head && recorded; head = head->next, recorded = recorded->next) {
+    if (strcmp(head->space, recorded->space) != 0) return 0;
+    for (a = head->options, b = recorded->options; a && b; a = a->next, b = b->next) {
+      if (strcmp(a->name, b->name) != 0) return 0;
+    }
+    if (a || b) return 0;
+  }
+
+  return !head && !recorded;
+}
+
+/**
+ * @fn LRC_configHistory* LRC_HDF5HistoryState(hid_t file, char* history_name, hid_t dataset, hid_t cch_tid, LRC_configNamespace* head)
+ * @brief The last recorded version of the config.
+ *
+ * The version kept by the previous LRC_HDF5HistoryWriter() call is used if
+ * it still describes the dataset: the same file and dataset name, the same
+ * number of records and the same last record. Otherwise it is rebuilt by
+ * replaying the whole history.
+ *
+ * @return
+ *  The state (the one of the config or a new one), NULL on failure
+ */
+LRC_configHistory* LRC_HDF5HistoryState(hid_t file, char* history_name, hid_t dataset,
+    hid_t cch_tid, LRC_configNamespace* head) {
+
+  LRC_configHistory* history = head->history;
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  hid_t dataspace;
+  hsize_t dims[1] = {0};
+  ssize_t len;
+  char* path = NULL;
+  cch_t* last = NULL;
+  int valid = 0;
+
+  len = H5Fget_name(file, NULL, 0);
+  if (len < 0) return NULL;
+
+  path = malloc((size_t)len + 1);
+  last = calloc(1, sizeof(cch_t));
+  if (!path || !last) {
+    perror("LRC_HDF5HistoryState: alloc failed");
+    goto failure;
+  }
+  H5Fget_name(file, path, (size_t)len + 1);
+
+  if (dataset >= 0) {
+    dataspace = H5Dget_space(dataset);
+    if (dataspace < 0) goto failure;
+    H5Sget_simple_extent_dims(dataspace, dims, NULL);
+    H5Sclose(dataspace);
+
+    if (dims[0] > 0 && LRC_HDF5HistoryLast(dataset, cch_tid, dims[0], last) < 0) goto failure;
+  }
+
+  if (history && history->records == dims[0]
+      && strcmp(history->path, path) == 0
+      && strcmp(history->name, history_name) == 0
+      && LRC_HDF5HistorySame(head, history->recorded)) {
+    valid = dims[0] == 0
+      || (history->last.step == last->step && history->last.type == last->type
+        && strcmp(history->last.space, last->space) == 0
+        && strcmp(history->last.name, last->name) == 0
+        && strcmp(history->last.value, last->value) == 0);
+  }
+
+  if (valid) {
+    free(path);
+    free(last);
+    return history;
+  }
+
+  history = calloc(1, sizeof(LRC_configHistory));
+  if (!history) {
+    perror("LRC_HDF5HistoryState: alloc failed");
+    goto failure;
+  }
+
+  history->path = path;
+  path = NULL;
+
+  history->name = malloc(strlen(history_name) + 1);
+  if (!history->name) {
+    perror("LRC_HDF5HistoryState: alloc failed");
+    goto failure;
+  }
+  strcpy(history->name, history_name);
+
+  /* Options that have never been recorded are marked with an invalid type */
+  history->recorded = LRC_copyConfig(head);
+  if (!history->recorded) goto failure;
+
+  for (current = history->recorded; current; current = current->next) {
+    for (option = current->options; option; option = option->next) {
+      option->value[0] = LRC_NULL;
+      option->type = -1;
+    }
+  }
+
+  history->records = dims[0];
+  history->step = LLONG_MIN;
+  memcpy(&history->last, last, sizeof(cch_t));
+
+  if (dims[0] > 0) {
+    if (LRC_HDF5HistoryReplay(dataset, cch_tid, LLONG_MAX, history->recorded, &history->step) < 0) {
+      goto failure;
+    }
+  }
+
+  free(last);
+  return history;
+
+failure:
+  if (path) free(path);
+  if (last) free(last);
+  if (history != head->history) LRC_freeHistory(history);
+  return NULL;
+}
+
+/**
+ * @fn void LRC_freeHistory(LRC_configHistory* history)
+ * @brief Frees the last recorded version of the config.
+ */
+void LRC_freeHistory(LRC_configHistory* history) {
+
+  if (!history) return;
+
+  if (history->path) free(history->path);
+  if (history->name) free(history->name);
+  if (history->recorded) LRC_cleanup(history->recorded);
+  free(history);
+}
+
+/**
+ * @fn int LRC_HDF5HistoryWriter(hid_t file, char* history_name, long long step, LRC_configNamespace* head)
+ * @brief Appends the current config version to the config history.
+ *
+ * The history is an extendible, chunked dataset (config/history_name) of
+ * records keyed by the step. Only the options that differ from the previously
+ * recorded version are appended, the first call records the whole tree. The
+ * step is any increasing counter, i.e. the output step or a timestamp. The
+ * records hold the values as text, so arrays longer than the value string
+ * (LRC_CONFIG_LEN) cannot be recorded: the append fails then.
+ *
+ * The recorded version is kept with the config, so the next append costs the
+ * number of options only. It is rebuilt from the whole history if the
+ * dataset has changed in the meantime (another config, another history).
+ *
+ * @param file
+ *   The handler of the file.
+ *
+ * @param history_name
+ *   Name of the history dataset in the config group.
+ *
+ * @param step
+ *   The step of this version, must be greater than the last recorded one.
+ *
+ * @param head
+ *   The current config.
+ *
+ * @return
+ *  Number of appended records (0 if nothing changed) or -1 on failure
+ */
+int LRC_HDF5HistoryWriter(hid_t file, char* history_name, long long step, LRC_configNamespace* head) {
+
+  hid_t master_group = -1, dataset = -1, dataspace = -1, memspace = -1, plist = -1;
+  hid_t cch_tid = -1, ccf_tid = -1;
+  hsize_t dims[1], maxdims[1], chunk[1], offset[1], count[1];
+  herr_t status;
+  htri_t cctt;
+  int n = 0, k = 0;
+
+  LRC_configHistory* history = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configNamespace* previous = NULL;
+  LRC_configOptions* currentOP = NULL;
+  LRC_configOptions* previousOP = NULL;
+  cch_t* wdata = NULL;
+  LRC_TIMER(t);
+
+  if (!head) {
+    perror("LRC_HDF5HistoryWriter: no config assigned");
+    return -1;
+  }
+
+  LRC_CLOCK(t);
+
+  cch_tid = LRC_HDF5HistoryType();
+  if (cch_tid < 0) goto failure;
+
+  cctt = H5Lexists(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  if (!cctt) {
+    master_group = H5Gcreate(file, LRC_CONFIG_GROUP, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  } else {
+    master_group = H5Gopen(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  }
+  if (master_group < 0) goto failure;
+
+  cctt = H5Lexists(master_group, history_name, H5P_DEFAULT);
+  if (cctt > 0) {
+    dataset = H5Dopen(master_group, history_name, H5P_DEFAULT);
+    if (dataset < 0) goto failure;
+  } else {
+
+    /* Create file datatype without the padding of the memory one */
+    ccf_tid = H5Tcopy(cch_tid);
+    status = H5Tpack(ccf_tid);
+    if (status < 0) goto failure;
+
+    dims[0] = 0;
+    maxdims[0] = H5S_UNLIMITED;
+    chunk[0] = LRC_HDF5_HISTORY_CHUNK;
+
+    plist = H5Pcreate(H5P_DATASET_CREATE);
+    status = H5Pset_chunk(plist, 1, chunk);
+    if (status < 0) goto failure;
+
+    /* Fixed-length strings are mostly padding, compress them if we can */
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+      status = H5Pset_deflate(plist, 6);
+      if (status < 0) goto failure;
+    }
+
+    dataspace = H5Screate_simple(1, dims, maxdims);
+    dataset = H5Dcreate(master_group, history_name, ccf_tid, dataspace,
+        H5P_DEFAULT, plist, H5P_DEFAULT);
+    if (dataset < 0) goto failure;
+
+    status = H5Sclose(dataspace);
+    dataspace = -1;
+    if (status < 0) goto failure;
+
+    status = H5Pclose(plist);
+    plist = -1;
+    if (status < 0) goto failure;
+
+    status = H5Tclose(ccf_tid);
+    ccf_tid = -1;
+    if (status < 0) goto failure;
+  }
+
+  history = LRC_HDF5HistoryState(file, history_name, dataset, cch_tid, head);
+  if (!history) goto failure;
+
+  if (history->records > 0 && history->step >= step) {
+    LRC_message(0, LRC_ERR_HDF, "History step must be greater than the last recorded one");
+    goto failure;
+  }
+
+  /* Both trees have the same shape, so we can walk them side by side */
+  n = 0;
+  for (current = head; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) n++;
+  }
+
+  wdata = calloc(n > 0 ? n : 1, sizeof(cch_t));
+  if (!wdata) {
+    perror("LRC_HDF5HistoryWriter: alloc failed");
+    goto failure;
+  }
+
+  /* The recorded version is brought up to date on the way. If the write
+   * fails, it is dropped */
+  k = 0;
+  for (current = head, previous = history->recorded; current && previous;
+      current = current->next, previous = previous->next) {
+    for (currentOP = current->options, previousOP = previous->options;
+        currentOP && previousOP;
+        currentOP = currentOP->next, previousOP = previousOP->next) {
+
+      if (LRC_isArray(currentOP->type) && currentOP->value[0] == LRC_NULL && currentOP->count > 0) {
+        LRC_report(head, LRC_ERR_HDF, 0, 0, current->space, currentOP->name, LRC_MSG_TOO_LONG);
+        goto failure;
       }
 
-    i++;
+      if (currentOP->type == previousOP->type
+          && strcmp(currentOP->value, previousOP->value) == 0) continue;
+
+      /* The record has the sizes of the tree, the strings always fit */
+      wdata[k].step = step;
+      memcpy(wdata[k].space, current->space, strlen(current->space) + 1);
+      memcpy(wdata[k].name, currentOP->name, strlen(currentOP->name) + 1);
+      memcpy(wdata[k].value, currentOP->value, strlen(currentOP->value) + 1);
+      wdata[k].type = currentOP->type;
+
+      memcpy(previousOP->value, currentOP->value, strlen(currentOP->value) + 1);
+      previousOP->type = currentOP->type;
+      k++;
+    }
+  }
+
+  /* Append all changes with a single write */
+  if (k > 0) {
+    dataspace = H5Dget_space(dataset);
+    H5Sget_simple_extent_dims(dataspace, dims, NULL);
+    status = H5Sclose(dataspace);
+    dataspace = -1;
+    if (status < 0) goto failure;
+
+    offset[0] = dims[0];
+    count[0] = k;
+    dims[0] = dims[0] + k;
+
+    status = H5Dset_extent(dataset, dims);
+    if (status < 0) goto failure;
+
+    dataspace = H5Dget_space(dataset);
+    status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset, NULL, count, NULL);
+    if (status < 0) goto failure;
+
+    memspace = H5Screate_simple(1, count, NULL);
+    status = H5Dwrite(dataset, cch_tid, memspace, dataspace, H5P_DEFAULT, wdata);
+    if (status < 0) goto failure;
+
+    status = H5Sclose(memspace);
+    memspace = -1;
+    if (status < 0) goto failure;
+
+    status = H5Sclose(dataspace);
+    dataspace = -1;
+    if (status < 0) goto failure;
+
+    history->records = dims[0];
+    history->step = step;
+    memcpy(&history->last, &wdata[k - 1], sizeof(cch_t));
+  }
+
+  /* Keep the recorded version for the next append */
+  if (history != head->history) {
+    LRC_freeHistory(head->history);
+    head->history = history;
+  }
+
+  free(wdata);
+  wdata = NULL;
+
+  status = H5Dclose(dataset);
+  dataset = -1;
+  if (status < 0) goto failure;
+
+  status = H5Gclose(master_group);
+  master_group = -1;
+  if (status < 0) goto failure;
+
+  status = H5Tclose(cch_tid);
+  cch_tid = -1;
+  if (status < 0) goto failure;
+
+  LRC_PHASE(head, LRC_PHASE_HDF5, t);
+
+  return k;
+
+failure:
+  if (wdata) free(wdata);
+
+  /* The recorded version may not match the file any more */
+  if (history == head->history) head->history = NULL;
+  LRC_freeHistory(history);
+
+  if (memspace >= 0) H5Sclose(memspace);
+  if (dataspace >= 0) H5Sclose(dataspace);
+  if (plist >= 0) H5Pclose(plist);
+  if (ccf_tid >= 0) H5Tclose(ccf_tid);
+  if (dataset >= 0) H5Dclose(dataset);
+  if (master_group >= 0) H5Gclose(master_group);
+  if (cch_tid >= 0) H5Tclose(cch_tid);
+  return -1;
+}
+
+/**
+ * @fn int LRC_HDF5HistoryParser(hid_t file, char* history_name, long long step, LRC_configNamespace* head)
+ * @brief Rebuilds the config active at the given step from the config history.
+ *
+ * All records up to (and including) the step are applied on top of the tree,
+ * so the tree should hold the defaults.
+ *
+ * @param file
+ *   The handler of the file.
+ *
+ * @param history_name
+ *   Name of the history dataset in the config group.
+ *
+ * @param step
+ *   The step to rebuild.
+ *
+ * @param head
+ *   Pointer to the structure with default values.
+ *
+ * @return
+ *  Number of applied records or -1 on failure
+ */
+int LRC_HDF5HistoryParser(hid_t file, char* history_name, long long step, LRC_configNamespace* head) {
+
+  hid_t master_group = -1, dataset = -1, cch_tid = -1;
+  herr_t status;
+  long long last = 0;
+  int applied = 0;
+  LRC_TIMER(t);
+
+  if (!head) {
+    perror("LRC_HDF5HistoryParser: no config assigned");
+    return -1;
+  }
+
+  LRC_CLOCK(t);
+  LRC_changed(head, NULL, NULL);
+
+  cch_tid = LRC_HDF5HistoryType();
+  if (cch_tid < 0) goto failure;
+
+  master_group = H5Gopen(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  if (master_group < 0) goto failure;
+
+  dataset = H5Dopen(master_group, history_name, H5P_DEFAULT);
+  if (dataset < 0) goto failure;
+
+  applied = LRC_HDF5HistoryReplay(dataset, cch_tid, step, head, &last);
+  if (applied < 0) goto failure;
+
+  status = H5Dclose(dataset);
+  dataset = -1;
+  if (status < 0) goto failure;
+
+  status = H5Gclose(master_group);
+  master_group = -1;
+  if (status < 0) goto failure;
+
+  status = H5Tclose(cch_tid);
+  cch_tid = -1;
+  if (status < 0) goto failure;
+
+  LRC_PHASE(head, LRC_PHASE_HDF5, t);
+
+  return applied;
+
+failure:
+  if (dataset >= 0) H5Dclose(dataset);
+  if (master_group >= 0) H5Gclose(master_group);
+  if (cch_tid >= 0) H5Tclose(cch_tid);
+  return -1;
+}
+
+#ifdef H5_HAVE_PARALLEL
+/**
+ * @fn int LRC_HDF5ParallelWriter(hid_t file, char* group_name, MPI_Comm comm, LRC_configNamespace* head)
+ * @brief Collective variant of LRC_HDF5Writer() for files opened with the MPI-IO driver.
+ *
+ * Must be called by all ranks of the communicator used to open the file. Groups,
+ * datasets and the datatype are created collectively with collective metadata
+ * operations, and each namespace is stored with a single collective H5Dwrite,
+ * in which only the root rank selects data. The file layout is the same as
+ * the one of LRC_HDF5Writer().
+ *
+ * For collective metadata writes, enable H5Pset_coll_metadata_write() on the
+ * file access property list.
+ *
+ * @param file
+ *   The handler of the file (opened with H5Pset_fapl_mpio).
+ *
+ * @param group_name
+ *   Name of the config group.
+ *
+ * @param comm
+ *   The communicator used to open the file.
+ *
+ * @param head
+ *   The config to write (the one of rank 0 is stored).
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_HDF5ParallelWriter(hid_t file, char* group_name, MPI_Comm comm, LRC_configNamespace* head) {
+
+  hid_t master_group, group, dataset, dataspace, memspace;
+  hid_t ccm_tid, ccf_tid, name_dt, value_dt;
+  hid_t fapl, lapl, gapl, dapl, dxpl;
+  hsize_t dims[1];
+  herr_t status;
+  htri_t cctt;
+  int rank = 0, k = 0, n = 0, nopts = 0;
+  size_t nlen, vlen;
+  long* shape = NULL;
+
+  LRC_configOptions* currentOP = NULL;
+  LRC_configNamespace* current = NULL;
+  ccd_t* ccd = NULL;
+
+  if (!head) {
+    perror("LRC_HDF5ParallelWriter: no config assigned");
+    return -1;
+  }
+
+  MPI_Comm_rank(comm, &rank);
+
+  fapl = H5Fget_access_plist(file);
+  if (H5Pget_driver(fapl) != H5FD_MPIO) {
+    LRC_message(0, LRC_ERR_HDF, "The file must be opened with the MPI-IO driver");
+    goto failure;
+  }
+  status = H5Pclose(fapl);
+  if (status < 0) goto failure;
+
+  /* Metadata reads are done by one rank and broadcast to the others */
+  lapl = H5Pcreate(H5P_LINK_ACCESS);
+  status = H5Pset_all_coll_metadata_ops(lapl, 1);
+  if (status < 0) goto failure;
+
+  gapl = H5Pcreate(H5P_GROUP_ACCESS);
+  status = H5Pset_all_coll_metadata_ops(gapl, 1);
+  if (status < 0) goto failure;
+
+  dapl = H5Pcreate(H5P_DATASET_ACCESS);
+  status = H5Pset_all_coll_metadata_ops(dapl, 1);
+  if (status < 0) goto failure;
+
+  dxpl = H5Pcreate(H5P_DATASET_XFER);
+  status = H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+  if (status < 0) goto failure;
+
+  cctt = H5Lexists(file, LRC_CONFIG_GROUP, lapl);
+  if (!cctt) {
+    master_group = H5Gcreate(file, LRC_CONFIG_GROUP, H5P_DEFAULT, H5P_DEFAULT, gapl);
+  } else {
+    master_group = H5Gopen(file, LRC_CONFIG_GROUP, gapl);
+  }
+  group = H5Gcreate(master_group, group_name, H5P_DEFAULT, H5P_DEFAULT, gapl);
+  if (master_group < 0 || group < 0) goto failure;
+
+  /* Create the same datatypes as the serial writer */
+  name_dt = H5Tcopy(H5T_C_S1);
+  status = H5Tset_size(name_dt, LRC_CONFIG_LEN);
+  if (status < 0) goto failure;
+
+  value_dt = H5Tcopy(H5T_C_S1);
+  status = H5Tset_size(value_dt, LRC_CONFIG_LEN);
+  if (status < 0) goto failure;
+
+  ccm_tid = H5Tcreate(H5T_COMPOUND, sizeof(ccd_t));
+
+  H5Tinsert(ccm_tid, "Name", HOFFSET(ccd_t, name), name_dt);
+  H5Tinsert(ccm_tid, "Value", HOFFSET(ccd_t, value), value_dt);
+  H5Tinsert(ccm_tid, "Type", HOFFSET(ccd_t, type), H5T_NATIVE_INT);
+
+  ccf_tid = H5Tcreate(H5T_COMPOUND, 8 + 2*LRC_CONFIG_LEN);
+
+  status = H5Tinsert(ccf_tid, "Name", 0, name_dt);
+  if (status < 0) goto failure;
+
+  status = H5Tinsert(ccf_tid, "Value", LRC_CONFIG_LEN, value_dt);
+  if (status < 0) goto failure;
+
+  status = H5Tinsert(ccf_tid, "Type", 2*LRC_CONFIG_LEN, H5T_NATIVE_INT);
+  if (status < 0) goto failure;
+
+  cctt = H5Lexists(file, LRC_HDF5_DATATYPE, lapl);
+  if (!cctt) {
+    status = H5Tcommit(file, LRC_HDF5_DATATYPE, ccf_tid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (status < 0) goto failure;
+  }
+
+  for (current = head; current; current = current->next) {
+
+    n = LRC_countOptions(current->space, current);
+
+    ccd = calloc(n > 0 ? n : 1, sizeof(ccd_t));
+    if (!ccd) {
+      perror("LRC_HDF5ParallelWriter: alloc failed");
+      goto failure;
+    }
+
+    if (rank == 0) {
+      k = 0;
+      for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+        nlen = strlen(currentOP->name);
+        strncpy(ccd[k].name, currentOP->name, nlen);
+        ccd[k].name[nlen] = LRC_NULL;
+
+        vlen = strlen(currentOP->value);
+        strncpy(ccd[k].value, currentOP->value, vlen);
+        ccd[k].value[vlen] = LRC_NULL;
+
+        ccd[k].type = currentOP->type;
+        k++;
+      }
+    }
+
+    dims[0] = (hsize_t)n;
+    dataspace = H5Screate_simple(1, dims, NULL);
+    memspace = H5Screate_simple(1, dims, NULL);
+
+    dataset = H5Dcreate(group, current->space, ccf_tid, dataspace,
+        H5P_DEFAULT, H5P_DEFAULT, dapl);
+    if (dataset < 0) goto failure;
+
+    /* Only the root contributes data to the collective write */
+    if (rank != 0) {
+      H5Sselect_none(memspace);
+      H5Sselect_none(dataspace);
+    }
+
+    status = H5Dwrite(dataset, ccm_tid, memspace, dataspace, dxpl, ccd);
+    if (status < 0) goto failure;
+
+    status = H5Sclose(memspace);
+    if (status < 0) goto failure;
+
+    status = H5Sclose(dataspace);
+    if (status < 0) goto failure;
+
+    status = H5Dclose(dataset);
+    if (status < 0) goto failure;
+
+    free(ccd);
+    ccd = NULL;
+  }
+
+  /* The array datasets are created collectively, so all ranks need the
+   * shapes of the root */
+  for (current = head; current; current = current->next) {
+    nopts += LRC_countOptions(current->space, current);
+  }
+
+  shape = calloc(nopts > 0 ? 2*(size_t)nopts : 1, sizeof(long));
+  if (!shape) {
+    perror("LRC_HDF5ParallelWriter: alloc failed");
+    goto failure;
+  }
+
+  if (rank == 0) {
+    k = 0;
+    for (current = head; current; current = current->next) {
+      for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+        shape[2*k] = currentOP->type;
+        shape[2*k+1] = (long)currentOP->count;
+        k++;
+      }
+    }
+  }
+
+  MPI_Bcast(shape, 2*nopts, MPI_LONG, 0, comm);
+
+  if (LRC_HDF5WriteArrays(group, head, shape, H5P_DEFAULT, gapl, dapl, dxpl, rank == 0) < 0) goto failure;
+
+  free(shape);
+  shape = NULL;
+
+  status = H5Gclose(group);
+  if (status < 0) goto failure;
+
+  status = H5Gclose(master_group);
+  if (status < 0) goto failure;
+
+  status = H5Tclose(name_dt);
+  if (status < 0) goto failure;
+
+  status = H5Tclose(value_dt);
+  if (status < 0) goto failure;
+
+  status = H5Tclose(ccf_tid);
+  if (status < 0) goto failure;
+
+  status = H5Tclose(ccm_tid);
+  if (status < 0) goto failure;
+
+  H5Pclose(lapl);
+  H5Pclose(gapl);
+  H5Pclose(dapl);
+  H5Pclose(dxpl);
+
+  return 0;
+
+failure:
+  if (ccd) free(ccd);
+  if (shape) free(shape);
+  return -1;
+}
+
+/**
+ * @fn int LRC_HDF5ParallelParser(hid_t file, char* group_name, MPI_Comm comm, LRC_configNamespace* head)
+ * @brief Parallel variant of LRC_HDF5Parser() for files opened with the MPI-IO driver.
+ *
+ * Must be called by all ranks of the communicator. Only the root rank reads the
+ * config (with independent metadata and data reads), the values are then
+ * broadcast to the other ranks, which never touch the file.
+ *
+ * @param file
+ *   The handler of the file (opened with H5Pset_fapl_mpio).
+ *
+ * @param group_name
+ *   Name of the config group.
+ *
+ * @param comm
+ *   The communicator used to open the file.
+ *
+ * @param head
+ *   Pointer to the structure with default values.
+ *
+ * @return
+ *  Number of read namespaces or -1 on failure
+ */
+int LRC_HDF5ParallelParser(hid_t file, char* group_name, MPI_Comm comm, LRC_configNamespace* head) {
+
+  hid_t master_group = -1, group = -1, dataset = -1, dataspace = -1;
+  hid_t ccm_tid = -1, name_dt = -1, value_dt = -1;
+  hid_t lapl = -1, gapl = -1, dapl = -1;
+  herr_t status;
+  H5G_info_t group_info;
+  hsize_t edims[1];
+
+  int rank = 0, numOfNM = 0, i = 0, k = 0, arrays = 0, ok = 0;
+  long header[2] = {-1, -1};
+  char link_name[LRC_MAX_LINE_LENGTH];
+  size_t len = 0;
+  char* buf = NULL;
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* newOP = NULL;
+  ccd_t* rdata = NULL;
+
+  if (!head) {
+    perror("LRC_HDF5ParallelParser: no config assigned");
+    return -1;
+  }
+
+  LRC_changed(head, NULL, NULL);
+
+  MPI_Comm_rank(comm, &rank);
+
+  if (rank == 0) {
+
+    /* Other ranks do not take part in the read, so force independent
+     * metadata operations, whatever the file access property list says.
+     * The H5Gopen, H5Dopen and H5Lget_name_by_idx calls below are made by
+     * this rank only and rely on it: with collective metadata reads they
+     * would wait for the other ranks forever. */
+    lapl = H5Pcreate(H5P_LINK_ACCESS);
+    H5Pset_all_coll_metadata_ops(lapl, 0);
+
+    gapl = H5Pcreate(H5P_GROUP_ACCESS);
+    H5Pset_all_coll_metadata_ops(gapl, 0);
+
+    dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    H5Pset_all_coll_metadata_ops(dapl, 0);
+
+    name_dt = H5Tcopy(H5T_C_S1);
+    status = H5Tset_size(name_dt, LRC_CONFIG_LEN);
+    if (status < 0) goto broadcast;
+
+    value_dt = H5Tcopy(H5T_C_S1);
+    status = H5Tset_size(value_dt, LRC_CONFIG_LEN);
+    if (status < 0) goto broadcast;
+
+    ccm_tid = H5Tcreate(H5T_COMPOUND, sizeof(ccd_t));
+
+    H5Tinsert(ccm_tid, "Name", HOFFSET(ccd_t, name), name_dt);
+    H5Tinsert(ccm_tid, "Value", HOFFSET(ccd_t, value), value_dt);
+    H5Tinsert(ccm_tid, "Type", HOFFSET(ccd_t, type), H5T_NATIVE_INT);
+
+    /* Independent open, see gapl above */
+    master_group = H5Gopen(file, LRC_CONFIG_GROUP, gapl);
+    if (master_group < 0) goto broadcast;
+
+    group = H5Gopen(master_group, group_name, gapl);
+    if (group < 0) goto broadcast;
+
+    status = H5Gget_info(group, &group_info);
+    if (status < 0) goto broadcast;
+
+    numOfNM = group_info.nlinks;
+
+    for (i = 0; i < numOfNM; i++) {
+
+      H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i,
+        link_name, LRC_MAX_LINE_LENGTH, lapl);
+
+      if (strcmp(link_name, LRC_HDF5_ARRAYS) == 0) {
+        arrays = 1;
+        continue;
+      }
+
+      dataset = H5Dopen(group, link_name, dapl);
+      if (dataset < 0) goto broadcast;
+
+      dataspace = H5Dget_space(dataset);
+      H5Sget_simple_extent_dims(dataspace, edims, NULL);
+
+      rdata = calloc(edims[0] > 0 ? (size_t)edims[0] : 1, sizeof(ccd_t));
+      if (!rdata) {
+        perror("LRC_HDF5ParallelParser: alloc failed");
+        goto broadcast;
+      }
+
+      status = H5Dread(dataset, ccm_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata);
+      if (status < 0) goto broadcast;
+
+      current = LRC_findNamespace(link_name, head);
+      if (current == NULL) {
+        LRC_report(head, LRC_ERR_HDF, i, 0, link_name, NULL, LRC_MSG_UNKNOWN_NAMESPACE);
+        goto broadcast;
+      }
+
+      for (k = 0; k < (int)edims[0]; k++) {
+        newOP = LRC_findOption(rdata[k].name, current);
+        if (newOP == NULL) {
+          LRC_report(head, LRC_ERR_HDF, i, 0, link_name, rdata[k].name, LRC_MSG_UNKNOWN_VAR);
+          goto broadcast;
+        }
+
+        if (LRC_storeValue(newOP, rdata[k].value, rdata[k].type) < 0) {
+          LRC_report(head, LRC_ERR_HDF, i, 0, link_name, rdata[k].name, LRC_MSG_WRONG_INPUT);
+          goto broadcast;
+        }
+      }
+
+      free(rdata);
+      rdata = NULL;
+
+      H5Sclose(dataspace);
+      dataspace = -1;
+      H5Dclose(dataset);
+      dataset = -1;
+    }
+
+    if (arrays) {
+      if (LRC_HDF5ReadArrays(group, head, lapl, gapl, dapl) < 0) goto broadcast;
+      numOfNM--;
+    }
+
+    buf = LRC_packConfig(head, &len);
+    if (buf) {
+      header[0] = (long)len;
+      header[1] = numOfNM;
+    }
+  }
+
+broadcast:
+  if (rdata) free(rdata);
+  if (dataspace >= 0) H5Sclose(dataspace);
+  if (dataset >= 0) H5Dclose(dataset);
+  if (group >= 0) H5Gclose(group);
+  if (master_group >= 0) H5Gclose(master_group);
+  if (ccm_tid >= 0) H5Tclose(ccm_tid);
+  if (name_dt >= 0) H5Tclose(name_dt);
+  if (value_dt >= 0) H5Tclose(value_dt);
+  if (lapl >= 0) H5Pclose(lapl);
+  if (gapl >= 0) H5Pclose(gapl);
+  if (dapl >= 0) H5Pclose(dapl);
+
+  /* The header tells the other ranks whether the root succeeded */
+  MPI_Bcast(header, 2, MPI_LONG, 0, comm);
+  if (header[0] < 0) goto failure;
+
+  if (rank != 0) {
+    buf = malloc(header[0] > 0 ? (size_t)header[0] : 1);
+    if (!buf) {
+      perror("LRC_HDF5ParallelParser: alloc failed");
+      ok = -1;
+    }
+  }
+
+  /* A rank that cannot receive the config fails the call on all ranks */
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+  if (ok < 0) goto failure;
+
+  MPI_Bcast(buf, (int)header[0], MPI_CHAR, 0, comm);
+
+  if (rank != 0) {
+    if (LRC_unpackConfig(buf, (size_t)header[0], head) < 0) goto failure;
+  }
+
+  free(buf);
+  return (int)header[1];
+
+failure:
+  if (buf) free(buf);
+  return -1;
+}
+#endif
+#endif
+
+/**
+ * @fn void LRC_printAll(LRC_configNamespace* head)
+ * @brief Prints all options.
+ */
+void LRC_printAll(LRC_configNamespace* head){
+
+  LRC_buffer buf = {NULL, 0, 0};
+  LRC_configOptions* currentOP = NULL;
+  LRC_configOptions* nextOP = NULL;
+  LRC_configNamespace* nextNM = NULL;
+  LRC_configNamespace* current = NULL;
+
+  if (head) current = head;
+
+  do {
+    if (current) {
+      nextNM = current->next;
+      printf("[%s][%d]\n",current->space, LRC_countOptions(current->space, current));
+      currentOP = current->options;
+      do {
+        if (currentOP) {
+          nextOP = currentOP->next;
+          if (LRC_isArray(currentOP->type)) {
+            printf("%s = ", currentOP->name);
+            buf.len = 0;
+            if (buf.data) buf.data[0] = LRC_NULL;
+            if (LRC_formatArray(&buf, currentOP) == 0 && buf.data) fputs(buf.data, stdout);
+            printf(" [type %d, %zu elements]\n", currentOP->type, currentOP->count);
+          } else {
+            printf("%s = %s [type %d]\n", currentOP->name, currentOP->value, currentOP->type);
+          }
+          currentOP = nextOP;
+        }
+      } while(currentOP);
+      
+      current=nextNM;
+    }
+		printf("\n");
+    
+  } while(current);
+
+  if (buf.data) free(buf.data);
+  current = NULL;
+
+}
+
+/**
+ * @fn int LRC_assignDefaults(LRC_configDefaults* cd)
+ * @brief Assign default values
+ *
+ * @return
+ *  Should return 0 on success, errcode otherwise
+ */
+
+LRC_configNamespace* LRC_assignDefaults(LRC_configDefaults* cd){
+
+  LRC_configNamespace* nextNM = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configNamespace* head = NULL;
+  LRC_configOptions* newOP = NULL;
+  LRC_configOptions* nextOP = NULL;
+  LRC_configOptions* currentOP = NULL;
+  size_t slen, nlen, vlen;
+  char space[LRC_CONFIG_LEN]; 
+  char name[LRC_CONFIG_LEN]; 
+  char value[LRC_CONFIG_LEN]; 
+
+  int i = 0;
+
+  head = NULL;
+  current = NULL;
+
+  while (cd[i].space[0] != LRC_NULL) {
+
+      /* Prepare namespace */
+      slen = strlen(cd[i].space);
+      strncpy(space,cd[i].space, slen);
+			space[slen] = LRC_NULL;
+
+      if (head == NULL) {
+        head = LRC_newNamespace(space);
+        current = head;
+      } else {
+        nextNM = LRC_findNamespace(space, head);
+
+        if (nextNM == NULL) {
+          current = LRC_lastLeaf(head);
+          current->next = LRC_newNamespace(space);
+          current = current->next;
+        } else {
+				  current = nextNM;
+          current->next = NULL;
+			  }
+      }
+
+      if (current) { 
+
+				/* Prepare var name*/
+       	nlen = strlen(cd[i].name);
+       	strncpy(name, cd[i].name, nlen);
+				name[nlen] = LRC_NULL;
+
+				currentOP = LRC_findOption(name, current);
+
+        if (currentOP == NULL) {  	
+					newOP = calloc(1, sizeof(LRC_configOptions));
+          if (!newOP) {
+            perror("LRC_assignDefaults: line 1108 alloc failed");
+            return NULL;
+          }
+          LRC_COUNT_ALLOC(current, sizeof(LRC_configOptions));
+          newOP->type = LRC_INT;
+          newOP->next = NULL;
+				
+				  if (current->options == NULL) {
+         	  current->options = newOP;
+            current->options->next = NULL;
+					  currentOP = current->options;
+				  } else {
+					  currentOP = current->options;
+            nextOP = currentOP->next;
+					  if (nextOP) {
+              do {
+                if (!nextOP->next) currentOP = nextOP;
+                nextOP = nextOP->next;
+              } while (nextOP);
+					  }
+					  currentOP->next = newOP;
+					  currentOP = newOP;
+				  }
+				
+       	  strncpy(currentOP->name, name, nlen);
+				  currentOP->name[nlen] = LRC_NULL;
+				
+          /* Prepare the value */
+          vlen = strlen(cd[i].value);
+          strncpy(value, cd[i].value, vlen);
+          value[vlen] = LRC_NULL;
+            
+          /* Assign value and type */
+          if (LRC_storeValue(currentOP, value, cd[i].type) < 0) {
+            LRC_report(head, LRC_ERR_WRONG_INPUT, i, 0, current->space, currentOP->name, currentOP->name);
+          }
+				} else {
+          LRC_modifyOption(current->space, currentOP->name, cd[i].value, cd[i].type, current);
+        }
+      }
+
+    i++;
+  }
+
+  return head;
+}
+
+/**
+ * @fn LRC_configNamespace* LRC_copyConfig(LRC_configNamespace* head)
+ * @brief Creates a deep copy of the config tree.
+ *
+ * Namespaces and options are copied in their original order, so that the copy
+ * may be walked side by side with the source tree.
+ *
+ * @param head
+ *  First namespace in the options list
+ *
+ * @return
+ *  The copy of the tree (free it with LRC_cleanup()) or NULL on failure
+ */
+LRC_configNamespace* LRC_copyConfig(LRC_configNamespace* head) {
+
+  LRC_configNamespace* copy = NULL;
+  LRC_configNamespace* currentNM = NULL;
+  LRC_configNamespace* lastNM = NULL;
+  LRC_configOptions* currentOP = NULL;
+  LRC_configOptions* lastOP = NULL;
+  LRC_configOptions* newOP = NULL;
+
+  currentNM = head;
+
+  while (currentNM) {
+    if (lastNM == NULL) {
+      copy = LRC_newNamespace(currentNM->space);
+      lastNM = copy;
+    } else {
+      lastNM->next = LRC_newNamespace(currentNM->space);
+      lastNM = lastNM->next;
+    }
+    if (!lastNM) goto failure;
+
+    lastOP = NULL;
+    currentOP = currentNM->options;
+    while (currentOP) {
+      newOP = calloc(1, sizeof(LRC_configOptions));
+      if (!newOP) {
+        perror("LRC_copyConfig: alloc failed");
+        goto failure;
+      }
+      LRC_COUNT_ALLOC(lastNM, sizeof(LRC_configOptions));
+
+      *newOP = *currentOP;
+      newOP->next = NULL;
+      newOP->array = NULL;
+
+      if (lastOP == NULL) {
+        lastNM->options = newOP;
+      } else {
+        lastOP->next = newOP;
+      }
+      lastOP = newOP;
+
+      if (currentOP->array) {
+        newOP->array = malloc(currentOP->count * LRC_arrayElement(currentOP->type));
+        if (!newOP->array) {
+          perror("LRC_copyConfig: alloc failed");
+          goto failure;
+        }
+        LRC_COUNT_ALLOC(lastNM, currentOP->count * LRC_arrayElement(currentOP->type));
+        memcpy(newOP->array, currentOP->array, currentOP->count * LRC_arrayElement(currentOP->type));
+      }
+
+      currentOP = currentOP->next;
+    }
+
+    currentNM = currentNM->next;
+  }
+
+  return copy;
+
+failure:
+  LRC_cleanup(copy);
+  return NULL;
+}
+
+/**
+ * @fn char* LRC_packConfig(LRC_configNamespace* head, size_t* len)
+ * @brief Packs the values of the tree into a compact buffer.
+ *
+ * Each option is stored as the native type followed by the namespace, the name
+ * and the value, as null-terminated strings. Array options are followed by the
+ * number of elements (size_t) and the elements. The buffer is meant to be
+ * shipped between processes of the same architecture, i.e. with MPI_Bcast.
+ *
+ * @param head
+ *  First namespace in the options list
+ *
+ * @param len
+ *  On return, the length of the buffer
+ *
+ * @return
+ *  The buffer (you must free it) or NULL on failure
+ */
+char* LRC_packConfig(LRC_configNamespace* head, size_t* len) {
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* currentOP = NULL;
+  size_t size = 0, slen, nlen, vlen, alen;
+  char* buf = NULL;
+  char* p = NULL;
+
+  for (current = head; current; current = current->next) {
+    slen = strlen(current->space) + 1;
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      size += sizeof(int) + slen + strlen(currentOP->name) + 1 + strlen(currentOP->value) + 1;
+      if (LRC_isArray(currentOP->type)) {
+        size += sizeof(size_t) + currentOP->count * LRC_arrayElement(currentOP->type);
+      }
+    }
+  }
+
+  buf = malloc(size > 0 ? size : 1);
+  if (!buf) {
+    perror("LRC_packConfig: alloc failed");
+    return NULL;
+  }
+  LRC_COUNT_ALLOC(head, size);
+
+  p = buf;
+  for (current = head; current; current = current->next) {
+    slen = strlen(current->space) + 1;
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      nlen = strlen(currentOP->name) + 1;
+      vlen = strlen(currentOP->value) + 1;
+
+      memcpy(p, &currentOP->type, sizeof(int));
+      p += sizeof(int);
+      memcpy(p, current->space, slen);
+      p += slen;
+      memcpy(p, currentOP->name, nlen);
+      p += nlen;
+      memcpy(p, currentOP->value, vlen);
+      p += vlen;
+
+      if (LRC_isArray(currentOP->type)) {
+        alen = currentOP->count * LRC_arrayElement(currentOP->type);
+        memcpy(p, &currentOP->count, sizeof(size_t));
+        p += sizeof(size_t);
+        if (alen > 0) memcpy(p, currentOP->array, alen);
+        p += alen;
+      }
+    }
+  }
+
+  *len = size;
+  return buf;
+}
+
+/**
+ * @fn char* LRC_unpackString(char* p, char* end)
+ * @brief Checks the packed string at p.
+ *
+ * @param p
+ *  The string
+ *
+ * @param end
+ *  The end of the buffer
+ *
+ * @return
+ *  The first byte after the string, or NULL if the string is not terminated
+ *  before end or does not fit LRC_CONFIG_LEN
+ */
+char* LRC_unpackString(char* p, char* end) {
+
+  char* nul = NULL;
+  size_t max;
+
+  if (p >= end) return NULL;
+
+  max = (size_t)(end - p);
+  if (max > LRC_CONFIG_LEN) max = LRC_CONFIG_LEN;
+
+  nul = memchr(p, LRC_NULL, max);
+  if (!nul) return NULL;
+
+  return nul + 1;
+}
+
+/**
+ * @fn int LRC_unpackConfig(char* buf, size_t len, LRC_configNamespace* head)
+ * @brief Applies the values packed with LRC_packConfig() to the tree.
+ *
+ * The buffer is checked against len, so that a truncated or damaged buffer
+ * fails instead of being read past its end.
+ *
+ * @param buf
+ *  The packed buffer
+ *
+ * @param len
+ *  The length of the buffer
+ *
+ * @param head
+ *  Pointer to the structure with default values
+ *
+ * @return
+ *  Number of applied options or -1 on failure
+ */
+int LRC_unpackConfig(char* buf, size_t len, LRC_configNamespace* head) {
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  char* p = buf;
+  char* end = buf + len;
+  char* space;
+  char* name;
+  char* value;
+  void* array = NULL;
+  int type = 0, n = 0;
+  size_t count = 0, alen = 0;
+
+  LRC_changed(head, NULL, NULL);
+
+  while (p < end) {
+    if ((size_t)(end - p) < sizeof(int) + 3) goto failure;
+    memcpy(&type, p, sizeof(int));
+    p += sizeof(int);
+
+    space = p;
+    p = LRC_unpackString(p, end);
+    if (!p) goto failure;
+
+    name = p;
+    p = LRC_unpackString(p, end);
+    if (!p) goto failure;
+
+    value = p;
+    p = LRC_unpackString(p, end);
+    if (!p) goto failure;
+
+    if (LRC_isArray(type)) {
+      if ((size_t)(end - p) < sizeof(size_t)) goto failure;
+      memcpy(&count, p, sizeof(size_t));
+      p += sizeof(size_t);
+
+      if (count > (size_t)(end - p) / LRC_arrayElement(type)) goto failure;
+      alen = count * LRC_arrayElement(type);
+    }
+
+    current = LRC_findNamespace(space, head);
+    if (current == NULL) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, n, 0, space, NULL, LRC_MSG_UNKNOWN_NAMESPACE);
+      goto failure;
+    }
+
+    option = LRC_findOption(name, current);
+    if (option == NULL) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, n, 0, space, name, LRC_MSG_UNKNOWN_VAR);
+      goto failure;
+    }
+
+    if (LRC_isArray(type)) {
+      array = NULL;
+      if (count > 0) {
+        array = malloc(alen);
+        if (!array) {
+          perror("LRC_unpackConfig: alloc failed");
+          goto failure;
+        }
+        LRC_COUNT_ALLOC(current, alen);
+        memcpy(array, p, alen);
+      }
+      p += alen;
+      LRC_storeArray(option, array, count, type);
+    } else if (LRC_storeValue(option, value, type) < 0) {
+      goto failure;
+    }
+    n++;
+  }
+
+  return n;
+
+failure:
+  return -1;
+}
+
+/**
+ * @fn int LRC_allOptions(LRC_configNamespace* head)
+ * @brief Count all available options
+ *
+ * @param head
+ * First namespace in the options list
+ *
+ * @return
+ * Number of options (all available namespaces)
+ */
+int LRC_allOptions(LRC_configNamespace* head) {
+  int allopts = 0;
+  LRC_configOptions* currentOP = NULL;
+  LRC_configOptions* nextOP = NULL;
+  LRC_configNamespace* nextNM = NULL;
+  LRC_configNamespace* current = NULL;
+
+  if (head) current = head;
+
+  do {
+    if (current) {
+      nextNM = current->next;
+      currentOP = current->options;
+      do {
+        if (currentOP) {
+          allopts++;
+          nextOP = currentOP->next;
+          currentOP = nextOP;
+        }
+      } while(currentOP);
+      current=nextNM;
+    }
+  } while(current);
+
+
+  return allopts;
+}
+
+/**
+ * @fn LRC_configNamespace* LRC_findNamespace(char* namespace)
+ * @brief Search for given namespace
+ *
+ * @param namespace
+ *  The name of the namespace to be searched for
+ *
+ * @return
+ *  Pointer to the namespace or NULL if namespace was not found
+ */
+LRC_configNamespace* LRC_findNamespace(char* namespace, LRC_configNamespace* head){
+  
+  LRC_configNamespace* test = NULL;
+  
+  if (head && namespace) {
+    test = head;
+    LRC_COUNT(head, lookups, 1);
+
+    while (test) {
+      LRC_COUNT(head, probes, 1);
+      if (strcmp(test->space, namespace) == 0) {
+        return test;
+      }
+      test = test->next;
+    }
+  }
+  return NULL;
+}
+
+LRC_configNamespace* LRC_lastLeaf(LRC_configNamespace* head) {
+
+  LRC_configNamespace* test = NULL;
+
+  if (head) {
+    test = head;
+
+    if (test->next == NULL) return test;
+
+    while (test->next) {
+      test = test->next;
+      if (test->next == NULL) return test;
+    }
+  }
+
+  return head;
+}
+
+/**
+ * @fn LRC_configOptions* LRC_findOption(char* varname, LRC_configNamespace* current)
+ * @brief Search for given variable
+ *
+ * @param varname
+ *  The name of the variable to be searched for
+ *
+ * @return
+ *  The pointer to the variable or NULL if the variable was not found
+ *
+ */
+LRC_configOptions* LRC_findOption(char* varname, LRC_configNamespace* current){
+
+  LRC_configOptions* testOP = NULL;
+  size_t vlen, olen;
+  char var[LRC_CONFIG_LEN];
+  char opt[LRC_CONFIG_LEN];
+
+  if (current && varname) {
+    if (current->options) {
+      testOP = current->options;
+      vlen = strlen(varname);
+      strncpy(var, varname, vlen);
+      var[vlen] = LRC_NULL;
+      LRC_COUNT(current, lookups, 1);
+
+      while (testOP) {
+        LRC_COUNT(current, probes, 1);
+        if (testOP->name) {
+
+          olen = strlen(testOP->name);
+          strncpy(opt, testOP->name, olen);
+          opt[olen] = LRC_NULL;
+          
+          if (strcmp(opt, var) == 0) {
+            return testOP;
+          }
+        }
+        testOP = testOP->next;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @fn int LRC_isArray(int type)
+ * @brief Checks if the type is one of the array types.
+ */
+int LRC_isArray(int type){
+  return type == LRC_INT_ARRAY || type == LRC_DOUBLE_ARRAY;
+}
+
+/**
+ * @fn size_t LRC_arrayElement(int type)
+ * @brief Size of the element of the array type.
+ */
+size_t LRC_arrayElement(int type){
+  return type == LRC_INT_ARRAY ? sizeof(int) : sizeof(double);
+}
+
+/**
+ * @fn int LRC_formatArray(LRC_buffer* buf, LRC_configOptions* option)
+ * @brief Appends the elements of the array option, separated with commas.
+ *
+ * Doubles are written in the shortest form which reads back exactly.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_formatArray(LRC_buffer* buf, LRC_configOptions* option){
+
+  char num[LRC_NUMBER_LEN];
+  size_t i;
+  int n, status = 0;
+
+  for (i = 0; i < option->count; i++) {
+    if (option->type == LRC_INT_ARRAY) {
+      n = sprintf(num, "%d", ((int*)option->array)[i]);
+    } else {
+      n = LRC_double2str(num, ((double*)option->array)[i]);
+    }
+    status |= LRC_bufferAppend(buf, num, (size_t)n);
+    if (i + 1 < option->count) status |= LRC_bufferAppend(buf, ", ", 2);
+  }
+
+  return status ? -1 : 0;
+}
+
+/**
+ * @fn void LRC_storeArray(LRC_configOptions* option, void* array, size_t count, int type)
+ * @brief Replaces the elements of the option.
+ *
+ * The option takes the ownership of the array. The value string is set to the
+ * text of the array, if it fits (empty otherwise, see LRC_formatArray()).
+ */
+void LRC_storeArray(LRC_configOptions* option, void* array, size_t count, int type){
+
+  char num[LRC_NUMBER_LEN];
+  size_t i, len = 0, sep;
+  int n;
+
+  if (option->array) free(option->array);
+
+  option->array = array;
+  option->count = count;
+  option->type = type;
+  option->value[0] = LRC_NULL;
+
+  /* The elements are formatted only as long as they fit */
+  for (i = 0; i < count; i++) {
+    if (type == LRC_INT_ARRAY) {
+      n = sprintf(num, "%d", ((int*)array)[i]);
+    } else {
+      n = LRC_double2str(num, ((double*)array)[i]);
+    }
+
+    sep = i + 1 < count ? 2 : 0;
+    if (len + (size_t)n + sep >= LRC_CONFIG_LEN) {
+      option->value[0] = LRC_NULL;
+      return;
+    }
+
+    memcpy(option->value + len, num, (size_t)n);
+    len += (size_t)n;
+    if (sep) memcpy(option->value + len, ", ", sep);
+    len += sep;
+  }
+
+  option->value[len] = LRC_NULL;
+}
+
+/**
+ * @fn int LRC_storeValue(LRC_configOptions* option, char* value, int type)
+ * @brief Stores the value and the type of the option.
+ *
+ * All changes of the values go through this function. Values of array types
+ * are converted to the array of elements.
+ *
+ * @return
+ *  0 on success, -1 if the value is too long or is not a valid array, also if
+ *  an element is out of range (the option is not changed then)
+ */
+int LRC_storeValue(LRC_configOptions* option, char* value, int type){
+
+  void* array = NULL;
+  size_t vlen, count = 0;
+
+  vlen = strlen(value);
+
+  if (LRC_isArray(type)) {
+    if (LRC_parseArray(value, type, &array, &count) != LRC_NUMBER_OK) {
+      if (array) free(array);
+      return -1;
+    }
+
+    if (option->array) free(option->array);
+    option->array = array;
+    option->count = count;
+    option->type = type;
+
+    /* Keep the text as written, if it fits */
+    if (vlen < LRC_CONFIG_LEN) {
+      memmove(option->value, value, vlen + 1);
+    } else {
+      option->value[0] = LRC_NULL;
+    }
+
+    return 0;
+  }
+
+  if (vlen >= LRC_CONFIG_LEN) return -1;
+
+  if (option->array) {
+    free(option->array);
+    option->array = NULL;
+    option->count = 0;
+  }
+
+  memmove(option->value, value, vlen + 1);
+  option->type = type;
+
+  return 0;
+}
+
+/**
+ * @fn LRC_configOptions* LRC_modifyOption(char* varname, char* newvalue, int newtype, LRC_configNamespace* head)
+ * @brief Modifies value and type of given option.
+ *
+ * Values of array types are lists, i.e. "1, 2, 3".
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found (or the
+ *  value does not fit the type)
+ */
+LRC_configOptions* LRC_modifyOption(char* namespace, char* varname, char* newvalue, int newtype, LRC_configNamespace* head){
+	
+	LRC_configOptions* option = NULL;
+  LRC_configNamespace* current = NULL;
+
+  if (head) {
+	  current = LRC_findNamespace(namespace, head);
+	  if (current) {
+      option = LRC_findOption(varname, current);
+
+      if (option) {
+        if (LRC_storeValue(option, newvalue, newtype) < 0) return NULL;
+        LRC_changed(head, namespace, option);
+      }
+    }
+  }
+	return option;
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setInt(char* namespace, char* varname, int value, LRC_configNamespace* head)
+ * @brief Sets the integer value of given option.
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setInt(char* namespace, char* varname, int value, LRC_configNamespace* head){
+
+  char str[LRC_NUMBER_LEN];
+
+  LRC_COUNT(head, conversions, 1);
+  sprintf(str, "%d", value);
+  return LRC_modifyOption(namespace, varname, str, LRC_INT, head);
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setLong(char* namespace, char* varname, long value, LRC_configNamespace* head)
+ * @brief Sets the long integer value of given option.
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setLong(char* namespace, char* varname, long value, LRC_configNamespace* head){
+
+  char str[LRC_NUMBER_LEN];
+
+  LRC_COUNT(head, conversions, 1);
+  sprintf(str, "%ld", value);
+  return LRC_modifyOption(namespace, varname, str, LRC_LONG, head);
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setFloat(char* namespace, char* varname, float value, LRC_configNamespace* head)
+ * @brief Sets the float value of given option.
+ *
+ * The value is stored with the shortest representation that reads back
+ * exactly, @see LRC_float2str()
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setFloat(char* namespace, char* varname, float value, LRC_configNamespace* head){
+
+  char str[LRC_NUMBER_LEN];
+
+  LRC_COUNT(head, conversions, 1);
+  LRC_float2str(str, value);
+  return LRC_modifyOption(namespace, varname, str, LRC_FLOAT, head);
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setDouble(char* namespace, char* varname, double value, LRC_configNamespace* head)
+ * @brief Sets the double value of given option.
+ *
+ * The value is stored with the shortest representation that reads back
+ * exactly, @see LRC_double2str()
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setDouble(char* namespace, char* varname, double value, LRC_configNamespace* head){
+
+  char str[LRC_NUMBER_LEN];
+
+  LRC_COUNT(head, conversions, 1);
+  LRC_double2str(str, value);
+  return LRC_modifyOption(namespace, varname, str, LRC_DOUBLE, head);
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setLdouble(char* namespace, char* varname, long double value, LRC_configNamespace* head)
+ * @brief Sets the long double value of given option (stored as LRC_DOUBLE).
+ *
+ * @see LRC_Ldouble2str()
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setLdouble(char* namespace, char* varname, long double value, LRC_configNamespace* head){
+
+  char str[LRC_NUMBER_LEN];
+
+  LRC_COUNT(head, conversions, 1);
+  LRC_Ldouble2str(str, value);
+  return LRC_modifyOption(namespace, varname, str, LRC_DOUBLE, head);
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setIntArray(char* namespace, char* varname, int* values, size_t count, LRC_configNamespace* head)
+ * @brief Sets the elements of the integer array option (the values are copied).
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setIntArray(char* namespace, char* varname, int* values, size_t count, LRC_configNamespace* head){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  int* array = NULL;
+
+  if (head && namespace && varname) {
+    current = LRC_findNamespace(namespace, head);
+    if (current) option = LRC_findOption(varname, current);
+  }
+
+  if (!option) return NULL;
+
+  if (count > 0) {
+    array = malloc(count * sizeof(int));
+    if (!array) {
+      perror("LRC_setIntArray: alloc failed");
+      return NULL;
+    }
+    LRC_COUNT_ALLOC(current, count * sizeof(int));
+    memcpy(array, values, count * sizeof(int));
+  }
+
+  LRC_storeArray(option, array, count, LRC_INT_ARRAY);
+  LRC_changed(head, namespace, option);
+
+  return option;
+}
+
+/**
+ * @fn LRC_configOptions* LRC_setDoubleArray(char* namespace, char* varname, double* values, size_t count, LRC_configNamespace* head)
+ * @brief Sets the elements of the double array option (the values are copied).
+ *
+ * @return
+ *  The pointer to modified option or NULL if option was not found
+ */
+LRC_configOptions* LRC_setDoubleArray(char* namespace, char* varname, double* values, size_t count, LRC_configNamespace* head){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  double* array = NULL;
+
+  if (head && namespace && varname) {
+    current = LRC_findNamespace(namespace, head);
+    if (current) option = LRC_findOption(varname, current);
+  }
+
+  if (!option) return NULL;
+
+  if (count > 0) {
+    array = malloc(count * sizeof(double));
+    if (!array) {
+      perror("LRC_setDoubleArray: alloc failed");
+      return NULL;
+    }
+    LRC_COUNT_ALLOC(current, count * sizeof(double));
+    memcpy(array, values, count * sizeof(double));
+  }
+
+  LRC_storeArray(option, array, count, LRC_DOUBLE_ARRAY);
+  LRC_changed(head, namespace, option);
+
+  return option;
+}
+
+char* LRC_getOptionValue(char* namespace, char* var, LRC_configNamespace* head){
+
+	LRC_configOptions* option = NULL;
+  LRC_configNamespace* current = NULL;
+
+  if (head) {
+    current = LRC_findNamespace(namespace, head);
+    if (current) {
+      option = LRC_findOption(var, current);
+      if (option && head->interp) return LRC_interpGet(head, namespace, option);
+      if (option && option->value) return option->value;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @fn int LRC_getInt(char* namespace, char* varname, int* value, LRC_configNamespace* head)
+ * @brief Converts the option to integer, with error checking
+ *
+ * @see LRC_str2int()
+ *
+ * @return
+ *  LRC_NUMBER_OK, LRC_NUMBER_RANGE or LRC_NUMBER_INVALID (also if the option
+ *  does not exist)
+ */
+int LRC_getInt(char* namespace, char* varname, int* value, LRC_configNamespace* head){
+
+  char* str = NULL;
+
+  *value = 0;
+
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
 
-  return head;
+  if (!str) return LRC_NUMBER_INVALID;
+
+  LRC_COUNT(head, conversions, 1);
+  return LRC_str2int(str, value);
 }
 
 /**
- * @fn int LRC_allOptions(LRC_configNamespace* head)
- * @brief Count all available options
+ * @fn int LRC_getLong(char* namespace, char* varname, long* value, LRC_configNamespace* head)
+ * @brief Converts the option to long integer, with error checking
  *
- * @param head
- * First namespace in the options list
+ * @see LRC_str2long()
  *
  * @return
- * Number of options (all available namespaces)
+ *  LRC_NUMBER_OK, LRC_NUMBER_RANGE or LRC_NUMBER_INVALID (also if the option
+ *  does not exist)
  */
-int LRC_allOptions(LRC_configNamespace* head) {
-  int allopts = 0;
-  LRC_configOptions* currentOP = NULL;
-  LRC_configOptions* nextOP = NULL;
-  LRC_configNamespace* nextNM = NULL;
-  LRC_configNamespace* current = NULL;
+int LRC_getLong(char* namespace, char* varname, long* value, LRC_configNamespace* head){
 
-  if (head) current = head;
+  char* str = NULL;
 
-  do {
-    if (current) {
-      nextNM = current->next;
-      currentOP = current->options;
-      do {
-        if (currentOP) {
-          allopts++;
-          nextOP = currentOP->next;
-          currentOP = nextOP;
-        }
-      } while(currentOP);
-      current=nextNM;
-    }
-  } while(current);
+  *value = 0;
 
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
+  }
 
-  return allopts;
+  if (!str) return LRC_NUMBER_INVALID;
+
+  LRC_COUNT(head, conversions, 1);
+  return LRC_str2long(str, value);
 }
 
 /**
- * @fn LRC_configNamespace* LRC_findNamespace(char* namespace)
- * @brief Search for given namespace
+ * @fn int LRC_getFloat(char* namespace, char* varname, float* value, LRC_configNamespace* head)
+ * @brief Converts the option to float, with error checking
  *
- * @param namespace
- *  The name of the namespace to be searched for
+ * @see LRC_str2float()
  *
  * @return
- *  Pointer to the namespace or NULL if namespace was not found
+ *  LRC_NUMBER_OK, LRC_NUMBER_RANGE or LRC_NUMBER_INVALID (also if the option
+ *  does not exist)
  */
-LRC_configNamespace* LRC_findNamespace(char* namespace, LRC_configNamespace* head){
-  
-  LRC_configNamespace* test = NULL;
-  
-  if (head && namespace) {
-    test = head;
+int LRC_getFloat(char* namespace, char* varname, float* value, LRC_configNamespace* head){
 
-    while (test) {
-      if (strcmp(test->space, namespace) == 0) {
-        return test;
-      }
-      test = test->next;
-    }
+  char* str = NULL;
+
+  *value = 0;
+
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
-  return NULL;
-}
 
-LRC_configNamespace* LRC_lastLeaf(LRC_configNamespace* head) {
+  if (!str) return LRC_NUMBER_INVALID;
 
-  LRC_configNamespace* test = NULL;
+  LRC_COUNT(head, conversions, 1);
+  return LRC_str2float(str, value);
+}
 
-  if (head) {
-    test = head;
+/**
+ * @fn int LRC_getDouble(char* namespace, char* varname, double* value, LRC_configNamespace* head)
+ * @brief Converts the option to double, with error checking
+ *
+ * @see LRC_str2double()
+ *
+ * @return
+ *  LRC_NUMBER_OK, LRC_NUMBER_RANGE or LRC_NUMBER_INVALID (also if the option
+ *  does not exist)
+ */
+int LRC_getDouble(char* namespace, char* varname, double* value, LRC_configNamespace* head){
 
-    if (test->next == NULL) return test;
+  char* str = NULL;
 
-    while (test->next) {
-      test = test->next;
-      if (test->next == NULL) return test;
-    }
+  *value = 0;
+
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
 
-  return head;
+  if (!str) return LRC_NUMBER_INVALID;
+
+  LRC_COUNT(head, conversions, 1);
+  return LRC_str2double(str, value);
 }
 
 /**
- * @fn LRC_configOptions* LRC_findOption(char* varname, LRC_configNamespace* current)
- * @brief Search for given variable
+ * @fn int LRC_getLdouble(char* namespace, char* varname, long double* value, LRC_configNamespace* head)
+ * @brief Converts the option to long double, with error checking
  *
- * @param varname
- *  The name of the variable to be searched for
+ * @see LRC_str2Ldouble()
  *
  * @return
- *  The pointer to the variable or NULL if the variable was not found
- *
+ *  LRC_NUMBER_OK, LRC_NUMBER_RANGE or LRC_NUMBER_INVALID (also if the option
+ *  does not exist)
  */
-LRC_configOptions* LRC_findOption(char* varname, LRC_configNamespace* current){
-
-  LRC_configOptions* testOP = NULL;
-  size_t vlen, olen;
-  char var[LRC_CONFIG_LEN];
-  char opt[LRC_CONFIG_LEN];
+int LRC_getLdouble(char* namespace, char* varname, long double* value, LRC_configNamespace* head){
 
-  if (current && varname) {
-    if (current->options) {
-      testOP = current->options;
-      vlen = strlen(varname);
-      strncpy(var, varname, vlen);
-      var[vlen] = LRC_NULL;
+  char* str = NULL;
 
-      while (testOP) {
-        if (testOP->name) {
+  *value = 0;
 
-          olen = strlen(testOP->name);
-          strncpy(opt, testOP->name, olen);
-          opt[olen] = LRC_NULL;
-          
-          if (strcmp(opt, var) == 0) {
-            return testOP;
-          }
-        }
-        testOP = testOP->next;
-      }
-    }
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
 
-  return NULL;
+  if (!str) return LRC_NUMBER_INVALID;
+
+  LRC_COUNT(head, conversions, 1);
+  return LRC_str2Ldouble(str, value);
 }
 
 /**
- * @fn LRC_configOptions* LRC_modifyOption(char* varname, char* newvalue, int newtype, LRC_configNamespace* head)
- * @brief Modifies value and type of given option.
+ * @fn long LRC_getIntArray(char* namespace, char* varname, int* values, size_t size, LRC_configNamespace* head)
+ * @brief Copies the elements of the integer array option into the buffer.
+ *
+ * @param values
+ *  The buffer
+ *
+ * @param size
+ *  The size of the buffer (number of elements), at most that many elements
+ *  are copied. Use 0 to query the number of elements.
  *
  * @return
- *  The pointer to modified option or NULL if option was not found
+ *  The number of elements of the option or -1 if the option does not exist or
+ *  is not an integer array
  */
-LRC_configOptions* LRC_modifyOption(char* namespace, char* varname, char* newvalue, int newtype, LRC_configNamespace* head){
-	
-	LRC_configOptions* option = NULL;
+long LRC_getIntArray(char* namespace, char* varname, int* values, size_t size, LRC_configNamespace* head){
+
   LRC_configNamespace* current = NULL;
-	size_t vlen;
+  LRC_configOptions* option = NULL;
 
-  if (head) {
-	  current = LRC_findNamespace(namespace, head);
-	  if (current) {
-      option = LRC_findOption(varname, current);
+  if (head && namespace && varname) {
+    current = LRC_findNamespace(namespace, head);
+    if (current) option = LRC_findOption(varname, current);
+  }
 
-	    vlen = strlen(newvalue);
+  if (!option || option->type != LRC_INT_ARRAY) return -1;
 
-      if (option) {
-        if (strcmp(option->value, newvalue) != 0) {
-          strncpy(option->value, newvalue, vlen);
-          option->value[vlen] = LRC_NULL;
-        }
-        if (option->type != newtype) {
-          option->type = newtype;
-        }
-      }
-    }
-  }
-	return option;
+  if (size > option->count) size = option->count;
+  if (size > 0) memcpy(values, option->array, size * sizeof(int));
+
+  return (long)option->count;
 }
 
-char* LRC_getOptionValue(char* namespace, char* var, LRC_configNamespace* head){
+/**
+ * @fn long LRC_getDoubleArray(char* namespace, char* varname, double* values, size_t size, LRC_configNamespace* head)
+ * @brief Copies the elements of the double array option into the buffer.
+ *
+ * @see LRC_getIntArray()
+ *
+ * @return
+ *  The number of elements of the option or -1 if the option does not exist or
+ *  is not a double array
+ */
+long LRC_getDoubleArray(char* namespace, char* varname, double* values, size_t size, LRC_configNamespace* head){
 
-	LRC_configOptions* option = NULL;
   LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
 
-  if (head) {
+  if (head && namespace && varname) {
     current = LRC_findNamespace(namespace, head);
-    if (current) {
-      option = LRC_findOption(var, current);
-      if (option && option->value) return option->value;
-    }
+    if (current) option = LRC_findOption(varname, current);
   }
-  return NULL;
+
+  if (!option || option->type != LRC_DOUBLE_ARRAY) return -1;
+
+  if (size > option->count) size = option->count;
+  if (size > 0) memcpy(values, option->array, size * sizeof(double));
+
+  return (long)option->count;
 }
 
 /**
  * @fn LRC_option2int(char* namespace, char* varname, LRC_configNamespace* head)
  * @brief Converts the option to integer
  *
+ * As with atoi() and strtod(), the number at the beginning of the value is
+ * converted and the rest is ignored ("12abc" gives 12), independently of the
+ * locale. LRC_getInt() reports such values as LRC_NUMBER_INVALID.
+ *
  * @return
  *  Converted option
  */
 int LRC_option2int(char* namespace, char* varname, LRC_configNamespace* head){
   
-  LRC_configOptions* option = NULL;
-  LRC_configNamespace* current = NULL;
+  char* str = NULL;
   int value = 0;
-  
-  if (head && namespace) {
-    current = LRC_findNamespace(namespace, head);
-    if (current && varname) {
-      option = LRC_findOption(varname, current);
 
-      if (option) {
-        if (option->value) {
-          value = atoi(option->value);
-        }
-      }
-    }
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
 
+  if (str) LRC_str2prefix(str, LRC_INT, &value);
+  
   return value;
 }
 
@@ -1332,28 +4076,22 @@ int LRC_option2int(char* namespace, char* varname, LRC_configNamespace* head){
  * @fn LRC_option2float(char* namespace, char* varname, LRC_configNamespace* head)
  * @brief Converts the option to float
  *
+ * The leading number is converted and the rest ignored, @see LRC_option2int().
+ * LRC_getFloat() reports such values as LRC_NUMBER_INVALID.
+ *
  * @return
  *  Converted option
  */
 float LRC_option2float(char* namespace, char* varname, LRC_configNamespace* head){
   
-  LRC_configOptions* option = NULL;
-  LRC_configNamespace* current = NULL;
+  char* str = NULL;
   float value = 0.0;
-  char* p = NULL;
-  
-  if (head && namespace) {
-    current = LRC_findNamespace(namespace, head);
-    if (current && varname) {
-      option = LRC_findOption(varname, current);
 
-      if (option) {
-        if (option->value) {
-          value = strtof(option->value, &p);
-        }
-      }
-    }
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
+
+  if (str) LRC_str2prefix(str, LRC_FLOAT, &value);
   
   return value;
 }
@@ -1362,28 +4100,22 @@ float LRC_option2float(char* namespace, char* varname, LRC_configNamespace* head
  * @fn LRC_option2double(char* namespace, char* varname, LRC_configNamespace* head)
  * @brief Converts the option to double
  *
+ * The leading number is converted and the rest ignored, @see LRC_option2int().
+ * LRC_getDouble() reports such values as LRC_NUMBER_INVALID.
+ *
  * @return
  *  Converted option
  */
 double LRC_option2double(char* namespace, char* varname, LRC_configNamespace* head){
   
-  LRC_configOptions* option = NULL;
-  LRC_configNamespace* current = NULL;
+  char* str = NULL;
   double value = 0.0;
-  char* p = NULL;
-  
-  if (head && namespace) {
-    current = LRC_findNamespace(namespace, head);
-    if (current && varname) {
-      option = LRC_findOption(varname, current);
 
-      if (option) {
-        if (option->value) {
-          value = strtod(option->value, &p);
-        }
-      }
-    }
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
+
+  if (str) LRC_str2prefix(str, LRC_DOUBLE, &value);
   
   return value;
 }
@@ -1392,29 +4124,23 @@ double LRC_option2double(char* namespace, char* varname, LRC_configNamespace* he
  * @fn LRC_option2Ldouble(char* namespace, char* varname, LRC_configNamespace* head)
  * @brief Converts the option to long double
  *
+ * The leading number is converted and the rest ignored, @see LRC_option2int().
+ * LRC_getLdouble() reports such values as LRC_NUMBER_INVALID.
+ *
  * @return
  *  Converted option
  */
 long double LRC_option2Ldouble(char* namespace, char* varname, LRC_configNamespace* head){
   
-  LRC_configOptions* option = NULL;
-  LRC_configNamespace* current = NULL;
+  char* str = NULL;
   long double value = 0.0;
-  char* p = NULL;
-  
-  if (head && namespace) {
-    current = LRC_findNamespace(namespace, head);
-    if (current && varname) {
-      option = LRC_findOption(varname, current);
-    
-      if (option) {
-        if (option->value) {
-          value = strtold(option->value, &p);
-        }
-      }
-    }
+
+  if (head && namespace && varname) {
+    str = LRC_getOptionValue(namespace, varname, head);
   }
 
+  if (str) LRC_str2prefix(str, 0, &value);
+  
   return value;
 }
 
@@ -1454,8 +4180,8 @@ int LRC_countOptions(char* nm, LRC_configNamespace* head){
  * For using it with integers, try:
  * LRC_itoa(str, (int*)value, LRC_INT)
  *
- * For using it with floats and doubles, try:
- * LRC_itao(str, &value, LRC_FLOAT/LRC_DOUBLE) etc.
+ * For floats and doubles use LRC_float2str(), LRC_double2str() and
+ * LRC_Ldouble2str(), or the typed setters (LRC_setDouble() etc.)
  *
  * It is not clear for me if this is a good implementation. However, this is the
  * only way I can do it in one function for all types of numerical values.
@@ -1535,6 +4261,148 @@ int LRC_mergeDefaults(LRC_configDefaults *in, LRC_configDefaults *add) {
   return status;
 }
 
+/**
+ * @fn int LRC_schemaType(char* type)
+ * @brief Converts the name of the type (int, long, float, double, string, val).
+ *
+ * @return
+ *  The LRC type or -1 if the type is not supported
+ */
+int LRC_schemaType(char* type){
+
+  if (strcmp(type, "int") == 0) return LRC_INT;
+  if (strcmp(type, "long") == 0) return LRC_LONG;
+  if (strcmp(type, "float") == 0) return LRC_FLOAT;
+  if (strcmp(type, "double") == 0) return LRC_DOUBLE;
+  if (strcmp(type, "string") == 0) return LRC_STRING;
+  if (strcmp(type, "val") == 0) return LRC_VAL;
+
+  return -1;
+}
+
+/**
+ * @fn int LRC_readDefaults(FILE* file, LRC_configDefaults** cd)
+ * @brief Reads the defaults table from the schema file.
+ *
+ * The schema has one option per line, blank lines and lines starting with #
+ * are skipped:
+ *
+ *     # namespace  name     type    default
+ *     default      nprocs   int     4
+ *     logs         period   double  23.47
+ *
+ * The default is the rest of the line and is validated.
+ *
+ * @param cd
+ *  The table, terminated with an empty option. You must free it.
+ *
+ * @return
+ *  Number of options or -1 on failure
+ */
+int LRC_readDefaults(FILE* file, LRC_configDefaults** cd){
+
+  char line[LRC_MAX_LINE_LENGTH];
+  char space[LRC_MAX_LINE_LENGTH], name[LRC_MAX_LINE_LENGTH], type[LRC_MAX_LINE_LENGTH];
+  char* value;
+  LRC_configDefaults* in = NULL;
+  LRC_configDefaults* tmp = NULL;
+  int n = 0, size = 0, j = 0, k, m, status = LRC_NUMBER_OK;
+  long l;
+  double d;
+  float f;
+
+  if (!file || !cd) return -1;
+
+  while (fgets(line, LRC_MAX_LINE_LENGTH, file)) {
+    j++;
+
+    if (!strchr(line, '\n') && !feof(file)) {
+      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_TOO_LONG);
+      goto failure;
+    }
+
+    value = LRC_trim(line);
+    if (value[0] == LRC_NULL || value[0] == '#') continue;
+
+    m = 0;
+    if (sscanf(value, "%s %s %s %n", space, name, type, &m) < 3 || m == 0) {
+      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_MISSING_VAL);
+      goto failure;
+    }
+    value = LRC_trim(value + m);
+
+    if (strlen(space) >= LRC_CONFIG_LEN || strlen(name) >= LRC_CONFIG_LEN
+        || strlen(value) >= LRC_CONFIG_LEN) {
+      LRC_message(j, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_TOO_LONG);
+      goto failure;
+    }
+
+    if (n == size) {
+      size = size ? 2*size : 64;
+      tmp = realloc(in, size * sizeof(LRC_configDefaults));
+      if (!tmp) {
+        perror("LRC_readDefaults: alloc failed");
+        goto failure;
+      }
+      in = tmp;
+    }
+
+    memset(&in[n], 0, sizeof(LRC_configDefaults));
+    strcpy(in[n].space, space);
+    strcpy(in[n].name, name);
+    strcpy(in[n].value, value);
+    in[n].type = LRC_schemaType(type);
+
+    if (in[n].type < 0) {
+      LRC_message(j, LRC_ERR_WRONG_INPUT, type);
+      goto failure;
+    }
+
+    /* Validate the default */
+    switch (in[n].type) {
+      case LRC_INT:
+      case LRC_VAL:
+        status = LRC_str2int(in[n].value, &k);
+        break;
+      case LRC_LONG:
+        status = LRC_str2long(in[n].value, &l);
+        break;
+      case LRC_FLOAT:
+        status = LRC_str2float(in[n].value, &f);
+        break;
+      case LRC_DOUBLE:
+        status = LRC_str2double(in[n].value, &d);
+        break;
+      default:
+        status = LRC_NUMBER_OK;
+        break;
+    }
+
+    if (status != LRC_NUMBER_OK) {
+      LRC_message(j, LRC_ERR_WRONG_INPUT, in[n].value);
+      goto failure;
+    }
+
+    n++;
+  }
+
+  /* The terminating empty option */
+  tmp = realloc(in, (n + 1) * sizeof(LRC_configDefaults));
+  if (!tmp) {
+    perror("LRC_readDefaults: alloc failed");
+    goto failure;
+  }
+  in = tmp;
+  memset(&in[n], 0, sizeof(LRC_configDefaults));
+
+  *cd = in;
+  return n;
+
+failure:
+  if (in) free(in);
+  return -1;
+}
+
 /**
  * @function
  * Counts all options in all namespaces
@@ -1604,7 +4472,12 @@ LRC_configDefaults* LRC_head2struct(LRC_configNamespace *head) {
   int opts = 0;
   opts = LRC_allOptions(head);
 
-  c = calloc(opts*sizeof(LRC_configDefaults), sizeof(LRC_configDefaults));
+  /* The last entry stays zeroed, LRC_OPTIONS_END */
+  c = calloc(opts + 1, sizeof(LRC_configDefaults));
+  if (!c) {
+    perror("LRC_head2struct: alloc failed");
+    return NULL;
+  }
   
   LRC_head2struct_noalloc(head, c);
   return c;
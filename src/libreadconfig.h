@@ -53,6 +53,12 @@
 #include <ctype.h>
 #include <string.h>
 #include <inttypes.h>
+#include <limits.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <float.h>
+#include <math.h>
+#include <locale.h>
 #include <popt.h>
 
 /**
@@ -61,10 +67,14 @@
  *
  * @def LRC_NULL
  * @brief Null character for trimming.
+ *
+ * @def LRC_NUMBER_LEN
+ * @brief Buffer length required by the number formatters.
  */
 #define LRC_MAX_LINE_LENGTH 1024
 #define LRC_CONFIG_LEN 512
 #define LRC_NULL '\0'
+#define LRC_NUMBER_LEN 64
 
 /**
  * @def LRC_E_CONFIG_SYNTAX
@@ -98,8 +108,12 @@ enum LRC_messages_type{
   LRC_ERR_UNKNOWN_VAR,
   LRC_ERR_FILE_OPEN,
   LRC_ERR_FILE_CLOSE,
-  LRC_ERR_HDF
-} LRC_messages;
+  LRC_ERR_HDF,
+  LRC_ERR_LIMIT,
+  LRC_ERR_MPI
+};
+
+extern enum LRC_messages_type LRC_messages;
 
 #define LRC_MSG_CONFIG_SYNTAX "Config file syntax error"
 #define LRC_MSG_MISSING_VAR "Missing variable name"
@@ -110,9 +124,34 @@ enum LRC_messages_type{
 #define LRC_MSG_WRONG_INPUT "Wrong input value type"
 #define LRC_MSG_UNKNOWN_VAR "Unknown variable"
 #define LRC_MSG_FILE_OPEN "File open error"
+#define LRC_MSG_FILE_CLOSE "File write error"
 #define LRC_MSG_HDF "HDF5 error"
 #define LRC_MSG_NONAMESPACE "No namespace has been specified"
 #define LRC_MSG_UNKNOWN_NAMESPACE "Unknown namespace"
+#define LRC_MSG_TOO_LONG "Value too long"
+#define LRC_MSG_LIMIT "Too many errors, further errors are suppressed"
+#define LRC_MSG_PATCH "Malformed config patch"
+#define LRC_MSG_INTERP "Value not available, the references of the config are unresolved"
+#define LRC_MSG_MPI "Config mismatch between MPI ranks"
+#define LRC_MSG_MPI_DIFFERS "Value differs from rank 0"
+#define LRC_MSG_MPI_MISSING "Option missing, set on rank 0"
+#define LRC_MSG_MPI_EXTRA "Option not set on rank 0"
+
+/**
+ * @def LRC_NUMBER_OK
+ * @brief The number was converted.
+ *
+ * @def LRC_NUMBER_INVALID
+ * @brief The value is not a number (or the option does not exist).
+ *
+ * @def LRC_NUMBER_RANGE
+ * @brief The number does not fit the type (overflow or underflow).
+ */
+enum LRC_numbers_type{
+  LRC_NUMBER_OK = 0,
+  LRC_NUMBER_INVALID = -1,
+  LRC_NUMBER_RANGE = -2
+};
 
 #define LRC_VAL POPT_ARG_VAL
 #define LRC_INT POPT_ARG_INT
@@ -121,6 +160,18 @@ enum LRC_messages_type{
 #define LRC_STRING POPT_ARG_STRING
 #define LRC_LONG POPT_ARG_LONG
 
+/**
+ * @def LRC_INT_ARRAY
+ * @brief Array of integers, "1, 2, 3" or "1 2 3" in the config file.
+ *
+ * @def LRC_DOUBLE_ARRAY
+ * @brief Array of doubles.
+ *
+ * The array types are outside of the popt argument range.
+ */
+#define LRC_INT_ARRAY 64
+#define LRC_DOUBLE_ARRAY 65
+
 /**
  * @struct LRC_configOptions
  * @brief Options struct.
@@ -133,11 +184,29 @@ enum LRC_messages_type{
  *
  * @param int
  *   The type of the variable.
+ *
+ * @param long
+ *   The byte offset of the value in the last parsed ASCII config file.
+ *
+ * @param size_t
+ *   The length of the value in the last parsed ASCII config file (0 if the
+ *   option was not read from that file).
+ *
+ * @param void*
+ *   The elements of array options (int or double), contiguous. The value
+ *   string holds the text of the array only if it fits LRC_CONFIG_LEN.
+ *
+ * @param size_t
+ *   The number of elements of array options.
  */
 typedef struct LRC_configOptions{
   char name[LRC_CONFIG_LEN];
   char value[LRC_CONFIG_LEN];
   int type;
+  long offset;
+  size_t length;
+  void* array;
+  size_t count;
   struct LRC_configOptions* next;
 } LRC_configOptions;
 
@@ -153,13 +222,89 @@ typedef struct LRC_configOptions{
  *
  * @param int
  *   The number of options read for given config options struct.
+ *
+ * @param interp
+ *   The interpolation state of the config, kept in the first namespace (NULL
+ *   if the values are not interpolated), see LRC_interpolate().
+ *
+ * @param stats
+ *   The counters of the namespace (NULL unless the library is built with
+ *   LRC_STATS), see LRC_getStats().
+ *
+ * @param diag
+ *   The diagnostics settings of the config, kept in the first namespace, see
+ *   LRC_setDiagnostics().
+ *
+ * @param hash
+ *   The fingerprint of the config, kept in the first namespace (NULL until
+ *   the first LRC_hash()).
+ *
+ * @param history
+ *   The version last recorded by LRC_HDF5HistoryWriter(), kept in the first
+ *   namespace (NULL before the first call).
  */
 typedef struct LRC_configNamespace{
   char space[LRC_CONFIG_LEN];
   LRC_configOptions* options;
   struct LRC_configNamespace* next;
+  struct LRC_configInterp* interp;
+  struct LRC_stats* stats;
+  struct LRC_configDiag* diag;
+  struct LRC_configHash* hash;
+  struct LRC_configHistory* history;
 } LRC_configNamespace;
 
+/**
+ * @struct LRC_diagnostic
+ * @brief Error record passed to the diagnostic handler.
+ *
+ * @param code
+ *   One of LRC_ERR_*.
+ *
+ * @param message
+ *   The message (one of LRC_MSG_* or a description).
+ *
+ * @param file
+ *   The config file (NULL if not known).
+ *
+ * @param line
+ *   The line in the file (the record, for HDF5; 0 if not known).
+ *
+ * @param column
+ *   The column in the line, from 1 (0 if not known).
+ *
+ * @param space
+ *   The namespace (NULL if not known).
+ *
+ * @param name
+ *   The option (NULL if not known).
+ */
+typedef struct LRC_diagnostic{
+  int code;
+  char* message;
+  char* file;
+  int line;
+  int column;
+  char* space;
+  char* name;
+} LRC_diagnostic;
+
+/**
+ * @brief Diagnostic handler, the record is valid during the call only.
+ */
+typedef void (*LRC_diagnosticHandler)(LRC_diagnostic* diagnostic, void* data);
+
+/**
+ * @def LRC_DIAG_DEDUP
+ * @brief Report the same problem (code, message, namespace and option) once.
+ *
+ * @def LRC_DIAG_COLLECT
+ * @brief LRC_ASCIIParser() goes on after an error, to report all errors of the
+ * file in one pass (and fails at the end).
+ */
+#define LRC_DIAG_DEDUP 1
+#define LRC_DIAG_COLLECT 2
+
 /**
  * @struct LRC_configDefaults
  * @brief Allowed types.
@@ -183,6 +328,398 @@ typedef struct {
   int attr;
 } LRC_configDefaults;
 
+/**
+ * @struct LRC_configIndex
+ * @brief Hash index of the config (open addressing).
+ *
+ * @param head
+ *   The indexed config.
+ *
+ * @param size
+ *   Number of slots (a power of two).
+ *
+ * @param count
+ *   Number of options.
+ *
+ * @param hashes
+ *   The hashes of the keys.
+ *
+ * @param spaces
+ *   The namespaces of the options.
+ *
+ * @param options
+ *   The options (NULL for free slots).
+ */
+typedef struct LRC_configIndex{
+  LRC_configNamespace* head;
+  size_t size;
+  size_t count;
+  uint64_t* hashes;
+  LRC_configNamespace** spaces;
+  LRC_configOptions** options;
+} LRC_configIndex;
+
+/**
+ * @struct LRC_overlayOption
+ * @brief Overridden value.
+ *
+ * @param option
+ *   The option of the base config (NULL for free slots).
+ *
+ * @param value
+ *   The value.
+ *
+ * @param type
+ *   The type of the value.
+ */
+typedef struct{
+  LRC_configOptions* option;
+  char* value;
+  int type;
+} LRC_overlayOption;
+
+/**
+ * @struct LRC_configOverlay
+ * @brief Sparse overrides of the shared base config.
+ *
+ * @param base
+ *   The index of the base config.
+ *
+ * @param size
+ *   Number of slots of the overrides table (a power of two, 0 if empty).
+ *
+ * @param count
+ *   Number of overrides.
+ *
+ * @param options
+ *   The overrides table, keyed by the base option.
+ */
+typedef struct LRC_configOverlay{
+  LRC_configIndex* base;
+  size_t size;
+  size_t count;
+  LRC_overlayOption* options;
+} LRC_configOverlay;
+
+/**
+ * @struct LRC_sweepColumn
+ * @brief Values of a single option across the tasks of the sweep.
+ *
+ * @param space
+ *   The namespace of the option (in the base config).
+ *
+ * @param option
+ *   The option of the base config.
+ *
+ * @param type
+ *   LRC_INT, LRC_LONG, LRC_FLOAT, LRC_DOUBLE or LRC_STRING.
+ *
+ * @param data
+ *   One value per task, contiguous (dictionary codes for strings).
+ */
+typedef struct{
+  LRC_configNamespace* space;
+  LRC_configOptions* option;
+  int type;
+  void* data;
+} LRC_sweepColumn;
+
+/**
+ * @struct LRC_configSweep
+ * @brief Columnar store of the tasks of a parameter sweep.
+ *
+ * @param base
+ *   The index of the base config.
+ *
+ * @param ntasks
+ *   Number of tasks.
+ *
+ * @param ncolumns
+ *   Number of swept options.
+ *
+ * @param columns
+ *   The swept options.
+ *
+ * @param nstrings
+ *   Number of strings in the dictionary.
+ *
+ * @param strings
+ *   The dictionary of string values.
+ *
+ * @param nslots
+ *   Size of the dictionary hash table (a power of two).
+ *
+ * @param slots
+ *   The dictionary hash table (codes, -1 for free slots).
+ */
+typedef struct LRC_configSweep{
+  LRC_configIndex* base;
+  size_t ntasks;
+  size_t ncolumns;
+  LRC_sweepColumn* columns;
+  size_t nstrings;
+  char** strings;
+  size_t nslots;
+  int* slots;
+} LRC_configSweep;
+
+/**
+ * @struct LRC_sweepDimension
+ * @brief Option with the range or the list value.
+ *
+ * @param space
+ *   The namespace of the option (in the base config).
+ *
+ * @param option
+ *   The option of the base config.
+ *
+ * @param kind
+ *   LRC_SWEEP_RANGE or LRC_SWEEP_LIST.
+ *
+ * @param count
+ *   Number of values.
+ *
+ * @param start
+ *   The first value of the range.
+ *
+ * @param stop
+ *   The last value of the range.
+ *
+ * @param step
+ *   The step of the range.
+ *
+ * @param scale
+ *   10^d, the values of the range are rounded to d decimal places of the
+ *   bounds (0 if not rounded).
+ *
+ * @param items
+ *   The values of the list.
+ */
+typedef struct{
+  LRC_configNamespace* space;
+  LRC_configOptions* option;
+  int kind;
+  size_t count;
+  double start;
+  double stop;
+  double step;
+  double scale;
+  char** items;
+} LRC_sweepDimension;
+
+/**
+ * @struct LRC_sweepIterator
+ * @brief Iterator over the Cartesian product of the sweep dimensions.
+ *
+ * @param base
+ *   The index of the base config.
+ *
+ * @param ndims
+ *   Number of dimensions.
+ *
+ * @param dims
+ *   The dimensions.
+ *
+ * @param ntasks
+ *   Number of tasks (the product of the dimension sizes).
+ *
+ * @param task
+ *   The next task.
+ *
+ * @param view
+ *   The config of the current task.
+ */
+typedef struct LRC_sweepIterator{
+  LRC_configIndex* base;
+  size_t ndims;
+  LRC_sweepDimension* dims;
+  size_t ntasks;
+  size_t task;
+  LRC_configOverlay* view;
+} LRC_sweepIterator;
+
+/**
+ * @brief Layers of the layered config, in the order of precedence (the
+ * later layer overrides the earlier ones).
+ */
+enum LRC_layer_type{
+  LRC_LAYER_DEFAULTS,
+  LRC_LAYER_SYSTEM,
+  LRC_LAYER_USER,
+  LRC_LAYER_ENV,
+  LRC_LAYER_CLI,
+  LRC_LAYERS
+};
+
+/**
+ * @struct LRC_configLoad
+ * @brief Handle of the config loaded in the background, see LRC_loadAsync().
+ */
+typedef struct LRC_configLoad LRC_configLoad;
+
+/**
+ * @struct LRC_configLayers
+ * @brief Layered config (defaults, system file, user file, environment,
+ * command line).
+ *
+ * @param defaults
+ *   The config of the defaults (the bottom layer).
+ *
+ * @param index
+ *   The index of the defaults.
+ *
+ * @param layers
+ *   The values of the upper layers, as overlays of the defaults (the
+ *   LRC_LAYER_DEFAULTS entry is NULL).
+ *
+ * @param masks
+ *   The layers that have the value of the option, a bit per layer, for each
+ *   slot of the index.
+ *
+ * @param env
+ *   The slots of the index keyed by the environment variable name (slot + 1,
+ *   0 for a free entry), index->size entries.
+ *
+ * @param scratch
+ *   The copy of the defaults the files are parsed into, made on the first
+ *   LRC_layerFile() and reused for the next ones.
+ */
+typedef struct LRC_configLayers{
+  LRC_configNamespace* defaults;
+  LRC_configIndex* index;
+  LRC_configOverlay* layers[LRC_LAYERS];
+  unsigned char* masks;
+  size_t* env;
+  LRC_configNamespace* scratch;
+} LRC_configLayers;
+
+/**
+ * @brief Phases timed by the statistics.
+ */
+enum LRC_phase_type{
+  LRC_PHASE_READ,
+  LRC_PHASE_TOKENIZE,
+  LRC_PHASE_LOOKUP,
+  LRC_PHASE_STORE,
+  LRC_PHASE_WRITE,
+  LRC_PHASE_HDF5,
+  LRC_PHASES
+};
+
+/**
+ * @struct LRC_stats
+ * @brief Counters and phase timers, see LRC_getStats().
+ *
+ * @param lines
+ *   Lines read by the parsers.
+ *
+ * @param bytes
+ *   Bytes read by the parsers.
+ *
+ * @param allocations
+ *   Allocations of the config data (namespaces, options, arrays, buffers).
+ *
+ * @param allocated
+ *   Bytes allocated by these allocations.
+ *
+ * @param lookups
+ *   Searches of namespaces and options (lists and index).
+ *
+ * @param probes
+ *   Entries compared by the searches (probes / lookups is the average probe
+ *   length).
+ *
+ * @param conversions
+ *   Conversions by the typed getters and setters.
+ *
+ * @param time
+ *   Time spent in each phase, in nanoseconds.
+ */
+typedef struct LRC_stats{
+  uint64_t lines;
+  uint64_t bytes;
+  uint64_t allocations;
+  uint64_t allocated;
+  uint64_t lookups;
+  uint64_t probes;
+  uint64_t conversions;
+  uint64_t time[LRC_PHASES];
+} LRC_stats;
+
+enum LRC_sweep_kind{
+  LRC_SWEEP_RANGE,
+  LRC_SWEEP_LIST
+};
+
+/**
+ * @brief Comparisons for LRC_sweepSelect().
+ */
+enum LRC_sweep_compare{
+  LRC_SWEEP_LT,
+  LRC_SWEEP_LE,
+  LRC_SWEEP_GT,
+  LRC_SWEEP_GE,
+  LRC_SWEEP_EQ,
+  LRC_SWEEP_NE
+};
+
+/**
+ * @brief Kinds of the differences, see LRC_diff().
+ */
+enum LRC_diff_op{
+  LRC_DIFF_ADDED = 1,
+  LRC_DIFF_REMOVED,
+  LRC_DIFF_CHANGED
+};
+
+/**
+ * @struct LRC_diffEntry
+ * @brief Difference of a single option.
+ *
+ * @param op
+ *   LRC_DIFF_ADDED, LRC_DIFF_REMOVED or LRC_DIFF_CHANGED.
+ *
+ * @param type
+ *   The new type of the option (not used for removed options).
+ *
+ * @param space
+ *   The namespace of the option. The namespace, the name and the value are
+ *   kept in a single allocation, which starts here.
+ *
+ * @param name
+ *   The name of the option.
+ *
+ * @param value
+ *   The new value, as text (empty for removed options).
+ */
+typedef struct{
+  int op;
+  int type;
+  char* space;
+  char* name;
+  char* value;
+} LRC_diffEntry;
+
+/**
+ * @struct LRC_configDiff
+ * @brief Differences between two configs, see LRC_diff().
+ *
+ * @param count
+ *   Number of the differences.
+ *
+ * @param size
+ *   Number of the allocated entries.
+ *
+ * @param entries
+ *   The differences: the removed and changed options in the order of the
+ *   first config, then the added ones in the order of the second config.
+ */
+typedef struct LRC_configDiff{
+  size_t count;
+  size_t size;
+  LRC_diffEntry* entries;
+} LRC_configDiff;
+
 /**
  * Public API
  */
@@ -197,18 +734,118 @@ void LRC_printAll(LRC_configNamespace* head);
 /* Parsers and writers */
 int LRC_ASCIIParser(FILE* file, char* sep, char* comm, LRC_configNamespace* head);
 int LRC_ASCIIWriter(FILE* file, char* sep, char* comm, LRC_configNamespace* head);
+int LRC_ASCIIWriteFile(char* path, char* sep, char* comm, LRC_configNamespace* head);
+char* LRC_ASCIIWriteBuffer(char* sep, char* comm, LRC_configNamespace* head, size_t* len);
+int LRC_ASCIIUpdateFile(char* path, LRC_configNamespace* head);
+int LRC_ASCIIParseFile(char* path, char* sep, char* comm, LRC_configNamespace* head);
+
+/* Background loading */
+LRC_configLoad* LRC_loadAsync(char* path, char* sep, char* comm, LRC_configDefaults* cd);
+LRC_configNamespace* LRC_wait(LRC_configLoad* load);
+int LRC_tryGet(LRC_configLoad* load, LRC_configNamespace** head);
+
+/* Diagnostics */
+int LRC_setDiagnostics(LRC_configNamespace* head, LRC_diagnosticHandler handler, void* data,
+    int limit, int flags);
+int LRC_diagnosticCount(LRC_configNamespace* head);
+void LRC_printDiagnostic(LRC_diagnostic* diagnostic, void* data);
+void LRC_message(int line, int type, char* message);
 
 /* Search and modify */
 LRC_configNamespace* LRC_findNamespace(char* space, LRC_configNamespace* head);
 LRC_configOptions* LRC_findOption(char* var, LRC_configNamespace* current);
 LRC_configOptions* LRC_modifyOption(char* space, char* var, char* value, int type, LRC_configNamespace* head);
+LRC_configOptions* LRC_setInt(char* space, char* var, int value, LRC_configNamespace* head);
+LRC_configOptions* LRC_setLong(char* space, char* var, long value, LRC_configNamespace* head);
+LRC_configOptions* LRC_setFloat(char* space, char* var, float value, LRC_configNamespace* head);
+LRC_configOptions* LRC_setDouble(char* space, char* var, double value, LRC_configNamespace* head);
+LRC_configOptions* LRC_setLdouble(char* space, char* var, long double value, LRC_configNamespace* head);
+LRC_configOptions* LRC_setIntArray(char* space, char* var, int* values, size_t count, LRC_configNamespace* head);
+LRC_configOptions* LRC_setDoubleArray(char* space, char* var, double* values, size_t count, LRC_configNamespace* head);
 int LRC_allOptions(LRC_configNamespace* head);
 int LRC_countOptions(char* space, LRC_configNamespace* head);
 char* LRC_getOptionValue(char* space, char* var, LRC_configNamespace* current);
 int LRC_countDefaultOptions(LRC_configDefaults *in);
 int LRC_mergeDefaults(LRC_configDefaults *in, LRC_configDefaults *add);
+int LRC_readDefaults(FILE* file, LRC_configDefaults** cd);
 LRC_configDefaults* LRC_head2struct(LRC_configNamespace *head);
 int LRC_head2struct_noalloc(LRC_configNamespace *head, LRC_configDefaults *c);
+LRC_configNamespace* LRC_copyConfig(LRC_configNamespace* head);
+
+/* Index and overlays */
+LRC_configIndex* LRC_indexConfig(LRC_configNamespace* head);
+LRC_configOptions* LRC_indexFind(LRC_configIndex* index, char* space, char* var);
+void LRC_freeIndex(LRC_configIndex* index);
+LRC_configOverlay* LRC_newOverlay(LRC_configIndex* base);
+int LRC_overlaySet(LRC_configOverlay* overlay, char* space, char* var, char* value, int type);
+char* LRC_overlayGet(LRC_configOverlay* overlay, char* space, char* var, int* type);
+int LRC_overlayGetInt(LRC_configOverlay* overlay, char* space, char* var, int* value);
+int LRC_overlayGetLong(LRC_configOverlay* overlay, char* space, char* var, long* value);
+int LRC_overlayGetFloat(LRC_configOverlay* overlay, char* space, char* var, float* value);
+int LRC_overlayGetDouble(LRC_configOverlay* overlay, char* space, char* var, double* value);
+LRC_configNamespace* LRC_overlay2config(LRC_configOverlay* overlay);
+void LRC_freeOverlay(LRC_configOverlay* overlay);
+
+/* Diff and patch */
+LRC_configDiff* LRC_diff(LRC_configNamespace* a, LRC_configNamespace* b);
+int LRC_applyPatch(LRC_configNamespace* head, LRC_configDiff* diff);
+char* LRC_diffPack(LRC_configDiff* diff, size_t* len);
+LRC_configDiff* LRC_diffUnpack(char* buf, size_t len);
+int LRC_diffWriteFile(char* path, LRC_configDiff* diff);
+LRC_configDiff* LRC_diffReadFile(char* path);
+void LRC_freeDiff(LRC_configDiff* diff);
+
+/* Fingerprint */
+uint64_t LRC_hash(LRC_configNamespace* head);
+void LRC_hash128(LRC_configNamespace* head, uint64_t* hash);
+
+/* Interpolation */
+int LRC_interpolate(LRC_configNamespace* head);
+
+/* Layered config */
+LRC_configLayers* LRC_newLayers(LRC_configDefaults* cd);
+int LRC_layerSet(LRC_configLayers* layers, int layer, char* space, char* var, char* value);
+int LRC_layerFile(LRC_configLayers* layers, int layer, char* path, char* sep, char* comm);
+int LRC_layerEnv(LRC_configLayers* layers);
+char* LRC_layerGet(LRC_configLayers* layers, char* space, char* var, int* layer);
+int LRC_layerSource(LRC_configLayers* layers, char* space, char* var);
+char* LRC_layerName(int layer);
+int LRC_layerGetInt(LRC_configLayers* layers, char* space, char* var, int* value);
+int LRC_layerGetLong(LRC_configLayers* layers, char* space, char* var, long* value);
+int LRC_layerGetFloat(LRC_configLayers* layers, char* space, char* var, float* value);
+int LRC_layerGetDouble(LRC_configLayers* layers, char* space, char* var, double* value);
+LRC_configNamespace* LRC_layers2config(LRC_configLayers* layers);
+void LRC_freeLayers(LRC_configLayers* layers);
+
+/* Command line */
+struct poptOption* LRC_poptTable(LRC_configDefaults* cd, LRC_configNamespace* head);
+struct poptOption* LRC_poptLayerTable(LRC_configDefaults* cd, LRC_configLayers* layers);
+int LRC_poptErrors(struct poptOption* table);
+
+/* Parameter sweeps */
+LRC_configSweep* LRC_newSweep(LRC_configIndex* base, size_t ntasks);
+int LRC_sweepAddColumn(LRC_configSweep* sweep, char* space, char* var);
+int LRC_sweepFind(LRC_configSweep* sweep, char* space, char* var);
+int LRC_sweepSet(LRC_configSweep* sweep, size_t task, int column, char* value);
+void* LRC_sweepColumnData(LRC_configSweep* sweep, int column, int* type);
+char* LRC_sweepString(LRC_configSweep* sweep, int code);
+int LRC_sweepFormat(LRC_configSweep* sweep, size_t task, int column, char* str);
+LRC_configOverlay* LRC_sweepTask(LRC_configSweep* sweep, size_t task);
+size_t LRC_sweepSelect(LRC_configSweep* sweep, int column, int op, double x, size_t* tasks);
+size_t LRC_sweepSelectString(LRC_configSweep* sweep, int column, char* value, size_t* tasks);
+void LRC_freeSweep(LRC_configSweep* sweep);
+LRC_sweepIterator* LRC_newSweepIterator(LRC_configIndex* base);
+int LRC_sweepValue(LRC_sweepIterator* it, size_t task, size_t dim, char* str);
+LRC_configOverlay* LRC_sweepSeek(LRC_sweepIterator* it, size_t task);
+LRC_configOverlay* LRC_sweepNext(LRC_sweepIterator* it);
+LRC_configSweep* LRC_sweepExpand(LRC_sweepIterator* it, size_t first, size_t count);
+void LRC_freeSweepIterator(LRC_sweepIterator* it);
+
+/* Statistics */
+LRC_stats LRC_getStats(LRC_configNamespace* head);
+void LRC_resetStats(LRC_configNamespace* head);
+char* LRC_phaseName(int phase);
+void LRC_printStats(LRC_stats* stats);
 
 /* Converters */
 int LRC_option2int(char* space, char* var, LRC_configNamespace* head);
@@ -216,6 +853,21 @@ float LRC_option2float(char* space, char* var, LRC_configNamespace* head);
 double LRC_option2double(char* space, char* var, LRC_configNamespace* head);
 long double LRC_option2Ldouble(char* space, char* var, LRC_configNamespace* head);
 int LRC_itoa(char* deststr, int value, int type);
+int LRC_float2str(char* str, float value);
+int LRC_double2str(char* str, double value);
+int LRC_Ldouble2str(char* str, long double value);
+int LRC_str2int(char* str, int* value);
+int LRC_str2long(char* str, long* value);
+int LRC_str2float(char* str, float* value);
+int LRC_str2double(char* str, double* value);
+int LRC_str2Ldouble(char* str, long double* value);
+int LRC_getInt(char* space, char* var, int* value, LRC_configNamespace* head);
+int LRC_getLong(char* space, char* var, long* value, LRC_configNamespace* head);
+int LRC_getFloat(char* space, char* var, float* value, LRC_configNamespace* head);
+int LRC_getDouble(char* space, char* var, double* value, LRC_configNamespace* head);
+int LRC_getLdouble(char* space, char* var, long double* value, LRC_configNamespace* head);
+long LRC_getIntArray(char* space, char* var, int* values, size_t size, LRC_configNamespace* head);
+long LRC_getDoubleArray(char* space, char* var, double* values, size_t size, LRC_configNamespace* head);
 char* LRC_trim(char*);
 
 #define LRC_OPTIONS_END {.space="", .name="", .shortName='\0', .value="", .description="", .type=0}
@@ -0,0 +1,338 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_async.c
+ * @brief Loading of the config in the background.
+ *
+ * LRC_loadAsync() starts a thread which builds the config from the defaults
+ * and parses the file into it, so that the latency of slow (shared) file
+ * systems overlaps with the rest of the initialization. The result is
+ * collected with LRC_wait() or, without blocking, with LRC_tryGet().
+ * LRC_loadAsyncHDF5() does the same for the config group of an HDF5 file.
+ *
+ * The loading thread works on its own config only. The errors go to the
+ * global diagnostics (the config does not exist yet), and its work is counted
+ * in the global statistics (LRC_STATS).
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @fn void LRC_loadRun(LRC_configLoad* load)
+ * @brief Builds the config and parses the file (the body of the thread).
+ */
+void LRC_loadRun(LRC_configLoad* load){
+
+  LRC_configNamespace* head = NULL;
+  int status = -1;
+
+  head = LRC_assignDefaults(load->cd);
+  if (head) {
+    if (!load->group) {
+      status = LRC_ASCIIParseFile(load->path, load->sep, load->comm, head);
+    }
+#if HAVE_HDF5_H
+    else {
+      status = LRC_HDF5ParseFile(load->path, load->group, head);
+    }
+#endif
+    if (status < 0) {
+      LRC_cleanup(head);
+      head = NULL;
+    }
+  }
+
+  pthread_mutex_lock(&load->lock);
+  load->head = head;
+  load->done = 1;
+  pthread_mutex_unlock(&load->lock);
+}
+
+/**
+ * @fn void* LRC_loadThread(void* arg)
+ * @brief The loading thread.
+ */
+void* LRC_loadThread(void* arg){
+  LRC_loadRun((LRC_configLoad*) arg);
+  return NULL;
+}
+
+/**
+ * @fn LRC_configLoad* LRC_loadAsync(char* path, char* sep, char* comm, LRC_configDefaults* cd)
+ * @brief Starts loading the ASCII config file in the background.
+ *
+ * The config is built with LRC_assignDefaults() and the file is parsed with
+ * LRC_ASCIIParseFile(), in a new thread. The path, the separator and the
+ * comment mark are copied, the defaults must stay valid until the result is
+ * collected. If the thread cannot be started, the config is loaded before
+ * returning.
+ *
+ * @param path
+ *  The config file
+ *
+ * @param sep
+ *  The separator
+ *
+ * @param comm
+ *  The comment mark
+ *
+ * @param cd
+ *  The defaults
+ *
+ * @return
+ *  The handle to be passed to LRC_wait() or LRC_tryGet(), NULL on failure
+ */
+LRC_configLoad* LRC_loadAsync(char* path, char* sep, char* comm, LRC_configDefaults* cd){
+
+  LRC_configLoad* load = NULL;
+  size_t plen, slen, clen;
+  int status;
+
+  if (!path || !sep || !comm || !cd) return NULL;
+
+  plen = strlen(path) + 1;
+  slen = strlen(sep) + 1;
+  clen = strlen(comm) + 1;
+
+  load = calloc(1, sizeof(LRC_configLoad));
+  if (!load) goto failure;
+
+  /* One allocation for the three strings */
+  load->path = malloc(plen + slen + clen);
+  if (!load->path) goto failure;
+
+  load->sep = load->path + plen;
+  load->comm = load->sep + slen;
+  memcpy(load->path, path, plen);
+  memcpy(load->sep, sep, slen);
+  memcpy(load->comm, comm, clen);
+  load->cd = cd;
+
+  status = pthread_mutex_init(&load->lock, NULL);
+  if (status != 0) {
+    errno = status;
+    perror("LRC_loadAsync: mutex init failed");
+    goto cleanup;
+  }
+
+  if (pthread_create(&load->thread, NULL, LRC_loadThread, load) == 0) {
+    load->threaded = 1;
+  } else {
+    LRC_loadRun(load);
+  }
+
+  return load;
+
+failure:
+  perror("LRC_loadAsync: alloc failed");
+cleanup:
+  if (load) {
+    if (load->path) free(load->path);
+    free(load);
+  }
+  return NULL;
+}
+
+#if HAVE_HDF5_H
+/**
+ * @fn int LRC_HDF5ParseFile(char* path, char* group, LRC_configNamespace* head)
+ * @brief Opens the HDF5 file read-only and reads the config group,
+ * @see LRC_HDF5Parser().
+ *
+ * @return
+ *  Number of read namespaces or -1 on failure
+ */
+int LRC_HDF5ParseFile(char* path, char* group, LRC_configNamespace* head){
+
+  hid_t file;
+  int status;
+
+  file = H5Fopen(path, H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (file < 0) {
+    LRC_report(head, LRC_ERR_FILE_OPEN, 0, 0, NULL, NULL, path);
+    status = -1;
+  } else {
+    status = LRC_HDF5Parser(file, group, head);
+    H5Fclose(file);
+  }
+
+  /* The error stack is per thread, and the loading thread ends after this */
+  if (status < 0) H5Eclear2(H5E_DEFAULT);
+
+  return status;
+}
+
+/**
+ * @fn LRC_configLoad* LRC_loadAsyncHDF5(char* path, char* group_name, LRC_configDefaults* cd)
+ * @brief Starts loading the config group of the HDF5 file in the background.
+ *
+ * The config is built with LRC_assignDefaults() and the group is read with
+ * LRC_HDF5Parser(), from the file opened read-only. The path and the name of
+ * the group are copied, the defaults must stay valid until the result is
+ * collected.
+ *
+ * The HDF5 library may be called from another thread only if it is built
+ * thread-safe (H5_HAVE_THREADSAFE). Otherwise, as when the thread cannot be
+ * started, the config is loaded before returning.
+ *
+ * @param path
+ *  The HDF5 file
+ *
+ * @param group_name
+ *  Name of the config group
+ *
+ * @param cd
+ *  The defaults
+ *
+ * @return
+ *  The handle to be passed to LRC_wait() or LRC_tryGet(), NULL on failure
+ */
+LRC_configLoad* LRC_loadAsyncHDF5(char* path, char* group_name, LRC_configDefaults* cd){
+
+  LRC_configLoad* load = NULL;
+  size_t plen, glen;
+  int status;
+
+  if (!path || !group_name || !cd) return NULL;
+
+  plen = strlen(path) + 1;
+  glen = strlen(group_name) + 1;
+
+  load = calloc(1, sizeof(LRC_configLoad));
+  if (!load) goto failure;
+
+  load->path = malloc(plen + glen);
+  if (!load->path) goto failure;
+
+  load->group = load->path + plen;
+  memcpy(load->path, path, plen);
+  memcpy(load->group, group_name, glen);
+  load->cd = cd;
+
+  status = pthread_mutex_init(&load->lock, NULL);
+  if (status != 0) {
+    errno = status;
+    perror("LRC_loadAsyncHDF5: mutex init failed");
+    goto cleanup;
+  }
+
+#ifdef H5_HAVE_THREADSAFE
+  if (pthread_create(&load->thread, NULL, LRC_loadThread, load) == 0) {
+    load->threaded = 1;
+  } else {
+    LRC_loadRun(load);
+  }
+#else
+  LRC_loadRun(load);
+#endif
+
+  return load;
+
+failure:
+  perror("LRC_loadAsyncHDF5: alloc failed");
+cleanup:
+  if (load) {
+    if (load->path) free(load->path);
+    free(load);
+  }
+  return NULL;
+}
+#endif
+
+/**
+ * @fn LRC_configNamespace* LRC_wait(LRC_configLoad* load)
+ * @brief Waits for the config loaded in the background.
+ *
+ * The handle is freed.
+ *
+ * @param load
+ *  The handle of LRC_loadAsync() or LRC_loadAsyncHDF5()
+ *
+ * @return
+ *  The config, NULL if it could not be loaded (the errors have been reported)
+ */
+LRC_configNamespace* LRC_wait(LRC_configLoad* load){
+
+  LRC_configNamespace* head = NULL;
+
+  if (!load) return NULL;
+
+  if (load->threaded) pthread_join(load->thread, NULL);
+
+  head = load->head;
+  pthread_mutex_destroy(&load->lock);
+  free(load->path);
+  free(load);
+
+  return head;
+}
+
+/**
+ * @fn int LRC_tryGet(LRC_configLoad* load, LRC_configNamespace** head)
+ * @brief Collects the config loaded in the background, if it is ready.
+ *
+ * Does not block. Once the result is collected, the handle is freed.
+ *
+ * @param load
+ *  The handle of LRC_loadAsync() or LRC_loadAsyncHDF5()
+ *
+ * @param head
+ *  The config, NULL until it is loaded or if it could not be loaded
+ *
+ * @return
+ *  1 if the config is loaded, 0 if it is still loading (the handle stays
+ *  valid), -1 if it could not be loaded
+ */
+int LRC_tryGet(LRC_configLoad* load, LRC_configNamespace** head){
+
+  int done;
+
+  *head = NULL;
+  if (!load) return -1;
+
+  pthread_mutex_lock(&load->lock);
+  done = load->done;
+  pthread_mutex_unlock(&load->lock);
+
+  if (!done) return 0;
+
+  *head = LRC_wait(load);
+  return *head ? 1 : -1;
+}
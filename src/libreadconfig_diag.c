@@ -0,0 +1,356 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_diag.c
+ * @brief Structured diagnostics: handlers, rate limiting, deduplication.
+ *
+ * The errors are passed as LRC_diagnostic records to the handler of the config
+ * (LRC_setDiagnostics()), or to the global handler, which by default prints
+ * them to stderr (LRC_printDiagnostic()). The errors with no config at hand
+ * always go to the global handler.
+ *
+ * Each config may limit the number of reported errors (the first suppressed
+ * one is reported as LRC_ERR_LIMIT) and report the same problem once. In the
+ * collect mode the parsers go on after an error and fail at the end, so all
+ * problems of the file are reported in one pass.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+static LRC_diagnosticHandler globalHandler = NULL;
+static void* globalData = NULL;
+
+/**
+ * @fn LRC_configDiag* LRC_diagOf(LRC_configNamespace* head)
+ * @brief Diagnostics state of the config, allocated on first use.
+ *
+ * @return
+ *  The state or NULL (no config, or the allocation failed)
+ */
+LRC_configDiag* LRC_diagOf(LRC_configNamespace* head){
+
+  if (!head) return NULL;
+
+  if (!head->diag) head->diag = calloc(1, sizeof(LRC_configDiag));
+
+  return head->diag;
+}
+
+/**
+ * @fn char* LRC_diagTitle(int type)
+ * @brief The title of the error type, NULL for the types that are not printed.
+ */
+char* LRC_diagTitle(int type){
+
+  switch (type) {
+    case LRC_ERR_CONFIG_SYNTAX:
+      return LRC_MSG_CONFIG_SYNTAX;
+    case LRC_ERR_FILE_OPEN:
+      return LRC_MSG_FILE_OPEN;
+    case LRC_ERR_FILE_CLOSE:
+      return LRC_MSG_FILE_CLOSE;
+    case LRC_ERR_WRONG_INPUT:
+      return LRC_MSG_WRONG_INPUT;
+    case LRC_ERR_HDF:
+      return LRC_MSG_HDF;
+    case LRC_ERR_LIMIT:
+      return LRC_MSG_LIMIT;
+    case LRC_ERR_MPI:
+      return LRC_MSG_MPI;
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * @fn int LRC_diagSeen(LRC_configDiag* diag, uint64_t h)
+ * @brief Adds the problem to the set of the reported ones.
+ *
+ * @return
+ *  1 if the problem was already reported, 0 otherwise
+ */
+int LRC_diagSeen(LRC_configDiag* diag, uint64_t h){
+
+  uint64_t* seen = NULL;
+  size_t size, i, slot;
+
+  /* 0 marks free slots */
+  h |= 1;
+
+  if (2 * (diag->nseen + 1) > diag->size) {
+    size = diag->size > 0 ? 2 * diag->size : 64;
+    seen = calloc(size, sizeof(uint64_t));
+    if (!seen) return 0;
+
+    for (i = 0; i < diag->size; i++) {
+      if (!diag->seen[i]) continue;
+      slot = (size_t)diag->seen[i] & (size - 1);
+      while (seen[slot]) slot = (slot + 1) & (size - 1);
+      seen[slot] = diag->seen[i];
+    }
+
+    if (diag->seen) free(diag->seen);
+    diag->seen = seen;
+    diag->size = size;
+  }
+
+  slot = (size_t)h & (diag->size - 1);
+  while (diag->seen[slot]) {
+    if (diag->seen[slot] == h) return 1;
+    slot = (slot + 1) & (diag->size - 1);
+  }
+
+  diag->seen[slot] = h;
+  diag->nseen++;
+
+  return 0;
+}
+
+/**
+ * @fn void LRC_report(LRC_configNamespace* head, int type, int line, int column, char* space, char* name, char* message)
+ * @brief Reports the error to the handler of the config.
+ *
+ * @param head
+ *  The config (NULL for the global handler)
+ *
+ * @param type
+ *  Type of the error, LRC_ERR_*
+ *
+ * @param line
+ *  The line in the config file (0 if not known)
+ *
+ * @param column
+ *  The column in the line (0 if not known)
+ *
+ * @param space
+ *  The namespace (NULL if not known)
+ *
+ * @param name
+ *  The option (NULL if not known)
+ *
+ * @param message
+ *  The message
+ */
+void LRC_report(LRC_configNamespace* head, int type, int line, int column,
+    char* space, char* name, char* message){
+
+  LRC_configDiag* diag = NULL;
+  LRC_diagnosticHandler handler = NULL;
+  LRC_diagnostic d;
+  void* data = NULL;
+  uint64_t h;
+
+  d.code = type;
+  d.message = message;
+  d.file = NULL;
+  d.line = line;
+  d.column = column;
+  d.space = space;
+  d.name = name;
+
+  diag = LRC_diagOf(head);
+  if (diag) {
+    diag->total++;
+    d.file = diag->file;
+
+    if (diag->flags & LRC_DIAG_DEDUP) {
+      h = LRC_hashKey(space ? space : "", name ? name : "");
+      h = (h ^ LRC_hashKey(message ? message : "", "")) * 31 + (uint64_t)type;
+      if (LRC_diagSeen(diag, h)) return;
+    }
+
+    if (diag->limit > 0 && diag->reported >= diag->limit) {
+      if (diag->reported > diag->limit) return;
+
+      /* Once, for the first suppressed error */
+      d.code = LRC_ERR_LIMIT;
+      d.message = LRC_MSG_LIMIT;
+      d.column = 0;
+      d.space = NULL;
+      d.name = NULL;
+    }
+
+    diag->reported++;
+    handler = diag->handler;
+    data = diag->data;
+  }
+
+  if (!handler) {
+    handler = globalHandler;
+    data = globalData;
+  }
+
+  if (handler) {
+    handler(&d, data);
+  } else {
+    LRC_printDiagnostic(&d, NULL);
+  }
+}
+
+/**
+ * @fn int LRC_diagCollect(LRC_configNamespace* head)
+ * @brief Whether the parsers go on after an error (collect mode).
+ */
+int LRC_diagCollect(LRC_configNamespace* head){
+  return head && head->diag && (head->diag->flags & LRC_DIAG_COLLECT);
+}
+
+/**
+ * @fn int LRC_setDiagnostics(LRC_configNamespace* head, LRC_diagnosticHandler handler, void* data, int limit, int flags)
+ * @brief Sets the diagnostic handler of the config.
+ *
+ * @param head
+ *  The config, or NULL for the global handler (used for the configs with no
+ *  handler and for the errors with no config, limit and flags are ignored)
+ *
+ * @param handler
+ *  The handler, NULL for the default one (the global handler, or
+ *  LRC_printDiagnostic() to stderr)
+ *
+ * @param data
+ *  Passed to the handler
+ *
+ * @param limit
+ *  Maximum number of reported errors, 0 for no limit
+ *
+ * @param flags
+ *  LRC_DIAG_DEDUP, LRC_DIAG_COLLECT, or 0
+ *
+ * @return
+ *  0 on success, -1 on failure
+ */
+int LRC_setDiagnostics(LRC_configNamespace* head, LRC_diagnosticHandler handler, void* data,
+    int limit, int flags){
+
+  LRC_configDiag* diag = NULL;
+
+  if (!head) {
+    globalHandler = handler;
+    globalData = data;
+    return 0;
+  }
+
+  diag = LRC_diagOf(head);
+  if (!diag) {
+    perror("LRC_setDiagnostics: alloc failed");
+    return -1;
+  }
+
+  diag->handler = handler;
+  diag->data = data;
+  diag->limit = limit > 0 ? limit : 0;
+  diag->flags = flags;
+  diag->reported = 0;
+  diag->total = 0;
+
+  if (diag->seen) free(diag->seen);
+  diag->seen = NULL;
+  diag->nseen = 0;
+  diag->size = 0;
+
+  return 0;
+}
+
+/**
+ * @fn int LRC_diagnosticCount(LRC_configNamespace* head)
+ * @brief Number of errors of the config, also the suppressed ones.
+ */
+int LRC_diagnosticCount(LRC_configNamespace* head){
+
+  if (!head || !head->diag) return 0;
+
+  return head->diag->total;
+}
+
+/**
+ * @fn void LRC_printDiagnostic(LRC_diagnostic* diagnostic, void* data)
+ * @brief Prints the record, i.e. "Config file syntax error at line 3, column 1
+ * of run.cfg: Unknown variable (physics.dt)".
+ *
+ * The location is left out for the records without a line (line 0).
+ *
+ * @param data
+ *  The stream (stderr if NULL)
+ */
+void LRC_printDiagnostic(LRC_diagnostic* diagnostic, void* data){
+
+  FILE* out = data ? (FILE*)data : stderr;
+  char* title;
+
+  title = LRC_diagTitle(diagnostic->code);
+  if (!title) return;
+
+  if (diagnostic->code == LRC_ERR_LIMIT) {
+    fprintf(out, "%s\n", title);
+    return;
+  }
+
+  /* Errors of the whole file (open, HDF5 and the like) have no line */
+  fprintf(out, "%s", title);
+  if (diagnostic->line > 0) {
+    fprintf(out, " at line %d", diagnostic->line);
+    if (diagnostic->column > 0) fprintf(out, ", column %d", diagnostic->column);
+    if (diagnostic->file) fprintf(out, " of %s", diagnostic->file);
+  } else if (diagnostic->file) {
+    fprintf(out, " in %s", diagnostic->file);
+  }
+  fprintf(out, ": %s", diagnostic->message);
+
+  if (diagnostic->name) {
+    fprintf(out, " (%s%s%s)", diagnostic->space ? diagnostic->space : "",
+        diagnostic->space ? "." : "", diagnostic->name);
+  } else if (diagnostic->space) {
+    fprintf(out, " ([%s])", diagnostic->space);
+  }
+
+  fprintf(out, "\n");
+}
+
+/**
+ * @fn void LRC_freeDiag(LRC_configDiag* diag)
+ * @brief Frees the diagnostics state.
+ */
+void LRC_freeDiag(LRC_configDiag* diag){
+
+  if (!diag) return;
+
+  if (diag->seen) free(diag->seen);
+  free(diag);
+}
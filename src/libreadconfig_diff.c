@@ -0,0 +1,796 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_diff.c
+ * @brief Structural diff and patch of configs.
+ *
+ * LRC_diff() indexes the second config (see LRC_indexConfig()) and walks the
+ * first one: every option is looked up with one hash probe and marked in the
+ * index, the unmarked options of the second config are the added ones. The
+ * diff is O(n) in the number of options of both configs.
+ *
+ * The values are compared by type: numbers by their value, so that 1.0 and
+ * 1.00 are the same double, arrays element by element, strings as text.
+ *
+ * The patch is stored in a compact, portable binary format. All integers are
+ * unsigned LEB128 varints and the values are kept as text (arrays in the
+ * shortest form which reads back exactly):
+ *
+ *     "LRCP" version count             count of the option records
+ *     0 len namespace                  following records are in this namespace
+ *     op len name [type len value]     the value for added and changed options
+ *
+ * where op is one of LRC_DIFF_ADDED, LRC_DIFF_REMOVED, LRC_DIFF_CHANGED.
+ */
+
+/* fileno */
+#define _POSIX_C_SOURCE 200809L
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @def LRC_PATCH_MAGIC
+ * @brief The first bytes of the patch.
+ *
+ * @def LRC_PATCH_VERSION
+ * @brief Version of the patch format.
+ */
+#define LRC_PATCH_MAGIC "LRCP"
+#define LRC_PATCH_VERSION 1
+
+/**
+ * @fn int LRC_diffSame(LRC_configOptions* x, LRC_configOptions* y)
+ * @brief Compares the typed values of the options.
+ *
+ * @return
+ *  1 if the values are the same, 0 otherwise
+ */
+int LRC_diffSame(LRC_configOptions* x, LRC_configOptions* y){
+
+  long lx, ly;
+  float fx, fy;
+  double dx, dy;
+  size_t i;
+
+  if (x->type != y->type) return 0;
+
+  /* The floating point elements are compared as LRC_hash() sees them: -0.0
+   * equals 0.0 and all NaNs are the same */
+  if (LRC_isArray(x->type)) {
+    if (x->count != y->count) return 0;
+    for (i = 0; i < x->count; i++) {
+      if (x->type == LRC_INT_ARRAY) {
+        if (((int*)x->array)[i] != ((int*)y->array)[i]) return 0;
+        continue;
+      }
+      dx = ((double*)x->array)[i];
+      dy = ((double*)y->array)[i];
+      if (dx != dy && (dx == dx || dy == dy)) return 0;
+    }
+    return 1;
+  }
+
+  switch (x->type) {
+    case LRC_INT:
+    case LRC_VAL:
+    case LRC_LONG:
+      if (LRC_str2long(x->value, &lx) == LRC_NUMBER_OK
+          && LRC_str2long(y->value, &ly) == LRC_NUMBER_OK) return lx == ly;
+      break;
+    case LRC_FLOAT:
+      if (LRC_str2float(x->value, &fx) == LRC_NUMBER_OK
+          && LRC_str2float(y->value, &fy) == LRC_NUMBER_OK) return fx == fy || (fx != fx && fy != fy);
+      break;
+    case LRC_DOUBLE:
+      if (LRC_str2double(x->value, &dx) == LRC_NUMBER_OK
+          && LRC_str2double(y->value, &dy) == LRC_NUMBER_OK) return dx == dy || (dx != dx && dy != dy);
+      break;
+    default:
+      break;
+  }
+
+  return strcmp(x->value, y->value) == 0;
+}
+
+/**
+ * @fn LRC_diffEntry* LRC_diffAppend(LRC_configDiff* diff, int op, int type, char* space, size_t slen, char* name, size_t nlen, char* value, size_t vlen)
+ * @brief Appends the difference (the strings are copied).
+ *
+ * @return
+ *  The entry or NULL on failure
+ */
+LRC_diffEntry* LRC_diffAppend(LRC_configDiff* diff, int op, int type, char* space, size_t slen,
+    char* name, size_t nlen, char* value, size_t vlen){
+
+  LRC_diffEntry* entries = NULL;
+  LRC_diffEntry* entry = NULL;
+  char* p = NULL;
+  size_t size;
+
+  if (diff->count == diff->size) {
+    size = diff->size ? 2 * diff->size : 16;
+    entries = realloc(diff->entries, size * sizeof(LRC_diffEntry));
+    if (!entries) {
+      perror("LRC_diffAppend: alloc failed");
+      return NULL;
+    }
+    diff->entries = entries;
+    diff->size = size;
+  }
+
+  p = malloc(slen + nlen + vlen + 3);
+  if (!p) {
+    perror("LRC_diffAppend: alloc failed");
+    return NULL;
+  }
+
+  entry = &diff->entries[diff->count++];
+  entry->op = op;
+  entry->type = type;
+
+  entry->space = p;
+  memcpy(p, space, slen);
+  p[slen] = LRC_NULL;
+
+  entry->name = p + slen + 1;
+  memcpy(entry->name, name, nlen);
+  entry->name[nlen] = LRC_NULL;
+
+  entry->value = entry->name + nlen + 1;
+  if (vlen > 0) memcpy(entry->value, value, vlen);
+  entry->value[vlen] = LRC_NULL;
+
+  return entry;
+}
+
+/**
+ * @fn LRC_diffEntry* LRC_diffOption(LRC_configDiff* diff, int op, char* space, LRC_configOptions* option)
+ * @brief Appends the difference of the option, with its value for added and
+ * changed options.
+ *
+ * @return
+ *  The entry or NULL on failure
+ */
+LRC_diffEntry* LRC_diffOption(LRC_configDiff* diff, int op, char* space, LRC_configOptions* option){
+
+  LRC_buffer buf = {NULL, 0, 0};
+  LRC_diffEntry* entry = NULL;
+  char* value = option->value;
+  size_t vlen;
+
+  if (op == LRC_DIFF_REMOVED) {
+    value = "";
+  } else if (LRC_isArray(option->type)) {
+    if (LRC_formatArray(&buf, option) < 0) goto finalize;
+    value = buf.data ? buf.data : "";
+  }
+
+  vlen = strlen(value);
+  entry = LRC_diffAppend(diff, op, option->type, space, strlen(space),
+      option->name, strlen(option->name), value, vlen);
+
+finalize:
+  if (buf.data) free(buf.data);
+  return entry;
+}
+
+/**
+ * @fn LRC_configDiff* LRC_diff(LRC_configNamespace* a, LRC_configNamespace* b)
+ * @brief Finds the options added, removed and changed from a to b.
+ *
+ * @param a
+ *  The old config (NULL for an empty one)
+ *
+ * @param b
+ *  The new config (NULL for an empty one)
+ *
+ * @return
+ *  The differences (free them with LRC_freeDiff()) or NULL on failure
+ */
+LRC_configDiff* LRC_diff(LRC_configNamespace* a, LRC_configNamespace* b){
+
+  LRC_configDiff* diff = NULL;
+  LRC_configIndex* index = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  LRC_configOptions* other = NULL;
+  char* seen = NULL;
+  size_t slot;
+
+  diff = calloc(1, sizeof(LRC_configDiff));
+  if (!diff) {
+    perror("LRC_diff: alloc failed");
+    return NULL;
+  }
+
+  if (b) {
+    index = LRC_indexConfig(b);
+    if (!index) goto failure;
+
+    seen = calloc(index->size, sizeof(char));
+    if (!seen) {
+      perror("LRC_diff: alloc failed");
+      goto failure;
+    }
+  }
+
+  for (current = a; current; current = current->next) {
+    for (option = current->options; option; option = option->next) {
+      other = NULL;
+      if (index) {
+        slot = LRC_indexSlot(index, current->space, option->name);
+        other = index->options[slot];
+      }
+
+      if (!other) {
+        if (!LRC_diffOption(diff, LRC_DIFF_REMOVED, current->space, option)) goto failure;
+        continue;
+      }
+
+      seen[slot] = 1;
+      if (!LRC_diffSame(option, other)) {
+        if (!LRC_diffOption(diff, LRC_DIFF_CHANGED, current->space, other)) goto failure;
+      }
+    }
+  }
+
+  for (current = b; current; current = current->next) {
+    for (option = current->options; option; option = option->next) {
+      slot = LRC_indexSlot(index, current->space, option->name);
+      if (seen[slot]) continue;
+      if (!LRC_diffOption(diff, LRC_DIFF_ADDED, current->space, option)) goto failure;
+    }
+  }
+
+  if (seen) free(seen);
+  LRC_freeIndex(index);
+
+  return diff;
+
+failure:
+  if (seen) free(seen);
+  LRC_freeIndex(index);
+  LRC_freeDiff(diff);
+  return NULL;
+}
+
+/**
+ * @fn LRC_configOptions* LRC_diffAdd(LRC_configNamespace* head, LRC_configNamespace** current, LRC_configOptions** last, char* space, char* name)
+ * @brief Adds the option (and the namespace, if needed) at the end of the config.
+ *
+ * @param current
+ *  The namespace of the last added option, or NULL
+ *
+ * @param last
+ *  The last option of that namespace
+ *
+ * @return
+ *  The option or NULL on failure
+ */
+LRC_configOptions* LRC_diffAdd(LRC_configNamespace* head, LRC_configNamespace** current,
+    LRC_configOptions** last, char* space, char* name){
+
+  LRC_configNamespace* nm = *current;
+  LRC_configOptions* option = NULL;
+
+  if (!nm || strcmp(nm->space, space) != 0) {
+    nm = LRC_findNamespace(space, head);
+    if (!nm) {
+      nm = LRC_newNamespace(space);
+      if (!nm) return NULL;
+      LRC_lastLeaf(head)->next = nm;
+    }
+
+    *current = nm;
+    *last = nm->options;
+    while (*last && (*last)->next) *last = (*last)->next;
+  }
+
+  option = calloc(1, sizeof(LRC_configOptions));
+  if (!option) {
+    perror("LRC_diffAdd: alloc failed");
+    return NULL;
+  }
+  LRC_COUNT_ALLOC(nm, sizeof(LRC_configOptions));
+
+  strcpy(option->name, name);
+  option->type = LRC_STRING;
+
+  if (*last) {
+    (*last)->next = option;
+  } else {
+    nm->options = option;
+  }
+  *last = option;
+
+  return option;
+}
+
+/**
+ * @fn int LRC_applyPatch(LRC_configNamespace* head, LRC_configDiff* diff)
+ * @brief Applies the differences to the config.
+ *
+ * After LRC_applyPatch(a, LRC_diff(a, b)) the config a has the options and
+ * values of b. The added options are appended to their namespaces (new
+ * namespaces at the end of the config) and the removed ones are freed, so the
+ * indexes, overlays and sweeps of the config must be built again.
+ *
+ * The patch is checked first: if it changes options that do not exist, adds
+ * an option that exists (or adds it twice), or a value does not fit its type,
+ * the config is not touched (only a failed allocation may leave it partly
+ * patched). The namespaces left empty by the
+ * patch are removed, except the first one (the head of the config).
+ *
+ * @return
+ *  Number of applied differences or -1 on failure
+ */
+int LRC_applyPatch(LRC_configNamespace* head, LRC_configDiff* diff){
+
+  LRC_configIndex* index = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configNamespace* previous = NULL;
+  LRC_configNamespace* added = NULL;
+  LRC_configNamespace* nextNM = NULL;
+  LRC_configOptions scratch;
+  LRC_configOptions* option = NULL;
+  LRC_configOptions* last = NULL;
+  LRC_configOptions* prev = NULL;
+  LRC_configOptions* next = NULL;
+  LRC_diffEntry* entry = NULL;
+  char* drop = NULL;
+  size_t* seen = NULL;
+  size_t i, slot, size;
+  int n = 0, dropped;
+
+  if (!head || !diff) {
+    perror("LRC_applyPatch: no config assigned");
+    return -1;
+  }
+
+  index = LRC_indexConfig(head);
+  if (!index) return -1;
+
+  /* The added names of the patch (entry + 1 in open addressing slots) */
+  size = 2;
+  while (size < 2 * diff->count) size <<= 1;
+
+  drop = calloc(index->size, sizeof(char));
+  seen = calloc(size, sizeof(size_t));
+  if (!drop || !seen) {
+    perror("LRC_applyPatch: alloc failed");
+    goto failure;
+  }
+
+  for (i = 0; i < diff->count; i++) {
+    entry = &diff->entries[i];
+
+    if (strlen(entry->space) >= LRC_CONFIG_LEN || strlen(entry->name) >= LRC_CONFIG_LEN) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, NULL, NULL, LRC_MSG_TOO_LONG);
+      goto failure;
+    }
+
+    if (entry->op == LRC_DIFF_CHANGED && !LRC_indexFind(index, entry->space, entry->name)) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, entry->space, entry->name, LRC_MSG_UNKNOWN_VAR);
+      goto failure;
+    }
+
+    if (entry->op == LRC_DIFF_ADDED) {
+      if (LRC_indexFind(index, entry->space, entry->name)) {
+        LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, entry->space, entry->name, LRC_MSG_PATCH);
+        goto failure;
+      }
+
+      slot = (size_t)LRC_hashKey(entry->space, entry->name) & (size - 1);
+      while (seen[slot]) {
+        if (strcmp(diff->entries[seen[slot] - 1].name, entry->name) == 0
+            && strcmp(diff->entries[seen[slot] - 1].space, entry->space) == 0) {
+          LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, entry->space, entry->name, LRC_MSG_PATCH);
+          goto failure;
+        }
+        slot = (slot + 1) & (size - 1);
+      }
+      seen[slot] = i + 1;
+    }
+
+    /* The value is stored on a scratch option, so that it cannot fail later */
+    if (entry->op != LRC_DIFF_REMOVED) {
+      memset(&scratch, 0, sizeof(LRC_configOptions));
+      if (LRC_storeValue(&scratch, entry->value, entry->type) < 0) {
+        LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, entry->space, entry->name,
+            strlen(entry->value) >= LRC_CONFIG_LEN ? LRC_MSG_TOO_LONG : LRC_MSG_WRONG_INPUT);
+        goto failure;
+      }
+      if (scratch.array) free(scratch.array);
+    }
+  }
+
+  LRC_changed(head, NULL, NULL);
+
+  for (i = 0; i < diff->count; i++) {
+    entry = &diff->entries[i];
+    slot = LRC_indexSlot(index, entry->space, entry->name);
+    option = index->options[slot];
+
+    if (entry->op == LRC_DIFF_REMOVED) {
+      if (option) {
+        drop[slot] = 1;
+        n++;
+      }
+      continue;
+    }
+
+    if (!option) {
+      option = LRC_diffAdd(head, &added, &last, entry->space, entry->name);
+      if (!option) goto failure;
+    }
+
+    if (LRC_storeValue(option, entry->value, entry->type) < 0) {
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, entry->space, entry->name, LRC_MSG_WRONG_INPUT);
+      goto failure;
+    }
+    n++;
+  }
+
+  /* The removed options (and the namespaces left empty) are unlinked in one pass */
+  for (current = head; current; current = nextNM) {
+    nextNM = current->next;
+    prev = NULL;
+    dropped = 0;
+    for (option = current->options; option; option = next) {
+      next = option->next;
+      slot = LRC_indexSlot(index, current->space, option->name);
+
+      if (index->options[slot] != option || !drop[slot]) {
+        prev = option;
+        continue;
+      }
+
+      if (prev) {
+        prev->next = next;
+      } else {
+        current->options = next;
+      }
+
+      if (option->array) free(option->array);
+      free(option);
+      dropped = 1;
+    }
+
+    if (dropped && !current->options && current != head) {
+      previous->next = current->next;
+      if (current->stats) free(current->stats);
+      free(current);
+      continue;
+    }
+    previous = current;
+  }
+
+  free(drop);
+  free(seen);
+  LRC_freeIndex(index);
+
+  return n;
+
+failure:
+  if (drop) free(drop);
+  if (seen) free(seen);
+  LRC_freeIndex(index);
+  return -1;
+}
+
+/**
+ * @fn int LRC_diffPutVarint(LRC_buffer* buf, uint64_t v)
+ * @brief Appends the unsigned LEB128 varint.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_diffPutVarint(LRC_buffer* buf, uint64_t v){
+
+  char b[10];
+  int n = 0;
+
+  do {
+    b[n] = (char)(v & 0x7f);
+    v >>= 7;
+    if (v) b[n] |= (char)0x80;
+    n++;
+  } while (v);
+
+  return LRC_bufferAppend(buf, b, (size_t)n);
+}
+
+/**
+ * @fn int LRC_diffGetVarint(char** p, char* end, uint64_t* v)
+ * @brief Reads the unsigned LEB128 varint.
+ *
+ * @return
+ *  0 on success, -1 if the varint is truncated or too long
+ */
+int LRC_diffGetVarint(char** p, char* end, uint64_t* v){
+
+  unsigned char c;
+  int shift = 0;
+
+  *v = 0;
+  do {
+    if (*p >= end || shift > 63) return -1;
+    c = (unsigned char)*(*p)++;
+    *v |= (uint64_t)(c & 0x7f) << shift;
+    shift += 7;
+  } while (c & 0x80);
+
+  return 0;
+}
+
+/**
+ * @fn int LRC_diffPutString(LRC_buffer* buf, char* str)
+ * @brief Appends the length of the string and the string.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_diffPutString(LRC_buffer* buf, char* str){
+
+  size_t len = strlen(str);
+
+  if (LRC_diffPutVarint(buf, len) < 0) return -1;
+
+  return LRC_bufferAppend(buf, str, len);
+}
+
+/**
+ * @fn int LRC_diffGetString(char** p, char* end, char** str, size_t* len)
+ * @brief Reads the length of the string and points to the string.
+ *
+ * @return
+ *  0 on success, -1 if the string is truncated
+ */
+int LRC_diffGetString(char** p, char* end, char** str, size_t* len){
+
+  uint64_t v;
+
+  if (LRC_diffGetVarint(p, end, &v) < 0 || v > (uint64_t)(end - *p)) return -1;
+  if (memchr(*p, LRC_NULL, (size_t)v)) return -1;
+
+  *str = *p;
+  *len = (size_t)v;
+  *p += v;
+
+  return 0;
+}
+
+/**
+ * @fn char* LRC_diffPack(LRC_configDiff* diff, size_t* len)
+ * @brief Packs the differences into the patch format.
+ *
+ * @param len
+ *  On return, the length of the patch
+ *
+ * @return
+ *  The patch (you must free it) or NULL on failure
+ */
+char* LRC_diffPack(LRC_configDiff* diff, size_t* len){
+
+  LRC_buffer buf = {NULL, 0, 0};
+  LRC_diffEntry* entry = NULL;
+  char* space = NULL;
+  char version = LRC_PATCH_VERSION;
+  size_t i;
+  int status = 0;
+
+  if (!diff || !len) return NULL;
+
+  status |= LRC_bufferAppend(&buf, LRC_PATCH_MAGIC, strlen(LRC_PATCH_MAGIC));
+  status |= LRC_bufferAppend(&buf, &version, 1);
+  status |= LRC_diffPutVarint(&buf, (uint64_t)diff->count);
+
+  for (i = 0; i < diff->count && status == 0; i++) {
+    entry = &diff->entries[i];
+
+    /* The namespace is written once for the following options */
+    if (!space || strcmp(space, entry->space) != 0) {
+      status |= LRC_diffPutVarint(&buf, 0);
+      status |= LRC_diffPutString(&buf, entry->space);
+      space = entry->space;
+    }
+
+    status |= LRC_diffPutVarint(&buf, (uint64_t)entry->op);
+    status |= LRC_diffPutString(&buf, entry->name);
+
+    if (entry->op != LRC_DIFF_REMOVED) {
+      status |= LRC_diffPutVarint(&buf, (uint64_t)entry->type);
+      status |= LRC_diffPutString(&buf, entry->value);
+    }
+  }
+
+  if (status) {
+    if (buf.data) free(buf.data);
+    return NULL;
+  }
+
+  *len = buf.len;
+  return buf.data;
+}
+
+/**
+ * @fn LRC_configDiff* LRC_diffUnpack(char* buf, size_t len)
+ * @brief Reads the differences from the patch format.
+ *
+ * @return
+ *  The differences (free them with LRC_freeDiff()) or NULL on failure
+ */
+LRC_configDiff* LRC_diffUnpack(char* buf, size_t len){
+
+  LRC_configDiff* diff = NULL;
+  char* p = buf;
+  char* end = buf + len;
+  char* space = NULL;
+  char* name = NULL;
+  char* value = "";
+  size_t mlen, slen = 0, nlen = 0, vlen = 0;
+  uint64_t count, op, type = 0;
+
+  mlen = strlen(LRC_PATCH_MAGIC);
+  if (!buf || len < mlen + 1 || memcmp(buf, LRC_PATCH_MAGIC, mlen) != 0
+      || buf[mlen] != LRC_PATCH_VERSION) {
+    LRC_message(0, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_PATCH);
+    return NULL;
+  }
+  p += mlen + 1;
+
+  diff = calloc(1, sizeof(LRC_configDiff));
+  if (!diff) {
+    perror("LRC_diffUnpack: alloc failed");
+    return NULL;
+  }
+
+  /* The count tells the patch cut between two records */
+  if (LRC_diffGetVarint(&p, end, &count) < 0) goto malformed;
+
+  while (p < end) {
+    if (LRC_diffGetVarint(&p, end, &op) < 0) goto malformed;
+
+    if (op == 0) {
+      if (LRC_diffGetString(&p, end, &space, &slen) < 0) goto malformed;
+      continue;
+    }
+
+    if (!space || op > LRC_DIFF_CHANGED) goto malformed;
+    if (LRC_diffGetString(&p, end, &name, &nlen) < 0) goto malformed;
+
+    value = "";
+    vlen = 0;
+    type = 0;
+    if (op != LRC_DIFF_REMOVED) {
+      if (LRC_diffGetVarint(&p, end, &type) < 0 || type > INT_MAX) goto malformed;
+      if (LRC_diffGetString(&p, end, &value, &vlen) < 0) goto malformed;
+    }
+
+    if (!LRC_diffAppend(diff, (int)op, (int)type, space, slen, name, nlen, value, vlen)) goto failure;
+  }
+
+  if (diff->count != count) goto malformed;
+
+  return diff;
+
+malformed:
+  LRC_message(0, LRC_ERR_CONFIG_SYNTAX, LRC_MSG_PATCH);
+
+failure:
+  LRC_freeDiff(diff);
+  return NULL;
+}
+
+/**
+ * @fn int LRC_diffWriteFile(char* path, LRC_configDiff* diff)
+ * @brief Writes the patch file, atomically (see LRC_ASCIIWriteFile()).
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_diffWriteFile(char* path, LRC_configDiff* diff){
+
+  char* buf = NULL;
+  size_t len = 0;
+  int status;
+
+  buf = LRC_diffPack(diff, &len);
+  if (!buf) return -1;
+
+  status = LRC_writeAtomic(path, buf, len);
+  free(buf);
+
+  return status;
+}
+
+/**
+ * @fn LRC_configDiff* LRC_diffReadFile(char* path)
+ * @brief Reads the patch file.
+ *
+ * @return
+ *  The differences (free them with LRC_freeDiff()) or NULL on failure
+ */
+LRC_configDiff* LRC_diffReadFile(char* path){
+
+  LRC_configDiff* diff = NULL;
+  struct stat st;
+  FILE* file = NULL;
+  char* buf = NULL;
+
+  file = fopen(path, "rb");
+  if (!file || fstat(fileno(file), &st) != 0) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, path);
+    goto finalize;
+  }
+
+  buf = malloc((size_t)st.st_size + 1);
+  if (!buf) {
+    perror("LRC_diffReadFile: alloc failed");
+    goto finalize;
+  }
+
+  if (fread(buf, 1, (size_t)st.st_size, file) != (size_t)st.st_size) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, path);
+    goto finalize;
+  }
+
+  diff = LRC_diffUnpack(buf, (size_t)st.st_size);
+
+finalize:
+  if (buf) free(buf);
+  if (file) fclose(file);
+  return diff;
+}
+
+/**
+ * @fn void LRC_freeDiff(LRC_configDiff* diff)
+ * @brief Frees the differences.
+ */
+void LRC_freeDiff(LRC_configDiff* diff){
+
+  size_t i;
+
+  if (!diff) return;
+
+  for (i = 0; i < diff->count; i++) free(diff->entries[i].space);
+  if (diff->entries) free(diff->entries);
+  free(diff);
+}
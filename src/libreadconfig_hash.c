@@ -0,0 +1,377 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_hash.c
+ * @brief Canonical fingerprint of the config.
+ *
+ * Every option contributes the 128-bit hash of its namespace, name, type and
+ * normalized value: numbers are hashed by their value (1.0 and 1.00 are the
+ * same double, -0.0 is 0.0, all NaNs are the same), arrays element by
+ * element and strings as text. The numbers are hashed as little-endian
+ * words, so the fingerprint is the same on all platforms.
+ *
+ * The contributions are summed (mod 2^64, in both lanes), so the fingerprint
+ * does not depend on the order of the namespaces and the options, nor on the
+ * layout of the config file.
+ *
+ * The sum is kept up to date through LRC_changed(): the contribution of the
+ * changed option is subtracted and added again, so that LRC_hash() is O(1).
+ * After the changes of many options at once (parsers, patches), the sum is
+ * computed again on the next read.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @fn uint64_t LRC_hashMix(uint64_t h)
+ * @brief Finalizer of the hash (all bits of the input affect all bits).
+ */
+uint64_t LRC_hashMix(uint64_t h){
+
+  h ^= h >> 30;
+  h *= UINT64_C(0xbf58476d1ce4e5b9);
+  h ^= h >> 27;
+  h *= UINT64_C(0x94d049bb133111eb);
+  h ^= h >> 31;
+
+  return h;
+}
+
+/**
+ * @fn void LRC_hashBytes(uint64_t* lanes, const char* p, size_t n)
+ * @brief Adds the bytes to both lanes of the hash (FNV-1a, different primes).
+ */
+void LRC_hashBytes(uint64_t* lanes, const char* p, size_t n){
+
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    lanes[0] = (lanes[0] ^ (unsigned char)p[i]) * UINT64_C(0x100000001b3);
+    lanes[1] = (lanes[1] ^ (unsigned char)p[i]) * UINT64_C(0x9e3779b97f4a7c15);
+  }
+}
+
+/**
+ * @fn void LRC_hashWord(uint64_t* lanes, uint64_t v)
+ * @brief Adds the word to the hash, as 8 little-endian bytes.
+ */
+void LRC_hashWord(uint64_t* lanes, uint64_t v){
+
+  char b[8];
+  int i;
+
+  for (i = 0; i < 8; i++) b[i] = (char)((v >> (8*i)) & 0xff);
+
+  LRC_hashBytes(lanes, b, 8);
+}
+
+/**
+ * @fn void LRC_hashDouble(uint64_t* lanes, double d)
+ * @brief Adds the normalized double to the hash.
+ */
+void LRC_hashDouble(uint64_t* lanes, double d){
+
+  uint64_t v;
+
+  if (d != d) {
+    v = UINT64_C(0x7ff8000000000000);
+  } else {
+    if (d == 0) d = 0;
+    memcpy(&v, &d, sizeof(double));
+  }
+
+  LRC_hashWord(lanes, v);
+}
+
+/**
+ * @fn void LRC_hashOf(char* space, LRC_configOptions* option, uint64_t* h)
+ * @brief The 128-bit contribution of the option to the fingerprint.
+ */
+void LRC_hashOf(char* space, LRC_configOptions* option, uint64_t* h){
+
+  uint64_t lanes[2] = {UINT64_C(0xcbf29ce484222325), UINT64_C(0x84222325cbf29ce4)};
+  size_t i;
+  long l;
+  float f;
+  double d;
+  int status = LRC_NUMBER_INVALID;
+
+  LRC_hashBytes(lanes, space, strlen(space) + 1);
+  LRC_hashBytes(lanes, option->name, strlen(option->name) + 1);
+  LRC_hashWord(lanes, (uint64_t)option->type);
+
+  switch (option->type) {
+    case LRC_INT_ARRAY:
+      LRC_hashWord(lanes, (uint64_t)option->count);
+      for (i = 0; i < option->count; i++) {
+        LRC_hashWord(lanes, (uint64_t)(int64_t)((int*)option->array)[i]);
+      }
+      status = LRC_NUMBER_OK;
+      break;
+    case LRC_DOUBLE_ARRAY:
+      LRC_hashWord(lanes, (uint64_t)option->count);
+      for (i = 0; i < option->count; i++) LRC_hashDouble(lanes, ((double*)option->array)[i]);
+      status = LRC_NUMBER_OK;
+      break;
+    case LRC_INT:
+    case LRC_VAL:
+    case LRC_LONG:
+      status = LRC_str2long(option->value, &l);
+      if (status == LRC_NUMBER_OK) LRC_hashWord(lanes, (uint64_t)(int64_t)l);
+      break;
+    case LRC_FLOAT:
+      status = LRC_str2float(option->value, &f);
+      if (status == LRC_NUMBER_OK) LRC_hashDouble(lanes, (double)f);
+      break;
+    case LRC_DOUBLE:
+      status = LRC_str2double(option->value, &d);
+      if (status == LRC_NUMBER_OK) LRC_hashDouble(lanes, d);
+      break;
+    default:
+      break;
+  }
+
+  /* Strings, and the numbers which do not convert, as text */
+  if (status != LRC_NUMBER_OK) {
+    LRC_hashBytes(lanes, "\377", 1);
+    LRC_hashBytes(lanes, option->value, strlen(option->value));
+  }
+
+  h[0] = LRC_hashMix(lanes[0]);
+  h[1] = LRC_hashMix(lanes[1]);
+}
+
+/**
+ * @fn LRC_hashEntry* LRC_hashSlot(LRC_configHash* hash, LRC_configOptions* option)
+ * @brief Finds the contribution of the option.
+ *
+ * @return
+ *  The slot of the option, or the free slot where it belongs
+ */
+LRC_hashEntry* LRC_hashSlot(LRC_configHash* hash, LRC_configOptions* option){
+
+  size_t slot;
+
+  slot = LRC_hashPointer(option) & (hash->size - 1);
+  while (hash->entries[slot].option && hash->entries[slot].option != option) {
+    slot = (slot + 1) & (hash->size - 1);
+  }
+
+  return &hash->entries[slot];
+}
+
+/**
+ * @fn int LRC_hashBuild(LRC_configNamespace* head, LRC_configHash* hash)
+ * @brief Computes the contributions of all options and the sum.
+ *
+ * @return
+ *  0 on success, -1 otherwise (the sum is computed anyway, the state stays dirty)
+ */
+int LRC_hashBuild(LRC_configNamespace* head, LRC_configHash* hash){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  LRC_hashEntry* entry = NULL;
+  LRC_hashEntry* entries = NULL;
+  uint64_t h[2];
+  size_t n = 0, size;
+
+  for (current = head; current; current = current->next) {
+    for (option = current->options; option; option = option->next) n++;
+  }
+
+  /* At most half full */
+  for (size = 8; size < 2*n; size *= 2);
+
+  if (size != hash->size) {
+    entries = calloc(size, sizeof(LRC_hashEntry));
+    if (entries) {
+      LRC_COUNT_ALLOC(head, size * sizeof(LRC_hashEntry));
+      if (hash->entries) free(hash->entries);
+      hash->entries = entries;
+      hash->size = size;
+    }
+  } else {
+    memset(hash->entries, 0, size * sizeof(LRC_hashEntry));
+    entries = hash->entries;
+  }
+
+  hash->sum[0] = 0;
+  hash->sum[1] = 0;
+  hash->count = n;
+  hash->dirty = entries ? 0 : 1;
+
+  for (current = head; current; current = current->next) {
+    for (option = current->options; option; option = option->next) {
+      LRC_hashOf(current->space, option, h);
+      hash->sum[0] += h[0];
+      hash->sum[1] += h[1];
+
+      if (entries) {
+        entry = LRC_hashSlot(hash, option);
+        entry->option = option;
+        entry->h[0] = h[0];
+        entry->h[1] = h[1];
+      }
+    }
+  }
+
+  return entries ? 0 : -1;
+}
+
+/**
+ * @fn void LRC_hashChanged(LRC_configNamespace* head, char* space, LRC_configOptions* option)
+ * @brief Updates the fingerprint after the change of the option, see LRC_changed().
+ */
+void LRC_hashChanged(LRC_configNamespace* head, char* space, LRC_configOptions* option){
+
+  LRC_configHash* hash = head->hash;
+  LRC_hashEntry* entry = NULL;
+  uint64_t h[2];
+
+  if (!hash || hash->dirty) return;
+
+  if (!option || !space) {
+    hash->dirty = 1;
+    return;
+  }
+
+  entry = LRC_hashSlot(hash, option);
+  if (!entry->option) {
+    hash->dirty = 1;
+    return;
+  }
+
+  LRC_hashOf(space, option, h);
+  hash->sum[0] += h[0] - entry->h[0];
+  hash->sum[1] += h[1] - entry->h[1];
+  entry->h[0] = h[0];
+  entry->h[1] = h[1];
+}
+
+/**
+ * @fn void LRC_hashNamespace(LRC_configNamespace* space, uint64_t* h)
+ * @brief The 128-bit fingerprint of the namespace alone (not kept up to date).
+ */
+void LRC_hashNamespace(LRC_configNamespace* space, uint64_t* h){
+
+  LRC_configOptions* option = NULL;
+  uint64_t sum[2] = {0, 0}, o[2];
+  uint64_t n = 0;
+
+  for (option = space->options; option; option = option->next) {
+    LRC_hashOf(space->space, option, o);
+    sum[0] += o[0];
+    sum[1] += o[1];
+    n++;
+  }
+
+  h[0] = LRC_hashMix(sum[0] + n);
+  h[1] = LRC_hashMix(sum[1] ^ n);
+}
+
+/**
+ * @fn void LRC_hash128(LRC_configNamespace* head, uint64_t* hash)
+ * @brief The 128-bit fingerprint of the config.
+ *
+ * Configs with the same options (namespace, name, type) and the same values
+ * have the same fingerprint, whatever the order and the file layout.
+ *
+ * @param hash
+ *  On return, the two 64-bit words of the fingerprint
+ */
+void LRC_hash128(LRC_configNamespace* head, uint64_t* hash){
+
+  LRC_configHash* state = NULL;
+  LRC_configHash scratch;
+
+  if (head && !head->hash) {
+    head->hash = calloc(1, sizeof(LRC_configHash));
+    if (head->hash) {
+      LRC_COUNT_ALLOC(head, sizeof(LRC_configHash));
+      head->hash->dirty = 1;
+    }
+  }
+
+  state = head ? head->hash : NULL;
+
+  /* Without the state, the sum is computed every time */
+  if (!state) {
+    memset(&scratch, 0, sizeof(LRC_configHash));
+    state = &scratch;
+    state->dirty = 1;
+  }
+
+  if (state->dirty) LRC_hashBuild(head, state);
+
+  /* The number of options is mixed in, and the empty config is not 0 */
+  hash[0] = LRC_hashMix(state->sum[0] + (uint64_t)state->count + UINT64_C(0x9e3779b97f4a7c15));
+  hash[1] = LRC_hashMix(state->sum[1] ^ ((uint64_t)state->count + UINT64_C(0xcbf29ce484222325)));
+
+  if (state == &scratch && scratch.entries) free(scratch.entries);
+}
+
+/**
+ * @fn uint64_t LRC_hash(LRC_configNamespace* head)
+ * @brief The 64-bit fingerprint of the config, see LRC_hash128().
+ *
+ * It is O(1), unless many options have changed at once (i.e. the config was
+ * read) since the last call.
+ */
+uint64_t LRC_hash(LRC_configNamespace* head){
+
+  uint64_t hash[2];
+
+  LRC_hash128(head, hash);
+
+  return hash[0];
+}
+
+/**
+ * @fn void LRC_freeHash(LRC_configHash* hash)
+ * @brief Frees the fingerprint state (the config is not touched).
+ */
+void LRC_freeHash(LRC_configHash* hash){
+
+  if (!hash) return;
+
+  if (hash->entries) free(hash->entries);
+  free(hash);
+}
@@ -44,8 +44,27 @@
 
 #define LRC_CONFIG_GROUP "config"
 #define LRC_HDF5_DATATYPE "LRC_Config"
+#define LRC_HDF5_HISTORY_CHUNK 64
+#define LRC_HDF5_ARRAYS ".arrays"
 
 int LRC_HDF5Parser(hid_t file_id, char* group_name, LRC_configNamespace* head);
 int LRC_HDF5Writer(hid_t file_id, char* group_name, LRC_configNamespace* head);
+int LRC_HDF5WriterDcpl(hid_t file_id, char* group_name, LRC_configNamespace* head, hid_t dcpl);
+
+/* Background loading */
+LRC_configLoad* LRC_loadAsyncHDF5(char* path, char* group_name, LRC_configDefaults* cd);
+
+/* Parameter sweeps */
+int LRC_HDF5SweepWriter(hid_t file_id, char* name, LRC_configSweep* sweep);
+
+/* Config history */
+int LRC_HDF5HistoryWriter(hid_t file_id, char* history_name, long long step, LRC_configNamespace* head);
+int LRC_HDF5HistoryParser(hid_t file_id, char* history_name, long long step, LRC_configNamespace* head);
+
+/* Parallel HDF5 (MPI-IO) */
+#ifdef H5_HAVE_PARALLEL
+int LRC_HDF5ParallelParser(hid_t file_id, char* group_name, MPI_Comm comm, LRC_configNamespace* head);
+int LRC_HDF5ParallelWriter(hid_t file_id, char* group_name, MPI_Comm comm, LRC_configNamespace* head);
+#endif
 
 #endif
@@ -39,17 +39,414 @@
 #ifndef LIBREADCONFIG_INTERNALS_H
 #define LIBREADCONFIG_INTERNALS_H
 
+#include <pthread.h>
 #include "libreadconfig.h"
+#if HAVE_HDF5_H
+  #include "libreadconfig_hdf5.h"
+#endif
+#if HAVE_MPI_H
+  #include "libreadconfig_mpi.h"
+#endif
+
+/**
+ * @var typedef struct LRC_buffer
+ * @brief Growable buffer used by the writers
+ *
+ * @param data
+ *  The content (null-terminated)
+ *
+ * @param len
+ *  Length of the content
+ *
+ * @param size
+ *  Allocated size
+ */
+typedef struct{
+  char* data;
+  size_t len;
+  size_t size;
+} LRC_buffer;
 
-void LRC_message(int line, int type, char* message);
 char* LRC_nameTrim(char*);
 int LRC_charCount(char*, char*);
+void LRC_valueSpan(char* l, char* s, char* c, size_t* start, size_t* len);
 int LRC_matchType(char*, char*, LRC_configDefaults*, int);
 int LRC_checkType(char*, int);
 int LRC_isAllowed(int);
 int LRC_checkName(char*, LRC_configDefaults*, int);
 LRC_configNamespace* LRC_newNamespace(char* cfg);
 LRC_configNamespace* LRC_lastLeaf(LRC_configNamespace* head);
+char* LRC_packConfig(LRC_configNamespace* head, size_t* len);
+int LRC_unpackConfig(char* buf, size_t len, LRC_configNamespace* head);
+char* LRC_unpackString(char* p, char* end);
+int LRC_bufferAppend(LRC_buffer* buf, const char* str, size_t len);
+int LRC_ASCIIFormat(LRC_buffer* buf, char* sep, char* comm, LRC_configNamespace* head);
+int LRC_writeAtomic(char* path, char* data, size_t len);
+int LRC_compareOffsets(const void* a, const void* b);
+int LRC_isArray(int type);
+size_t LRC_arrayElement(int type);
+int LRC_schemaType(char* type);
+int LRC_formatArray(LRC_buffer* buf, LRC_configOptions* option);
+void LRC_storeArray(LRC_configOptions* option, void* array, size_t count, int type);
+int LRC_storeValue(LRC_configOptions* option, char* value, int type);
+uint64_t LRC_hashKey(const char* space, const char* name);
+size_t LRC_hashPointer(void* p);
+size_t LRC_layerEnvName(char* key, char* space, char* name);
+uint64_t LRC_layerEnvHash(const char* key, size_t len);
+size_t LRC_indexSlot(LRC_configIndex* index, char* space, char* var);
+LRC_overlayOption* LRC_overlaySlot(LRC_configOverlay* overlay, LRC_configOptions* option);
+int LRC_overlayGrow(LRC_configOverlay* overlay);
+size_t LRC_sweepElement(int type);
+int LRC_sweepCode(LRC_configSweep* sweep, char* str);
+int LRC_sweepIntern(LRC_configSweep* sweep, char* str);
+int LRC_sweepDecimals(char* str);
+int LRC_sweepParse(LRC_configOptions* option, LRC_sweepDimension* dim);
+int LRC_diffSame(LRC_configOptions* x, LRC_configOptions* y);
+LRC_diffEntry* LRC_diffAppend(LRC_configDiff* diff, int op, int type, char* space, size_t slen,
+    char* name, size_t nlen, char* value, size_t vlen);
+LRC_diffEntry* LRC_diffOption(LRC_configDiff* diff, int op, char* space, LRC_configOptions* option);
+LRC_configOptions* LRC_diffAdd(LRC_configNamespace* head, LRC_configNamespace** current,
+    LRC_configOptions** last, char* space, char* name);
+int LRC_diffPutVarint(LRC_buffer* buf, uint64_t v);
+int LRC_diffGetVarint(char** p, char* end, uint64_t* v);
+int LRC_diffPutString(LRC_buffer* buf, char* str);
+int LRC_diffGetString(char** p, char* end, char** str, size_t* len);
+
+/**
+ * @var typedef struct LRC_configDiag
+ * @brief Diagnostics settings and state of the config
+ *
+ * @param handler
+ *  The handler (NULL for the global one)
+ *
+ * @param data
+ *  The data of the handler
+ *
+ * @param limit
+ *  Maximum number of reported errors (0 for no limit)
+ *
+ * @param flags
+ *  LRC_DIAG_DEDUP, LRC_DIAG_COLLECT
+ *
+ * @param reported
+ *  Number of reported errors
+ *
+ * @param total
+ *  Number of all errors, also the suppressed ones
+ *
+ * @param file
+ *  The file being parsed (NULL if not known)
+ *
+ * @param seen
+ *  Hash set of the reported problems (0 for free slots)
+ *
+ * @param nseen
+ *  Number of the reported problems
+ *
+ * @param size
+ *  Number of slots of the set (a power of two)
+ */
+typedef struct LRC_configDiag{
+  LRC_diagnosticHandler handler;
+  void* data;
+  int limit;
+  int flags;
+  int reported;
+  int total;
+  char* file;
+  uint64_t* seen;
+  size_t nseen;
+  size_t size;
+} LRC_configDiag;
+
+LRC_configDiag* LRC_diagOf(LRC_configNamespace* head);
+void LRC_report(LRC_configNamespace* head, int type, int line, int column,
+    char* space, char* name, char* message);
+int LRC_diagCollect(LRC_configNamespace* head);
+int LRC_diagSeen(LRC_configDiag* diag, uint64_t h);
+char* LRC_diagTitle(int type);
+void LRC_freeDiag(LRC_configDiag* diag);
+
+/* Statistics. Without LRC_STATS the macros expand to nothing */
+extern LRC_stats LRC_globalStats;
+LRC_stats* LRC_statsOf(LRC_configNamespace* space);
+uint64_t LRC_statsClock(void);
+uint64_t LRC_statsPhase(LRC_configNamespace* space, int phase, uint64_t start);
+
+/* The global counters are shared by all threads */
+#if defined(__GNUC__)
+  #define LRC_ATOMIC_ADD(x, n) __atomic_fetch_add(&(x), (n), __ATOMIC_RELAXED)
+  #define LRC_ATOMIC_LOAD(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+  #define LRC_ATOMIC_STORE(x, n) __atomic_store_n(&(x), (n), __ATOMIC_RELAXED)
+#else
+  #define LRC_ATOMIC_ADD(x, n) ((x) += (n))
+  #define LRC_ATOMIC_LOAD(x) (x)
+  #define LRC_ATOMIC_STORE(x, n) ((x) = (n))
+#endif
+
+#ifdef LRC_STATS
+  #define LRC_COUNT(space, counter, n) do { \
+      LRC_stats* LRC_s = LRC_statsOf(space); \
+      LRC_ATOMIC_ADD(LRC_globalStats.counter, (uint64_t)(n)); \
+      if (LRC_s) LRC_s->counter += (uint64_t)(n); \
+    } while (0)
+  #define LRC_COUNT_ALLOC(space, size) do { \
+      LRC_COUNT(space, allocations, 1); \
+      LRC_COUNT(space, allocated, size); \
+    } while (0)
+  #define LRC_TIMER(t) uint64_t t = 0
+  #define LRC_CLOCK(t) (t = LRC_statsClock())
+  #define LRC_PHASE(space, phase, t) (t = LRC_statsPhase(space, phase, t))
+#else
+  #define LRC_COUNT(space, counter, n) ((void)0)
+  #define LRC_COUNT_ALLOC(space, size) ((void)0)
+  #define LRC_TIMER(t) struct LRC_noTimer
+  #define LRC_CLOCK(t) ((void)0)
+  #define LRC_PHASE(space, phase, t) ((void)0)
+#endif
+
+/**
+ * @var typedef struct LRC_configInterp
+ * @brief Interpolation state of the config
+ *
+ * @param index
+ *  The index of the config, the slots are the nodes of the graph
+ *
+ * @param first
+ *  The dependents of the option in the slot are dependents[first[slot]] up to
+ *  dependents[first[slot + 1]]
+ *
+ * @param dependents
+ *  The slots of the options which reference the option
+ *
+ * @param order
+ *  The slots of the options in the topological order
+ *
+ * @param values
+ *  The expanded values (NULL for options without references)
+ *
+ * @param valid
+ *  The expanded value is up to date
+ *
+ * @param dirty
+ *  The references have changed, the graph has to be rebuilt
+ *
+ * @param failed
+ *  The graph could not be built (unknown or circular references), the
+ *  expanded values are not available until the config changes
+ *
+ * @param scratch
+ *  Text of the arrays too long for the value string
+ */
+typedef struct LRC_configInterp{
+  LRC_configIndex* index;
+  size_t* first;
+  size_t* dependents;
+  size_t* order;
+  char** values;
+  unsigned char* valid;
+  int dirty;
+  int failed;
+  LRC_buffer scratch;
+} LRC_configInterp;
+
+int LRC_interpRef(char* str, char** start, char** end, char* space, char* name);
+int LRC_interpLiteral(LRC_buffer* out, char* str, size_t len);
+int LRC_interpEval(LRC_configInterp* interp, size_t slot);
+int LRC_interpUpdate(LRC_configInterp* interp);
+char* LRC_interpValue(LRC_configInterp* interp, size_t slot);
+char* LRC_interpGet(LRC_configNamespace* head, char* space, LRC_configOptions* option);
+void LRC_changed(LRC_configNamespace* head, char* space, LRC_configOptions* option);
+void LRC_freeInterp(LRC_configInterp* interp);
+
+/**
+ * @var typedef struct LRC_hashEntry
+ * @brief Contribution of the option to the fingerprint
+ *
+ * @param option
+ *  The option (NULL for free slots)
+ *
+ * @param h
+ *  The 128-bit hash of the option
+ */
+typedef struct{
+  LRC_configOptions* option;
+  uint64_t h[2];
+} LRC_hashEntry;
+
+/**
+ * @var typedef struct LRC_configHash
+ * @brief Fingerprint state of the config
+ *
+ * @param sum
+ *  The sum of the contributions of all options (both lanes)
+ *
+ * @param count
+ *  Number of options
+ *
+ * @param size
+ *  Number of slots of the table (a power of two)
+ *
+ * @param entries
+ *  The contributions, keyed by the option
+ *
+ * @param dirty
+ *  Many options have changed, the sum has to be computed again
+ */
+typedef struct LRC_configHash{
+  uint64_t sum[2];
+  size_t count;
+  size_t size;
+  LRC_hashEntry* entries;
+  int dirty;
+} LRC_configHash;
+
+uint64_t LRC_hashMix(uint64_t h);
+void LRC_hashBytes(uint64_t* lanes, const char* p, size_t n);
+void LRC_hashWord(uint64_t* lanes, uint64_t v);
+void LRC_hashDouble(uint64_t* lanes, double d);
+void LRC_hashOf(char* space, LRC_configOptions* option, uint64_t* h);
+LRC_hashEntry* LRC_hashSlot(LRC_configHash* hash, LRC_configOptions* option);
+int LRC_hashBuild(LRC_configNamespace* head, LRC_configHash* hash);
+void LRC_hashChanged(LRC_configNamespace* head, char* space, LRC_configOptions* option);
+void LRC_hashNamespace(LRC_configNamespace* space, uint64_t* h);
+void LRC_freeHash(LRC_configHash* hash);
+
+/**
+ * @var typedef struct LRC_configLoad
+ * @brief Config loaded in the background
+ *
+ * @param thread
+ *  The loading thread
+ *
+ * @param lock
+ *  Guards the result
+ *
+ * @param path
+ *  Copy of the path of the config file
+ *
+ * @param sep
+ *  Copy of the separator
+ *
+ * @param comm
+ *  Copy of the comment mark
+ *
+ * @param group
+ *  Copy of the name of the config group of the HDF5 file (NULL for the ASCII
+ *  files)
+ *
+ * @param cd
+ *  The defaults
+ *
+ * @param head
+ *  The loaded config (NULL on failure)
+ *
+ * @param threaded
+ *  The thread was started and has to be joined
+ *
+ * @param done
+ *  The result is ready
+ */
+typedef struct LRC_configLoad{
+  pthread_t thread;
+  pthread_mutex_t lock;
+  char* path;
+  char* sep;
+  char* comm;
+  char* group;
+  LRC_configDefaults* cd;
+  LRC_configNamespace* head;
+  int threaded;
+  int done;
+} LRC_configLoad;
+
+void LRC_loadRun(LRC_configLoad* load);
+void* LRC_loadThread(void* arg);
+
+/**
+ * @var typedef struct LRC_poptTarget
+ * @brief Data of the callback of the popt table
+ *
+ * @param head
+ *  The config
+ *
+ * @param layers
+ *  The layered config (NULL if the values go to the config)
+ *
+ * @param errors
+ *  Number of wrong arguments
+ *
+ * @param spaces
+ *  The namespaces of the options, in the order of the table
+ *
+ * @param options
+ *  The options, in the order of the table
+ */
+typedef struct{
+  LRC_configNamespace* head;
+  LRC_configLayers* layers;
+  int errors;
+  LRC_configNamespace** spaces;
+  LRC_configOptions** options;
+} LRC_poptTarget;
+
+void LRC_poptCallback(poptContext con, enum poptCallbackReason reason,
+    const struct poptOption* opt, const char* arg, const void* data);
+struct poptOption* LRC_poptBuild(LRC_configDefaults* cd, LRC_configIndex* index, LRC_configLayers* layers);
+
+/**
+ * @var typedef struct LRC_decimal
+ * @brief Decimal number split by the parser
+ *
+ * @param w
+ *  Up to 19 significant digits
+ *
+ * @param q
+ *  Decimal exponent, value = w * 10^q
+ *
+ * @param negative
+ *  The sign
+ *
+ * @param truncated
+ *  Non-zero digits were dropped from w
+ *
+ * @param special
+ *  One of LRC_DECIMAL_* (infinity, nan, or a syntax handled by the C library)
+ */
+#define LRC_DECIMAL_NONE 0
+#define LRC_DECIMAL_INF 1
+#define LRC_DECIMAL_NAN 2
+#define LRC_DECIMAL_OTHER 3
+
+typedef struct{
+  uint64_t w;
+  int q;
+  int negative;
+  int truncated;
+  int special;
+} LRC_decimal;
+
+/* Number formatting and parsing */
+void LRC_d2d(uint64_t mantissa, int exponent, uint64_t* digits, int* exp10);
+void LRC_f2d(uint32_t mantissa, int exponent, uint32_t* digits, int* exp10);
+int LRC_digits(uint64_t value, char* digits, int* exp10);
+int LRC_formatDecimal(char* str, int sign, char* digits, int ndigits, int exp10);
+int LRC_formatSpecial(char* str, int sign, int nan);
+int LRC_scanNumber(char* str, char* limit, char** end, LRC_decimal* d);
+int LRC_scanDecimal(char* str, LRC_decimal* d);
+int LRC_scanLong(char* str, char** end, long* value);
+int LRC_str2prefix(char* str, int type, void* value);
+int LRC_decimal2double(LRC_decimal* d, char* str, size_t len, double* value);
+int LRC_decimal2float(LRC_decimal* d, char* str, size_t len, float* value);
+int LRC_parseArray(char* str, int type, void** array, size_t* count);
+void LRC_eiselLemire(uint64_t w, int q, int mbits, int minexp, int infpow, int rtemin, int rtemax,
+    uint64_t* mantissa, int* power2);
+void LRC_strtoC(char* str, size_t len, int type, void* value);
+
+#if HAVE_MPI_H
+int LRC_MPI_BcastBuffer(MPI_Comm comm, int root, char** buf, size_t* len, int status);
+void LRC_MPI_Mismatch(LRC_configNamespace* head, int rank, char* space, char* name, char* message);
+#endif
 
 #if HAVE_HDF5_H
 /**
@@ -70,6 +467,78 @@ typedef struct{
   char value[LRC_CONFIG_LEN];
   int type;
 } ccd_t;
+
+/**
+ * @var typedef struct cch_t
+ * @brief Helper datatype used for HDF5 config history storage
+ *
+ * @param step
+ *  Step (or timestamp) at which the change was recorded
+ *
+ * @param space
+ *  Namespace of the variable
+ *
+ * @param name
+ *  Name of the variable
+ *
+ * @param value
+ *  Value of the variable
+ *
+ * @param type
+ *  Type of the variable
+ */
+typedef struct{
+  long long step;
+  char space[LRC_CONFIG_LEN];
+  char name[LRC_CONFIG_LEN];
+  char value[LRC_CONFIG_LEN];
+  int type;
+} cch_t;
+
+/**
+ * @var typedef struct LRC_configHistory
+ * @brief The version of the config last recorded in the history
+ *
+ * @param path
+ *  The name of the file
+ *
+ * @param name
+ *  The name of the history dataset
+ *
+ * @param records
+ *  Number of records in the dataset
+ *
+ * @param step
+ *  The step of the last record
+ *
+ * @param last
+ *  The last record, to check that the dataset was not changed
+ *
+ * @param recorded
+ *  The recorded version (invalid type for the options never recorded)
+ */
+typedef struct LRC_configHistory{
+  char* path;
+  char* name;
+  hsize_t records;
+  long long step;
+  cch_t last;
+  LRC_configNamespace* recorded;
+} LRC_configHistory;
+
+hid_t LRC_HDF5HistoryType(void);
+int LRC_HDF5HistoryReplay(hid_t dataset, hid_t cch_tid, long long step,
+    LRC_configNamespace* head, long long* last);
+int LRC_HDF5HistoryLast(hid_t dataset, hid_t cch_tid, hsize_t records, cch_t* record);
+int LRC_HDF5HistorySame(LRC_configNamespace* head, LRC_configNamespace* recorded);
+LRC_configHistory* LRC_HDF5HistoryState(hid_t file, char* history_name, hid_t dataset,
+    hid_t cch_tid, LRC_configNamespace* head);
+void LRC_freeHistory(LRC_configHistory* history);
+hid_t LRC_HDF5DatasetDcpl(hid_t dcpl, hsize_t n);
+int LRC_HDF5WriteArrays(hid_t group, LRC_configNamespace* head, long* shape,
+    hid_t dcpl, hid_t gapl, hid_t dapl, hid_t dxpl, int root);
+int LRC_HDF5ReadArrays(hid_t group, LRC_configNamespace* head, hid_t lapl, hid_t gapl, hid_t dapl);
+int LRC_HDF5ParseFile(char* path, char* group, LRC_configNamespace* head);
 #endif
 
 #endif
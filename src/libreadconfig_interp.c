@@ -0,0 +1,497 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_interp.c
+ * @brief Interpolation of the values: ${namespace.name} references.
+ *
+ * LRC_interpolate() builds the dependency graph of the config once: the
+ * references are resolved through the index and stored as the list of
+ * dependents of every option. The graph is sorted topologically (which also
+ * finds the cycles) and all values are expanded in that order, each from the
+ * already expanded values of its references.
+ *
+ * The expanded values are kept until an input changes. The change marks only
+ * the dependents of the option for the evaluation, which happens on the next
+ * read, again in the topological order. If the references themselves change
+ * (the option had or gets a reference), the graph is rebuilt on the next read.
+ *
+ * If the graph cannot be built, the config keeps the failed state: the reads
+ * fail (and report it) until the config changes and the graph is built again.
+ *
+ * $${ is a literal ${.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @fn int LRC_interpRef(char* str, char** start, char** end, char* space, char* name)
+ * @brief Finds the next reference in the value.
+ *
+ * @param start
+ *   The beginning of the reference (the $ character).
+ *
+ * @param end
+ *   The first character after the reference.
+ *
+ * @param space
+ *   The namespace of the reference.
+ *
+ * @param name
+ *   The name of the reference.
+ *
+ * @return
+ *  1 if the reference was found, 0 if there are no more references, -1 if
+ *  the reference is malformed
+ */
+int LRC_interpRef(char* str, char** start, char** end, char* space, char* name){
+
+  char* p = str;
+  char* dot;
+  char* close;
+
+  while ((p = strstr(p, "${")) != NULL) {
+
+    /* $${ is not a reference */
+    if (p > str && p[-1] == '$') {
+      p += 2;
+      continue;
+    }
+
+    close = strchr(p + 2, '}');
+    if (!close) return -1;
+
+    dot = memchr(p + 2, '.', (size_t)(close - p - 2));
+    if (!dot || dot == p + 2 || dot + 1 == close) return -1;
+    if (dot - p - 2 >= LRC_CONFIG_LEN || close - dot - 1 >= LRC_CONFIG_LEN) return -1;
+
+    memcpy(space, p + 2, (size_t)(dot - p - 2));
+    space[dot - p - 2] = LRC_NULL;
+    memcpy(name, dot + 1, (size_t)(close - dot - 1));
+    name[close - dot - 1] = LRC_NULL;
+
+    *start = p;
+    *end = close + 1;
+
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * @fn int LRC_interpLiteral(LRC_buffer* out, char* str, size_t len)
+ * @brief Appends the text between the references, with $${ written as ${.
+ *
+ * The text of the template is unescaped while it is scanned, so that the
+ * values of the references are copied as they are.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_interpLiteral(LRC_buffer* out, char* str, size_t len){
+
+  char* end = str + len;
+  char* p;
+  int status = 0;
+
+  for (p = str; p + 2 < end; p++) {
+    if (p[0] != '$' || p[1] != '$' || p[2] != '{') continue;
+    status |= LRC_bufferAppend(out, str, (size_t)(p + 1 - str));
+    str = p + 2;
+    p = str;
+  }
+  status |= LRC_bufferAppend(out, str, (size_t)(end - str));
+
+  return status;
+}
+
+/**
+ * @fn int LRC_interpEval(LRC_configInterp* interp, size_t slot)
+ * @brief Expands the value of the option (the references have to be valid).
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_interpEval(LRC_configInterp* interp, size_t slot){
+
+  LRC_configIndex* index = interp->index;
+  LRC_configOptions* option = index->options[slot];
+  LRC_buffer out = {NULL, 0, 0};
+  char space[LRC_CONFIG_LEN], name[LRC_CONFIG_LEN];
+  char* p = option->value;
+  char* start;
+  char* end;
+  char* value;
+  size_t ref, len;
+  int status = 0, found;
+
+  if (!strstr(option->value, "${")) {
+    if (interp->values[slot]) free(interp->values[slot]);
+    interp->values[slot] = NULL;
+    interp->valid[slot] = 1;
+    return 0;
+  }
+
+  while ((found = LRC_interpRef(p, &start, &end, space, name)) > 0) {
+    status |= LRC_interpLiteral(&out, p, (size_t)(start - p));
+
+    ref = LRC_indexSlot(index, space, name);
+    value = LRC_interpValue(interp, ref);
+    if (!value) goto failure;
+
+    status |= LRC_bufferAppend(&out, value, strlen(value));
+    p = end;
+  }
+  status |= LRC_interpLiteral(&out, p, strlen(p));
+  if (status || found < 0) goto failure;
+
+  len = out.len;
+  if (len >= LRC_CONFIG_LEN) {
+    LRC_report(index->head, LRC_ERR_CONFIG_SYNTAX, 0, 0, index->spaces[slot]->space, option->name,
+        LRC_MSG_TOO_LONG);
+    goto failure;
+  }
+
+  if (interp->values[slot]) free(interp->values[slot]);
+  interp->values[slot] = realloc(out.data, len + 1);
+  if (!interp->values[slot]) interp->values[slot] = out.data;
+  interp->valid[slot] = 1;
+
+  return 0;
+
+failure:
+  if (out.data) free(out.data);
+  return -1;
+}
+
+/**
+ * @fn int LRC_interpUpdate(LRC_configInterp* interp)
+ * @brief Evaluates the invalid options, in the topological order.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_interpUpdate(LRC_configInterp* interp){
+
+  size_t i;
+
+  for (i = 0; i < interp->index->count; i++) {
+    if (interp->valid[interp->order[i]]) continue;
+    if (LRC_interpEval(interp, interp->order[i]) < 0) return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @fn char* LRC_interpValue(LRC_configInterp* interp, size_t slot)
+ * @brief The expanded value of the option in the slot, evaluated if needed.
+ *
+ * @return
+ *  The value or NULL on failure
+ */
+char* LRC_interpValue(LRC_configInterp* interp, size_t slot){
+
+  LRC_configOptions* option = interp->index->options[slot];
+
+  if (!option) return NULL;
+
+  if (!interp->valid[slot] && LRC_interpUpdate(interp) < 0) return NULL;
+
+  if (interp->values[slot]) return interp->values[slot];
+
+  /* Arrays too long for the value string */
+  if (LRC_isArray(option->type) && option->value[0] == LRC_NULL && option->count > 0) {
+    interp->scratch.len = 0;
+    if (LRC_formatArray(&interp->scratch, option) < 0) return NULL;
+    return interp->scratch.data;
+  }
+
+  return option->value;
+}
+
+/**
+ * @fn int LRC_interpolate(LRC_configNamespace* head)
+ * @brief Builds the dependency graph of the config and expands the values.
+ *
+ * Call it after the config is read. From then on, the getters (see
+ * LRC_getOptionValue()) return the expanded values, while the writers keep
+ * the references. The state is freed with the config.
+ *
+ * @return
+ *  0 on success, -1 if any reference is unknown or circular (the getters fail
+ *  then, until the config is changed and the graph can be built)
+ */
+int LRC_interpolate(LRC_configNamespace* head){
+
+  LRC_configInterp* interp = NULL;
+  LRC_configIndex* index = NULL;
+  LRC_configOptions* option = NULL;
+  char space[LRC_CONFIG_LEN], name[LRC_CONFIG_LEN], msg[4*LRC_CONFIG_LEN + 64];
+  char* p;
+  char* start;
+  char* end;
+  size_t* indegree = NULL;
+  size_t* queue = NULL;
+  size_t* fill = NULL;
+  size_t slot, ref, i, qhead = 0, qtail = 0;
+  int found, pass;
+
+  if (!head) {
+    perror("LRC_interpolate: no config assigned");
+    return -1;
+  }
+
+  LRC_freeInterp(head->interp);
+  head->interp = NULL;
+
+  interp = calloc(1, sizeof(LRC_configInterp));
+  if (!interp) goto alloc_failure;
+
+  interp->index = index = LRC_indexConfig(head);
+  if (!index) goto failure;
+
+  interp->first = calloc(index->size + 1, sizeof(size_t));
+  interp->values = calloc(index->size, sizeof(char*));
+  interp->valid = calloc(index->size, 1);
+  indegree = calloc(index->size, sizeof(size_t));
+  interp->order = queue = malloc((index->count + 1) * sizeof(size_t));
+  if (!interp->first || !interp->values || !interp->valid || !indegree || !queue) goto alloc_failure;
+
+  /* The edges are stored as the lists of dependents of every option. The
+   * first pass counts them, the second fills the lists */
+  for (pass = 0; pass < 2; pass++) {
+    for (slot = 0; slot < index->size; slot++) {
+      option = index->options[slot];
+      if (!option) continue;
+
+      p = option->value;
+      while ((found = LRC_interpRef(p, &start, &end, space, name)) > 0) {
+        ref = LRC_indexSlot(index, space, name);
+        if (!index->options[ref]) {
+          sprintf(msg, "%s: ${%s.%s}", LRC_MSG_UNKNOWN_VAR, space, name);
+          LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, index->spaces[slot]->space, option->name, msg);
+          goto failure;
+        }
+
+        if (pass == 0) {
+          interp->first[ref + 1]++;
+          indegree[slot]++;
+        } else {
+          interp->dependents[fill[ref]++] = slot;
+        }
+        p = end;
+      }
+
+      if (found < 0) {
+        LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, index->spaces[slot]->space, option->name,
+            "Malformed reference");
+        goto failure;
+      }
+    }
+
+    if (pass == 0) {
+      for (slot = 0; slot < index->size; slot++) interp->first[slot + 1] += interp->first[slot];
+
+      interp->dependents = malloc((interp->first[index->size] + 1) * sizeof(size_t));
+      fill = malloc(index->size * sizeof(size_t));
+      if (!interp->dependents || !fill) goto alloc_failure;
+      memcpy(fill, interp->first, index->size * sizeof(size_t));
+    }
+  }
+
+  /* Topological order: an option is expanded when all its references are.
+   * The queue is kept as the order of the later evaluations */
+  for (slot = 0; slot < index->size; slot++) {
+    if (index->options[slot] && indegree[slot] == 0) queue[qtail++] = slot;
+  }
+
+  while (qhead < qtail) {
+    slot = queue[qhead++];
+    if (LRC_interpEval(interp, slot) < 0) goto failure;
+
+    for (i = interp->first[slot]; i < interp->first[slot + 1]; i++) {
+      ref = interp->dependents[i];
+      if (--indegree[ref] == 0) queue[qtail++] = ref;
+    }
+  }
+
+  /* Whatever is left is on a cycle, or depends on one */
+  if (qtail < index->count) {
+    for (slot = 0; slot < index->size; slot++) {
+      if (!index->options[slot] || indegree[slot] == 0) continue;
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, index->spaces[slot]->space,
+          index->options[slot]->name, "Circular reference");
+    }
+    goto failure;
+  }
+
+  free(indegree);
+  free(fill);
+
+  head->interp = interp;
+
+  return 0;
+
+alloc_failure:
+  perror("LRC_interpolate: alloc failed");
+
+failure:
+  if (indegree) free(indegree);
+  if (fill) free(fill);
+  LRC_freeInterp(interp);
+
+  /* The raw references must not be returned as values */
+  head->interp = calloc(1, sizeof(LRC_configInterp));
+  if (head->interp) head->interp->failed = 1;
+  return -1;
+}
+
+/**
+ * @fn char* LRC_interpGet(LRC_configNamespace* head, char* space, LRC_configOptions* option)
+ * @brief The expanded value of the option, see LRC_getOptionValue().
+ *
+ * The graph is rebuilt first, if the references have changed.
+ *
+ * @return
+ *  The value or NULL on failure
+ */
+char* LRC_interpGet(LRC_configNamespace* head, char* space, LRC_configOptions* option){
+
+  LRC_configInterp* interp = head->interp;
+
+  if (interp->dirty) {
+    if (LRC_interpolate(head) < 0) return NULL;
+    interp = head->interp;
+  }
+
+  if (interp->failed) {
+    LRC_report(head, LRC_ERR_CONFIG_SYNTAX, 0, 0, space, option->name, LRC_MSG_INTERP);
+    return NULL;
+  }
+
+  return LRC_interpValue(interp, LRC_indexSlot(interp->index, space, option->name));
+}
+
+/**
+ * @fn void LRC_changed(LRC_configNamespace* head, char* space, LRC_configOptions* option)
+ * @brief Notifies the config that the value of the option has changed.
+ *
+ * The fingerprint is updated (see LRC_hash()). The expanded values of the
+ * dependents are dropped, they are evaluated again on the next read.
+ *
+ * @param option
+ *   The changed option, or NULL if any number of options could have changed
+ *   (e.g. the config was read).
+ */
+void LRC_changed(LRC_configNamespace* head, char* space, LRC_configOptions* option){
+
+  LRC_configInterp* interp = NULL;
+  size_t* stack = NULL;
+  size_t slot, i, n = 0;
+
+  if (!head) return;
+
+  LRC_hashChanged(head, space, option);
+
+  if (!head->interp) return;
+  interp = head->interp;
+
+  if (!option || !space || interp->failed) {
+    interp->dirty = 1;
+    return;
+  }
+
+  slot = LRC_indexSlot(interp->index, space, option->name);
+
+  /* The references could have changed */
+  if (interp->values[slot] || strstr(option->value, "${")) {
+    interp->dirty = 1;
+    return;
+  }
+
+  if (interp->first[slot] == interp->first[slot + 1]) return;
+
+  /* Every option is pushed at most once, when it is invalidated. The
+   * dependents of an invalid option are invalid already */
+  stack = malloc(interp->index->count * sizeof(size_t));
+  if (!stack) {
+    interp->dirty = 1;
+    return;
+  }
+
+  stack[n++] = slot;
+  while (n > 0) {
+    slot = stack[--n];
+    for (i = interp->first[slot]; i < interp->first[slot + 1]; i++) {
+      if (!interp->valid[interp->dependents[i]]) continue;
+      interp->valid[interp->dependents[i]] = 0;
+      stack[n++] = interp->dependents[i];
+    }
+  }
+
+  free(stack);
+}
+
+/**
+ * @fn void LRC_freeInterp(LRC_configInterp* interp)
+ * @brief Frees the interpolation state (the config is not touched).
+ */
+void LRC_freeInterp(LRC_configInterp* interp){
+
+  size_t i;
+
+  if (!interp) return;
+
+  if (interp->values) {
+    for (i = 0; i < interp->index->size; i++) {
+      if (interp->values[i]) free(interp->values[i]);
+    }
+    free(interp->values);
+  }
+
+  if (interp->first) free(interp->first);
+  if (interp->order) free(interp->order);
+  if (interp->dependents) free(interp->dependents);
+  if (interp->valid) free(interp->valid);
+  if (interp->scratch.data) free(interp->scratch.data);
+  LRC_freeIndex(interp->index);
+  free(interp);
+}
@@ -0,0 +1,509 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_layers.c
+ * @brief Layered config: defaults, system file, user file, environment and
+ * command line.
+ *
+ * Every layer above the defaults is an overlay of the defaults and holds only
+ * the options set in that layer. The layers are never merged: a lookup probes
+ * the index of the defaults once, and the bit mask kept for the slot tells
+ * which layers have the value, so the value of the topmost one is read from
+ * its overlay. The precedence and the source of the value (provenance) cost
+ * the same single probe.
+ *
+ * Environment variables are named LRC_<NAMESPACE>_<NAME>, upper case, with
+ * characters other than letters and digits replaced by '_'. The names are
+ * hashed into a table of the index slots when the layers are created, so the
+ * environment is read in a single pass.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+extern char** environ;
+
+/**
+ * @fn size_t LRC_layerEnvName(char* key, char* space, char* name)
+ * @brief Writes the environment variable name of the option into key
+ * (2*LRC_CONFIG_LEN + 8 characters).
+ *
+ * @return
+ *  The length of the name
+ */
+size_t LRC_layerEnvName(char* key, char* space, char* name){
+
+  char* c;
+
+  sprintf(key, "LRC_%s_%s", space, name);
+  for (c = key + 4; *c; c++) {
+    *c = isalnum((unsigned char)*c) ? (char)toupper((unsigned char)*c) : '_';
+  }
+
+  return (size_t)(c - key);
+}
+
+/**
+ * @fn uint64_t LRC_layerEnvHash(const char* key, size_t len)
+ * @brief FNV-1a hash of the first len characters of the variable name.
+ */
+uint64_t LRC_layerEnvHash(const char* key, size_t len){
+
+  uint64_t h = UINT64_C(0xcbf29ce484222325);
+  size_t i;
+
+  for (i = 0; i < len; i++) {
+    h ^= (unsigned char)key[i];
+    h *= UINT64_C(0x100000001b3);
+  }
+
+  return h;
+}
+
+/**
+ * @fn LRC_configLayers* LRC_newLayers(LRC_configDefaults* cd)
+ * @brief Creates the layered config with the defaults as the bottom layer.
+ *
+ * @param cd
+ *   The defaults, see LRC_assignDefaults().
+ *
+ * @return
+ *  The layered config or NULL on failure
+ */
+LRC_configLayers* LRC_newLayers(LRC_configDefaults* cd){
+
+  LRC_configLayers* layers = NULL;
+  LRC_configIndex* index = NULL;
+  char key[2*LRC_CONFIG_LEN + 8];
+  size_t slot, k, len;
+  int i;
+
+  layers = calloc(1, sizeof(LRC_configLayers));
+  if (!layers) goto failure;
+
+  layers->defaults = LRC_assignDefaults(cd);
+  if (!layers->defaults) goto failure;
+
+  layers->index = LRC_indexConfig(layers->defaults);
+  if (!layers->index) goto failure;
+
+  for (i = LRC_LAYER_DEFAULTS + 1; i < LRC_LAYERS; i++) {
+    layers->layers[i] = LRC_newOverlay(layers->index);
+    if (!layers->layers[i]) goto failure;
+  }
+
+  /* The defaults have every option */
+  layers->masks = malloc(layers->index->size);
+  if (!layers->masks) goto failure;
+  memset(layers->masks, 1 << LRC_LAYER_DEFAULTS, layers->index->size);
+
+  /* Environment names, at most half full as the index */
+  index = layers->index;
+  layers->env = calloc(index->size, sizeof(size_t));
+  if (!layers->env) goto failure;
+
+  for (slot = 0; slot < index->size; slot++) {
+    if (!index->options[slot]) continue;
+
+    len = LRC_layerEnvName(key, index->spaces[slot]->space, index->options[slot]->name);
+    k = (size_t)LRC_layerEnvHash(key, len) & (index->size - 1);
+    while (layers->env[k]) k = (k + 1) & (index->size - 1);
+    layers->env[k] = slot + 1;
+  }
+
+  return layers;
+
+failure:
+  perror("LRC_newLayers: alloc failed");
+  LRC_freeLayers(layers);
+  return NULL;
+}
+
+/**
+ * @fn int LRC_layerSet(LRC_configLayers* layers, int layer, char* space, char* var, char* value)
+ * @brief Sets the value of the option in the layer.
+ *
+ * The value has the type of the default. The defaults are not changed, the
+ * layer must be one above LRC_LAYER_DEFAULTS.
+ *
+ * @return
+ *  0 on success, -1 if the option does not exist or the value is wrong
+ */
+int LRC_layerSet(LRC_configLayers* layers, int layer, char* space, char* var, char* value){
+
+  LRC_configOptions* option = NULL;
+  size_t slot;
+
+  if (!layers || !space || !var || !value) return -1;
+  if (layer <= LRC_LAYER_DEFAULTS || layer >= LRC_LAYERS) return -1;
+
+  slot = LRC_indexSlot(layers->index, space, var);
+  option = layers->index->options[slot];
+  if (!option) return -1;
+
+  if (LRC_overlaySet(layers->layers[layer], space, var, value, option->type) < 0) return -1;
+
+  layers->masks[slot] |= (unsigned char)(1 << layer);
+
+  return 0;
+}
+
+/**
+ * @fn int LRC_layerFile(LRC_configLayers* layers, int layer, char* path, char* sep, char* comm)
+ * @brief Reads the ASCII config file into the layer.
+ *
+ * Only the options present in the file are stored in the layer. The file is
+ * optional: if it does not exist, the layer stays empty. The file is parsed
+ * into layers->scratch, a copy of the defaults made on the first call (the
+ * parser resets the value spans of the previous file).
+ *
+ * @param layer
+ *   LRC_LAYER_SYSTEM or LRC_LAYER_USER (any layer above the defaults).
+ *
+ * @return
+ *  Number of options read from the file (0 if the file does not exist), -1 on
+ *  failure
+ */
+int LRC_layerFile(LRC_configLayers* layers, int layer, char* path, char* sep, char* comm){
+
+  FILE* file = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* currentOP = NULL;
+  LRC_buffer buf = {NULL, 0, 0};
+  LRC_configDiag* diag = NULL;
+  char* previous = NULL;
+  char* value;
+  int n = 0, status;
+
+  if (!layers || !path) return -1;
+
+  file = fopen(path, "r");
+  if (!file) {
+    if (errno == ENOENT) return 0;
+    LRC_report(layers->defaults, LRC_ERR_FILE_OPEN, 0, 0, NULL, NULL, path);
+    return -1;
+  }
+
+  /* The parser checks the file against the defaults. The options read from
+   * the file are the ones with the value span set. The errors go to the
+   * handler of the defaults */
+  if (!layers->scratch) {
+    layers->scratch = LRC_copyConfig(layers->defaults);
+    if (!layers->scratch) goto failure;
+  }
+
+  diag = LRC_diagOf(layers->defaults);
+  if (diag) {
+    previous = diag->file;
+    diag->file = path;
+  }
+  layers->scratch->diag = diag;
+  status = LRC_ASCIIParser(file, sep, comm, layers->scratch);
+  layers->scratch->diag = NULL;
+  if (diag) diag->file = previous;
+
+  if (status < 0) goto failure;
+
+  for (current = layers->scratch; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      if (currentOP->length == 0) continue;
+
+      value = currentOP->value;
+
+      /* Arrays too long for the value string */
+      if (LRC_isArray(currentOP->type) && value[0] == LRC_NULL && currentOP->count > 0) {
+        buf.len = 0;
+        if (LRC_formatArray(&buf, currentOP) < 0) goto failure;
+        value = buf.data;
+      }
+
+      if (LRC_layerSet(layers, layer, current->space, currentOP->name, value) < 0) goto failure;
+      n++;
+    }
+  }
+
+  if (buf.data) free(buf.data);
+  fclose(file);
+
+  return n;
+
+failure:
+  if (buf.data) free(buf.data);
+  fclose(file);
+  return -1;
+}
+
+/**
+ * @fn int LRC_layerEnv(LRC_configLayers* layers)
+ * @brief Reads the LRC_<NAMESPACE>_<NAME> environment variables into the
+ * LRC_LAYER_ENV layer.
+ *
+ * @return
+ *  Number of options set from the environment, -1 on failure
+ */
+int LRC_layerEnv(LRC_configLayers* layers){
+
+  LRC_configIndex* index = NULL;
+  char** env = NULL;
+  char key[2*LRC_CONFIG_LEN + 8];
+  char* eq;
+  size_t slot, k, len;
+  int n = 0;
+
+  if (!layers) return -1;
+  index = layers->index;
+
+  for (env = environ; env && *env; env++) {
+    if (strncmp(*env, "LRC_", 4) != 0) continue;
+
+    eq = strchr(*env, '=');
+    if (!eq) continue;
+    len = (size_t)(eq - *env);
+
+    /* Different options may share the name, e.g. "a-b" and "a_b" */
+    k = (size_t)LRC_layerEnvHash(*env, len) & (index->size - 1);
+    for (; layers->env[k]; k = (k + 1) & (index->size - 1)) {
+      slot = layers->env[k] - 1;
+      if (LRC_layerEnvName(key, index->spaces[slot]->space, index->options[slot]->name) != len
+          || strncmp(key, *env, len) != 0) {
+        continue;
+      }
+
+      if (LRC_layerSet(layers, LRC_LAYER_ENV, index->spaces[slot]->space,
+            index->options[slot]->name, eq + 1) < 0) {
+        LRC_report(layers->defaults, LRC_ERR_WRONG_INPUT, 0, 0, index->spaces[slot]->space,
+            index->options[slot]->name, key);
+        return -1;
+      }
+      n++;
+    }
+  }
+
+  return n;
+}
+
+/**
+ * @fn char* LRC_layerGet(LRC_configLayers* layers, char* space, char* var, int* layer)
+ * @brief The value of the option from the topmost layer which has it.
+ *
+ * The value is the text as written, the references (${namespace.name}) are
+ * not expanded. For the expanded values, see LRC_layers2config() and
+ * LRC_interpolate().
+ *
+ * @param layer
+ *   If not NULL, the layer of the value is stored there.
+ *
+ * @return
+ *  The value (owned by the layers) or NULL if the option does not exist
+ */
+char* LRC_layerGet(LRC_configLayers* layers, char* space, char* var, int* layer){
+
+  LRC_configOptions* option = NULL;
+  LRC_overlayOption* entry = NULL;
+  unsigned char mask;
+  size_t slot;
+  int top;
+
+  if (!layers || !space || !var) return NULL;
+
+  slot = LRC_indexSlot(layers->index, space, var);
+  option = layers->index->options[slot];
+  if (!option) return NULL;
+
+  mask = layers->masks[slot];
+  for (top = LRC_LAYERS - 1; top > LRC_LAYER_DEFAULTS; top--) {
+    if (mask & (1 << top)) break;
+  }
+
+  if (layer) *layer = top;
+
+  if (top == LRC_LAYER_DEFAULTS) return option->value;
+
+  entry = LRC_overlaySlot(layers->layers[top], option);
+  return entry->value;
+}
+
+/**
+ * @fn int LRC_layerSource(LRC_configLayers* layers, char* space, char* var)
+ * @brief The layer which provides the value of the option.
+ *
+ * @return
+ *  One of LRC_LAYER_*, -1 if the option does not exist
+ */
+int LRC_layerSource(LRC_configLayers* layers, char* space, char* var){
+
+  int layer = -1;
+
+  LRC_layerGet(layers, space, var, &layer);
+
+  return layer;
+}
+
+/**
+ * @fn char* LRC_layerName(int layer)
+ * @brief Name of the layer, for messages.
+ */
+char* LRC_layerName(int layer){
+
+  switch (layer) {
+    case LRC_LAYER_DEFAULTS: return "defaults";
+    case LRC_LAYER_SYSTEM: return "system file";
+    case LRC_LAYER_USER: return "user file";
+    case LRC_LAYER_ENV: return "environment";
+    case LRC_LAYER_CLI: return "command line";
+    default: return "unknown";
+  }
+}
+
+/**
+ * @fn int LRC_layerGetInt(LRC_configLayers* layers, char* space, char* var, int* value)
+ * @brief Converts the value of the option to int, see LRC_getInt().
+ *
+ * @return
+ *  LRC_NUMBER_OK, LRC_NUMBER_INVALID (also if the option does not exist) or
+ *  LRC_NUMBER_RANGE
+ */
+int LRC_layerGetInt(LRC_configLayers* layers, char* space, char* var, int* value){
+
+  char* str = LRC_layerGet(layers, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2int(str, value);
+}
+
+/**
+ * @fn int LRC_layerGetLong(LRC_configLayers* layers, char* space, char* var, long* value)
+ * @brief Converts the value of the option to long.
+ */
+int LRC_layerGetLong(LRC_configLayers* layers, char* space, char* var, long* value){
+
+  char* str = LRC_layerGet(layers, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2long(str, value);
+}
+
+/**
+ * @fn int LRC_layerGetFloat(LRC_configLayers* layers, char* space, char* var, float* value)
+ * @brief Converts the value of the option to float.
+ */
+int LRC_layerGetFloat(LRC_configLayers* layers, char* space, char* var, float* value){
+
+  char* str = LRC_layerGet(layers, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2float(str, value);
+}
+
+/**
+ * @fn int LRC_layerGetDouble(LRC_configLayers* layers, char* space, char* var, double* value)
+ * @brief Converts the value of the option to double.
+ */
+int LRC_layerGetDouble(LRC_configLayers* layers, char* space, char* var, double* value){
+
+  char* str = LRC_layerGet(layers, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2double(str, value);
+}
+
+/**
+ * @fn LRC_configNamespace* LRC_layers2config(LRC_configLayers* layers)
+ * @brief Creates the resolved config (every option from its topmost layer),
+ * e.g. for the writers.
+ *
+ * @return
+ *  The new config (free with LRC_cleanup()) or NULL on failure
+ */
+LRC_configNamespace* LRC_layers2config(LRC_configLayers* layers){
+
+  LRC_configNamespace* copy = NULL;
+  LRC_configNamespace* baseNM = NULL;
+  LRC_configNamespace* copyNM = NULL;
+  LRC_configOptions* baseOP = NULL;
+  LRC_configOptions* copyOP = NULL;
+  char* value;
+  int layer;
+
+  if (!layers) return NULL;
+
+  copy = LRC_copyConfig(layers->defaults);
+  if (!copy) return NULL;
+
+  /* The copy has the layout of the defaults */
+  for (baseNM = layers->defaults, copyNM = copy; baseNM;
+      baseNM = baseNM->next, copyNM = copyNM->next) {
+    for (baseOP = baseNM->options, copyOP = copyNM->options; baseOP;
+        baseOP = baseOP->next, copyOP = copyOP->next) {
+      value = LRC_layerGet(layers, baseNM->space, baseOP->name, &layer);
+      if (layer == LRC_LAYER_DEFAULTS) continue;
+
+      if (LRC_storeValue(copyOP, value, baseOP->type) < 0) goto failure;
+    }
+  }
+
+  return copy;
+
+failure:
+  LRC_cleanup(copy);
+  return NULL;
+}
+
+/**
+ * @fn void LRC_freeLayers(LRC_configLayers* layers)
+ * @brief Frees the layered config.
+ */
+void LRC_freeLayers(LRC_configLayers* layers){
+
+  int i;
+
+  if (!layers) return;
+
+  for (i = 0; i < LRC_LAYERS; i++) LRC_freeOverlay(layers->layers[i]);
+  if (layers->masks) free(layers->masks);
+  if (layers->env) free(layers->env);
+  if (layers->scratch) LRC_cleanup(layers->scratch);
+  LRC_freeIndex(layers->index);
+  if (layers->defaults) LRC_cleanup(layers->defaults);
+  free(layers);
+}
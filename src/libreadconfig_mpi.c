@@ -0,0 +1,440 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_mpi.c
+ * @brief Distribution of the config between MPI ranks.
+ *
+ * The config is parsed once, on the root, and the values are shipped to the
+ * other ranks in the packed form of LRC_packConfig(). Each rank applies them to
+ * its own tree of defaults, so only the root touches the file system.
+ *
+ * LRC_MPI_NodeBcast() sends the buffer once per node: the node leaders receive
+ * it into a shared memory window, and the ranks of the node unpack it from
+ * there (MPI-3; LRC_MPI_Bcast() is used with older MPI).
+ *
+ * LRC_MPI_Verify() checks that all ranks run with the same config. The
+ * fingerprints (LRC_hash128()) are compared with a single allreduce; only when
+ * they differ, the hashes of the namespaces and then of the options of the
+ * differing namespaces are compared with rank 0, and each differing option is
+ * reported.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+#if HAVE_MPI_H
+#include "libreadconfig_mpi.h"
+
+/**
+ * @fn int LRC_MPI_Bcast(MPI_Comm comm, int root, LRC_configNamespace* head)
+ * @brief Broadcasts the config of the root to all ranks of the communicator.
+ *
+ * Collective. The config of the root is left untouched, the other ranks get
+ * its values (the tree must be created from the same defaults).
+ *
+ * @param comm
+ *  The communicator
+ *
+ * @param root
+ *  The rank with the config
+ *
+ * @param head
+ *  Pointer to the structure with default values (the config on the root)
+ *
+ * @return
+ *  0 on success, -1 on failure (on all ranks)
+ */
+int LRC_MPI_Bcast(MPI_Comm comm, int root, LRC_configNamespace* head){
+
+  char* buf = NULL;
+  size_t len = 0;
+  long header = -1;
+  int rank, status = 0;
+
+  MPI_Comm_rank(comm, &rank);
+
+  if (rank == root) {
+    buf = LRC_packConfig(head, &len);
+    if (buf && len <= INT_MAX) header = (long)len;
+  }
+
+  /* The header tells the other ranks whether the root succeeded */
+  MPI_Bcast(&header, 1, MPI_LONG, root, comm);
+  if (header < 0) goto failure;
+
+  if (rank != root) {
+    buf = malloc(header > 0 ? (size_t)header : 1);
+    if (!buf) {
+      perror("LRC_MPI_Bcast: alloc failed");
+      status = -1;
+    }
+  }
+
+  /* A rank that cannot receive the config fails the call on all ranks */
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+  if (status < 0) goto failure;
+
+  MPI_Bcast(buf, (int)header, MPI_CHAR, root, comm);
+
+  if (rank != root) {
+    if (LRC_unpackConfig(buf, (size_t)header, head) < 0) status = -1;
+  }
+
+  free(buf);
+
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+  return status;
+
+failure:
+  if (buf) free(buf);
+  return -1;
+}
+
+/**
+ * @fn int LRC_MPI_NodeBcast(MPI_Comm comm, int root, LRC_configNamespace* head)
+ * @brief Broadcasts the config of the root once per node.
+ *
+ * Collective. The packed config goes from the root to one leader on each node
+ * (the root leads its own node), into a memory window shared by the node. The
+ * ranks of the node rebuild the config from the shared copy.
+ *
+ * @param comm
+ *  The communicator
+ *
+ * @param root
+ *  The rank with the config
+ *
+ * @param head
+ *  Pointer to the structure with default values (the config on the root)
+ *
+ * @return
+ *  0 on success, -1 on failure (on all ranks)
+ */
+int LRC_MPI_NodeBcast(MPI_Comm comm, int root, LRC_configNamespace* head){
+
+#if MPI_VERSION >= 3
+  MPI_Comm node = MPI_COMM_NULL, leaders = MPI_COMM_NULL;
+  MPI_Win win = MPI_WIN_NULL;
+  MPI_Aint size;
+  char* buf = NULL;
+  char* shared = NULL;
+  size_t len = 0;
+  long header = -1;
+  int rank, noderank, key, disp, status = 0;
+
+  MPI_Comm_rank(comm, &rank);
+
+  /* The root is the first rank of its node and of the leaders */
+  key = (rank == root) ? 0 : rank + 1;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &node);
+  MPI_Comm_rank(node, &noderank);
+  MPI_Comm_split(comm, noderank == 0 ? 0 : MPI_UNDEFINED, key, &leaders);
+
+  if (rank == root) {
+    buf = LRC_packConfig(head, &len);
+    if (buf && len <= INT_MAX) header = (long)len;
+  }
+
+  if (leaders != MPI_COMM_NULL) MPI_Bcast(&header, 1, MPI_LONG, 0, leaders);
+  MPI_Bcast(&header, 1, MPI_LONG, 0, node);
+  if (header < 0) goto failure;
+
+  MPI_Win_allocate_shared(noderank == 0 ? (MPI_Aint)header : 0, 1, MPI_INFO_NULL,
+      node, &shared, &win);
+  MPI_Win_shared_query(win, 0, &size, &disp, &shared);
+
+  MPI_Win_fence(0, win);
+  if (leaders != MPI_COMM_NULL) {
+    if (rank == root && header > 0) memcpy(shared, buf, (size_t)header);
+    MPI_Bcast(shared, (int)header, MPI_CHAR, 0, leaders);
+  }
+  MPI_Win_fence(0, win);
+
+  if (rank != root) {
+    if (LRC_unpackConfig(shared, (size_t)header, head) < 0) status = -1;
+  }
+
+  MPI_Win_fence(0, win);
+  MPI_Win_free(&win);
+  if (buf) free(buf);
+  if (leaders != MPI_COMM_NULL) MPI_Comm_free(&leaders);
+  MPI_Comm_free(&node);
+
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+  return status;
+
+failure:
+  if (buf) free(buf);
+  if (leaders != MPI_COMM_NULL) MPI_Comm_free(&leaders);
+  MPI_Comm_free(&node);
+  return -1;
+#else
+  return LRC_MPI_Bcast(comm, root, head);
+#endif
+}
+
+/**
+ * @fn int LRC_MPI_BcastBuffer(MPI_Comm comm, int root, char** buf, size_t* len, int status)
+ * @brief Broadcasts a buffer of the root (allocated on the other ranks).
+ *
+ * @param status
+ *  Negative if the root failed to prepare the buffer
+ *
+ * @return
+ *  0 on success, -1 if the root failed or a rank could not allocate the
+ *  buffer (on all ranks)
+ */
+int LRC_MPI_BcastBuffer(MPI_Comm comm, int root, char** buf, size_t* len, int status){
+
+  long header = -1;
+  int rank, ok = 0;
+
+  MPI_Comm_rank(comm, &rank);
+
+  if (rank == root && status >= 0 && *len <= INT_MAX) header = (long)*len;
+
+  MPI_Bcast(&header, 1, MPI_LONG, root, comm);
+  if (header < 0) return -1;
+
+  if (rank != root) {
+    *buf = malloc(header > 0 ? (size_t)header : 1);
+    if (!*buf) {
+      perror("LRC_MPI_BcastBuffer: alloc failed");
+      ok = -1;
+    }
+    *len = (size_t)header;
+  }
+
+  /* A rank that cannot receive the buffer fails the call on all ranks */
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+  if (ok < 0) {
+    if (rank != root && *buf) {
+      free(*buf);
+      *buf = NULL;
+    }
+    return -1;
+  }
+
+  if (header > 0) MPI_Bcast(*buf, (int)header, MPI_CHAR, root, comm);
+
+  return 0;
+}
+
+/**
+ * @fn void LRC_MPI_Mismatch(LRC_configNamespace* head, int rank, char* space, char* name, char* message)
+ * @brief Reports the option that differs on the rank.
+ */
+void LRC_MPI_Mismatch(LRC_configNamespace* head, int rank, char* space, char* name, char* message){
+
+  char text[128];
+
+  snprintf(text, sizeof(text), "%s (rank %d)", message, rank);
+  LRC_report(head, LRC_ERR_MPI, 0, 0, space, name, text);
+}
+
+/**
+ * @fn int LRC_MPI_Verify(MPI_Comm comm, LRC_configNamespace* head)
+ * @brief Checks that all ranks of the communicator have the same config.
+ *
+ * Collective. When the configs agree, this costs one allreduce of the
+ * fingerprints. Otherwise the namespaces and the options of rank 0 are
+ * compared on the other ranks, and each option that differs from rank 0, is
+ * missing or is not set on rank 0 is reported by the rank that has it
+ * (LRC_ERR_MPI, see LRC_setDiagnostics()).
+ *
+ * @param comm
+ *  The communicator
+ *
+ * @param head
+ *  Pointer to the config
+ *
+ * @return
+ *  0 if the configs are the same, -1 otherwise (on all ranks)
+ */
+int LRC_MPI_Verify(MPI_Comm comm, LRC_configNamespace* head){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  LRC_configIndex* index = NULL;
+  LRC_buffer buf = {NULL, 0, 0};
+  unsigned long long h[4];
+  uint64_t w[2], r[2];
+  unsigned char* flags = NULL;
+  char* seen = NULL;
+  char* spaces = NULL;
+  char* records = NULL;
+  char* p = NULL;
+  char* end = NULL;
+  char* space = NULL;
+  char* name = NULL;
+  size_t nspaces = 0, slen = 0, rlen = 0, i, slot;
+  int rank, status = 0;
+
+  LRC_hash128(head, w);
+
+  /* The maxima of the words and of their complements agree only if all ranks do */
+  h[0] = w[0]; h[1] = ~w[0];
+  h[2] = w[1]; h[3] = ~w[1];
+  MPI_Allreduce(MPI_IN_PLACE, h, 4, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+  if (h[0] == (unsigned long long)~h[1] && h[2] == (unsigned long long)~h[3]) return 0;
+
+  MPI_Comm_rank(comm, &rank);
+
+  /* The namespaces of rank 0 with their hashes */
+  if (rank == 0) {
+    for (current = head; current; current = current->next) {
+      LRC_hashNamespace(current, w);
+      if (LRC_bufferAppend(&buf, current->space, strlen(current->space) + 1) < 0
+          || LRC_bufferAppend(&buf, (char*)w, sizeof(w)) < 0) status = -1;
+    }
+    spaces = buf.data;
+    slen = buf.len;
+    buf.data = NULL;
+    buf.len = buf.size = 0;
+  }
+  if (LRC_MPI_BcastBuffer(comm, 0, &spaces, &slen, status) < 0) goto finalize;
+
+  for (p = spaces, end = spaces + slen; p < end; p += strlen(p) + 1 + sizeof(w)) nspaces++;
+
+  flags = calloc(nspaces + 1, sizeof(unsigned char));
+  status = flags ? 0 : -1;
+  if (!flags) perror("LRC_MPI_Verify: alloc failed");
+
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+  if (status < 0) goto finalize;
+
+  if (rank != 0) {
+    for (i = 0, p = spaces; p < end; i++) {
+      space = p;
+      p += strlen(p) + 1;
+      memcpy(r, p, sizeof(r));
+      p += sizeof(r);
+
+      current = LRC_findNamespace(space, head);
+      if (current) LRC_hashNamespace(current, w);
+      if (!current || w[0] != r[0] || w[1] != r[1]) flags[i] = 1;
+    }
+
+    /* The namespaces that rank 0 does not have */
+    for (current = head; current; current = current->next) {
+      for (p = spaces; p < end; p += strlen(p) + 1 + sizeof(w)) {
+        if (strcmp(p, current->space) == 0) break;
+      }
+      if (p < end) continue;
+      for (option = current->options; option; option = option->next) {
+        LRC_MPI_Mismatch(head, rank, current->space, option->name, LRC_MSG_MPI_EXTRA);
+      }
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, flags, (int)nspaces, MPI_UNSIGNED_CHAR, MPI_MAX, comm);
+
+  /* The options of rank 0 in the differing namespaces */
+  status = 0;
+  if (rank == 0) {
+    for (i = 0, current = head; current; i++, current = current->next) {
+      if (!flags[i]) continue;
+      for (option = current->options; option; option = option->next) {
+        LRC_hashOf(current->space, option, w);
+        if (LRC_bufferAppend(&buf, current->space, strlen(current->space) + 1) < 0
+            || LRC_bufferAppend(&buf, option->name, strlen(option->name) + 1) < 0
+            || LRC_bufferAppend(&buf, (char*)w, sizeof(w)) < 0) status = -1;
+      }
+    }
+    records = buf.data;
+    rlen = buf.len;
+  }
+  if (LRC_MPI_BcastBuffer(comm, 0, &records, &rlen, status) < 0) goto finalize;
+
+  if (rank != 0 && head) {
+    index = LRC_indexConfig(head);
+    if (!index) goto finalize;
+
+    seen = calloc(index->size, sizeof(char));
+    if (!seen) {
+      perror("LRC_MPI_Verify: alloc failed");
+      goto finalize;
+    }
+
+    for (p = records, end = records + rlen; p < end; ) {
+      space = p;
+      p += strlen(p) + 1;
+      name = p;
+      p += strlen(p) + 1;
+      memcpy(r, p, sizeof(r));
+      p += sizeof(r);
+
+      slot = LRC_indexSlot(index, space, name);
+      option = index->options[slot];
+      if (!option) {
+        LRC_MPI_Mismatch(head, rank, space, name, LRC_MSG_MPI_MISSING);
+        continue;
+      }
+
+      seen[slot] = 1;
+      LRC_hashOf(space, option, w);
+      if (w[0] != r[0] || w[1] != r[1]) {
+        LRC_MPI_Mismatch(head, rank, space, name, LRC_MSG_MPI_DIFFERS);
+      }
+    }
+
+    /* The options of the differing namespaces that rank 0 does not have */
+    for (i = 0, p = spaces, end = spaces + slen; p < end; i++, p += strlen(p) + 1 + sizeof(w)) {
+      if (!flags[i]) continue;
+      current = LRC_findNamespace(p, head);
+      if (!current) continue;
+      for (option = current->options; option; option = option->next) {
+        slot = LRC_indexSlot(index, current->space, option->name);
+        if (!seen[slot]) {
+          LRC_MPI_Mismatch(head, rank, current->space, option->name, LRC_MSG_MPI_EXTRA);
+        }
+      }
+    }
+  }
+
+finalize:
+  if (seen) free(seen);
+  if (index) LRC_freeIndex(index);
+  if (flags) free(flags);
+  if (records) free(records);
+  if (spaces) free(spaces);
+  if (buf.data && buf.data != records) free(buf.data);
+  return -1;
+}
+#endif
@@ -0,0 +1,2249 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_numeric.c
+ * @brief Number formatting and parsing.
+ *
+ * Floating point values are formatted with the shortest representation that
+ * reads back to exactly the same value (the Ryu algorithm by Ulf Adams,
+ * "Ryu: fast float-to-string conversion", PLDI 2018). The multiplier tables
+ * hold 5^i and 2^k/5^i, normalized to 125 (double) and 61/59 (float) bits.
+ *
+ * Parsing is locale independent, see @ref LRC_numeric_parse.
+ */
+
+/* newlocale and uselocale */
+#define _POSIX_C_SOURCE 200809L
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+static const uint64_t LRC_DOUBLE_POW5_INV_SPLIT[292][2] = {
+  { UINT64_C(1), UINT64_C(2305843009213693952) }, { UINT64_C(11068046444225730970), UINT64_C(1844674407370955161) },
+  { UINT64_C(5165088340638674453), UINT64_C(1475739525896764129) }, { UINT64_C(7821419487252849886), UINT64_C(1180591620717411303) },
+  { UINT64_C(8824922364862649494), UINT64_C(1888946593147858085) }, { UINT64_C(7059937891890119595), UINT64_C(1511157274518286468) },
+  { UINT64_C(13026647942995916322), UINT64_C(1208925819614629174) }, { UINT64_C(9774590264567735146), UINT64_C(1934281311383406679) },
+  { UINT64_C(11509021026396098440), UINT64_C(1547425049106725343) }, { UINT64_C(16585914450600699399), UINT64_C(1237940039285380274) },
+  { UINT64_C(15469416676735388068), UINT64_C(1980704062856608439) }, { UINT64_C(16064882156130220778), UINT64_C(1584563250285286751) },
+  { UINT64_C(9162556910162266299), UINT64_C(1267650600228229401) }, { UINT64_C(7281393426775805432), UINT64_C(2028240960365167042) },
+  { UINT64_C(16893161185646375315), UINT64_C(1622592768292133633) }, { UINT64_C(2446482504291369283), UINT64_C(1298074214633706907) },
+  { UINT64_C(7603720821608101175), UINT64_C(2076918743413931051) }, { UINT64_C(2393627842544570617), UINT64_C(1661534994731144841) },
+  { UINT64_C(16672297533003297786), UINT64_C(1329227995784915872) }, { UINT64_C(11918280793837635165), UINT64_C(2126764793255865396) },
+  { UINT64_C(5845275820328197809), UINT64_C(1701411834604692317) }, { UINT64_C(15744267100488289217), UINT64_C(1361129467683753853) },
+  { UINT64_C(3054734472329800808), UINT64_C(2177807148294006166) }, { UINT64_C(17201182836831481939), UINT64_C(1742245718635204932) },
+  { UINT64_C(6382248639981364905), UINT64_C(1393796574908163946) }, { UINT64_C(2832900194486363201), UINT64_C(2230074519853062314) },
+  { UINT64_C(5955668970331000884), UINT64_C(1784059615882449851) }, { UINT64_C(1075186361522890384), UINT64_C(1427247692705959881) },
+  { UINT64_C(12788344622662355584), UINT64_C(2283596308329535809) }, { UINT64_C(13920024512871794791), UINT64_C(1826877046663628647) },
+  { UINT64_C(3757321980813615186), UINT64_C(1461501637330902918) }, { UINT64_C(10384555214134712795), UINT64_C(1169201309864722334) },
+  { UINT64_C(5547241898389809503), UINT64_C(1870722095783555735) }, { UINT64_C(4437793518711847602), UINT64_C(1496577676626844588) },
+  { UINT64_C(10928932444453298728), UINT64_C(1197262141301475670) }, { UINT64_C(17486291911125277965), UINT64_C(1915619426082361072) },
+  { UINT64_C(6610335899416401726), UINT64_C(1532495540865888858) }, { UINT64_C(12666966349016942027), UINT64_C(1225996432692711086) },
+  { UINT64_C(12888448528943286597), UINT64_C(1961594292308337738) }, { UINT64_C(17689456452638449924), UINT64_C(1569275433846670190) },
+  { UINT64_C(14151565162110759939), UINT64_C(1255420347077336152) }, { UINT64_C(7885109000409574610), UINT64_C(2008672555323737844) },
+  { UINT64_C(9997436015069570011), UINT64_C(1606938044258990275) }, { UINT64_C(7997948812055656009), UINT64_C(1285550435407192220) },
+  { UINT64_C(12796718099289049614), UINT64_C(2056880696651507552) }, { UINT64_C(2858676849947419045), UINT64_C(1645504557321206042) },
+  { UINT64_C(13354987924183666206), UINT64_C(1316403645856964833) }, { UINT64_C(17678631863951955605), UINT64_C(2106245833371143733) },
+  { UINT64_C(3074859046935833515), UINT64_C(1684996666696914987) }, { UINT64_C(13527933681774397782), UINT64_C(1347997333357531989) },
+  { UINT64_C(10576647446613305481), UINT64_C(2156795733372051183) }, { UINT64_C(15840015586774465031), UINT64_C(1725436586697640946) },
+  { UINT64_C(8982663654677661702), UINT64_C(1380349269358112757) }, { UINT64_C(18061610662226169046), UINT64_C(2208558830972980411) },
+  { UINT64_C(10759939715039024913), UINT64_C(1766847064778384329) }, { UINT64_C(12297300586773130254), UINT64_C(1413477651822707463) },
+  { UINT64_C(15986332124095098083), UINT64_C(2261564242916331941) }, { UINT64_C(9099716884534168143), UINT64_C(1809251394333065553) },
+  { UINT64_C(14658471137111155161), UINT64_C(1447401115466452442) }, { UINT64_C(4348079280205103483), UINT64_C(1157920892373161954) },
+  { UINT64_C(14335624477811986218), UINT64_C(1852673427797059126) }, { UINT64_C(7779150767507678651), UINT64_C(1482138742237647301) },
+  { UINT64_C(2533971799264232598), UINT64_C(1185710993790117841) }, { UINT64_C(15122401323048503126), UINT64_C(1897137590064188545) },
+  { UINT64_C(12097921058438802501), UINT64_C(1517710072051350836) }, { UINT64_C(5988988032009131678), UINT64_C(1214168057641080669) },
+  { UINT64_C(16961078480698431330), UINT64_C(1942668892225729070) }, { UINT64_C(13568862784558745064), UINT64_C(1554135113780583256) },
+  { UINT64_C(7165741412905085728), UINT64_C(1243308091024466605) }, { UINT64_C(11465186260648137165), UINT64_C(1989292945639146568) },
+  { UINT64_C(16550846638002330379), UINT64_C(1591434356511317254) }, { UINT64_C(16930026125143774626), UINT64_C(1273147485209053803) },
+  { UINT64_C(4951948911778577463), UINT64_C(2037035976334486086) }, { UINT64_C(272210314680951647), UINT64_C(1629628781067588869) },
+  { UINT64_C(3907117066486671641), UINT64_C(1303703024854071095) }, { UINT64_C(6251387306378674625), UINT64_C(2085924839766513752) },
+  { UINT64_C(16069156289328670670), UINT64_C(1668739871813211001) }, { UINT64_C(9165976216721026213), UINT64_C(1334991897450568801) },
+  { UINT64_C(7286864317269821294), UINT64_C(2135987035920910082) }, { UINT64_C(16897537898041588005), UINT64_C(1708789628736728065) },
+  { UINT64_C(13518030318433270404), UINT64_C(1367031702989382452) }, { UINT64_C(6871453250525591353), UINT64_C(2187250724783011924) },
+  { UINT64_C(9186511415162383406), UINT64_C(1749800579826409539) }, { UINT64_C(11038557946871817048), UINT64_C(1399840463861127631) },
+  { UINT64_C(10282995085511086630), UINT64_C(2239744742177804210) }, { UINT64_C(8226396068408869304), UINT64_C(1791795793742243368) },
+  { UINT64_C(13959814484210916090), UINT64_C(1433436634993794694) }, { UINT64_C(11267656730511734774), UINT64_C(2293498615990071511) },
+  { UINT64_C(5324776569667477496), UINT64_C(1834798892792057209) }, { UINT64_C(7949170070475892320), UINT64_C(1467839114233645767) },
+  { UINT64_C(17427382500606444826), UINT64_C(1174271291386916613) }, { UINT64_C(5747719112518849781), UINT64_C(1878834066219066582) },
+  { UINT64_C(15666221734240810795), UINT64_C(1503067252975253265) }, { UINT64_C(12532977387392648636), UINT64_C(1202453802380202612) },
+  { UINT64_C(5295368560860596524), UINT64_C(1923926083808324180) }, { UINT64_C(4236294848688477220), UINT64_C(1539140867046659344) },
+  { UINT64_C(7078384693692692099), UINT64_C(1231312693637327475) }, { UINT64_C(11325415509908307358), UINT64_C(1970100309819723960) },
+  { UINT64_C(9060332407926645887), UINT64_C(1576080247855779168) }, { UINT64_C(14626963555825137356), UINT64_C(1260864198284623334) },
+  { UINT64_C(12335095245094488799), UINT64_C(2017382717255397335) }, { UINT64_C(9868076196075591040), UINT64_C(1613906173804317868) },
+  { UINT64_C(15273158586344293478), UINT64_C(1291124939043454294) }, { UINT64_C(13369007293925138595), UINT64_C(2065799902469526871) },
+  { UINT64_C(7005857020398200553), UINT64_C(1652639921975621497) }, { UINT64_C(16672732060544291412), UINT64_C(1322111937580497197) },
+  { UINT64_C(11918976037903224966), UINT64_C(2115379100128795516) }, { UINT64_C(5845832015580669650), UINT64_C(1692303280103036413) },
+  { UINT64_C(12055363241948356366), UINT64_C(1353842624082429130) }, { UINT64_C(841837113407818570), UINT64_C(2166148198531886609) },
+  { UINT64_C(4362818505468165179), UINT64_C(1732918558825509287) }, { UINT64_C(14558301248600263113), UINT64_C(1386334847060407429) },
+  { UINT64_C(12225235553534690011), UINT64_C(2218135755296651887) }, { UINT64_C(2401490813343931363), UINT64_C(1774508604237321510) },
+  { UINT64_C(1921192650675145090), UINT64_C(1419606883389857208) }, { UINT64_C(17831303500047873437), UINT64_C(2271371013423771532) },
+  { UINT64_C(6886345170554478103), UINT64_C(1817096810739017226) }, { UINT64_C(1819727321701672159), UINT64_C(1453677448591213781) },
+  { UINT64_C(16213177116328979020), UINT64_C(1162941958872971024) }, { UINT64_C(14873036941900635463), UINT64_C(1860707134196753639) },
+  { UINT64_C(15587778368262418694), UINT64_C(1488565707357402911) }, { UINT64_C(8780873879868024632), UINT64_C(1190852565885922329) },
+  { UINT64_C(2981351763563108441), UINT64_C(1905364105417475727) }, { UINT64_C(13453127855076217722), UINT64_C(1524291284333980581) },
+  { UINT64_C(7073153469319063855), UINT64_C(1219433027467184465) }, { UINT64_C(11317045550910502167), UINT64_C(1951092843947495144) },
+  { UINT64_C(12742985255470312057), UINT64_C(1560874275157996115) }, { UINT64_C(10194388204376249646), UINT64_C(1248699420126396892) },
+  { UINT64_C(1553625868034358140), UINT64_C(1997919072202235028) }, { UINT64_C(8621598323911307159), UINT64_C(1598335257761788022) },
+  { UINT64_C(17965325103354776697), UINT64_C(1278668206209430417) }, { UINT64_C(13987124906400001422), UINT64_C(2045869129935088668) },
+  { UINT64_C(121653480894270168), UINT64_C(1636695303948070935) }, { UINT64_C(97322784715416134), UINT64_C(1309356243158456748) },
+  { UINT64_C(14913111714512307107), UINT64_C(2094969989053530796) }, { UINT64_C(8241140556867935363), UINT64_C(1675975991242824637) },
+  { UINT64_C(17660958889720079260), UINT64_C(1340780792994259709) }, { UINT64_C(17189487779326395846), UINT64_C(2145249268790815535) },
+  { UINT64_C(13751590223461116677), UINT64_C(1716199415032652428) }, { UINT64_C(18379969808252713988), UINT64_C(1372959532026121942) },
+  { UINT64_C(14650556434236701088), UINT64_C(2196735251241795108) }, { UINT64_C(652398703163629901), UINT64_C(1757388200993436087) },
+  { UINT64_C(11589965406756634890), UINT64_C(1405910560794748869) }, { UINT64_C(7475898206584884855), UINT64_C(2249456897271598191) },
+  { UINT64_C(2291369750525997561), UINT64_C(1799565517817278553) }, { UINT64_C(9211793429904618695), UINT64_C(1439652414253822842) },
+  { UINT64_C(18428218302589300235), UINT64_C(2303443862806116547) }, { UINT64_C(7363877012587619542), UINT64_C(1842755090244893238) },
+  { UINT64_C(13269799239553916280), UINT64_C(1474204072195914590) }, { UINT64_C(10615839391643133024), UINT64_C(1179363257756731672) },
+  { UINT64_C(2227947767661371545), UINT64_C(1886981212410770676) }, { UINT64_C(16539753473096738529), UINT64_C(1509584969928616540) },
+  { UINT64_C(13231802778477390823), UINT64_C(1207667975942893232) }, { UINT64_C(6413489186596184024), UINT64_C(1932268761508629172) },
+  { UINT64_C(16198837793502678189), UINT64_C(1545815009206903337) }, { UINT64_C(5580372605318321905), UINT64_C(1236652007365522670) },
+  { UINT64_C(8928596168509315048), UINT64_C(1978643211784836272) }, { UINT64_C(18210923379033183008), UINT64_C(1582914569427869017) },
+  { UINT64_C(7190041073742725760), UINT64_C(1266331655542295214) }, { UINT64_C(436019273762630246), UINT64_C(2026130648867672343) },
+  { UINT64_C(7727513048493924843), UINT64_C(1620904519094137874) }, { UINT64_C(9871359253537050198), UINT64_C(1296723615275310299) },
+  { UINT64_C(4726128361433549347), UINT64_C(2074757784440496479) }, { UINT64_C(7470251503888749801), UINT64_C(1659806227552397183) },
+  { UINT64_C(13354898832594820487), UINT64_C(1327844982041917746) }, { UINT64_C(13989140502667892133), UINT64_C(2124551971267068394) },
+  { UINT64_C(14880661216876224029), UINT64_C(1699641577013654715) }, { UINT64_C(11904528973500979224), UINT64_C(1359713261610923772) },
+  { UINT64_C(4289851098633925465), UINT64_C(2175541218577478036) }, { UINT64_C(18189276137874781665), UINT64_C(1740432974861982428) },
+  { UINT64_C(3483374466074094362), UINT64_C(1392346379889585943) }, { UINT64_C(1884050330976640656), UINT64_C(2227754207823337509) },
+  { UINT64_C(5196589079523222848), UINT64_C(1782203366258670007) }, { UINT64_C(15225317707844309248), UINT64_C(1425762693006936005) },
+  { UINT64_C(5913764258841343181), UINT64_C(2281220308811097609) }, { UINT64_C(8420360221814984868), UINT64_C(1824976247048878087) },
+  { UINT64_C(17804334621677718864), UINT64_C(1459980997639102469) }, { UINT64_C(17932816512084085415), UINT64_C(1167984798111281975) },
+  { UINT64_C(10245762345624985047), UINT64_C(1868775676978051161) }, { UINT64_C(4507261061758077715), UINT64_C(1495020541582440929) },
+  { UINT64_C(7295157664148372495), UINT64_C(1196016433265952743) }, { UINT64_C(7982903447895485668), UINT64_C(1913626293225524389) },
+  { UINT64_C(10075671573058298858), UINT64_C(1530901034580419511) }, { UINT64_C(4371188443704728763), UINT64_C(1224720827664335609) },
+  { UINT64_C(14372599139411386667), UINT64_C(1959553324262936974) }, { UINT64_C(15187428126271019657), UINT64_C(1567642659410349579) },
+  { UINT64_C(15839291315758726049), UINT64_C(1254114127528279663) }, { UINT64_C(3206773216762499739), UINT64_C(2006582604045247462) },
+  { UINT64_C(13633465017635730761), UINT64_C(1605266083236197969) }, { UINT64_C(14596120828850494932), UINT64_C(1284212866588958375) },
+  { UINT64_C(4907049252451240275), UINT64_C(2054740586542333401) }, { UINT64_C(236290587219081897), UINT64_C(1643792469233866721) },
+  { UINT64_C(14946427728742906810), UINT64_C(1315033975387093376) }, { UINT64_C(16535586736504830250), UINT64_C(2104054360619349402) },
+  { UINT64_C(5849771759720043554), UINT64_C(1683243488495479522) }, { UINT64_C(15747863852001765813), UINT64_C(1346594790796383617) },
+  { UINT64_C(10439186904235184007), UINT64_C(2154551665274213788) }, { UINT64_C(15730047152871967852), UINT64_C(1723641332219371030) },
+  { UINT64_C(12584037722297574282), UINT64_C(1378913065775496824) }, { UINT64_C(9066413911450387881), UINT64_C(2206260905240794919) },
+  { UINT64_C(10942479943902220628), UINT64_C(1765008724192635935) }, { UINT64_C(8753983955121776503), UINT64_C(1412006979354108748) },
+  { UINT64_C(10317025513452932081), UINT64_C(2259211166966573997) }, { UINT64_C(874922781278525018), UINT64_C(1807368933573259198) },
+  { UINT64_C(8078635854506640661), UINT64_C(1445895146858607358) }, { UINT64_C(13841606313089133175), UINT64_C(1156716117486885886) },
+  { UINT64_C(14767872471458792434), UINT64_C(1850745787979017418) }, { UINT64_C(746251532941302978), UINT64_C(1480596630383213935) },
+  { UINT64_C(597001226353042382), UINT64_C(1184477304306571148) }, { UINT64_C(15712597221132509104), UINT64_C(1895163686890513836) },
+  { UINT64_C(8880728962164096960), UINT64_C(1516130949512411069) }, { UINT64_C(10793931984473187891), UINT64_C(1212904759609928855) },
+  { UINT64_C(17270291175157100626), UINT64_C(1940647615375886168) }, { UINT64_C(2748186495899949531), UINT64_C(1552518092300708935) },
+  { UINT64_C(2198549196719959625), UINT64_C(1242014473840567148) }, { UINT64_C(18275073973719576693), UINT64_C(1987223158144907436) },
+  { UINT64_C(10930710364233751031), UINT64_C(1589778526515925949) }, { UINT64_C(12433917106128911148), UINT64_C(1271822821212740759) },
+  { UINT64_C(8826220925580526867), UINT64_C(2034916513940385215) }, { UINT64_C(7060976740464421494), UINT64_C(1627933211152308172) },
+  { UINT64_C(16716827836597268165), UINT64_C(1302346568921846537) }, { UINT64_C(11989529279587987770), UINT64_C(2083754510274954460) },
+  { UINT64_C(9591623423670390216), UINT64_C(1667003608219963568) }, { UINT64_C(15051996368420132820), UINT64_C(1333602886575970854) },
+  { UINT64_C(13015147745246481542), UINT64_C(2133764618521553367) }, { UINT64_C(3033420566713364587), UINT64_C(1707011694817242694) },
+  { UINT64_C(6116085268112601993), UINT64_C(1365609355853794155) }, { UINT64_C(9785736428980163188), UINT64_C(2184974969366070648) },
+  { UINT64_C(15207286772667951197), UINT64_C(1747979975492856518) }, { UINT64_C(1097782973908629988), UINT64_C(1398383980394285215) },
+  { UINT64_C(1756452758253807981), UINT64_C(2237414368630856344) }, { UINT64_C(5094511021344956708), UINT64_C(1789931494904685075) },
+  { UINT64_C(4075608817075965366), UINT64_C(1431945195923748060) }, { UINT64_C(6520974107321544586), UINT64_C(2291112313477996896) },
+  { UINT64_C(1527430471115325346), UINT64_C(1832889850782397517) }, { UINT64_C(12289990821117991246), UINT64_C(1466311880625918013) },
+  { UINT64_C(17210690286378213644), UINT64_C(1173049504500734410) }, { UINT64_C(9090360384495590213), UINT64_C(1876879207201175057) },
+  { UINT64_C(18340334751822203140), UINT64_C(1501503365760940045) }, { UINT64_C(14672267801457762512), UINT64_C(1201202692608752036) },
+  { UINT64_C(16096930852848599373), UINT64_C(1921924308174003258) }, { UINT64_C(1809498238053148529), UINT64_C(1537539446539202607) },
+  { UINT64_C(12515645034668249793), UINT64_C(1230031557231362085) }, { UINT64_C(1578287981759648052), UINT64_C(1968050491570179337) },
+  { UINT64_C(12330676829633449412), UINT64_C(1574440393256143469) }, { UINT64_C(13553890278448669853), UINT64_C(1259552314604914775) },
+  { UINT64_C(3239480371808320148), UINT64_C(2015283703367863641) }, { UINT64_C(17348979556414297411), UINT64_C(1612226962694290912) },
+  { UINT64_C(6500486015647617283), UINT64_C(1289781570155432730) }, { UINT64_C(10400777625036187652), UINT64_C(2063650512248692368) },
+  { UINT64_C(15699319729512770768), UINT64_C(1650920409798953894) }, { UINT64_C(16248804598352126938), UINT64_C(1320736327839163115) },
+  { UINT64_C(7551343283653851484), UINT64_C(2113178124542660985) }, { UINT64_C(6041074626923081187), UINT64_C(1690542499634128788) },
+  { UINT64_C(12211557331022285596), UINT64_C(1352433999707303030) }, { UINT64_C(1091747655926105338), UINT64_C(2163894399531684849) },
+  { UINT64_C(4562746939482794594), UINT64_C(1731115519625347879) }, { UINT64_C(7339546366328145998), UINT64_C(1384892415700278303) },
+  { UINT64_C(8053925371383123274), UINT64_C(2215827865120445285) }, { UINT64_C(6443140297106498619), UINT64_C(1772662292096356228) },
+  { UINT64_C(12533209867169019542), UINT64_C(1418129833677084982) }, { UINT64_C(5295740528502789974), UINT64_C(2269007733883335972) },
+  { UINT64_C(15304638867027962949), UINT64_C(1815206187106668777) }, { UINT64_C(4865013464138549713), UINT64_C(1452164949685335022) },
+  { UINT64_C(14960057215536570740), UINT64_C(1161731959748268017) }, { UINT64_C(9178696285890871890), UINT64_C(1858771135597228828) },
+  { UINT64_C(14721654658196518159), UINT64_C(1487016908477783062) }, { UINT64_C(4398626097073393881), UINT64_C(1189613526782226450) },
+  { UINT64_C(7037801755317430209), UINT64_C(1903381642851562320) }, { UINT64_C(5630241404253944167), UINT64_C(1522705314281249856) },
+  { UINT64_C(814844308661245011), UINT64_C(1218164251424999885) }, { UINT64_C(1303750893857992017), UINT64_C(1949062802279999816) },
+  { UINT64_C(15800395974054034906), UINT64_C(1559250241823999852) }, { UINT64_C(5261619149759407279), UINT64_C(1247400193459199882) },
+  { UINT64_C(12107939454356961969), UINT64_C(1995840309534719811) }, { UINT64_C(5997002748743659252), UINT64_C(1596672247627775849) },
+  { UINT64_C(8486951013736837725), UINT64_C(1277337798102220679) }, { UINT64_C(2511075177753209390), UINT64_C(2043740476963553087) },
+  { UINT64_C(13076906586428298482), UINT64_C(1634992381570842469) }, { UINT64_C(14150874083884549109), UINT64_C(1307993905256673975) },
+  { UINT64_C(4194654460505726958), UINT64_C(2092790248410678361) }, { UINT64_C(18113118827372222859), UINT64_C(1674232198728542688) },
+  { UINT64_C(3422448617672047318), UINT64_C(1339385758982834151) }, { UINT64_C(16543964232501006678), UINT64_C(2143017214372534641) },
+  { UINT64_C(9545822571258895019), UINT64_C(1714413771498027713) }, { UINT64_C(15015355686490936662), UINT64_C(1371531017198422170) },
+  { UINT64_C(5577825024675947042), UINT64_C(2194449627517475473) }, { UINT64_C(11840957649224578280), UINT64_C(1755559702013980378) },
+  { UINT64_C(16851463748863483271), UINT64_C(1404447761611184302) }, { UINT64_C(12204946739213931940), UINT64_C(2247116418577894884) },
+  { UINT64_C(13453306206113055875), UINT64_C(1797693134862315907) }, { UINT64_C(3383947335406624054), UINT64_C(1438154507889852726) }
+};
+
+static const uint64_t LRC_DOUBLE_POW5_SPLIT[326][2] = {
+  { UINT64_C(0), UINT64_C(1152921504606846976) }, { UINT64_C(0), UINT64_C(1441151880758558720) },
+  { UINT64_C(0), UINT64_C(1801439850948198400) }, { UINT64_C(0), UINT64_C(2251799813685248000) },
+  { UINT64_C(0), UINT64_C(1407374883553280000) }, { UINT64_C(0), UINT64_C(1759218604441600000) },
+  { UINT64_C(0), UINT64_C(2199023255552000000) }, { UINT64_C(0), UINT64_C(1374389534720000000) },
+  { UINT64_C(0), UINT64_C(1717986918400000000) }, { UINT64_C(0), UINT64_C(2147483648000000000) },
+  { UINT64_C(0), UINT64_C(1342177280000000000) }, { UINT64_C(0), UINT64_C(1677721600000000000) },
+  { UINT64_C(0), UINT64_C(2097152000000000000) }, { UINT64_C(0), UINT64_C(1310720000000000000) },
+  { UINT64_C(0), UINT64_C(1638400000000000000) }, { UINT64_C(0), UINT64_C(2048000000000000000) },
+  { UINT64_C(0), UINT64_C(1280000000000000000) }, { UINT64_C(0), UINT64_C(1600000000000000000) },
+  { UINT64_C(0), UINT64_C(2000000000000000000) }, { UINT64_C(0), UINT64_C(1250000000000000000) },
+  { UINT64_C(0), UINT64_C(1562500000000000000) }, { UINT64_C(0), UINT64_C(1953125000000000000) },
+  { UINT64_C(0), UINT64_C(1220703125000000000) }, { UINT64_C(0), UINT64_C(1525878906250000000) },
+  { UINT64_C(0), UINT64_C(1907348632812500000) }, { UINT64_C(0), UINT64_C(1192092895507812500) },
+  { UINT64_C(0), UINT64_C(1490116119384765625) }, { UINT64_C(4611686018427387904), UINT64_C(1862645149230957031) },
+  { UINT64_C(9799832789158199296), UINT64_C(1164153218269348144) }, { UINT64_C(12249790986447749120), UINT64_C(1455191522836685180) },
+  { UINT64_C(15312238733059686400), UINT64_C(1818989403545856475) }, { UINT64_C(14528612397897220096), UINT64_C(2273736754432320594) },
+  { UINT64_C(13692068767113150464), UINT64_C(1421085471520200371) }, { UINT64_C(12503399940464050176), UINT64_C(1776356839400250464) },
+  { UINT64_C(15629249925580062720), UINT64_C(2220446049250313080) }, { UINT64_C(9768281203487539200), UINT64_C(1387778780781445675) },
+  { UINT64_C(7598665485932036096), UINT64_C(1734723475976807094) }, { UINT64_C(274959820560269312), UINT64_C(2168404344971008868) },
+  { UINT64_C(9395221924704944128), UINT64_C(1355252715606880542) }, { UINT64_C(2520655369026404352), UINT64_C(1694065894508600678) },
+  { UINT64_C(12374191248137781248), UINT64_C(2117582368135750847) }, { UINT64_C(14651398557727195136), UINT64_C(1323488980084844279) },
+  { UINT64_C(13702562178731606016), UINT64_C(1654361225106055349) }, { UINT64_C(3293144668132343808), UINT64_C(2067951531382569187) },
+  { UINT64_C(18199116482078572544), UINT64_C(1292469707114105741) }, { UINT64_C(8913837547316051968), UINT64_C(1615587133892632177) },
+  { UINT64_C(15753982952572452864), UINT64_C(2019483917365790221) }, { UINT64_C(12152082354571476992), UINT64_C(1262177448353618888) },
+  { UINT64_C(15190102943214346240), UINT64_C(1577721810442023610) }, { UINT64_C(9764256642163156992), UINT64_C(1972152263052529513) },
+  { UINT64_C(17631875447420442880), UINT64_C(1232595164407830945) }, { UINT64_C(8204786253993389888), UINT64_C(1540743955509788682) },
+  { UINT64_C(1032610780636961552), UINT64_C(1925929944387235853) }, { UINT64_C(2951224747111794922), UINT64_C(1203706215242022408) },
+  { UINT64_C(3689030933889743652), UINT64_C(1504632769052528010) }, { UINT64_C(13834660704216955373), UINT64_C(1880790961315660012) },
+  { UINT64_C(17870034976990372916), UINT64_C(1175494350822287507) }, { UINT64_C(17725857702810578241), UINT64_C(1469367938527859384) },
+  { UINT64_C(3710578054803671186), UINT64_C(1836709923159824231) }, { UINT64_C(26536550077201078), UINT64_C(2295887403949780289) },
+  { UINT64_C(11545800389866720434), UINT64_C(1434929627468612680) }, { UINT64_C(14432250487333400542), UINT64_C(1793662034335765850) },
+  { UINT64_C(8816941072311974870), UINT64_C(2242077542919707313) }, { UINT64_C(17039803216263454053), UINT64_C(1401298464324817070) },
+  { UINT64_C(12076381983474541759), UINT64_C(1751623080406021338) }, { UINT64_C(5872105442488401391), UINT64_C(2189528850507526673) },
+  { UINT64_C(15199280947623720629), UINT64_C(1368455531567204170) }, { UINT64_C(9775729147674874978), UINT64_C(1710569414459005213) },
+  { UINT64_C(16831347453020981627), UINT64_C(2138211768073756516) }, { UINT64_C(1296220121283337709), UINT64_C(1336382355046097823) },
+  { UINT64_C(15455333206886335848), UINT64_C(1670477943807622278) }, { UINT64_C(10095794471753144002), UINT64_C(2088097429759527848) },
+  { UINT64_C(6309871544845715001), UINT64_C(1305060893599704905) }, { UINT64_C(12499025449484531656), UINT64_C(1631326116999631131) },
+  { UINT64_C(11012095793428276666), UINT64_C(2039157646249538914) }, { UINT64_C(11494245889320060820), UINT64_C(1274473528905961821) },
+  { UINT64_C(532749306367912313), UINT64_C(1593091911132452277) }, { UINT64_C(5277622651387278295), UINT64_C(1991364888915565346) },
+  { UINT64_C(7910200175544436838), UINT64_C(1244603055572228341) }, { UINT64_C(14499436237857933952), UINT64_C(1555753819465285426) },
+  { UINT64_C(8900923260467641632), UINT64_C(1944692274331606783) }, { UINT64_C(12480606065433357876), UINT64_C(1215432671457254239) },
+  { UINT64_C(10989071563364309441), UINT64_C(1519290839321567799) }, { UINT64_C(9124653435777998898), UINT64_C(1899113549151959749) },
+  { UINT64_C(8008751406574943263), UINT64_C(1186945968219974843) }, { UINT64_C(5399253239791291175), UINT64_C(1483682460274968554) },
+  { UINT64_C(15972438586593889776), UINT64_C(1854603075343710692) }, { UINT64_C(759402079766405302), UINT64_C(1159126922089819183) },
+  { UINT64_C(14784310654990170340), UINT64_C(1448908652612273978) }, { UINT64_C(9257016281882937117), UINT64_C(1811135815765342473) },
+  { UINT64_C(16182956370781059300), UINT64_C(2263919769706678091) }, { UINT64_C(7808504722524468110), UINT64_C(1414949856066673807) },
+  { UINT64_C(5148944884728197234), UINT64_C(1768687320083342259) }, { UINT64_C(1824495087482858639), UINT64_C(2210859150104177824) },
+  { UINT64_C(1140309429676786649), UINT64_C(1381786968815111140) }, { UINT64_C(1425386787095983311), UINT64_C(1727233711018888925) },
+  { UINT64_C(6393419502297367043), UINT64_C(2159042138773611156) }, { UINT64_C(13219259225790630210), UINT64_C(1349401336733506972) },
+  { UINT64_C(16524074032238287762), UINT64_C(1686751670916883715) }, { UINT64_C(16043406521870471799), UINT64_C(2108439588646104644) },
+  { UINT64_C(803757039314269066), UINT64_C(1317774742903815403) }, { UINT64_C(14839754354425000045), UINT64_C(1647218428629769253) },
+  { UINT64_C(4714634887749086344), UINT64_C(2059023035787211567) }, { UINT64_C(9864175832484260821), UINT64_C(1286889397367007229) },
+  { UINT64_C(16941905809032713930), UINT64_C(1608611746708759036) }, { UINT64_C(2730638187581340797), UINT64_C(2010764683385948796) },
+  { UINT64_C(10930020904093113806), UINT64_C(1256727927116217997) }, { UINT64_C(18274212148543780162), UINT64_C(1570909908895272496) },
+  { UINT64_C(4396021111970173586), UINT64_C(1963637386119090621) }, { UINT64_C(5053356204195052443), UINT64_C(1227273366324431638) },
+  { UINT64_C(15540067292098591362), UINT64_C(1534091707905539547) }, { UINT64_C(14813398096695851299), UINT64_C(1917614634881924434) },
+  { UINT64_C(13870059828862294966), UINT64_C(1198509146801202771) }, { UINT64_C(12725888767650480803), UINT64_C(1498136433501503464) },
+  { UINT64_C(15907360959563101004), UINT64_C(1872670541876879330) }, { UINT64_C(14553786618154326031), UINT64_C(1170419088673049581) },
+  { UINT64_C(4357175217410743827), UINT64_C(1463023860841311977) }, { UINT64_C(10058155040190817688), UINT64_C(1828779826051639971) },
+  { UINT64_C(7961007781811134206), UINT64_C(2285974782564549964) }, { UINT64_C(14199001900486734687), UINT64_C(1428734239102843727) },
+  { UINT64_C(13137066357181030455), UINT64_C(1785917798878554659) }, { UINT64_C(11809646928048900164), UINT64_C(2232397248598193324) },
+  { UINT64_C(16604401366885338411), UINT64_C(1395248280373870827) }, { UINT64_C(16143815690179285109), UINT64_C(1744060350467338534) },
+  { UINT64_C(10956397575869330579), UINT64_C(2180075438084173168) }, { UINT64_C(6847748484918331612), UINT64_C(1362547148802608230) },
+  { UINT64_C(17783057643002690323), UINT64_C(1703183936003260287) }, { UINT64_C(17617136035325974999), UINT64_C(2128979920004075359) },
+  { UINT64_C(17928239049719816230), UINT64_C(1330612450002547099) }, { UINT64_C(17798612793722382384), UINT64_C(1663265562503183874) },
+  { UINT64_C(13024893955298202172), UINT64_C(2079081953128979843) }, { UINT64_C(5834715712847682405), UINT64_C(1299426220705612402) },
+  { UINT64_C(16516766677914378815), UINT64_C(1624282775882015502) }, { UINT64_C(11422586310538197711), UINT64_C(2030353469852519378) },
+  { UINT64_C(11750802462513761473), UINT64_C(1268970918657824611) }, { UINT64_C(10076817059714813937), UINT64_C(1586213648322280764) },
+  { UINT64_C(12596021324643517422), UINT64_C(1982767060402850955) }, { UINT64_C(5566670318688504437), UINT64_C(1239229412751781847) },
+  { UINT64_C(2346651879933242642), UINT64_C(1549036765939727309) }, { UINT64_C(7545000868343941206), UINT64_C(1936295957424659136) },
+  { UINT64_C(4715625542714963254), UINT64_C(1210184973390411960) }, { UINT64_C(5894531928393704067), UINT64_C(1512731216738014950) },
+  { UINT64_C(16591536947346905892), UINT64_C(1890914020922518687) }, { UINT64_C(17287239619732898039), UINT64_C(1181821263076574179) },
+  { UINT64_C(16997363506238734644), UINT64_C(1477276578845717724) }, { UINT64_C(2799960309088866689), UINT64_C(1846595723557147156) },
+  { UINT64_C(10973347230035317489), UINT64_C(1154122327223216972) }, { UINT64_C(13716684037544146861), UINT64_C(1442652909029021215) },
+  { UINT64_C(12534169028502795672), UINT64_C(1803316136286276519) }, { UINT64_C(11056025267201106687), UINT64_C(2254145170357845649) },
+  { UINT64_C(18439230838069161439), UINT64_C(1408840731473653530) }, { UINT64_C(13825666510731675991), UINT64_C(1761050914342066913) },
+  { UINT64_C(3447025083132431277), UINT64_C(2201313642927583642) }, { UINT64_C(6766076695385157452), UINT64_C(1375821026829739776) },
+  { UINT64_C(8457595869231446815), UINT64_C(1719776283537174720) }, { UINT64_C(10571994836539308519), UINT64_C(2149720354421468400) },
+  { UINT64_C(6607496772837067824), UINT64_C(1343575221513417750) }, { UINT64_C(17482743002901110588), UINT64_C(1679469026891772187) },
+  { UINT64_C(17241742735199000331), UINT64_C(2099336283614715234) }, { UINT64_C(15387775227926763111), UINT64_C(1312085177259197021) },
+  { UINT64_C(5399660979626290177), UINT64_C(1640106471573996277) }, { UINT64_C(11361262242960250625), UINT64_C(2050133089467495346) },
+  { UINT64_C(11712474920277544544), UINT64_C(1281333180917184591) }, { UINT64_C(10028907631919542777), UINT64_C(1601666476146480739) },
+  { UINT64_C(7924448521472040567), UINT64_C(2002083095183100924) }, { UINT64_C(14176152362774801162), UINT64_C(1251301934489438077) },
+  { UINT64_C(3885132398186337741), UINT64_C(1564127418111797597) }, { UINT64_C(9468101516160310080), UINT64_C(1955159272639746996) },
+  { UINT64_C(15140935484454969608), UINT64_C(1221974545399841872) }, { UINT64_C(479425281859160394), UINT64_C(1527468181749802341) },
+  { UINT64_C(5210967620751338397), UINT64_C(1909335227187252926) }, { UINT64_C(17091912818251750210), UINT64_C(1193334516992033078) },
+  { UINT64_C(12141518985959911954), UINT64_C(1491668146240041348) }, { UINT64_C(15176898732449889943), UINT64_C(1864585182800051685) },
+  { UINT64_C(11791404716994875166), UINT64_C(1165365739250032303) }, { UINT64_C(10127569877816206054), UINT64_C(1456707174062540379) },
+  { UINT64_C(8047776328842869663), UINT64_C(1820883967578175474) }, { UINT64_C(836348374198811271), UINT64_C(2276104959472719343) },
+  { UINT64_C(7440246761515338900), UINT64_C(1422565599670449589) }, { UINT64_C(13911994470321561530), UINT64_C(1778206999588061986) },
+  { UINT64_C(8166621051047176104), UINT64_C(2222758749485077483) }, { UINT64_C(2798295147690791113), UINT64_C(1389224218428173427) },
+  { UINT64_C(17332926989895652603), UINT64_C(1736530273035216783) }, { UINT64_C(17054472718942177850), UINT64_C(2170662841294020979) },
+  { UINT64_C(8353202440125167204), UINT64_C(1356664275808763112) }, { UINT64_C(10441503050156459005), UINT64_C(1695830344760953890) },
+  { UINT64_C(3828506775840797949), UINT64_C(2119787930951192363) }, { UINT64_C(86973725686804766), UINT64_C(1324867456844495227) },
+  { UINT64_C(13943775212390669669), UINT64_C(1656084321055619033) }, { UINT64_C(3594660960206173375), UINT64_C(2070105401319523792) },
+  { UINT64_C(2246663100128858359), UINT64_C(1293815875824702370) }, { UINT64_C(12031700912015848757), UINT64_C(1617269844780877962) },
+  { UINT64_C(5816254103165035138), UINT64_C(2021587305976097453) }, { UINT64_C(5941001823691840913), UINT64_C(1263492066235060908) },
+  { UINT64_C(7426252279614801142), UINT64_C(1579365082793826135) }, { UINT64_C(4671129331091113523), UINT64_C(1974206353492282669) },
+  { UINT64_C(5225298841145639904), UINT64_C(1233878970932676668) }, { UINT64_C(6531623551432049880), UINT64_C(1542348713665845835) },
+  { UINT64_C(3552843420862674446), UINT64_C(1927935892082307294) }, { UINT64_C(16055585193321335241), UINT64_C(1204959932551442058) },
+  { UINT64_C(10846109454796893243), UINT64_C(1506199915689302573) }, { UINT64_C(18169322836923504458), UINT64_C(1882749894611628216) },
+  { UINT64_C(11355826773077190286), UINT64_C(1176718684132267635) }, { UINT64_C(9583097447919099954), UINT64_C(1470898355165334544) },
+  { UINT64_C(11978871809898874942), UINT64_C(1838622943956668180) }, { UINT64_C(14973589762373593678), UINT64_C(2298278679945835225) },
+  { UINT64_C(2440964573842414192), UINT64_C(1436424174966147016) }, { UINT64_C(3051205717303017741), UINT64_C(1795530218707683770) },
+  { UINT64_C(13037379183483547984), UINT64_C(2244412773384604712) }, { UINT64_C(8148361989677217490), UINT64_C(1402757983365377945) },
+  { UINT64_C(14797138505523909766), UINT64_C(1753447479206722431) }, { UINT64_C(13884737113477499304), UINT64_C(2191809349008403039) },
+  { UINT64_C(15595489723564518921), UINT64_C(1369880843130251899) }, { UINT64_C(14882676136028260747), UINT64_C(1712351053912814874) },
+  { UINT64_C(9379973133180550126), UINT64_C(2140438817391018593) }, { UINT64_C(17391698254306313589), UINT64_C(1337774260869386620) },
+  { UINT64_C(3292878744173340370), UINT64_C(1672217826086733276) }, { UINT64_C(4116098430216675462), UINT64_C(2090272282608416595) },
+  { UINT64_C(266718509671728212), UINT64_C(1306420176630260372) }, { UINT64_C(333398137089660265), UINT64_C(1633025220787825465) },
+  { UINT64_C(5028433689789463235), UINT64_C(2041281525984781831) }, { UINT64_C(10060300083759496378), UINT64_C(1275800953740488644) },
+  { UINT64_C(12575375104699370472), UINT64_C(1594751192175610805) }, { UINT64_C(1884160825592049379), UINT64_C(1993438990219513507) },
+  { UINT64_C(17318501580490888525), UINT64_C(1245899368887195941) }, { UINT64_C(7813068920331446945), UINT64_C(1557374211108994927) },
+  { UINT64_C(5154650131986920777), UINT64_C(1946717763886243659) }, { UINT64_C(915813323278131534), UINT64_C(1216698602428902287) },
+  { UINT64_C(14979824709379828129), UINT64_C(1520873253036127858) }, { UINT64_C(9501408849870009354), UINT64_C(1901091566295159823) },
+  { UINT64_C(12855909558809837702), UINT64_C(1188182228934474889) }, { UINT64_C(2234828893230133415), UINT64_C(1485227786168093612) },
+  { UINT64_C(2793536116537666769), UINT64_C(1856534732710117015) }, { UINT64_C(8663489100477123587), UINT64_C(1160334207943823134) },
+  { UINT64_C(1605989338741628675), UINT64_C(1450417759929778918) }, { UINT64_C(11230858710281811652), UINT64_C(1813022199912223647) },
+  { UINT64_C(9426887369424876662), UINT64_C(2266277749890279559) }, { UINT64_C(12809333633531629769), UINT64_C(1416423593681424724) },
+  { UINT64_C(16011667041914537212), UINT64_C(1770529492101780905) }, { UINT64_C(6179525747111007803), UINT64_C(2213161865127226132) },
+  { UINT64_C(13085575628799155685), UINT64_C(1383226165704516332) }, { UINT64_C(16356969535998944606), UINT64_C(1729032707130645415) },
+  { UINT64_C(15834525901571292854), UINT64_C(2161290883913306769) }, { UINT64_C(2979049660840976177), UINT64_C(1350806802445816731) },
+  { UINT64_C(17558870131333383934), UINT64_C(1688508503057270913) }, { UINT64_C(8113529608884566205), UINT64_C(2110635628821588642) },
+  { UINT64_C(9682642023980241782), UINT64_C(1319147268013492901) }, { UINT64_C(16714988548402690132), UINT64_C(1648934085016866126) },
+  { UINT64_C(11670363648648586857), UINT64_C(2061167606271082658) }, { UINT64_C(11905663298832754689), UINT64_C(1288229753919426661) },
+  { UINT64_C(1047021068258779650), UINT64_C(1610287192399283327) }, { UINT64_C(15143834390605638274), UINT64_C(2012858990499104158) },
+  { UINT64_C(4853210475701136017), UINT64_C(1258036869061940099) }, { UINT64_C(1454827076199032118), UINT64_C(1572546086327425124) },
+  { UINT64_C(1818533845248790147), UINT64_C(1965682607909281405) }, { UINT64_C(3442426662494187794), UINT64_C(1228551629943300878) },
+  { UINT64_C(13526405364972510550), UINT64_C(1535689537429126097) }, { UINT64_C(3072948650933474476), UINT64_C(1919611921786407622) },
+  { UINT64_C(15755650962115585259), UINT64_C(1199757451116504763) }, { UINT64_C(15082877684217093670), UINT64_C(1499696813895630954) },
+  { UINT64_C(9630225068416591280), UINT64_C(1874621017369538693) }, { UINT64_C(8324733676974063502), UINT64_C(1171638135855961683) },
+  { UINT64_C(5794231077790191473), UINT64_C(1464547669819952104) }, { UINT64_C(7242788847237739342), UINT64_C(1830684587274940130) },
+  { UINT64_C(18276858095901949986), UINT64_C(2288355734093675162) }, { UINT64_C(16034722328366106645), UINT64_C(1430222333808546976) },
+  { UINT64_C(1596658836748081690), UINT64_C(1787777917260683721) }, { UINT64_C(6607509564362490017), UINT64_C(2234722396575854651) },
+  { UINT64_C(1823850468512862308), UINT64_C(1396701497859909157) }, { UINT64_C(6891499104068465790), UINT64_C(1745876872324886446) },
+  { UINT64_C(17837745916940358045), UINT64_C(2182346090406108057) }, { UINT64_C(4231062170446641922), UINT64_C(1363966306503817536) },
+  { UINT64_C(5288827713058302403), UINT64_C(1704957883129771920) }, { UINT64_C(6611034641322878003), UINT64_C(2131197353912214900) },
+  { UINT64_C(13355268687681574560), UINT64_C(1331998346195134312) }, { UINT64_C(16694085859601968200), UINT64_C(1664997932743917890) },
+  { UINT64_C(11644235287647684442), UINT64_C(2081247415929897363) }, { UINT64_C(4971804045566108824), UINT64_C(1300779634956185852) },
+  { UINT64_C(6214755056957636030), UINT64_C(1625974543695232315) }, { UINT64_C(3156757802769657134), UINT64_C(2032468179619040394) },
+  { UINT64_C(6584659645158423613), UINT64_C(1270292612261900246) }, { UINT64_C(17454196593302805324), UINT64_C(1587865765327375307) },
+  { UINT64_C(17206059723201118751), UINT64_C(1984832206659219134) }, { UINT64_C(6142101308573311315), UINT64_C(1240520129162011959) },
+  { UINT64_C(3065940617289251240), UINT64_C(1550650161452514949) }, { UINT64_C(8444111790038951954), UINT64_C(1938312701815643686) },
+  { UINT64_C(665883850346957067), UINT64_C(1211445438634777304) }, { UINT64_C(832354812933696334), UINT64_C(1514306798293471630) },
+  { UINT64_C(10263815553021896226), UINT64_C(1892883497866839537) }, { UINT64_C(17944099766707154901), UINT64_C(1183052186166774710) },
+  { UINT64_C(13206752671529167818), UINT64_C(1478815232708468388) }, { UINT64_C(16508440839411459773), UINT64_C(1848519040885585485) },
+  { UINT64_C(12623618533845856310), UINT64_C(1155324400553490928) }, { UINT64_C(15779523167307320387), UINT64_C(1444155500691863660) },
+  { UINT64_C(1277659885424598868), UINT64_C(1805194375864829576) }, { UINT64_C(1597074856780748586), UINT64_C(2256492969831036970) },
+  { UINT64_C(5609857803915355770), UINT64_C(1410308106144398106) }, { UINT64_C(16235694291748970521), UINT64_C(1762885132680497632) },
+  { UINT64_C(1847873790976661535), UINT64_C(2203606415850622041) }, { UINT64_C(12684136165428883219), UINT64_C(1377254009906638775) },
+  { UINT64_C(11243484188358716120), UINT64_C(1721567512383298469) }, { UINT64_C(219297180166231438), UINT64_C(2151959390479123087) },
+  { UINT64_C(7054589765244976505), UINT64_C(1344974619049451929) }, { UINT64_C(13429923224983608535), UINT64_C(1681218273811814911) },
+  { UINT64_C(12175718012802122765), UINT64_C(2101522842264768639) }, { UINT64_C(14527352785642408584), UINT64_C(1313451776415480399) },
+  { UINT64_C(13547504963625622826), UINT64_C(1641814720519350499) }, { UINT64_C(12322695186104640628), UINT64_C(2052268400649188124) },
+  { UINT64_C(16925056528170176201), UINT64_C(1282667750405742577) }, { UINT64_C(7321262604930556539), UINT64_C(1603334688007178222) },
+  { UINT64_C(18374950293017971482), UINT64_C(2004168360008972777) }, { UINT64_C(4566814905495150320), UINT64_C(1252605225005607986) },
+  { UINT64_C(14931890668723713708), UINT64_C(1565756531257009982) }, { UINT64_C(9441491299049866327), UINT64_C(1957195664071262478) },
+  { UINT64_C(1289246043478778550), UINT64_C(1223247290044539049) }, { UINT64_C(6223243572775861092), UINT64_C(1529059112555673811) },
+  { UINT64_C(3167368447542438461), UINT64_C(1911323890694592264) }, { UINT64_C(1979605279714024038), UINT64_C(1194577431684120165) },
+  { UINT64_C(7086192618069917952), UINT64_C(1493221789605150206) }, { UINT64_C(18081112809442173248), UINT64_C(1866527237006437757) },
+  { UINT64_C(13606538515115052232), UINT64_C(1166579523129023598) }, { UINT64_C(7784801107039039482), UINT64_C(1458224403911279498) },
+  { UINT64_C(507629346944023544), UINT64_C(1822780504889099373) }, { UINT64_C(5246222702107417334), UINT64_C(2278475631111374216) },
+  { UINT64_C(3278889188817135834), UINT64_C(1424047269444608885) }, { UINT64_C(8710297504448807696), UINT64_C(1780059086805761106) }
+};
+
+static const uint64_t LRC_FLOAT_POW5_INV_SPLIT[31] = {
+  UINT64_C(576460752303423489), UINT64_C(461168601842738791), UINT64_C(368934881474191033),
+  UINT64_C(295147905179352826), UINT64_C(472236648286964522), UINT64_C(377789318629571618),
+  UINT64_C(302231454903657294), UINT64_C(483570327845851670), UINT64_C(386856262276681336),
+  UINT64_C(309485009821345069), UINT64_C(495176015714152110), UINT64_C(396140812571321688),
+  UINT64_C(316912650057057351), UINT64_C(507060240091291761), UINT64_C(405648192073033409),
+  UINT64_C(324518553658426727), UINT64_C(519229685853482763), UINT64_C(415383748682786211),
+  UINT64_C(332306998946228969), UINT64_C(531691198313966350), UINT64_C(425352958651173080),
+  UINT64_C(340282366920938464), UINT64_C(544451787073501542), UINT64_C(435561429658801234),
+  UINT64_C(348449143727040987), UINT64_C(557518629963265579), UINT64_C(446014903970612463),
+  UINT64_C(356811923176489971), UINT64_C(570899077082383953), UINT64_C(456719261665907162),
+  UINT64_C(365375409332725730)
+};
+
+static const uint64_t LRC_FLOAT_POW5_SPLIT[47] = {
+  UINT64_C(1152921504606846976), UINT64_C(1441151880758558720), UINT64_C(1801439850948198400),
+  UINT64_C(2251799813685248000), UINT64_C(1407374883553280000), UINT64_C(1759218604441600000),
+  UINT64_C(2199023255552000000), UINT64_C(1374389534720000000), UINT64_C(1717986918400000000),
+  UINT64_C(2147483648000000000), UINT64_C(1342177280000000000), UINT64_C(1677721600000000000),
+  UINT64_C(2097152000000000000), UINT64_C(1310720000000000000), UINT64_C(1638400000000000000),
+  UINT64_C(2048000000000000000), UINT64_C(1280000000000000000), UINT64_C(1600000000000000000),
+  UINT64_C(2000000000000000000), UINT64_C(1250000000000000000), UINT64_C(1562500000000000000),
+  UINT64_C(1953125000000000000), UINT64_C(1220703125000000000), UINT64_C(1525878906250000000),
+  UINT64_C(1907348632812500000), UINT64_C(1192092895507812500), UINT64_C(1490116119384765625),
+  UINT64_C(1862645149230957031), UINT64_C(1164153218269348144), UINT64_C(1455191522836685180),
+  UINT64_C(1818989403545856475), UINT64_C(2273736754432320594), UINT64_C(1421085471520200371),
+  UINT64_C(1776356839400250464), UINT64_C(2220446049250313080), UINT64_C(1387778780781445675),
+  UINT64_C(1734723475976807094), UINT64_C(2168404344971008868), UINT64_C(1355252715606880542),
+  UINT64_C(1694065894508600678), UINT64_C(2117582368135750847), UINT64_C(1323488980084844279),
+  UINT64_C(1654361225106055349), UINT64_C(2067951531382569187), UINT64_C(1292469707114105741),
+  UINT64_C(1615587133892632177), UINT64_C(2019483917365790221)
+};
+
+
+/* 128-bit truncated 5^q, q = -342...308, used by the parser */
+static const uint64_t LRC_POW5_128[651][2] = {
+  { UINT64_C(17218479456385750618), UINT64_C(1242899115359157055) }, { UINT64_C(10761549660241094136), UINT64_C(5388497965526861063) },
+  { UINT64_C(13451937075301367670), UINT64_C(6735622456908576329) }, { UINT64_C(16814921344126709587), UINT64_C(17642900107990496220) },
+  { UINT64_C(10509325840079193492), UINT64_C(8720969558280366185) }, { UINT64_C(13136657300098991865), UINT64_C(10901211947850457732) },
+  { UINT64_C(16420821625123739831), UINT64_C(18238200953240460069) }, { UINT64_C(10263013515702337394), UINT64_C(18316404623416369399) },
+  { UINT64_C(12828766894627921743), UINT64_C(13672133742415685941) }, { UINT64_C(16035958618284902179), UINT64_C(12478481159592219522) },
+  { UINT64_C(10022474136428063862), UINT64_C(5493207715531443249) }, { UINT64_C(12528092670535079827), UINT64_C(16089881681269079869) },
+  { UINT64_C(15660115838168849784), UINT64_C(15500666083158961933) }, { UINT64_C(9787572398855531115), UINT64_C(9687916301974351208) },
+  { UINT64_C(12234465498569413894), UINT64_C(7498209359040551106) }, { UINT64_C(15293081873211767368), UINT64_C(149389661945913074) },
+  { UINT64_C(9558176170757354605), UINT64_C(93368538716195671) }, { UINT64_C(11947720213446693256), UINT64_C(4728396691822632493) },
+  { UINT64_C(14934650266808366570), UINT64_C(5910495864778290617) }, { UINT64_C(9334156416755229106), UINT64_C(8305745933913819539) },
+  { UINT64_C(11667695520944036383), UINT64_C(1158810380537498616) }, { UINT64_C(14584619401180045478), UINT64_C(15283571030954036982) },
+  { UINT64_C(18230774251475056848), UINT64_C(9881091751837770420) }, { UINT64_C(11394233907171910530), UINT64_C(6175682344898606512) },
+  { UINT64_C(14242792383964888162), UINT64_C(16942974967978033949) }, { UINT64_C(17803490479956110203), UINT64_C(11955346673117766628) },
+  { UINT64_C(11127181549972568877), UINT64_C(5166248661484910190) }, { UINT64_C(13908976937465711096), UINT64_C(11069496845283525642) },
+  { UINT64_C(17386221171832138870), UINT64_C(13836871056604407053) }, { UINT64_C(10866388232395086794), UINT64_C(4036358391950366504) },
+  { UINT64_C(13582985290493858492), UINT64_C(14268820026792733938) }, { UINT64_C(16978731613117323115), UINT64_C(17836025033490917422) },
+  { UINT64_C(10611707258198326947), UINT64_C(8841672636718129437) }, { UINT64_C(13264634072747908684), UINT64_C(6440404777470273892) },
+  { UINT64_C(16580792590934885855), UINT64_C(8050505971837842365) }, { UINT64_C(10362995369334303659), UINT64_C(11949095260039733334) },
+  { UINT64_C(12953744211667879574), UINT64_C(10324683056622278764) }, { UINT64_C(16192180264584849468), UINT64_C(3682481783923072647) },
+  { UINT64_C(10120112665365530917), UINT64_C(11524923151806696212) }, { UINT64_C(12650140831706913647), UINT64_C(571095884476206553) },
+  { UINT64_C(15812676039633642058), UINT64_C(14548927910877421904) }, { UINT64_C(9882922524771026286), UINT64_C(13704765962725776594) },
+  { UINT64_C(12353653155963782858), UINT64_C(7907585416552444934) }, { UINT64_C(15442066444954728573), UINT64_C(661109733835780360) },
+  { UINT64_C(9651291528096705358), UINT64_C(2719036592861056677) }, { UINT64_C(12064114410120881697), UINT64_C(12622167777931096654) },
+  { UINT64_C(15080143012651102122), UINT64_C(1942651667131707105) }, { UINT64_C(9425089382906938826), UINT64_C(5825843310384704845) },
+  { UINT64_C(11781361728633673532), UINT64_C(16505676174835656864) }, { UINT64_C(14726702160792091916), UINT64_C(2185351144835019464) },
+  { UINT64_C(18408377700990114895), UINT64_C(2731688931043774330) }, { UINT64_C(11505236063118821809), UINT64_C(8624834609543440812) },
+  { UINT64_C(14381545078898527261), UINT64_C(15392729280356688919) }, { UINT64_C(17976931348623159077), UINT64_C(5405853545163697437) },
+  { UINT64_C(11235582092889474423), UINT64_C(5684501474941004850) }, { UINT64_C(14044477616111843029), UINT64_C(2493940825248868159) },
+  { UINT64_C(17555597020139803786), UINT64_C(7729112049988473103) }, { UINT64_C(10972248137587377366), UINT64_C(9442381049670183593) },
+  { UINT64_C(13715310171984221708), UINT64_C(2579604275232953683) }, { UINT64_C(17144137714980277135), UINT64_C(3224505344041192104) },
+  { UINT64_C(10715086071862673209), UINT64_C(8932844867666826921) }, { UINT64_C(13393857589828341511), UINT64_C(15777742103010921555) },
+  { UINT64_C(16742321987285426889), UINT64_C(15110491610336264040) }, { UINT64_C(10463951242053391806), UINT64_C(2526528228819083169) },
+  { UINT64_C(13079939052566739757), UINT64_C(12381532322878629770) }, { UINT64_C(16349923815708424697), UINT64_C(1641857348316123500) },
+  { UINT64_C(10218702384817765435), UINT64_C(12555375888766046947) }, { UINT64_C(12773377981022206794), UINT64_C(11082533842530170780) },
+  { UINT64_C(15966722476277758493), UINT64_C(4629795266307937667) }, { UINT64_C(9979201547673599058), UINT64_C(5199465050656154994) },
+  { UINT64_C(12474001934591998822), UINT64_C(15722703350174969551) }, { UINT64_C(15592502418239998528), UINT64_C(10430007150863936130) },
+  { UINT64_C(9745314011399999080), UINT64_C(6518754469289960081) }, { UINT64_C(12181642514249998850), UINT64_C(8148443086612450102) },
+  { UINT64_C(15227053142812498563), UINT64_C(962181821410786819) }, { UINT64_C(9516908214257811601), UINT64_C(16742264702877599426) },
+  { UINT64_C(11896135267822264502), UINT64_C(7092772823314835570) }, { UINT64_C(14870169084777830627), UINT64_C(18089338065998320271) },
+  { UINT64_C(9293855677986144142), UINT64_C(8999993282035256217) }, { UINT64_C(11617319597482680178), UINT64_C(2026619565689294464) },
+  { UINT64_C(14521649496853350222), UINT64_C(11756646493966393888) }, { UINT64_C(18152061871066687778), UINT64_C(5472436080603216552) },
+  { UINT64_C(11345038669416679861), UINT64_C(8031958568804398249) }, { UINT64_C(14181298336770849826), UINT64_C(14651634229432885715) },
+  { UINT64_C(17726622920963562283), UINT64_C(9091170749936331336) }, { UINT64_C(11079139325602226427), UINT64_C(3376138709496513133) },
+  { UINT64_C(13848924157002783033), UINT64_C(18055231442152805128) }, { UINT64_C(17311155196253478792), UINT64_C(8733981247408842698) },
+  { UINT64_C(10819471997658424245), UINT64_C(5458738279630526686) }, { UINT64_C(13524339997073030306), UINT64_C(11435108867965546262) },
+  { UINT64_C(16905424996341287883), UINT64_C(5070514048102157020) }, { UINT64_C(10565890622713304927), UINT64_C(863228270850154185) },
+  { UINT64_C(13207363278391631158), UINT64_C(14914093393844856443) }, { UINT64_C(16509204097989538948), UINT64_C(9419244705451294746) },
+  { UINT64_C(10318252561243461842), UINT64_C(15110399977761835024) }, { UINT64_C(12897815701554327303), UINT64_C(9664627935347517973) },
+  { UINT64_C(16122269626942909129), UINT64_C(7469098900757009562) }, { UINT64_C(10076418516839318205), UINT64_C(16197401859041600736) },
+  { UINT64_C(12595523146049147757), UINT64_C(6411694268519837208) }, { UINT64_C(15744403932561434696), UINT64_C(12626303854077184414) },
+  { UINT64_C(9840252457850896685), UINT64_C(7891439908798240259) }, { UINT64_C(12300315572313620856), UINT64_C(14475985904425188227) },
+  { UINT64_C(15375394465392026070), UINT64_C(18094982380531485284) }, { UINT64_C(9609621540870016294), UINT64_C(6697677969404790399) },
+  { UINT64_C(12012026926087520367), UINT64_C(17595469498610763806) }, { UINT64_C(15015033657609400459), UINT64_C(17382650854836066854) },
+  { UINT64_C(9384396036005875287), UINT64_C(8558313775058847832) }, { UINT64_C(11730495045007344109), UINT64_C(6086206200396171886) },
+  { UINT64_C(14663118806259180136), UINT64_C(12219443768922602761) }, { UINT64_C(18328898507823975170), UINT64_C(15274304711153253452) },
+  { UINT64_C(11455561567389984481), UINT64_C(14158126462898171311) }, { UINT64_C(14319451959237480602), UINT64_C(3862600023340550427) },
+  { UINT64_C(17899314949046850752), UINT64_C(14051622066030463842) }, { UINT64_C(11187071843154281720), UINT64_C(8782263791269039901) },
+  { UINT64_C(13983839803942852150), UINT64_C(10977829739086299876) }, { UINT64_C(17479799754928565188), UINT64_C(4498915137003099037) },
+  { UINT64_C(10924874846830353242), UINT64_C(12035193997481712706) }, { UINT64_C(13656093558537941553), UINT64_C(5820620459997365075) },
+  { UINT64_C(17070116948172426941), UINT64_C(11887461593424094248) }, { UINT64_C(10668823092607766838), UINT64_C(9735506505103752857) },
+  { UINT64_C(13336028865759708548), UINT64_C(2946011094524915263) }, { UINT64_C(16670036082199635685), UINT64_C(3682513868156144079) },
+  { UINT64_C(10418772551374772303), UINT64_C(4607414176811284001) }, { UINT64_C(13023465689218465379), UINT64_C(1147581702586717097) },
+  { UINT64_C(16279332111523081723), UINT64_C(15269535183515560084) }, { UINT64_C(10174582569701926077), UINT64_C(7237616480483531100) },
+  { UINT64_C(12718228212127407596), UINT64_C(13658706619031801779) }, { UINT64_C(15897785265159259495), UINT64_C(17073383273789752224) },
+  { UINT64_C(9936115790724537184), UINT64_C(17588393573759676996) }, { UINT64_C(12420144738405671481), UINT64_C(3538747893490044629) },
+  { UINT64_C(15525180923007089351), UINT64_C(9035120885289943691) }, { UINT64_C(9703238076879430844), UINT64_C(12564479580947296663) },
+  { UINT64_C(12129047596099288555), UINT64_C(15705599476184120828) }, { UINT64_C(15161309495124110694), UINT64_C(15020313326802763131) },
+  { UINT64_C(9475818434452569184), UINT64_C(4776009810824339053) }, { UINT64_C(11844773043065711480), UINT64_C(5970012263530423816) },
+  { UINT64_C(14805966303832139350), UINT64_C(7462515329413029771) }, { UINT64_C(9253728939895087094), UINT64_C(52386062455755702) },
+  { UINT64_C(11567161174868858867), UINT64_C(9288854614924470436) }, { UINT64_C(14458951468586073584), UINT64_C(6999382250228200141) },
+  { UINT64_C(18073689335732591980), UINT64_C(8749227812785250177) }, { UINT64_C(11296055834832869987), UINT64_C(14691639419845557168) },
+  { UINT64_C(14120069793541087484), UINT64_C(13752863256379558556) }, { UINT64_C(17650087241926359355), UINT64_C(17191079070474448196) },
+  { UINT64_C(11031304526203974597), UINT64_C(8438581409832836170) }, { UINT64_C(13789130657754968246), UINT64_C(15159912780718433117) },
+  { UINT64_C(17236413322193710308), UINT64_C(9726518939043265588) }, { UINT64_C(10772758326371068942), UINT64_C(15302446373756816800) },
+  { UINT64_C(13465947907963836178), UINT64_C(9904685930341245193) }, { UINT64_C(16832434884954795223), UINT64_C(3157485376071780683) },
+  { UINT64_C(10520271803096747014), UINT64_C(8890957387685944783) }, { UINT64_C(13150339753870933768), UINT64_C(1890324697752655170) },
+  { UINT64_C(16437924692338667210), UINT64_C(2362905872190818963) }, { UINT64_C(10273702932711667006), UINT64_C(6088502188546649756) },
+  { UINT64_C(12842128665889583757), UINT64_C(16833999772538088003) }, { UINT64_C(16052660832361979697), UINT64_C(7207441660390446292) },
+  { UINT64_C(10032913020226237310), UINT64_C(16033866083812498692) }, { UINT64_C(12541141275282796638), UINT64_C(10818960567910847557) },
+  { UINT64_C(15676426594103495798), UINT64_C(4300328673033783639) }, { UINT64_C(9797766621314684873), UINT64_C(16522763475928278486) },
+  { UINT64_C(12247208276643356092), UINT64_C(6818396289628184396) }, { UINT64_C(15309010345804195115), UINT64_C(8522995362035230495) },
+  { UINT64_C(9568131466127621947), UINT64_C(3021029092058325107) }, { UINT64_C(11960164332659527433), UINT64_C(17611344420355070096) },
+  { UINT64_C(14950205415824409292), UINT64_C(8179122470161673908) }, { UINT64_C(9343878384890255807), UINT64_C(14335323580705822000) },
+  { UINT64_C(11679847981112819759), UINT64_C(13307468457454889596) }, { UINT64_C(14599809976391024699), UINT64_C(12022649553391224092) },
+  { UINT64_C(18249762470488780874), UINT64_C(10416625923311642211) }, { UINT64_C(11406101544055488046), UINT64_C(11122077220497164286) },
+  { UINT64_C(14257626930069360058), UINT64_C(4679224488766679549) }, { UINT64_C(17822033662586700072), UINT64_C(15072402647813125244) },
+  { UINT64_C(11138771039116687545), UINT64_C(9420251654883203278) }, { UINT64_C(13923463798895859431), UINT64_C(16387000587031392001) },
+  { UINT64_C(17404329748619824289), UINT64_C(15872064715361852097) }, { UINT64_C(10877706092887390181), UINT64_C(3002511419460075705) },
+  { UINT64_C(13597132616109237726), UINT64_C(8364825292752482535) }, { UINT64_C(16996415770136547158), UINT64_C(1232659579085827361) },
+  { UINT64_C(10622759856335341973), UINT64_C(14605470292210805812) }, { UINT64_C(13278449820419177467), UINT64_C(4421779809981343554) },
+  { UINT64_C(16598062275523971834), UINT64_C(915538744049291538) }, { UINT64_C(10373788922202482396), UINT64_C(5183897733458195115) },
+  { UINT64_C(12967236152753102995), UINT64_C(6479872166822743894) }, { UINT64_C(16209045190941378744), UINT64_C(3488154190101041964) },
+  { UINT64_C(10130653244338361715), UINT64_C(2180096368813151227) }, { UINT64_C(12663316555422952143), UINT64_C(16560178516298602746) },
+  { UINT64_C(15829145694278690179), UINT64_C(16088537126945865529) }, { UINT64_C(9893216058924181362), UINT64_C(7749492695127472003) },
+  { UINT64_C(12366520073655226703), UINT64_C(463493832054564196) }, { UINT64_C(15458150092069033378), UINT64_C(14414425345350368957) },
+  { UINT64_C(9661343807543145861), UINT64_C(13620701859271368502) }, { UINT64_C(12076679759428932327), UINT64_C(3190819268807046916) },
+  { UINT64_C(15095849699286165408), UINT64_C(17823582141290972357) }, { UINT64_C(9434906062053853380), UINT64_C(11139738838306857723) },
+  { UINT64_C(11793632577567316725), UINT64_C(13924673547883572154) }, { UINT64_C(14742040721959145907), UINT64_C(3570783879572301480) },
+  { UINT64_C(18427550902448932383), UINT64_C(18298537904747540562) }, { UINT64_C(11517219314030582739), UINT64_C(18354115218108294707) },
+  { UINT64_C(14396524142538228424), UINT64_C(18330958004207980480) }, { UINT64_C(17995655178172785531), UINT64_C(4466953431550423984) },
+  { UINT64_C(11247284486357990957), UINT64_C(486002885505321038) }, { UINT64_C(14059105607947488696), UINT64_C(5219189625309039202) },
+  { UINT64_C(17573882009934360870), UINT64_C(6523987031636299002) }, { UINT64_C(10983676256208975543), UINT64_C(17912549950054850588) },
+  { UINT64_C(13729595320261219429), UINT64_C(17779001419141175331) }, { UINT64_C(17161994150326524287), UINT64_C(8388693718644305452) },
+  { UINT64_C(10726246343954077679), UINT64_C(12160462601793772764) }, { UINT64_C(13407807929942597099), UINT64_C(10588892233814828051) },
+  { UINT64_C(16759759912428246374), UINT64_C(8624429273841147159) }, { UINT64_C(10474849945267653984), UINT64_C(778582277723329070) },
+  { UINT64_C(13093562431584567480), UINT64_C(973227847154161338) }, { UINT64_C(16366953039480709350), UINT64_C(1216534808942701673) },
+  { UINT64_C(10229345649675443343), UINT64_C(14595392310871352257) }, { UINT64_C(12786682062094304179), UINT64_C(13632554370161802418) },
+  { UINT64_C(15983352577617880224), UINT64_C(12429006944274865118) }, { UINT64_C(9989595361011175140), UINT64_C(7768129340171790699) },
+  { UINT64_C(12486994201263968925), UINT64_C(9710161675214738374) }, { UINT64_C(15608742751579961156), UINT64_C(16749388112445810871) },
+  { UINT64_C(9755464219737475723), UINT64_C(1244995533423855986) }, { UINT64_C(12194330274671844653), UINT64_C(15391302472061983695) },
+  { UINT64_C(15242912843339805817), UINT64_C(5404070034795315907) }, { UINT64_C(9526820527087378635), UINT64_C(14906758817815542202) },
+  { UINT64_C(11908525658859223294), UINT64_C(14021762503842039848) }, { UINT64_C(14885657073574029118), UINT64_C(8303831092947774002) },
+  { UINT64_C(9303535670983768199), UINT64_C(578208414664970847) }, { UINT64_C(11629419588729710248), UINT64_C(14557818573613377271) },
+  { UINT64_C(14536774485912137810), UINT64_C(18197273217016721589) }, { UINT64_C(18170968107390172263), UINT64_C(13523219484416126178) },
+  { UINT64_C(11356855067118857664), UINT64_C(15369541205401160717) }, { UINT64_C(14196068833898572081), UINT64_C(765182433041899281) },
+  { UINT64_C(17745086042373215101), UINT64_C(5568164059729762005) }, { UINT64_C(11090678776483259438), UINT64_C(5785945546544795205) },
+  { UINT64_C(13863348470604074297), UINT64_C(16455803970035769814) }, { UINT64_C(17329185588255092872), UINT64_C(6734696907262548556) },
+  { UINT64_C(10830740992659433045), UINT64_C(4209185567039092847) }, { UINT64_C(13538426240824291306), UINT64_C(9873167977226253963) },
+  { UINT64_C(16923032801030364133), UINT64_C(3118087934678041646) }, { UINT64_C(10576895500643977583), UINT64_C(4254647968387469981) },
+  { UINT64_C(13221119375804971979), UINT64_C(706623942056949572) }, { UINT64_C(16526399219756214973), UINT64_C(14718337982853350677) },
+  { UINT64_C(10328999512347634358), UINT64_C(11504804248497038125) }, { UINT64_C(12911249390434542948), UINT64_C(5157633273766521849) },
+  { UINT64_C(16139061738043178685), UINT64_C(6447041592208152311) }, { UINT64_C(10086913586276986678), UINT64_C(6335244004343789146) },
+  { UINT64_C(12608641982846233347), UINT64_C(17142427042284512241) }, { UINT64_C(15760802478557791684), UINT64_C(16816347784428252397) },
+  { UINT64_C(9850501549098619803), UINT64_C(1286845328412881940) }, { UINT64_C(12313126936373274753), UINT64_C(15443614715798266137) },
+  { UINT64_C(15391408670466593442), UINT64_C(5469460339465668959) }, { UINT64_C(9619630419041620901), UINT64_C(8030098730593431003) },
+  { UINT64_C(12024538023802026126), UINT64_C(14649309431669176658) }, { UINT64_C(15030672529752532658), UINT64_C(9088264752731695015) },
+  { UINT64_C(9394170331095332911), UINT64_C(10291851488884697288) }, { UINT64_C(11742712913869166139), UINT64_C(8253128342678483706) },
+  { UINT64_C(14678391142336457674), UINT64_C(5704724409920716729) }, { UINT64_C(18347988927920572092), UINT64_C(16354277549255671720) },
+  { UINT64_C(11467493079950357558), UINT64_C(998051431430019017) }, { UINT64_C(14334366349937946947), UINT64_C(10470936326142299579) },
+  { UINT64_C(17917957937422433684), UINT64_C(8476984389250486570) }, { UINT64_C(11198723710889021052), UINT64_C(14521487280136329914) },
+  { UINT64_C(13998404638611276315), UINT64_C(18151859100170412392) }, { UINT64_C(17498005798264095394), UINT64_C(18078137856785627587) },
+  { UINT64_C(10936253623915059621), UINT64_C(15910522178918405146) }, { UINT64_C(13670317029893824527), UINT64_C(6053094668365842720) },
+  { UINT64_C(17087896287367280659), UINT64_C(2954682317029915496) }, { UINT64_C(10679935179604550411), UINT64_C(17987577512639554849) },
+  { UINT64_C(13349918974505688014), UINT64_C(17872785872372055657) }, { UINT64_C(16687398718132110018), UINT64_C(13117610303610293764) },
+  { UINT64_C(10429624198832568761), UINT64_C(12810192458183821506) }, { UINT64_C(13037030248540710952), UINT64_C(2177682517447613171) },
+  { UINT64_C(16296287810675888690), UINT64_C(2722103146809516464) }, { UINT64_C(10185179881672430431), UINT64_C(6313000485183335694) },
+  { UINT64_C(12731474852090538039), UINT64_C(3279564588051781713) }, { UINT64_C(15914343565113172548), UINT64_C(17934513790346890853) },
+  { UINT64_C(9946464728195732843), UINT64_C(1985699082112030975) }, { UINT64_C(12433080910244666053), UINT64_C(16317181907922202431) },
+  { UINT64_C(15541351137805832567), UINT64_C(6561419329620589327) }, { UINT64_C(9713344461128645354), UINT64_C(11018416108653950185) },
+  { UINT64_C(12141680576410806693), UINT64_C(4549648098962661924) }, { UINT64_C(15177100720513508366), UINT64_C(10298746142130715309) },
+  { UINT64_C(9485687950320942729), UINT64_C(1825030320404309164) }, { UINT64_C(11857109937901178411), UINT64_C(6892973918932774359) },
+  { UINT64_C(14821387422376473014), UINT64_C(4004531380238580045) }, { UINT64_C(9263367138985295633), UINT64_C(16337890167931276240) },
+  { UINT64_C(11579208923731619542), UINT64_C(6587304654631931588) }, { UINT64_C(14474011154664524427), UINT64_C(17457502855144690293) },
+  { UINT64_C(18092513943330655534), UINT64_C(17210192550503474962) }, { UINT64_C(11307821214581659709), UINT64_C(6144684325637283947) },
+  { UINT64_C(14134776518227074636), UINT64_C(12292541425473992838) }, { UINT64_C(17668470647783843295), UINT64_C(15365676781842491048) },
+  { UINT64_C(11042794154864902059), UINT64_C(16521077016292638761) }, { UINT64_C(13803492693581127574), UINT64_C(16039660251938410547) },
+  { UINT64_C(17254365866976409468), UINT64_C(10826203278068237376) }, { UINT64_C(10783978666860255917), UINT64_C(15989749085647424168) },
+  { UINT64_C(13479973333575319897), UINT64_C(6152128301777116498) }, { UINT64_C(16849966666969149871), UINT64_C(12301846395648783526) },
+  { UINT64_C(10531229166855718669), UINT64_C(14606183024921571560) }, { UINT64_C(13164036458569648337), UINT64_C(4422670725869800738) },
+  { UINT64_C(16455045573212060421), UINT64_C(10140024425764638826) }, { UINT64_C(10284403483257537763), UINT64_C(8643358275316593218) },
+  { UINT64_C(12855504354071922204), UINT64_C(6192511825718353619) }, { UINT64_C(16069380442589902755), UINT64_C(7740639782147942024) },
+  { UINT64_C(10043362776618689222), UINT64_C(2532056854628769813) }, { UINT64_C(12554203470773361527), UINT64_C(12388443105140738074) },
+  { UINT64_C(15692754338466701909), UINT64_C(10873867862998534689) }, { UINT64_C(9807971461541688693), UINT64_C(9102010423587778132) },
+  { UINT64_C(12259964326927110866), UINT64_C(15989199047912110569) }, { UINT64_C(15324955408658888583), UINT64_C(10763126773035362404) },
+  { UINT64_C(9578097130411805364), UINT64_C(13644483260788183358) }, { UINT64_C(11972621413014756705), UINT64_C(17055604075985229198) },
+  { UINT64_C(14965776766268445882), UINT64_C(7484447039699372786) }, { UINT64_C(9353610478917778676), UINT64_C(9289465418239495895) },
+  { UINT64_C(11692013098647223345), UINT64_C(11611831772799369869) }, { UINT64_C(14615016373309029182), UINT64_C(679731660717048624) },
+  { UINT64_C(18268770466636286477), UINT64_C(10073036612751086588) }, { UINT64_C(11417981541647679048), UINT64_C(8601490892183123070) },
+  { UINT64_C(14272476927059598810), UINT64_C(10751863615228903838) }, { UINT64_C(17840596158824498513), UINT64_C(4216457482181353989) },
+  { UINT64_C(11150372599265311570), UINT64_C(14164500972431816003) }, { UINT64_C(13937965749081639463), UINT64_C(8482254178684994196) },
+  { UINT64_C(17422457186352049329), UINT64_C(5991131704928854841) }, { UINT64_C(10889035741470030830), UINT64_C(15273672361649004036) },
+  { UINT64_C(13611294676837538538), UINT64_C(9868718415206479237) }, { UINT64_C(17014118346046923173), UINT64_C(3112525982153323238) },
+  { UINT64_C(10633823966279326983), UINT64_C(4251171748059520976) }, { UINT64_C(13292279957849158729), UINT64_C(702278666647013315) },
+  { UINT64_C(16615349947311448411), UINT64_C(5489534351736154548) }, { UINT64_C(10384593717069655257), UINT64_C(1125115960621402641) },
+  { UINT64_C(12980742146337069071), UINT64_C(6018080969204141205) }, { UINT64_C(16225927682921336339), UINT64_C(2910915193077788602) },
+  { UINT64_C(10141204801825835211), UINT64_C(17960223060169475540) }, { UINT64_C(12676506002282294014), UINT64_C(17838592806784456521) },
+  { UINT64_C(15845632502852867518), UINT64_C(13074868971625794844) }, { UINT64_C(9903520314283042199), UINT64_C(3560107088838733873) },
+  { UINT64_C(12379400392853802748), UINT64_C(18285191916330581054) }, { UINT64_C(15474250491067253436), UINT64_C(4409745821703674701) },
+  { UINT64_C(9671406556917033397), UINT64_C(11979463175419572496) }, { UINT64_C(12089258196146291747), UINT64_C(1139270913992301908) },
+  { UINT64_C(15111572745182864683), UINT64_C(15259146697772541097) }, { UINT64_C(9444732965739290427), UINT64_C(7231123676894144234) },
+  { UINT64_C(11805916207174113034), UINT64_C(4427218577690292388) }, { UINT64_C(14757395258967641292), UINT64_C(14757395258967641293) },
+  { UINT64_C(9223372036854775808), UINT64_C(0) }, { UINT64_C(11529215046068469760), UINT64_C(0) },
+  { UINT64_C(14411518807585587200), UINT64_C(0) }, { UINT64_C(18014398509481984000), UINT64_C(0) },
+  { UINT64_C(11258999068426240000), UINT64_C(0) }, { UINT64_C(14073748835532800000), UINT64_C(0) },
+  { UINT64_C(17592186044416000000), UINT64_C(0) }, { UINT64_C(10995116277760000000), UINT64_C(0) },
+  { UINT64_C(13743895347200000000), UINT64_C(0) }, { UINT64_C(17179869184000000000), UINT64_C(0) },
+  { UINT64_C(10737418240000000000), UINT64_C(0) }, { UINT64_C(13421772800000000000), UINT64_C(0) },
+  { UINT64_C(16777216000000000000), UINT64_C(0) }, { UINT64_C(10485760000000000000), UINT64_C(0) },
+  { UINT64_C(13107200000000000000), UINT64_C(0) }, { UINT64_C(16384000000000000000), UINT64_C(0) },
+  { UINT64_C(10240000000000000000), UINT64_C(0) }, { UINT64_C(12800000000000000000), UINT64_C(0) },
+  { UINT64_C(16000000000000000000), UINT64_C(0) }, { UINT64_C(10000000000000000000), UINT64_C(0) },
+  { UINT64_C(12500000000000000000), UINT64_C(0) }, { UINT64_C(15625000000000000000), UINT64_C(0) },
+  { UINT64_C(9765625000000000000), UINT64_C(0) }, { UINT64_C(12207031250000000000), UINT64_C(0) },
+  { UINT64_C(15258789062500000000), UINT64_C(0) }, { UINT64_C(9536743164062500000), UINT64_C(0) },
+  { UINT64_C(11920928955078125000), UINT64_C(0) }, { UINT64_C(14901161193847656250), UINT64_C(0) },
+  { UINT64_C(9313225746154785156), UINT64_C(4611686018427387904) }, { UINT64_C(11641532182693481445), UINT64_C(5764607523034234880) },
+  { UINT64_C(14551915228366851806), UINT64_C(11817445422220181504) }, { UINT64_C(18189894035458564758), UINT64_C(5548434740920451072) },
+  { UINT64_C(11368683772161602973), UINT64_C(17302829768357445632) }, { UINT64_C(14210854715202003717), UINT64_C(7793479155164643328) },
+  { UINT64_C(17763568394002504646), UINT64_C(14353534962383192064) }, { UINT64_C(11102230246251565404), UINT64_C(4359273333062107136) },
+  { UINT64_C(13877787807814456755), UINT64_C(5449091666327633920) }, { UINT64_C(17347234759768070944), UINT64_C(2199678564482154496) },
+  { UINT64_C(10842021724855044340), UINT64_C(1374799102801346560) }, { UINT64_C(13552527156068805425), UINT64_C(1718498878501683200) },
+  { UINT64_C(16940658945086006781), UINT64_C(6759809616554491904) }, { UINT64_C(10587911840678754238), UINT64_C(6530724019560251392) },
+  { UINT64_C(13234889800848442797), UINT64_C(17386777061305090048) }, { UINT64_C(16543612251060553497), UINT64_C(7898413271349198848) },
+  { UINT64_C(10339757656912845935), UINT64_C(16465723340661719040) }, { UINT64_C(12924697071141057419), UINT64_C(15970468157399760896) },
+  { UINT64_C(16155871338926321774), UINT64_C(15351399178322313216) }, { UINT64_C(10097419586828951109), UINT64_C(4982938468024057856) },
+  { UINT64_C(12621774483536188886), UINT64_C(10840359103457460224) }, { UINT64_C(15777218104420236108), UINT64_C(4327076842467049472) },
+  { UINT64_C(9860761315262647567), UINT64_C(11927795063396681728) }, { UINT64_C(12325951644078309459), UINT64_C(10298057810818464256) },
+  { UINT64_C(15407439555097886824), UINT64_C(8260886245095692416) }, { UINT64_C(9629649721936179265), UINT64_C(5163053903184807760) },
+  { UINT64_C(12037062152420224081), UINT64_C(11065503397408397604) }, { UINT64_C(15046327690525280101), UINT64_C(18443565265187884909) },
+  { UINT64_C(9403954806578300063), UINT64_C(13833071299956122020) }, { UINT64_C(11754943508222875079), UINT64_C(12679653106517764621) },
+  { UINT64_C(14693679385278593849), UINT64_C(11237880364719817872) }, { UINT64_C(18367099231598242312), UINT64_C(212292400617608628) },
+  { UINT64_C(11479437019748901445), UINT64_C(132682750386005392) }, { UINT64_C(14349296274686126806), UINT64_C(4777539456409894645) },
+  { UINT64_C(17936620343357658507), UINT64_C(15195296357367144114) }, { UINT64_C(11210387714598536567), UINT64_C(7191217214140771119) },
+  { UINT64_C(14012984643248170709), UINT64_C(4377335499248575995) }, { UINT64_C(17516230804060213386), UINT64_C(10083355392488107898) },
+  { UINT64_C(10947644252537633366), UINT64_C(10913783138732455340) }, { UINT64_C(13684555315672041708), UINT64_C(4418856886560793367) },
+  { UINT64_C(17105694144590052135), UINT64_C(5523571108200991709) }, { UINT64_C(10691058840368782584), UINT64_C(10369760970266701674) },
+  { UINT64_C(13363823550460978230), UINT64_C(12962201212833377092) }, { UINT64_C(16704779438076222788), UINT64_C(6979379479186945558) },
+  { UINT64_C(10440487148797639242), UINT64_C(13585484211346616781) }, { UINT64_C(13050608935997049053), UINT64_C(7758483227328495169) },
+  { UINT64_C(16313261169996311316), UINT64_C(14309790052588006865) }, { UINT64_C(10195788231247694572), UINT64_C(18166990819722280098) },
+  { UINT64_C(12744735289059618216), UINT64_C(4261994450943298507) }, { UINT64_C(15930919111324522770), UINT64_C(5327493063679123134) },
+  { UINT64_C(9956824444577826731), UINT64_C(7941369183226839863) }, { UINT64_C(12446030555722283414), UINT64_C(5315025460606161924) },
+  { UINT64_C(15557538194652854267), UINT64_C(15867153862612478214) }, { UINT64_C(9723461371658033917), UINT64_C(7611128154919104931) },
+  { UINT64_C(12154326714572542396), UINT64_C(14125596212076269068) }, { UINT64_C(15192908393215677995), UINT64_C(17656995265095336336) },
+  { UINT64_C(9495567745759798747), UINT64_C(8729779031470891258) }, { UINT64_C(11869459682199748434), UINT64_C(6300537770911226168) },
+  { UINT64_C(14836824602749685542), UINT64_C(17099044250493808518) }, { UINT64_C(9273015376718553464), UINT64_C(6075216638131242420) },
+  { UINT64_C(11591269220898191830), UINT64_C(7594020797664053025) }, { UINT64_C(14489086526122739788), UINT64_C(269153960225290473) },
+  { UINT64_C(18111358157653424735), UINT64_C(336442450281613091) }, { UINT64_C(11319598848533390459), UINT64_C(7127805559067090038) },
+  { UINT64_C(14149498560666738074), UINT64_C(4298070930406474644) }, { UINT64_C(17686873200833422592), UINT64_C(14595960699862869113) },
+  { UINT64_C(11054295750520889120), UINT64_C(9122475437414293195) }, { UINT64_C(13817869688151111400), UINT64_C(11403094296767866494) },
+  { UINT64_C(17272337110188889250), UINT64_C(14253867870959833118) }, { UINT64_C(10795210693868055781), UINT64_C(13520353437777283602) },
+  { UINT64_C(13494013367335069727), UINT64_C(3065383741939440791) }, { UINT64_C(16867516709168837158), UINT64_C(17666787732706464701) },
+  { UINT64_C(10542197943230523224), UINT64_C(6430056314514152534) }, { UINT64_C(13177747429038154030), UINT64_C(8037570393142690668) },
+  { UINT64_C(16472184286297692538), UINT64_C(823590954573587527) }, { UINT64_C(10295115178936057836), UINT64_C(5126430365035880108) },
+  { UINT64_C(12868893973670072295), UINT64_C(6408037956294850135) }, { UINT64_C(16086117467087590369), UINT64_C(3398361426941174765) },
+  { UINT64_C(10053823416929743980), UINT64_C(13653190937906703988) }, { UINT64_C(12567279271162179975), UINT64_C(17066488672383379985) },
+  { UINT64_C(15709099088952724969), UINT64_C(16721424822051837077) }, { UINT64_C(9818186930595453106), UINT64_C(3533361486141316317) },
+  { UINT64_C(12272733663244316382), UINT64_C(13640073894531421205) }, { UINT64_C(15340917079055395478), UINT64_C(7826720331309500698) },
+  { UINT64_C(9588073174409622174), UINT64_C(280014188641050032) }, { UINT64_C(11985091468012027717), UINT64_C(9573389772656088348) },
+  { UINT64_C(14981364335015034646), UINT64_C(16578423234247498339) }, { UINT64_C(9363352709384396654), UINT64_C(5749828502977298558) },
+  { UINT64_C(11704190886730495817), UINT64_C(16410657665576399005) }, { UINT64_C(14630238608413119772), UINT64_C(6678264026688335045) },
+  { UINT64_C(18287798260516399715), UINT64_C(8347830033360418806) }, { UINT64_C(11429873912822749822), UINT64_C(2911550761636567802) },
+  { UINT64_C(14287342391028437277), UINT64_C(12862810488900485560) }, { UINT64_C(17859177988785546597), UINT64_C(2243455055843443238) },
+  { UINT64_C(11161986242990966623), UINT64_C(3708002419115845976) }, { UINT64_C(13952482803738708279), UINT64_C(23317005467419566) },
+  { UINT64_C(17440603504673385348), UINT64_C(13864204312116438170) }, { UINT64_C(10900377190420865842), UINT64_C(17888499731927549664) },
+  { UINT64_C(13625471488026082303), UINT64_C(13137252628054661272) }, { UINT64_C(17031839360032602879), UINT64_C(11809879766640938686) },
+  { UINT64_C(10644899600020376799), UINT64_C(14298703881791668535) }, { UINT64_C(13306124500025470999), UINT64_C(13261693833812197764) },
+  { UINT64_C(16632655625031838749), UINT64_C(11965431273837859301) }, { UINT64_C(10395409765644899218), UINT64_C(9784237555362356015) },
+  { UINT64_C(12994262207056124023), UINT64_C(3006924907348169211) }, { UINT64_C(16242827758820155028), UINT64_C(17593714189467375226) },
+  { UINT64_C(10151767349262596893), UINT64_C(1772699331562333708) }, { UINT64_C(12689709186578246116), UINT64_C(6827560182880305039) },
+  { UINT64_C(15862136483222807645), UINT64_C(8534450228600381299) }, { UINT64_C(9913835302014254778), UINT64_C(7639874402088932264) },
+  { UINT64_C(12392294127517818473), UINT64_C(326470965756389522) }, { UINT64_C(15490367659397273091), UINT64_C(5019774725622874806) },
+  { UINT64_C(9681479787123295682), UINT64_C(831516194300602802) }, { UINT64_C(12101849733904119602), UINT64_C(10262767279730529310) },
+  { UINT64_C(15127312167380149503), UINT64_C(3605087062808385830) }, { UINT64_C(9454570104612593439), UINT64_C(9170708441896323000) },
+  { UINT64_C(11818212630765741799), UINT64_C(6851699533943015846) }, { UINT64_C(14772765788457177249), UINT64_C(3952938399001381903) },
+  { UINT64_C(9232978617785735780), UINT64_C(13999801545444333449) }, { UINT64_C(11541223272232169725), UINT64_C(17499751931805416812) },
+  { UINT64_C(14426529090290212157), UINT64_C(8039631859474607303) }, { UINT64_C(18033161362862765196), UINT64_C(14661225842770647033) },
+  { UINT64_C(11270725851789228247), UINT64_C(18386638188586430203) }, { UINT64_C(14088407314736535309), UINT64_C(18371611717305649850) },
+  { UINT64_C(17610509143420669137), UINT64_C(9129456591349898601) }, { UINT64_C(11006568214637918210), UINT64_C(17235125415662156385) },
+  { UINT64_C(13758210268297397763), UINT64_C(12320534732722919674) }, { UINT64_C(17197762835371747204), UINT64_C(10788982397476261688) },
+  { UINT64_C(10748601772107342002), UINT64_C(15966486035277439363) }, { UINT64_C(13435752215134177503), UINT64_C(10734735507242023396) },
+  { UINT64_C(16794690268917721879), UINT64_C(8806733365625141341) }, { UINT64_C(10496681418073576174), UINT64_C(12421737381156795194) },
+  { UINT64_C(13120851772591970218), UINT64_C(6303799689591218185) }, { UINT64_C(16401064715739962772), UINT64_C(17103121648843798539) },
+  { UINT64_C(10250665447337476733), UINT64_C(1466078993672598279) }, { UINT64_C(12813331809171845916), UINT64_C(6444284760518135752) },
+  { UINT64_C(16016664761464807395), UINT64_C(8055355950647669691) }, { UINT64_C(10010415475915504622), UINT64_C(2728754459941099604) },
+  { UINT64_C(12513019344894380777), UINT64_C(12634315111781150314) }, { UINT64_C(15641274181117975972), UINT64_C(1957835834444274180) },
+  { UINT64_C(9775796363198734982), UINT64_C(10447019433382447170) }, { UINT64_C(12219745453998418728), UINT64_C(3835402254873283155) },
+  { UINT64_C(15274681817498023410), UINT64_C(4794252818591603944) }, { UINT64_C(9546676135936264631), UINT64_C(7608094030047140369) },
+  { UINT64_C(11933345169920330789), UINT64_C(4898431519131537557) }, { UINT64_C(14916681462400413486), UINT64_C(10734725417341809851) },
+  { UINT64_C(9322925914000258429), UINT64_C(2097517367411243253) }, { UINT64_C(11653657392500323036), UINT64_C(7233582727691441970) },
+  { UINT64_C(14567071740625403795), UINT64_C(9041978409614302462) }, { UINT64_C(18208839675781754744), UINT64_C(6690786993590490174) },
+  { UINT64_C(11380524797363596715), UINT64_C(4181741870994056359) }, { UINT64_C(14225655996704495894), UINT64_C(615491320315182544) },
+  { UINT64_C(17782069995880619867), UINT64_C(9992736187248753989) }, { UINT64_C(11113793747425387417), UINT64_C(3939617107816777291) },
+  { UINT64_C(13892242184281734271), UINT64_C(9536207403198359517) }, { UINT64_C(17365302730352167839), UINT64_C(7308573235570561493) },
+  { UINT64_C(10853314206470104899), UINT64_C(11485387299872682789) }, { UINT64_C(13566642758087631124), UINT64_C(9745048106413465582) },
+  { UINT64_C(16958303447609538905), UINT64_C(12181310133016831978) }, { UINT64_C(10598939654755961816), UINT64_C(695789805494438130) },
+  { UINT64_C(13248674568444952270), UINT64_C(869737256868047663) }, { UINT64_C(16560843210556190337), UINT64_C(10310543607939835386) },
+  { UINT64_C(10350527006597618960), UINT64_C(17973304801030866876) }, { UINT64_C(12938158758247023701), UINT64_C(4019886927579031980) },
+  { UINT64_C(16172698447808779626), UINT64_C(9636544677901177879) }, { UINT64_C(10107936529880487266), UINT64_C(10634526442115624078) },
+  { UINT64_C(12634920662350609083), UINT64_C(4069786015789754290) }, { UINT64_C(15793650827938261354), UINT64_C(475546501309804958) },
+  { UINT64_C(9871031767461413346), UINT64_C(4908902581746016003) }, { UINT64_C(12338789709326766682), UINT64_C(15359500264037295811) },
+  { UINT64_C(15423487136658458353), UINT64_C(9976003293191843956) }, { UINT64_C(9639679460411536470), UINT64_C(17764217104313372233) },
+  { UINT64_C(12049599325514420588), UINT64_C(12981899343536939483) }, { UINT64_C(15061999156893025735), UINT64_C(16227374179421174354) },
+  { UINT64_C(9413749473058141084), UINT64_C(17059637889779315827) }, { UINT64_C(11767186841322676356), UINT64_C(2877803288514593168) },
+  { UINT64_C(14708983551653345445), UINT64_C(3597254110643241460) }, { UINT64_C(18386229439566681806), UINT64_C(9108253656731439729) },
+  { UINT64_C(11491393399729176129), UINT64_C(1080972517029761926) }, { UINT64_C(14364241749661470161), UINT64_C(5962901664714590312) },
+  { UINT64_C(17955302187076837701), UINT64_C(12065313099320625794) }, { UINT64_C(11222063866923023563), UINT64_C(9846663696289085073) },
+  { UINT64_C(14027579833653779454), UINT64_C(7696643601933968437) }, { UINT64_C(17534474792067224318), UINT64_C(397432465562684739) },
+  { UINT64_C(10959046745042015198), UINT64_C(14083453346258841674) }, { UINT64_C(13698808431302518998), UINT64_C(8380944645968776284) },
+  { UINT64_C(17123510539128148748), UINT64_C(1252808770606194547) }, { UINT64_C(10702194086955092967), UINT64_C(10006377518483647400) },
+  { UINT64_C(13377742608693866209), UINT64_C(7896285879677171346) }, { UINT64_C(16722178260867332761), UINT64_C(14482043368023852087) },
+  { UINT64_C(10451361413042082976), UINT64_C(2133748077373825698) }, { UINT64_C(13064201766302603720), UINT64_C(2667185096717282123) },
+  { UINT64_C(16330252207878254650), UINT64_C(3333981370896602653) }, { UINT64_C(10206407629923909156), UINT64_C(6695424375237764562) },
+  { UINT64_C(12758009537404886445), UINT64_C(8369280469047205703) }, { UINT64_C(15947511921756108056), UINT64_C(15073286604736395033) },
+  { UINT64_C(9967194951097567535), UINT64_C(9420804127960246895) }, { UINT64_C(12458993688871959419), UINT64_C(7164319141522920715) },
+  { UINT64_C(15573742111089949274), UINT64_C(4343712908476262990) }, { UINT64_C(9733588819431218296), UINT64_C(7326506586225052273) },
+  { UINT64_C(12166986024289022870), UINT64_C(9158133232781315341) }, { UINT64_C(15208732530361278588), UINT64_C(2224294504121868368) },
+  { UINT64_C(9505457831475799117), UINT64_C(10613556101930943538) }, { UINT64_C(11881822289344748896), UINT64_C(17878631145841067327) },
+  { UINT64_C(14852277861680936121), UINT64_C(3901544858591782542) }, { UINT64_C(9282673663550585075), UINT64_C(13967680582688333849) },
+  { UINT64_C(11603342079438231344), UINT64_C(12847914709933029407) }, { UINT64_C(14504177599297789180), UINT64_C(16059893387416286759) },
+  { UINT64_C(18130221999122236476), UINT64_C(1628122660560806833) }, { UINT64_C(11331388749451397797), UINT64_C(10240948699705280078) },
+  { UINT64_C(14164235936814247246), UINT64_C(17412871893058988002) }, { UINT64_C(17705294921017809058), UINT64_C(12542717829468959195) },
+  { UINT64_C(11065809325636130661), UINT64_C(12450884661845487401) }, { UINT64_C(13832261657045163327), UINT64_C(1728547772024695539) },
+  { UINT64_C(17290327071306454158), UINT64_C(15995742770313033136) }, { UINT64_C(10806454419566533849), UINT64_C(5385653213018257806) },
+  { UINT64_C(13508068024458167311), UINT64_C(11343752534700210161) }, { UINT64_C(16885085030572709139), UINT64_C(9568004649947874797) },
+  { UINT64_C(10553178144107943212), UINT64_C(3674159897003727796) }, { UINT64_C(13191472680134929015), UINT64_C(4592699871254659745) },
+  { UINT64_C(16489340850168661269), UINT64_C(1129188820640936778) }, { UINT64_C(10305838031355413293), UINT64_C(3011586022114279438) },
+  { UINT64_C(12882297539194266616), UINT64_C(8376168546070237202) }, { UINT64_C(16102871923992833270), UINT64_C(10470210682587796502) },
+  { UINT64_C(10064294952495520794), UINT64_C(1932195658189984910) }, { UINT64_C(12580368690619400992), UINT64_C(11638616609592256945) },
+  { UINT64_C(15725460863274251240), UINT64_C(14548270761990321182) }, { UINT64_C(9828413039546407025), UINT64_C(9092669226243950738) },
+  { UINT64_C(12285516299433008781), UINT64_C(15977522551232326327) }, { UINT64_C(15356895374291260977), UINT64_C(6136845133758244197) },
+  { UINT64_C(9598059608932038110), UINT64_C(15364743254667372383) }, { UINT64_C(11997574511165047638), UINT64_C(9982557031479439671) },
+  { UINT64_C(14996968138956309548), UINT64_C(3254824252494523781) }, { UINT64_C(9373105086847693467), UINT64_C(11257637194663853171) },
+  { UINT64_C(11716381358559616834), UINT64_C(9460360474902428559) }, { UINT64_C(14645476698199521043), UINT64_C(2602078556773259891) },
+  { UINT64_C(18306845872749401303), UINT64_C(17087656251248738576) }, { UINT64_C(11441778670468375814), UINT64_C(17597314184671543466) },
+  { UINT64_C(14302223338085469768), UINT64_C(12773270693984653525) }, { UINT64_C(17877779172606837210), UINT64_C(15966588367480816906) },
+  { UINT64_C(11173611982879273256), UINT64_C(14590803748102898470) }, { UINT64_C(13967014978599091570), UINT64_C(18238504685128623088) },
+  { UINT64_C(17458768723248864463), UINT64_C(13574758819556003052) }, { UINT64_C(10911730452030540289), UINT64_C(15401753289863583763) },
+  { UINT64_C(13639663065038175362), UINT64_C(5417133557047315992) }, { UINT64_C(17049578831297719202), UINT64_C(15994788983163920798) },
+  { UINT64_C(10655986769561074501), UINT64_C(14608429132904838403) }, { UINT64_C(13319983461951343127), UINT64_C(4425478360848884291) },
+  { UINT64_C(16649979327439178909), UINT64_C(920161932633717460) }, { UINT64_C(10406237079649486818), UINT64_C(2880944217109767365) },
+  { UINT64_C(13007796349561858522), UINT64_C(12824552308241985014) }, { UINT64_C(16259745436952323153), UINT64_C(6807318348447705459) },
+  { UINT64_C(10162340898095201970), UINT64_C(15783789013848285672) }, { UINT64_C(12702926122619002463), UINT64_C(10506364230455581282) },
+  { UINT64_C(15878657653273753079), UINT64_C(8521269269642088699) }, { UINT64_C(9924161033296095674), UINT64_C(12243322321167387293) },
+  { UINT64_C(12405201291620119593), UINT64_C(6080780864604458308) }, { UINT64_C(15506501614525149491), UINT64_C(12212662099182960789) },
+  { UINT64_C(9691563509078218432), UINT64_C(5327070802775656541) }, { UINT64_C(12114454386347773040), UINT64_C(6658838503469570676) },
+  { UINT64_C(15143067982934716300), UINT64_C(8323548129336963345) }, { UINT64_C(9464417489334197687), UINT64_C(14425589617690377899) },
+  { UINT64_C(11830521861667747109), UINT64_C(13420301003685584469) }, { UINT64_C(14788152327084683887), UINT64_C(2940318199324816875) },
+  { UINT64_C(9242595204427927429), UINT64_C(8755227902219092403) }, { UINT64_C(11553244005534909286), UINT64_C(15555720896201253407) },
+  { UINT64_C(14441555006918636608), UINT64_C(10221279083396790951) }, { UINT64_C(18051943758648295760), UINT64_C(12776598854245988689) },
+  { UINT64_C(11282464849155184850), UINT64_C(7985374283903742931) }, { UINT64_C(14103081061443981063), UINT64_C(758345818024902856) },
+  { UINT64_C(17628851326804976328), UINT64_C(14782990327813292282) }, { UINT64_C(11018032079253110205), UINT64_C(9239368954883307676) },
+  { UINT64_C(13772540099066387756), UINT64_C(16160897212031522499) }, { UINT64_C(17215675123832984696), UINT64_C(1754377441329851508) },
+  { UINT64_C(10759796952395615435), UINT64_C(1096485900831157192) }, { UINT64_C(13449746190494519293), UINT64_C(15205665431321110202) },
+  { UINT64_C(16812182738118149117), UINT64_C(5172023733869224041) }, { UINT64_C(10507614211323843198), UINT64_C(5538357842881958977) },
+  { UINT64_C(13134517764154803997), UINT64_C(16146319340457224530) }, { UINT64_C(16418147205193504997), UINT64_C(6347841120289366950) },
+  { UINT64_C(10261342003245940623), UINT64_C(6273243709394548296) }
+};
+
+/**
+ * @defgroup LRC_numeric Number formatting
+ * @{
+ */
+
+/* Ceil(log2(5^e)), valid for 0 <= e <= 3528 */
+static int LRC_pow5bits(int e){
+  return (int)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+/* Floor(log10(2^e)), valid for 0 <= e <= 1650 */
+static int LRC_log10Pow2(int e){
+  return (int)(((uint32_t)e * 78913) >> 18);
+}
+
+/* Floor(log10(5^e)), valid for 0 <= e <= 2620 */
+static int LRC_log10Pow5(int e){
+  return (int)(((uint32_t)e * 732923) >> 20);
+}
+
+static int LRC_pow5Factor(uint64_t v){
+  int count = 0;
+
+  while (v % 5 == 0) {
+    v /= 5;
+    count++;
+  }
+
+  return count;
+}
+
+static int LRC_multipleOfPow5(uint64_t v, int p){
+  return LRC_pow5Factor(v) >= p;
+}
+
+static int LRC_multipleOfPow2(uint64_t v, int p){
+  return (v & ((UINT64_C(1) << p) - 1)) == 0;
+}
+
+#if !defined(__SIZEOF_INT128__)
+/* 64x64 -> 128 bit multiplication, on 32-bit halves */
+static uint64_t LRC_umul128(uint64_t a, uint64_t b, uint64_t* hi){
+  uint64_t b00, b01, b10, b11, mid1, mid2;
+
+  b00 = (a & 0xffffffff) * (b & 0xffffffff);
+  b01 = (a & 0xffffffff) * (b >> 32);
+  b10 = (a >> 32) * (b & 0xffffffff);
+  b11 = (a >> 32) * (b >> 32);
+
+  mid1 = b10 + (b00 >> 32);
+  mid2 = b01 + (mid1 & 0xffffffff);
+
+  *hi = b11 + (mid1 >> 32) + (mid2 >> 32);
+  return (mid2 << 32) | (b00 & 0xffffffff);
+}
+#endif
+
+/* (m * mul) >> j, where mul is a 128-bit multiplier and 64 < j < 128 */
+static uint64_t LRC_mulShift64(uint64_t m, const uint64_t* mul, int j){
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128;
+  uint128 b0, b2;
+
+  b0 = (uint128)m * mul[0];
+  b2 = (uint128)m * mul[1];
+
+  return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
+#else
+  uint64_t lo0, hi0, lo1, hi1, sum;
+
+  lo0 = LRC_umul128(m, mul[0], &hi0);
+  lo1 = LRC_umul128(m, mul[1], &hi1);
+  (void)lo0;
+
+  sum = hi0 + lo1;
+  if (sum < hi0) hi1++;
+
+  return (hi1 << (128 - j)) | (sum >> (j - 64));
+#endif
+}
+
+/* (m * mul) >> j, where mul is a 64-bit multiplier and 32 < j < 96 */
+static uint32_t LRC_mulShift32(uint32_t m, uint64_t mul, int j){
+  uint64_t b0, b1;
+
+  b0 = (uint64_t)m * (mul & 0xffffffff);
+  b1 = (uint64_t)m * (mul >> 32);
+
+  return (uint32_t)(((b0 >> 32) + b1) >> (j - 32));
+}
+
+/**
+ * @fn void LRC_d2d(uint64_t mantissa, int exponent, uint64_t* digits, int* exp10)
+ * @brief Finds the shortest decimal representation of a finite double.
+ *
+ * @param mantissa
+ *   The IEEE mantissa bits.
+ *
+ * @param exponent
+ *   The IEEE (biased) exponent bits.
+ *
+ * @param digits
+ *   On return, the decimal digits.
+ *
+ * @param exp10
+ *   On return, the decimal exponent, value = digits * 10^exp10.
+ */
+void LRC_d2d(uint64_t mantissa, int exponent, uint64_t* digits, int* exp10){
+
+  uint64_t m2, mv, vr, vp, vm, output;
+  int e2, q, k, i, j, e10, removed = 0;
+  int even, mmShift, vmIsTrailingZeros = 0, vrIsTrailingZeros = 0;
+  int lastRemovedDigit = 0, roundUp = 0;
+
+  if (exponent == 0) {
+    e2 = 1 - 1023 - 52 - 2;
+    m2 = mantissa;
+  } else {
+    e2 = exponent - 1023 - 52 - 2;
+    m2 = (UINT64_C(1) << 52) | mantissa;
+  }
+
+  even = (m2 & 1) == 0;
+  mv = 4 * m2;
+  mmShift = mantissa != 0 || exponent <= 1;
+
+  /* Step 1: the interval of valid representations, scaled by 10^-e10 */
+  if (e2 >= 0) {
+    q = LRC_log10Pow2(e2) - (e2 > 3);
+    e10 = q;
+    k = 125 + LRC_pow5bits(q) - 1;
+    i = -e2 + q + k;
+
+    vr = LRC_mulShift64(4 * m2, LRC_DOUBLE_POW5_INV_SPLIT[q], i);
+    vp = LRC_mulShift64(4 * m2 + 2, LRC_DOUBLE_POW5_INV_SPLIT[q], i);
+    vm = LRC_mulShift64(4 * m2 - 1 - mmShift, LRC_DOUBLE_POW5_INV_SPLIT[q], i);
+
+    if (q <= 21) {
+      if (mv % 5 == 0) {
+        vrIsTrailingZeros = LRC_multipleOfPow5(mv, q);
+      } else if (even) {
+        vmIsTrailingZeros = LRC_multipleOfPow5(mv - 1 - mmShift, q);
+      } else {
+        vp -= LRC_multipleOfPow5(mv + 2, q);
+      }
+    }
+  } else {
+    q = LRC_log10Pow5(-e2) - (-e2 > 1);
+    e10 = q + e2;
+    i = -e2 - q;
+    k = LRC_pow5bits(i) - 125;
+    j = q - k;
+
+    vr = LRC_mulShift64(4 * m2, LRC_DOUBLE_POW5_SPLIT[i], j);
+    vp = LRC_mulShift64(4 * m2 + 2, LRC_DOUBLE_POW5_SPLIT[i], j);
+    vm = LRC_mulShift64(4 * m2 - 1 - mmShift, LRC_DOUBLE_POW5_SPLIT[i], j);
+
+    if (q <= 1) {
+      vrIsTrailingZeros = 1;
+      if (even) {
+        vmIsTrailingZeros = mmShift == 1;
+      } else {
+        vp--;
+      }
+    } else if (q < 63) {
+      vrIsTrailingZeros = LRC_multipleOfPow2(mv, q);
+    }
+  }
+
+  /* Step 2: the shortest representation in the interval */
+  if (vmIsTrailingZeros || vrIsTrailingZeros) {
+    while (vp / 10 > vm / 10) {
+      vmIsTrailingZeros &= vm % 10 == 0;
+      vrIsTrailingZeros &= lastRemovedDigit == 0;
+      lastRemovedDigit = (int)(vr % 10);
+      vr /= 10; vp /= 10; vm /= 10;
+      removed++;
+    }
+
+    if (vmIsTrailingZeros) {
+      while (vm % 10 == 0) {
+        vrIsTrailingZeros &= lastRemovedDigit == 0;
+        lastRemovedDigit = (int)(vr % 10);
+        vr /= 10; vp /= 10; vm /= 10;
+        removed++;
+      }
+    }
+
+    /* Round half to even */
+    if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) lastRemovedDigit = 4;
+
+    output = vr + ((vr == vm && (!even || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+  } else {
+    while (vp / 10 > vm / 10) {
+      roundUp = vr % 10 >= 5;
+      vr /= 10; vp /= 10; vm /= 10;
+      removed++;
+    }
+
+    output = vr + (vr == vm || roundUp);
+  }
+
+  *digits = output;
+  *exp10 = e10 + removed;
+}
+
+/**
+ * @fn void LRC_f2d(uint32_t mantissa, int exponent, uint32_t* digits, int* exp10)
+ * @brief Finds the shortest decimal representation of a finite float.
+ *
+ * @see LRC_d2d()
+ */
+void LRC_f2d(uint32_t mantissa, int exponent, uint32_t* digits, int* exp10){
+
+  uint32_t m2, mv, mp, mm, vr, vp, vm, output;
+  int e2, q, k, i, j, l, e10, removed = 0;
+  int even, mmShift, vmIsTrailingZeros = 0, vrIsTrailingZeros = 0;
+  int lastRemovedDigit = 0;
+
+  if (exponent == 0) {
+    e2 = 1 - 127 - 23 - 2;
+    m2 = mantissa;
+  } else {
+    e2 = exponent - 127 - 23 - 2;
+    m2 = (UINT32_C(1) << 23) | mantissa;
+  }
+
+  even = (m2 & 1) == 0;
+  mmShift = mantissa != 0 || exponent <= 1;
+  mv = 4 * m2;
+  mp = 4 * m2 + 2;
+  mm = 4 * m2 - 1 - mmShift;
+
+  /* Step 1: the interval of valid representations, scaled by 10^-e10 */
+  if (e2 >= 0) {
+    q = LRC_log10Pow2(e2);
+    e10 = q;
+    k = 59 + LRC_pow5bits(q) - 1;
+    i = -e2 + q + k;
+
+    vr = LRC_mulShift32(mv, LRC_FLOAT_POW5_INV_SPLIT[q], i);
+    vp = LRC_mulShift32(mp, LRC_FLOAT_POW5_INV_SPLIT[q], i);
+    vm = LRC_mulShift32(mm, LRC_FLOAT_POW5_INV_SPLIT[q], i);
+
+    if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+      /* The last removed digit is needed for rounding */
+      l = 59 + LRC_pow5bits(q - 1) - 1;
+      lastRemovedDigit = (int)(LRC_mulShift32(mv, LRC_FLOAT_POW5_INV_SPLIT[q - 1], -e2 + q - 1 + l) % 10);
+    }
+
+    if (q <= 9) {
+      if (mv % 5 == 0) {
+        vrIsTrailingZeros = LRC_multipleOfPow5(mv, q);
+      } else if (even) {
+        vmIsTrailingZeros = LRC_multipleOfPow5(mm, q);
+      } else {
+        vp -= LRC_multipleOfPow5(mp, q);
+      }
+    }
+  } else {
+    q = LRC_log10Pow5(-e2);
+    e10 = q + e2;
+    i = -e2 - q;
+    k = LRC_pow5bits(i) - 61;
+    j = q - k;
+
+    vr = LRC_mulShift32(mv, LRC_FLOAT_POW5_SPLIT[i], j);
+    vp = LRC_mulShift32(mp, LRC_FLOAT_POW5_SPLIT[i], j);
+    vm = LRC_mulShift32(mm, LRC_FLOAT_POW5_SPLIT[i], j);
+
+    if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+      j = q - 1 - (LRC_pow5bits(i + 1) - 61);
+      lastRemovedDigit = (int)(LRC_mulShift32(mv, LRC_FLOAT_POW5_SPLIT[i + 1], j) % 10);
+    }
+
+    if (q <= 1) {
+      vrIsTrailingZeros = 1;
+      if (even) {
+        vmIsTrailingZeros = mmShift == 1;
+      } else {
+        vp--;
+      }
+    } else if (q < 31) {
+      vrIsTrailingZeros = LRC_multipleOfPow2(mv, q - 1);
+    }
+  }
+
+  /* Step 2: the shortest representation in the interval */
+  if (vmIsTrailingZeros || vrIsTrailingZeros) {
+    while (vp / 10 > vm / 10) {
+      vmIsTrailingZeros &= vm % 10 == 0;
+      vrIsTrailingZeros &= lastRemovedDigit == 0;
+      lastRemovedDigit = (int)(vr % 10);
+      vr /= 10; vp /= 10; vm /= 10;
+      removed++;
+    }
+
+    if (vmIsTrailingZeros) {
+      while (vm % 10 == 0) {
+        vrIsTrailingZeros &= lastRemovedDigit == 0;
+        lastRemovedDigit = (int)(vr % 10);
+        vr /= 10; vp /= 10; vm /= 10;
+        removed++;
+      }
+    }
+
+    /* Round half to even */
+    if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) lastRemovedDigit = 4;
+
+    output = vr + ((vr == vm && (!even || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+  } else {
+    while (vp / 10 > vm / 10) {
+      lastRemovedDigit = (int)(vr % 10);
+      vr /= 10; vp /= 10; vm /= 10;
+      removed++;
+    }
+
+    output = vr + (vr == vm || lastRemovedDigit >= 5);
+  }
+
+  *digits = output;
+  *exp10 = e10 + removed;
+}
+
+/**
+ * @fn int LRC_digits(uint64_t value, char* digits, int* exp10)
+ * @brief Writes the decimal digits of the value, without trailing zeros
+ * (they are moved to the exponent).
+ *
+ * @return
+ *   Number of the digits.
+ */
+int LRC_digits(uint64_t value, char* digits, int* exp10){
+
+  uint64_t v;
+  int n = 0, i;
+
+  while (value % 10 == 0) {
+    value /= 10;
+    (*exp10)++;
+  }
+
+  for (v = value; v > 0; v /= 10) n++;
+  for (i = n - 1; i >= 0; i--) {
+    digits[i] = (char)('0' + value % 10);
+    value /= 10;
+  }
+
+  return n;
+}
+
+/**
+ * @fn int LRC_formatDecimal(char* str, int sign, char* digits, int ndigits, int exp10)
+ * @brief Lays out decimal digits as a number.
+ *
+ * Numbers with the decimal exponent in [-4, 16) are written in the fixed
+ * notation, always with the decimal point (e.g. 2003.0, 0.001), other ones in
+ * the scientific notation (e.g. 1e+16, 2.5e-05).
+ *
+ * @param str
+ *   The output, at least LRC_NUMBER_LEN long.
+ *
+ * @param sign
+ *   1 if the number is negative.
+ *
+ * @param digits
+ *   The significant digits, without leading and trailing zeros.
+ *
+ * @param ndigits
+ *   Number of the digits.
+ *
+ * @param exp10
+ *   The decimal exponent, value = digits * 10^exp10.
+ *
+ * @return
+ *   Length of the output.
+ */
+int LRC_formatDecimal(char* str, int sign, char* digits, int ndigits, int exp10){
+
+  int point, e, i, n = 0;
+
+  if (sign) str[n++] = '-';
+
+  /* Position of the decimal point, relative to the first digit */
+  point = ndigits + exp10;
+  e = point - 1;
+
+  if (e >= -4 && e < 16) {
+    if (point <= 0) {
+      str[n++] = '0';
+      str[n++] = '.';
+      for (i = point; i < 0; i++) str[n++] = '0';
+      memcpy(str + n, digits, ndigits);
+      n += ndigits;
+    } else if (point >= ndigits) {
+      memcpy(str + n, digits, ndigits);
+      n += ndigits;
+      for (i = ndigits; i < point; i++) str[n++] = '0';
+      str[n++] = '.';
+      str[n++] = '0';
+    } else {
+      memcpy(str + n, digits, point);
+      n += point;
+      str[n++] = '.';
+      memcpy(str + n, digits + point, ndigits - point);
+      n += ndigits - point;
+    }
+    str[n] = LRC_NULL;
+  } else {
+    str[n++] = digits[0];
+    if (ndigits > 1) {
+      str[n++] = '.';
+      memcpy(str + n, digits + 1, ndigits - 1);
+      n += ndigits - 1;
+    }
+    n += sprintf(str + n, "e%c%02d", e < 0 ? '-' : '+', e < 0 ? -e : e);
+  }
+
+  return n;
+}
+
+/**
+ * @fn int LRC_formatSpecial(char* str, int sign, int nan)
+ * @brief Formats infinities and NaNs.
+ */
+int LRC_formatSpecial(char* str, int sign, int nan){
+  if (nan) return sprintf(str, "nan");
+  return sprintf(str, "%sinf", sign ? "-" : "");
+}
+
+/**
+ * @fn int LRC_double2str(char* str, double value)
+ * @brief Formats the double with the shortest representation that reads back
+ * to exactly the same value.
+ *
+ * @param str
+ *   The output, at least LRC_NUMBER_LEN long.
+ *
+ * @param value
+ *   The value.
+ *
+ * @return
+ *   Length of the output.
+ */
+int LRC_double2str(char* str, double value){
+
+  uint64_t bits, mantissa, output;
+  char digits[24];
+  int exponent, sign, exp10, n;
+
+  memcpy(&bits, &value, sizeof(double));
+
+  sign = (int)(bits >> 63);
+  exponent = (int)((bits >> 52) & 0x7ff);
+  mantissa = bits & ((UINT64_C(1) << 52) - 1);
+
+  if (exponent == 0x7ff) return LRC_formatSpecial(str, sign, mantissa != 0);
+  if (exponent == 0 && mantissa == 0) return sprintf(str, "%s0.0", sign ? "-" : "");
+
+  LRC_d2d(mantissa, exponent, &output, &exp10);
+
+  n = LRC_digits(output, digits, &exp10);
+
+  return LRC_formatDecimal(str, sign, digits, n, exp10);
+}
+
+/**
+ * @fn int LRC_float2str(char* str, float value)
+ * @brief Formats the float with the shortest representation that reads back
+ * to exactly the same value.
+ *
+ * @see LRC_double2str()
+ */
+int LRC_float2str(char* str, float value){
+
+  uint32_t bits, mantissa, output;
+  char digits[16];
+  int exponent, sign, exp10, n;
+
+  memcpy(&bits, &value, sizeof(float));
+
+  sign = (int)(bits >> 31);
+  exponent = (int)((bits >> 23) & 0xff);
+  mantissa = bits & ((UINT32_C(1) << 23) - 1);
+
+  if (exponent == 0xff) return LRC_formatSpecial(str, sign, mantissa != 0);
+  if (exponent == 0 && mantissa == 0) return sprintf(str, "%s0.0", sign ? "-" : "");
+
+  LRC_f2d(mantissa, exponent, &output, &exp10);
+  n = LRC_digits(output, digits, &exp10);
+
+  return LRC_formatDecimal(str, sign, digits, n, exp10);
+}
+
+/**
+ * @fn int LRC_Ldouble2str(char* str, long double value)
+ * @brief Formats the long double with the shortest representation that reads
+ * back to exactly the same value.
+ *
+ * There is no table-driven algorithm for the extended formats, so the
+ * shortest precision which survives the round trip is found with a binary
+ * search over printf precisions (the round trip is monotonic in the number of
+ * digits). If long double is the same as double, LRC_double2str() is used.
+ *
+ * @see LRC_double2str()
+ */
+int LRC_Ldouble2str(char* str, long double value){
+
+  char buf[LRC_NUMBER_LEN];
+  char digits[LRC_NUMBER_LEN];
+  char* p = NULL;
+  int lo = 1, hi, mid, sign, n = 0, exp10;
+
+  if (LDBL_MANT_DIG == DBL_MANT_DIG) return LRC_double2str(str, (double)value);
+
+  sign = signbit(value) != 0;
+  if (isnan(value) || isinf(value)) return LRC_formatSpecial(str, sign, isnan(value));
+  if (value == 0.0L) return sprintf(str, "%s0.0", sign ? "-" : "");
+
+  /* Enough digits to distinguish all long doubles */
+  hi = LDBL_DIG + 3;
+
+  while (lo < hi) {
+    mid = (lo + hi) / 2;
+    snprintf(buf, LRC_NUMBER_LEN, "%.*Le", mid - 1, value);
+    if (strtold(buf, NULL) == value) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+
+  /* Take the digits and the exponent of d.ddde+XX (the radix character
+   * depends on the locale) */
+  snprintf(buf, LRC_NUMBER_LEN, "%.*Le", lo - 1, value);
+  for (p = buf; *p && *p != 'e'; p++) {
+    if (isdigit((unsigned char)*p)) digits[n++] = *p;
+  }
+
+  exp10 = (int)strtol(p + 1, NULL, 10) - (n - 1);
+  while (n > 1 && digits[n - 1] == '0') {
+    n--;
+    exp10++;
+  }
+
+  return LRC_formatDecimal(str, sign, digits, n, exp10);
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup LRC_numeric_parse Number parsing
+ * @{
+ *
+ * The parsers do not depend on the locale and accept
+ *
+ *   [+-] digits [. digits] [(e|E) [+-] digits]
+ *
+ * as well as inf, infinity and nan, with optional surrounding white spaces.
+ *
+ * Floating point values are converted with the Clinger fast path (exact
+ * mantissa and power of ten), then with the Eisel-Lemire algorithm
+ * (D. Lemire, "Number Parsing at a Gigabyte per Second", 2021), which is
+ * exact for up to 19 significant digits. Longer mantissas that cannot be
+ * decided, hexadecimal values and long doubles fall back to strtod() and
+ * friends in the C locale.
+ */
+
+/* Exact powers of ten */
+static const double LRC_POW10_DOUBLE[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const float LRC_POW10_FLOAT[] = {
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+/* Case insensitive prefix match */
+static int LRC_matchWord(const char* str, const char* word){
+  size_t i;
+
+  for (i = 0; word[i]; i++) {
+    if (tolower((unsigned char)str[i]) != word[i]) return 0;
+  }
+
+  return (int)i;
+}
+
+static int LRC_leadingZeros(uint64_t v){
+#if defined(__GNUC__)
+  return __builtin_clzll(v);
+#else
+  int n = 0;
+
+  while (!(v & (UINT64_C(1) << 63))) {
+    v <<= 1;
+    n++;
+  }
+
+  return n;
+#endif
+}
+
+/* 64x64 -> 128 bit multiplication */
+static void LRC_mul128(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo){
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128;
+  uint128 p = (uint128)a * b;
+
+  *hi = (uint64_t)(p >> 64);
+  *lo = (uint64_t)p;
+#else
+  *lo = LRC_umul128(a, b, hi);
+#endif
+}
+
+/* SWAR check and conversion of eight ASCII digits at once, little-endian
+ * (Lemire, "Number Parsing at a Gigabyte per Second", section 7) */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define LRC_SWAR 1
+
+static uint64_t LRC_load8(const char* p){
+  uint64_t v;
+
+  memcpy(&v, p, sizeof(uint64_t));
+  return v;
+}
+
+static int LRC_isEightDigits(uint64_t v){
+  return (((v & UINT64_C(0xF0F0F0F0F0F0F0F0))
+      | (((v + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) >> 4))
+      == UINT64_C(0x3333333333333333));
+}
+
+static uint64_t LRC_parseEightDigits(uint64_t v){
+  const uint64_t mask = UINT64_C(0x000000FF000000FF);
+  const uint64_t mul1 = UINT64_C(0x000F424000000064);
+  const uint64_t mul2 = UINT64_C(0x0000271000000001);
+
+  v -= UINT64_C(0x3030303030303030);
+  v = (v * 10) + (v >> 8);
+  v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+
+  return v & 0xffffffff;
+}
+#else
+#define LRC_SWAR 0
+#endif
+
+/**
+ * @fn int LRC_scanNumber(char* str, char* limit, char** end, LRC_decimal* d)
+ * @brief Splits the number at the beginning of the string into the sign, the
+ * significant digits and the decimal exponent.
+ *
+ * Up to 19 significant digits are kept, any further non-zero digit sets the
+ * truncated flag. Runs of eight digits are converted at once.
+ *
+ * @param str
+ *   The string.
+ *
+ * @param limit
+ *   The end of the string (the terminating null).
+ *
+ * @param end
+ *   On return, the first character after the number.
+ *
+ * @param d
+ *   On return, the number.
+ *
+ * @return
+ *   LRC_NUMBER_OK or LRC_NUMBER_INVALID
+ */
+int LRC_scanNumber(char* str, char* limit, char** end, LRC_decimal* d){
+
+  char* p = str;
+  long exp10 = 0, e = 0;
+  int ndigits = 0, seen = 0, esign = 1, n;
+
+  memset(d, 0, sizeof(LRC_decimal));
+  *end = str;
+
+  if (*p == '-' || *p == '+') {
+    d->negative = *p == '-';
+    p++;
+  }
+
+  /* Special values */
+  if ((n = LRC_matchWord(p, "infinity")) || (n = LRC_matchWord(p, "inf"))) {
+    d->special = LRC_DECIMAL_INF;
+    *end = p + n;
+    return LRC_NUMBER_OK;
+  }
+
+  if ((n = LRC_matchWord(p, "nan"))) {
+    d->special = LRC_DECIMAL_NAN;
+    *end = p + n;
+    return LRC_NUMBER_OK;
+  }
+
+  /* Hexadecimal values are left to the C library */
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    d->special = LRC_DECIMAL_OTHER;
+    for (p += 2; isxdigit((unsigned char)*p) || *p == '.' || *p == 'p' || *p == 'P'
+        || ((*p == '-' || *p == '+') && (p[-1] == 'p' || p[-1] == 'P')); p++);
+    *end = p;
+    return LRC_NUMBER_OK;
+  }
+
+  /* Integral part */
+  while (isdigit((unsigned char)*p)) {
+    seen = 1;
+#if LRC_SWAR
+    if (ndigits > 0 && ndigits <= 11 && limit - p >= 8 && LRC_isEightDigits(LRC_load8(p))) {
+      d->w = d->w * 100000000 + LRC_parseEightDigits(LRC_load8(p));
+      ndigits += 8;
+      p += 8;
+      continue;
+    }
+#endif
+    if (ndigits == 0 && *p == '0') {
+      /* Leading zero */
+    } else if (ndigits < 19) {
+      d->w = d->w * 10 + (uint64_t)(*p - '0');
+      ndigits++;
+    } else {
+      if (*p != '0') d->truncated = 1;
+      exp10++;
+    }
+    p++;
+  }
+
+  /* Fraction */
+  if (*p == '.') {
+    p++;
+    while (isdigit((unsigned char)*p)) {
+      seen = 1;
+#if LRC_SWAR
+      if (ndigits > 0 && ndigits <= 11 && limit - p >= 8 && LRC_isEightDigits(LRC_load8(p))) {
+        d->w = d->w * 100000000 + LRC_parseEightDigits(LRC_load8(p));
+        ndigits += 8;
+        exp10 -= 8;
+        p += 8;
+        continue;
+      }
+#endif
+      if (ndigits == 0 && *p == '0') {
+        exp10--;
+      } else if (ndigits < 19) {
+        d->w = d->w * 10 + (uint64_t)(*p - '0');
+        ndigits++;
+        exp10--;
+      } else {
+        if (*p != '0') d->truncated = 1;
+      }
+      p++;
+    }
+  }
+
+  if (!seen) return LRC_NUMBER_INVALID;
+
+  /* Exponent */
+  if (*p == 'e' || *p == 'E') {
+    p++;
+    if (*p == '-' || *p == '+') {
+      if (*p == '-') esign = -1;
+      p++;
+    }
+
+    if (!isdigit((unsigned char)*p)) return LRC_NUMBER_INVALID;
+
+    for (; isdigit((unsigned char)*p); p++) {
+      if (e < 100000) e = e * 10 + (*p - '0');
+    }
+
+    exp10 += esign * e;
+  }
+
+  if (exp10 > 100000) exp10 = 100000;
+  if (exp10 < -100000) exp10 = -100000;
+  d->q = (int)exp10;
+
+  *end = p;
+
+  return LRC_NUMBER_OK;
+}
+
+/**
+ * @fn int LRC_scanDecimal(char* str, LRC_decimal* d)
+ * @brief Splits the whole string (a single number, with optional surrounding
+ * white spaces).
+ *
+ * @see LRC_scanNumber()
+ *
+ * @return
+ *   LRC_NUMBER_OK or LRC_NUMBER_INVALID
+ */
+int LRC_scanDecimal(char* str, LRC_decimal* d){
+
+  char* p = str;
+  char* end = NULL;
+  int status;
+
+  memset(d, 0, sizeof(LRC_decimal));
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  while (isspace((unsigned char)*p)) p++;
+
+  status = LRC_scanNumber(p, p + strlen(p), &end, d);
+  if (status != LRC_NUMBER_OK) return status;
+
+  while (isspace((unsigned char)*end)) end++;
+  if (*end != LRC_NULL) return LRC_NUMBER_INVALID;
+
+  return LRC_NUMBER_OK;
+}
+
+/**
+ * @fn int LRC_eiselLemire(uint64_t w, int q, int mbits, int minexp, int infpow, int rtemin, int rtemax, uint64_t* mantissa, int* power2)
+ * @brief Computes the binary mantissa and the biased exponent of w * 10^q,
+ * correctly rounded.
+ *
+ * @param w
+ *   The decimal significand, non-zero.
+ *
+ * @param q
+ *   The decimal exponent, within the range of the table.
+ *
+ * @param mbits
+ *   Number of the explicit mantissa bits of the target type.
+ *
+ * @param minexp
+ *   The minimal (unbiased) exponent of the target type.
+ *
+ * @param infpow
+ *   The biased exponent of the infinity.
+ *
+ * @param rtemin, rtemax
+ *   The range of q where ties to even may happen.
+ *
+ * @param mantissa
+ *   On return, the mantissa bits.
+ *
+ * @param power2
+ *   On return, the biased exponent.
+ */
+void LRC_eiselLemire(uint64_t w, int q, int mbits, int minexp, int infpow, int rtemin, int rtemax,
+    uint64_t* mantissa, int* power2){
+
+  uint64_t hi, lo, hi2, lo2, mask, m;
+  int lz, upperbit, shift, p2;
+
+  lz = LRC_leadingZeros(w);
+  w <<= lz;
+
+  /* The truncated 128-bit product is always sufficient (Mushtak, Lemire,
+   * "Fast Number Parsing Without Fallback", 2023) */
+  LRC_mul128(w, LRC_POW5_128[q + 342][0], &hi, &lo);
+
+  mask = UINT64_C(0xFFFFFFFFFFFFFFFF) >> (mbits + 3);
+  if ((hi & mask) == mask) {
+    LRC_mul128(w, LRC_POW5_128[q + 342][1], &hi2, &lo2);
+    lo += hi2;
+    if (hi2 > lo) hi++;
+  }
+
+  upperbit = (int)(hi >> 63);
+  shift = upperbit + 64 - mbits - 3;
+  m = hi >> shift;
+
+  /* floor(log2(10^q)) + 63, the shift is arithmetic */
+  p2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz - minexp;
+
+  /* Subnormals */
+  if (p2 <= 0) {
+    if (-p2 + 1 >= 64) {
+      *mantissa = 0;
+      *power2 = 0;
+      return;
+    }
+
+    m >>= -p2 + 1;
+    m += m & 1;
+    m >>= 1;
+
+    *mantissa = m;
+    *power2 = m < (UINT64_C(1) << mbits) ? 0 : 1;
+    return;
+  }
+
+  /* Exactly halfway, round to even */
+  if (lo <= 1 && q >= rtemin && q <= rtemax && (m & 3) == 1 && (m << shift) == hi) {
+    m &= ~UINT64_C(1);
+  }
+
+  m += m & 1;
+  m >>= 1;
+
+  if (m >= (UINT64_C(2) << mbits)) {
+    m = UINT64_C(1) << mbits;
+    p2++;
+  }
+
+  m &= ~(UINT64_C(1) << mbits);
+
+  if (p2 >= infpow) {
+    p2 = infpow;
+    m = 0;
+  }
+
+  *mantissa = m;
+  *power2 = p2;
+}
+
+static pthread_once_t LRC_localeOnce = PTHREAD_ONCE_INIT;
+static locale_t LRC_localeC = (locale_t)0;
+
+/**
+ * @fn void LRC_localeInit(void)
+ * @brief Creates the C locale used by LRC_strtoC(), once per process.
+ */
+static void LRC_localeInit(void){
+  LRC_localeC = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+}
+
+/**
+ * @fn void LRC_strtoC(char* str, size_t len, int type, void* value)
+ * @brief strtof(), strtod() or strtold() of the first len characters, in the
+ * C locale.
+ *
+ * The locale is created on the first call and kept for the lifetime of the
+ * process.
+ *
+ * @param type
+ *   LRC_FLOAT, LRC_DOUBLE or 0 for long double.
+ */
+void LRC_strtoC(char* str, size_t len, int type, void* value){
+
+  locale_t old = (locale_t)0;
+  char* tmp = NULL;
+
+  /* Cut the number out of a longer string */
+  if (str[len] != LRC_NULL) {
+    tmp = malloc(len + 1);
+    if (tmp) {
+      memcpy(tmp, str, len);
+      tmp[len] = LRC_NULL;
+      str = tmp;
+    }
+  }
+
+  pthread_once(&LRC_localeOnce, LRC_localeInit);
+  if (LRC_localeC != (locale_t)0) old = uselocale(LRC_localeC);
+
+  switch (type) {
+    case LRC_FLOAT:
+      *(float*)value = strtof(str, NULL);
+      break;
+    case LRC_DOUBLE:
+      *(double*)value = strtod(str, NULL);
+      break;
+    default:
+      *(long double*)value = strtold(str, NULL);
+      break;
+  }
+
+  if (LRC_localeC != (locale_t)0) uselocale(old);
+
+  if (tmp) free(tmp);
+}
+
+/**
+ * @fn int LRC_decimal2double(LRC_decimal* dd, char* str, size_t len, double* value)
+ * @brief Converts the scanned number to double.
+ *
+ * @param dd
+ *   The number, @see LRC_scanNumber()
+ *
+ * @param str, len
+ *   The text of the number, for the fallback conversion.
+ *
+ * @param value
+ *   On return, the value.
+ *
+ * @return
+ *   LRC_NUMBER_OK or LRC_NUMBER_RANGE
+ */
+int LRC_decimal2double(LRC_decimal* dd, char* str, size_t len, double* value){
+
+  LRC_decimal d = *dd;
+  uint64_t bits, m, m1;
+  int p2, p21;
+
+  switch (d.special) {
+    case LRC_DECIMAL_INF:
+      *value = d.negative ? -HUGE_VAL : HUGE_VAL;
+      return LRC_NUMBER_OK;
+    case LRC_DECIMAL_NAN:
+      *value = d.negative ? -NAN : NAN;
+      return LRC_NUMBER_OK;
+    case LRC_DECIMAL_OTHER:
+      LRC_strtoC(str, len, LRC_DOUBLE, value);
+      if (isinf(*value)) return LRC_NUMBER_RANGE;
+      return LRC_NUMBER_OK;
+    default:
+      break;
+  }
+
+  if (d.w == 0) {
+    *value = d.negative ? -0.0 : 0.0;
+    return LRC_NUMBER_OK;
+  }
+
+#if FLT_EVAL_METHOD == 0
+  /* Both the mantissa and the power of ten are exact */
+  if (!d.truncated && d.q >= -22 && d.q <= 22 && d.w <= (UINT64_C(1) << 53)) {
+    *value = (double)d.w;
+    if (d.q < 0) {
+      *value /= LRC_POW10_DOUBLE[-d.q];
+    } else {
+      *value *= LRC_POW10_DOUBLE[d.q];
+    }
+    if (d.negative) *value = -*value;
+    return LRC_NUMBER_OK;
+  }
+#endif
+
+  if (d.q < -342) {
+    m = 0;
+    p2 = 0;
+  } else if (d.q > 308) {
+    m = 0;
+    p2 = 0x7ff;
+  } else {
+    LRC_eiselLemire(d.w, d.q, 52, -1023, 0x7ff, -4, 23, &m, &p2);
+
+    /* The dropped digits matter only if w + 1 rounds differently */
+    if (d.truncated) {
+      LRC_eiselLemire(d.w + 1, d.q, 52, -1023, 0x7ff, -4, 23, &m1, &p21);
+      if (m != m1 || p2 != p21) {
+        LRC_strtoC(str, len, LRC_DOUBLE, value);
+        if (isinf(*value) || *value == 0.0) return LRC_NUMBER_RANGE;
+        return LRC_NUMBER_OK;
+      }
+    }
+  }
+
+  bits = m | ((uint64_t)p2 << 52) | ((uint64_t)d.negative << 63);
+  memcpy(value, &bits, sizeof(double));
+
+  if (p2 == 0x7ff || (p2 == 0 && m == 0)) return LRC_NUMBER_RANGE;
+
+  return LRC_NUMBER_OK;
+}
+
+/**
+ * @fn int LRC_str2double(char* str, double* value)
+ * @brief Converts the string to double, independently of the locale.
+ *
+ * @param str
+ *   The string.
+ *
+ * @param value
+ *   On return, the value: 0 if the string is not a number, +-HUGE_VAL on
+ *   overflow and +-0 on underflow.
+ *
+ * @return
+ *   LRC_NUMBER_OK, LRC_NUMBER_INVALID or LRC_NUMBER_RANGE
+ */
+int LRC_str2double(char* str, double* value){
+
+  LRC_decimal d;
+  int status;
+
+  *value = 0.0;
+
+  status = LRC_scanDecimal(str, &d);
+  if (status != LRC_NUMBER_OK) return status;
+
+  return LRC_decimal2double(&d, str, strlen(str), value);
+}
+
+/**
+ * @fn int LRC_decimal2float(LRC_decimal* dd, char* str, size_t len, float* value)
+ * @brief Converts the scanned number to float.
+ *
+ * The value is rounded once, directly from the decimal digits.
+ *
+ * @see LRC_decimal2double()
+ */
+int LRC_decimal2float(LRC_decimal* dd, char* str, size_t len, float* value){
+
+  LRC_decimal d = *dd;
+  uint64_t m, m1;
+  uint32_t bits;
+  int p2, p21;
+
+  switch (d.special) {
+    case LRC_DECIMAL_INF:
+      *value = d.negative ? -HUGE_VALF : HUGE_VALF;
+      return LRC_NUMBER_OK;
+    case LRC_DECIMAL_NAN:
+      *value = d.negative ? -NAN : NAN;
+      return LRC_NUMBER_OK;
+    case LRC_DECIMAL_OTHER:
+      LRC_strtoC(str, len, LRC_FLOAT, value);
+      if (isinf(*value)) return LRC_NUMBER_RANGE;
+      return LRC_NUMBER_OK;
+    default:
+      break;
+  }
+
+  if (d.w == 0) {
+    *value = d.negative ? -0.0f : 0.0f;
+    return LRC_NUMBER_OK;
+  }
+
+#if FLT_EVAL_METHOD == 0
+  if (!d.truncated && d.q >= -10 && d.q <= 10 && d.w <= (UINT64_C(1) << 24)) {
+    *value = (float)d.w;
+    if (d.q < 0) {
+      *value /= LRC_POW10_FLOAT[-d.q];
+    } else {
+      *value *= LRC_POW10_FLOAT[d.q];
+    }
+    if (d.negative) *value = -*value;
+    return LRC_NUMBER_OK;
+  }
+#endif
+
+  if (d.q < -64) {
+    m = 0;
+    p2 = 0;
+  } else if (d.q > 38) {
+    m = 0;
+    p2 = 0xff;
+  } else {
+    LRC_eiselLemire(d.w, d.q, 23, -127, 0xff, -17, 10, &m, &p2);
+
+    if (d.truncated) {
+      LRC_eiselLemire(d.w + 1, d.q, 23, -127, 0xff, -17, 10, &m1, &p21);
+      if (m != m1 || p2 != p21) {
+        LRC_strtoC(str, len, LRC_FLOAT, value);
+        if (isinf(*value) || *value == 0.0f) return LRC_NUMBER_RANGE;
+        return LRC_NUMBER_OK;
+      }
+    }
+  }
+
+  bits = (uint32_t)m | ((uint32_t)p2 << 23) | ((uint32_t)d.negative << 31);
+  memcpy(value, &bits, sizeof(float));
+
+  if (p2 == 0xff || (p2 == 0 && m == 0)) return LRC_NUMBER_RANGE;
+
+  return LRC_NUMBER_OK;
+}
+
+/**
+ * @fn int LRC_str2float(char* str, float* value)
+ * @brief Converts the string to float, independently of the locale.
+ *
+ * @see LRC_str2double()
+ */
+int LRC_str2float(char* str, float* value){
+
+  LRC_decimal d;
+  int status;
+
+  *value = 0.0f;
+
+  status = LRC_scanDecimal(str, &d);
+  if (status != LRC_NUMBER_OK) return status;
+
+  return LRC_decimal2float(&d, str, strlen(str), value);
+}
+
+/**
+ * @fn int LRC_str2Ldouble(char* str, long double* value)
+ * @brief Converts the string to long double, independently of the locale.
+ *
+ * The syntax is checked as for the other types, the conversion itself is done
+ * by strtold() in the C locale.
+ *
+ * @see LRC_str2double()
+ */
+int LRC_str2Ldouble(char* str, long double* value){
+
+  LRC_decimal d;
+  int status;
+
+  *value = 0.0L;
+
+  status = LRC_scanDecimal(str, &d);
+  if (status != LRC_NUMBER_OK) return status;
+
+  LRC_strtoC(str, strlen(str), 0, value);
+
+  if (d.special == LRC_DECIMAL_NONE && d.w != 0) {
+    if (isinf(*value) || *value == 0.0L) return LRC_NUMBER_RANGE;
+  }
+
+  return LRC_NUMBER_OK;
+}
+
+/**
+ * @fn int LRC_scanLong(char* str, char** end, long* value)
+ * @brief Converts the integer at the beginning of the string.
+ *
+ * @param str
+ *   The string: [+-] digits.
+ *
+ * @param end
+ *   On return, the first character after the number.
+ *
+ * @param value
+ *   On return, the value, LONG_MAX or LONG_MIN on overflow.
+ *
+ * @return
+ *   LRC_NUMBER_OK, LRC_NUMBER_INVALID or LRC_NUMBER_RANGE
+ */
+int LRC_scanLong(char* str, char** end, long* value){
+
+  char* p = str;
+  unsigned long v = 0, limit, digit;
+  int negative = 0, overflow = 0;
+
+  *value = 0;
+  *end = str;
+
+  if (*p == '-' || *p == '+') {
+    negative = *p == '-';
+    p++;
+  }
+
+  if (!isdigit((unsigned char)*p)) return LRC_NUMBER_INVALID;
+
+  limit = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+
+  for (; isdigit((unsigned char)*p); p++) {
+    digit = (unsigned long)(*p - '0');
+    if (v > (limit - digit) / 10) {
+      overflow = 1;
+    } else {
+      v = v * 10 + digit;
+    }
+  }
+
+  *end = p;
+
+  if (overflow) {
+    *value = negative ? LONG_MIN : LONG_MAX;
+    return LRC_NUMBER_RANGE;
+  }
+
+  if (negative) {
+    *value = v > 0 ? -(long)(v - 1) - 1 : 0;
+  } else {
+    *value = (long)v;
+  }
+
+  return LRC_NUMBER_OK;
+}
+
+/**
+ * @fn int LRC_str2long(char* str, long* value)
+ * @brief Converts the string to long integer.
+ *
+ * @param str
+ *   The string: [+-] digits, with optional surrounding white spaces.
+ *
+ * @param value
+ *   On return, the value: 0 if the string is not a number, LONG_MAX or
+ *   LONG_MIN on overflow.
+ *
+ * @return
+ *   LRC_NUMBER_OK, LRC_NUMBER_INVALID or LRC_NUMBER_RANGE
+ */
+int LRC_str2long(char* str, long* value){
+
+  char* p = str;
+  char* end = NULL;
+  int status;
+
+  *value = 0;
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  while (isspace((unsigned char)*p)) p++;
+
+  status = LRC_scanLong(p, &end, value);
+  if (status == LRC_NUMBER_INVALID) return status;
+
+  while (isspace((unsigned char)*end)) end++;
+  if (*end != LRC_NULL) {
+    *value = 0;
+    return LRC_NUMBER_INVALID;
+  }
+
+  return status;
+}
+
+/**
+ * @fn int LRC_str2int(char* str, int* value)
+ * @brief Converts the string to integer.
+ *
+ * @see LRC_str2long()
+ */
+int LRC_str2int(char* str, int* value){
+
+  long v;
+  int status;
+
+  status = LRC_str2long(str, &v);
+
+  if (v > INT_MAX) {
+    *value = INT_MAX;
+    return LRC_NUMBER_RANGE;
+  }
+
+  if (v < INT_MIN) {
+    *value = INT_MIN;
+    return LRC_NUMBER_RANGE;
+  }
+
+  *value = (int)v;
+
+  return status;
+}
+
+/**
+ * @fn int LRC_str2prefix(char* str, int type, void* value)
+ * @brief Converts the number at the beginning of the string and ignores the
+ * rest, as atoi() and strtod() do.
+ *
+ * "12abc" gives 12 and "3.5" gives 3 for LRC_INT. The conversion is still
+ * independent of the locale.
+ *
+ * @param type
+ *   LRC_INT, LRC_FLOAT, LRC_DOUBLE or 0 for long double.
+ *
+ * @param value
+ *   On return, the value, 0 if the string does not start with a number.
+ *
+ * @return
+ *   LRC_NUMBER_OK, LRC_NUMBER_INVALID or LRC_NUMBER_RANGE
+ */
+int LRC_str2prefix(char* str, int type, void* value){
+
+  LRC_decimal d;
+  char* p = str;
+  char* end = NULL;
+  long v = 0;
+  double dv = 0.0;
+  float fv = 0.0f;
+  int status;
+
+  while (isspace((unsigned char)*p)) p++;
+
+  if (type == LRC_INT) {
+    status = LRC_scanLong(p, &end, &v);
+    if (v > INT_MAX) {
+      v = INT_MAX;
+      status = LRC_NUMBER_RANGE;
+    }
+    if (v < INT_MIN) {
+      v = INT_MIN;
+      status = LRC_NUMBER_RANGE;
+    }
+    *(int*)value = (int)v;
+    return status;
+  }
+
+  status = LRC_scanNumber(p, p + strlen(p), &end, &d);
+
+  /* Long double is converted by strtold() anyway */
+  if (type != LRC_FLOAT && type != LRC_DOUBLE) {
+    LRC_strtoC(p, strlen(p), 0, value);
+    return status;
+  }
+
+  /* Prefixes the scanner refuses, e.g. "1e", are left to strtod() */
+  if (status != LRC_NUMBER_OK) {
+    LRC_strtoC(p, strlen(p), type, value);
+    return status;
+  }
+
+  if (type == LRC_FLOAT) {
+    status = LRC_decimal2float(&d, p, (size_t)(end - p), &fv);
+    *(float*)value = fv;
+  } else {
+    status = LRC_decimal2double(&d, p, (size_t)(end - p), &dv);
+    *(double*)value = dv;
+  }
+
+  return status;
+}
+
+/**
+ * @fn int LRC_parseArray(char* str, int type, void** array, size_t* count)
+ * @brief Converts the list of numbers into a contiguous array.
+ *
+ * The numbers are separated with commas and/or white spaces. The first pass
+ * counts the elements, so that the second one converts them straight into the
+ * final buffer, without reallocations or copies of the text.
+ *
+ * @param str
+ *   The list, e.g. "1.0, 2.5, 3e2" or "1 2 3".
+ *
+ * @param type
+ *   LRC_INT_ARRAY or LRC_DOUBLE_ARRAY.
+ *
+ * @param array
+ *   On return, the array of int or double (you must free it), NULL if the list
+ *   is empty.
+ *
+ * @param count
+ *   On return, the number of elements.
+ *
+ * @return
+ *   LRC_NUMBER_OK, LRC_NUMBER_INVALID or LRC_NUMBER_RANGE
+ */
+int LRC_parseArray(char* str, int type, void** array, size_t* count){
+
+  LRC_decimal d;
+  char* p = str;
+  char* limit = NULL;
+  char* end = NULL;
+  int* ints = NULL;
+  double* doubles = NULL;
+  long l;
+  size_t n = 0, i = 0, elem;
+  int status = LRC_NUMBER_OK, s, sep = 1, comma = 0;
+
+  *array = NULL;
+  *count = 0;
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  /* Count the elements */
+  for (p = str; *p; p++) {
+    if (*p == ',' || isspace((unsigned char)*p)) {
+      sep = 1;
+    } else {
+      if (sep) n++;
+      sep = 0;
+    }
+  }
+  limit = p;
+
+  if (n == 0) {
+    for (p = str; *p; p++) {
+      if (*p == ',') return LRC_NUMBER_INVALID;
+    }
+    return LRC_NUMBER_OK;
+  }
+
+  elem = type == LRC_INT_ARRAY ? sizeof(int) : sizeof(double);
+  *array = malloc(n * elem);
+  if (!*array) {
+    perror("LRC_parseArray: alloc failed");
+    return LRC_NUMBER_INVALID;
+  }
+
+  ints = *array;
+  doubles = *array;
+
+  /* Convert */
+  p = str;
+  while (isspace((unsigned char)*p)) p++;
+
+  for (i = 0; i < n; i++) {
+    if (type == LRC_INT_ARRAY) {
+      s = LRC_scanLong(p, &end, &l);
+      if (s == LRC_NUMBER_OK && (l > INT_MAX || l < INT_MIN)) s = LRC_NUMBER_RANGE;
+      ints[i] = l > INT_MAX ? INT_MAX : (l < INT_MIN ? INT_MIN : (int)l);
+    } else {
+      s = LRC_scanNumber(p, limit, &end, &d);
+      if (s == LRC_NUMBER_OK) s = LRC_decimal2double(&d, p, (size_t)(end - p), &doubles[i]);
+    }
+
+    if (s == LRC_NUMBER_INVALID) goto failure;
+    if (s == LRC_NUMBER_RANGE) status = LRC_NUMBER_RANGE;
+
+    /* The element must end at a separator */
+    p = end;
+    comma = 0;
+    while (*p == ',' || isspace((unsigned char)*p)) {
+      if (*p == ',') {
+        if (comma) goto failure;
+        comma = 1;
+      }
+      p++;
+    }
+
+    if (i + 1 < n && p == end) goto failure;
+  }
+
+  if (*p != LRC_NULL || comma) goto failure;
+
+  *count = n;
+  return status;
+
+failure:
+  free(*array);
+  *array = NULL;
+  return LRC_NUMBER_INVALID;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,533 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_overlay.c
+ * @brief Hash index of the config and overlays.
+ *
+ * The index maps the key (namespace and name) to the option with one FNV-1a
+ * hash and, usually, one probe of an open addressing table.
+ *
+ * An overlay holds only the values that differ from the base config and reads
+ * all other values from the base through its index. Creating an overlay is
+ * O(1), every override O(1) amortized, and the lookup is two hash probes (the
+ * base index and the overrides, keyed by the base option).
+ *
+ * The base config is shared by all overlays and must not be destroyed, nor
+ * changed, while they are in use.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @fn uint64_t LRC_hashKey(const char* space, const char* name)
+ * @brief FNV-1a hash of the key (namespace, null character, name).
+ */
+uint64_t LRC_hashKey(const char* space, const char* name){
+
+  uint64_t h = UINT64_C(0xcbf29ce484222325);
+
+  while (*space) {
+    h ^= (unsigned char)*space++;
+    h *= UINT64_C(0x100000001b3);
+  }
+  h *= UINT64_C(0x100000001b3);
+  while (*name) {
+    h ^= (unsigned char)*name++;
+    h *= UINT64_C(0x100000001b3);
+  }
+
+  return h;
+}
+
+/**
+ * @fn size_t LRC_hashPointer(void* p)
+ * @brief Hash of the option pointer, for the overrides table.
+ */
+size_t LRC_hashPointer(void* p){
+
+  uint64_t h = (uint64_t)(uintptr_t)p;
+
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+
+  return (size_t)h;
+}
+
+/**
+ * @fn LRC_configIndex* LRC_indexConfig(LRC_configNamespace* head)
+ * @brief Builds the hash index of the config.
+ *
+ * The index is valid as long as the config exists, since the set of options
+ * does not change after LRC_assignDefaults().
+ *
+ * @return
+ *  The index or NULL on failure
+ */
+LRC_configIndex* LRC_indexConfig(LRC_configNamespace* head){
+
+  LRC_configIndex* index = NULL;
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* currentOP = NULL;
+  size_t n = 0, slot;
+  uint64_t h;
+
+  if (!head) {
+    perror("LRC_indexConfig: no config assigned");
+    return NULL;
+  }
+
+  for (current = head; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) n++;
+  }
+
+  index = calloc(1, sizeof(LRC_configIndex));
+  if (!index) goto failure;
+
+  /* At most half full */
+  for (index->size = 8; index->size < 2*n; index->size *= 2);
+  index->head = head;
+
+  index->hashes = calloc(index->size, sizeof(uint64_t));
+  index->spaces = calloc(index->size, sizeof(LRC_configNamespace*));
+  index->options = calloc(index->size, sizeof(LRC_configOptions*));
+  if (!index->hashes || !index->spaces || !index->options) goto failure;
+
+  for (current = head; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      h = LRC_hashKey(current->space, currentOP->name);
+      slot = (size_t)h & (index->size - 1);
+      while (index->options[slot]) slot = (slot + 1) & (index->size - 1);
+
+      index->hashes[slot] = h;
+      index->spaces[slot] = current;
+      index->options[slot] = currentOP;
+      index->count++;
+    }
+  }
+
+  return index;
+
+failure:
+  perror("LRC_indexConfig: alloc failed");
+  LRC_freeIndex(index);
+  return NULL;
+}
+
+/**
+ * @fn size_t LRC_indexSlot(LRC_configIndex* index, char* space, char* var)
+ * @brief Finds the slot of the option in the index.
+ *
+ * @return
+ *  The slot of the option, or the free slot if the option does not exist
+ */
+size_t LRC_indexSlot(LRC_configIndex* index, char* space, char* var){
+
+  size_t slot;
+  uint64_t h;
+
+  h = LRC_hashKey(space, var);
+  slot = (size_t)h & (index->size - 1);
+  LRC_COUNT(index->head, lookups, 1);
+
+  while (index->options[slot]) {
+    LRC_COUNT(index->head, probes, 1);
+    if (index->hashes[slot] == h
+        && strcmp(index->options[slot]->name, var) == 0
+        && strcmp(index->spaces[slot]->space, space) == 0) {
+      break;
+    }
+    slot = (slot + 1) & (index->size - 1);
+  }
+
+  return slot;
+}
+
+/**
+ * @fn LRC_configOptions* LRC_indexFind(LRC_configIndex* index, char* space, char* var)
+ * @brief Finds the option through the index.
+ *
+ * @return
+ *  The option or NULL if it does not exist
+ */
+LRC_configOptions* LRC_indexFind(LRC_configIndex* index, char* space, char* var){
+
+  if (!index || !space || !var) return NULL;
+
+  return index->options[LRC_indexSlot(index, space, var)];
+}
+
+/**
+ * @fn void LRC_freeIndex(LRC_configIndex* index)
+ * @brief Frees the index (the config is not touched).
+ */
+void LRC_freeIndex(LRC_configIndex* index){
+
+  if (!index) return;
+
+  if (index->hashes) free(index->hashes);
+  if (index->spaces) free(index->spaces);
+  if (index->options) free(index->options);
+  free(index);
+}
+
+/**
+ * @fn LRC_configOverlay* LRC_newOverlay(LRC_configIndex* base)
+ * @brief Creates the overlay of the base config, without any overrides.
+ *
+ * @param base
+ *   The index of the base config, see LRC_indexConfig(). It may be shared by
+ *   any number of overlays.
+ *
+ * @return
+ *  The overlay or NULL on failure
+ */
+LRC_configOverlay* LRC_newOverlay(LRC_configIndex* base){
+
+  LRC_configOverlay* overlay = NULL;
+
+  if (!base) {
+    perror("LRC_newOverlay: no config assigned");
+    return NULL;
+  }
+
+  overlay = calloc(1, sizeof(LRC_configOverlay));
+  if (!overlay) {
+    perror("LRC_newOverlay: alloc failed");
+    return NULL;
+  }
+
+  overlay->base = base;
+
+  return overlay;
+}
+
+/**
+ * @fn LRC_overlayOption* LRC_overlaySlot(LRC_configOverlay* overlay, LRC_configOptions* option)
+ * @brief Finds the override of the base option.
+ *
+ * @return
+ *  The slot of the override, or the free slot where it belongs (option is
+ *  NULL then), or NULL if the overlay has no overrides
+ */
+LRC_overlayOption* LRC_overlaySlot(LRC_configOverlay* overlay, LRC_configOptions* option){
+
+  size_t slot;
+
+  if (overlay->size == 0) return NULL;
+
+  slot = LRC_hashPointer(option) & (overlay->size - 1);
+  while (overlay->options[slot].option && overlay->options[slot].option != option) {
+    slot = (slot + 1) & (overlay->size - 1);
+  }
+
+  return &overlay->options[slot];
+}
+
+/**
+ * @fn int LRC_overlayGrow(LRC_configOverlay* overlay)
+ * @brief Doubles the overrides table.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_overlayGrow(LRC_configOverlay* overlay){
+
+  LRC_overlayOption* old = overlay->options;
+  LRC_overlayOption* entry = NULL;
+  size_t i, size = overlay->size;
+
+  overlay->size = size ? 2*size : 4;
+  overlay->options = calloc(overlay->size, sizeof(LRC_overlayOption));
+  if (!overlay->options) {
+    perror("LRC_overlayGrow: alloc failed");
+    overlay->options = old;
+    overlay->size = size;
+    return -1;
+  }
+
+  for (i = 0; i < size; i++) {
+    if (!old[i].option) continue;
+    entry = LRC_overlaySlot(overlay, old[i].option);
+    *entry = old[i];
+  }
+
+  if (old) free(old);
+
+  return 0;
+}
+
+/**
+ * @fn int LRC_overlaySet(LRC_configOverlay* overlay, char* space, char* var, char* value, int type)
+ * @brief Overrides the value of the option (the base config is not changed).
+ *
+ * The value is checked as LRC_modifyOption() checks it, and the numeric
+ * scalars must be valid numbers of their type (unless they have references,
+ * which are checked when the value is expanded).
+ *
+ * @return
+ *  0 on success, -1 if the option does not exist, the type differs from the
+ *  type of the option or the value is wrong (too long, not a valid number or
+ *  array, or out of range)
+ */
+int LRC_overlaySet(LRC_configOverlay* overlay, char* space, char* var, char* value, int type){
+
+  LRC_configOptions* option = NULL;
+  LRC_overlayOption* entry = NULL;
+  LRC_configOptions scratch;
+  char rspace[LRC_CONFIG_LEN], rname[LRC_CONFIG_LEN];
+  char* start;
+  char* end;
+  char* copy;
+  long l;
+  float f;
+  double d;
+  int status, k;
+
+  if (!overlay || !value) return -1;
+
+  option = LRC_indexFind(overlay->base, space, var);
+  if (!option || type != option->type) return -1;
+
+  /* The same checks as for the values of the config, on a scratch option */
+  memset(&scratch, 0, sizeof(LRC_configOptions));
+  status = LRC_storeValue(&scratch, value, type);
+  if (scratch.array) free(scratch.array);
+  if (status < 0) return -1;
+
+  /* The values with references are checked when they are expanded */
+  if (LRC_interpRef(value, &start, &end, rspace, rname) != 1) {
+    switch (type) {
+      case LRC_INT:
+      case LRC_VAL:
+        status = LRC_str2int(value, &k);
+        break;
+      case LRC_LONG:
+        status = LRC_str2long(value, &l);
+        break;
+      case LRC_FLOAT:
+        status = LRC_str2float(value, &f);
+        break;
+      case LRC_DOUBLE:
+        status = LRC_str2double(value, &d);
+        break;
+      default:
+        break;
+    }
+  }
+  if (status != LRC_NUMBER_OK) return -1;
+
+  copy = malloc(strlen(value) + 1);
+  if (!copy) {
+    perror("LRC_overlaySet: alloc failed");
+    return -1;
+  }
+  strcpy(copy, value);
+
+  entry = LRC_overlaySlot(overlay, option);
+  if (entry && entry->option) {
+    free(entry->value);
+  } else {
+    if (2*(overlay->count + 1) > overlay->size) {
+      if (LRC_overlayGrow(overlay) < 0) {
+        free(copy);
+        return -1;
+      }
+    }
+    entry = LRC_overlaySlot(overlay, option);
+    entry->option = option;
+    overlay->count++;
+  }
+
+  entry->value = copy;
+  entry->type = type;
+
+  return 0;
+}
+
+/**
+ * @fn char* LRC_overlayGet(LRC_configOverlay* overlay, char* space, char* var, int* type)
+ * @brief The value of the option, overridden or from the base config.
+ *
+ * The value is the text as written: the references (${namespace.name}) are
+ * not expanded, also if the base config is interpolated. For the expanded
+ * values, see LRC_overlay2config() and LRC_interpolate().
+ *
+ * @param type
+ *   If not NULL, the type of the value is stored there.
+ *
+ * @return
+ *  The value (owned by the overlay or the base config) or NULL if the option
+ *  does not exist
+ */
+char* LRC_overlayGet(LRC_configOverlay* overlay, char* space, char* var, int* type){
+
+  LRC_configOptions* option = NULL;
+  LRC_overlayOption* entry = NULL;
+
+  if (!overlay) return NULL;
+
+  option = LRC_indexFind(overlay->base, space, var);
+  if (!option) return NULL;
+
+  entry = LRC_overlaySlot(overlay, option);
+  if (entry && entry->option) {
+    if (type) *type = entry->type;
+    return entry->value;
+  }
+
+  if (type) *type = option->type;
+  return option->value;
+}
+
+/**
+ * @fn int LRC_overlayGetInt(LRC_configOverlay* overlay, char* space, char* var, int* value)
+ * @brief Converts the value of the overlay option to int, see LRC_getInt().
+ *
+ * @return
+ *  LRC_NUMBER_OK, LRC_NUMBER_INVALID (also if the option does not exist) or
+ *  LRC_NUMBER_RANGE
+ */
+int LRC_overlayGetInt(LRC_configOverlay* overlay, char* space, char* var, int* value){
+
+  char* str = LRC_overlayGet(overlay, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2int(str, value);
+}
+
+/**
+ * @fn int LRC_overlayGetLong(LRC_configOverlay* overlay, char* space, char* var, long* value)
+ * @brief Converts the value of the overlay option to long.
+ */
+int LRC_overlayGetLong(LRC_configOverlay* overlay, char* space, char* var, long* value){
+
+  char* str = LRC_overlayGet(overlay, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2long(str, value);
+}
+
+/**
+ * @fn int LRC_overlayGetFloat(LRC_configOverlay* overlay, char* space, char* var, float* value)
+ * @brief Converts the value of the overlay option to float.
+ */
+int LRC_overlayGetFloat(LRC_configOverlay* overlay, char* space, char* var, float* value){
+
+  char* str = LRC_overlayGet(overlay, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2float(str, value);
+}
+
+/**
+ * @fn int LRC_overlayGetDouble(LRC_configOverlay* overlay, char* space, char* var, double* value)
+ * @brief Converts the value of the overlay option to double.
+ */
+int LRC_overlayGetDouble(LRC_configOverlay* overlay, char* space, char* var, double* value){
+
+  char* str = LRC_overlayGet(overlay, space, var, NULL);
+
+  if (!str) return LRC_NUMBER_INVALID;
+
+  return LRC_str2double(str, value);
+}
+
+/**
+ * @fn LRC_configNamespace* LRC_overlay2config(LRC_configOverlay* overlay)
+ * @brief Creates the full config of the overlay (base config with the
+ * overrides applied), e.g. for the writers.
+ *
+ * @return
+ *  The new config (free with LRC_cleanup()) or NULL on failure
+ */
+LRC_configNamespace* LRC_overlay2config(LRC_configOverlay* overlay){
+
+  LRC_configNamespace* copy = NULL;
+  LRC_configNamespace* baseNM = NULL;
+  LRC_configNamespace* copyNM = NULL;
+  LRC_configOptions* baseOP = NULL;
+  LRC_configOptions* copyOP = NULL;
+  LRC_overlayOption* entry = NULL;
+
+  if (!overlay) return NULL;
+
+  copy = LRC_copyConfig(overlay->base->head);
+  if (!copy) return NULL;
+
+  /* The copy has the layout of the base */
+  for (baseNM = overlay->base->head, copyNM = copy; baseNM;
+      baseNM = baseNM->next, copyNM = copyNM->next) {
+    for (baseOP = baseNM->options, copyOP = copyNM->options; baseOP;
+        baseOP = baseOP->next, copyOP = copyOP->next) {
+      entry = LRC_overlaySlot(overlay, baseOP);
+      if (!entry || !entry->option) continue;
+
+      if (LRC_storeValue(copyOP, entry->value, entry->type) < 0) goto failure;
+    }
+  }
+
+  return copy;
+
+failure:
+  LRC_cleanup(copy);
+  return NULL;
+}
+
+/**
+ * @fn void LRC_freeOverlay(LRC_configOverlay* overlay)
+ * @brief Frees the overlay (the base config is not touched).
+ */
+void LRC_freeOverlay(LRC_configOverlay* overlay){
+
+  size_t i;
+
+  if (!overlay) return;
+
+  for (i = 0; i < overlay->size; i++) {
+    if (overlay->options[i].option) free(overlay->options[i].value);
+  }
+
+  if (overlay->options) free(overlay->options);
+  free(overlay);
+}
@@ -0,0 +1,298 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_popt.c
+ * @brief Command line options generated from the defaults.
+ *
+ * LRC_poptTable() builds the popt table with an option --namespace-name for
+ * every default (with the short name and the description of the default).
+ * The callback of the table stores the parsed arguments directly in the
+ * options of the config, so the command line is parsed in the same pass as
+ * the other popt options of the program:
+ *
+ * @code
+ * struct poptOption* lrc = LRC_poptTable(cd, head);
+ * struct poptOption table[] = {
+ *   {NULL, '\0', POPT_ARG_INCLUDE_TABLE, lrc, 0, "Config options:", NULL},
+ *   POPT_AUTOHELP
+ *   POPT_TABLEEND
+ * };
+ * @endcode
+ *
+ * LRC_poptLayerTable() does the same for the LRC_LAYER_CLI layer of the
+ * layered config.
+ *
+ * The arguments are declared as POPT_ARG_STRING, also for the numbers. The
+ * config holds every value as the text of the file (the getters convert it),
+ * so typed popt arguments would be converted by popt, in the current locale,
+ * only to be formatted back to text. Instead the callback checks the text
+ * with the locale independent parsers of the library and stores it as is.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @fn void LRC_poptCallback(poptContext con, enum poptCallbackReason reason, const struct poptOption* opt, const char* arg, const void* data)
+ * @brief Stores the argument of the option in the config.
+ *
+ * The val of the table entry is the position of the option in the target.
+ * The numbers are checked with the parsers of the library, wrong values are
+ * reported and counted, see LRC_poptErrors().
+ */
+void LRC_poptCallback(poptContext con, enum poptCallbackReason reason,
+    const struct poptOption* opt, const char* arg, const void* data){
+
+  LRC_poptTarget* target = (LRC_poptTarget*)data;
+  LRC_configOptions* option = NULL;
+  char* value;
+  int status = LRC_NUMBER_OK, i;
+  long l;
+  float f;
+  double d;
+
+  (void)con;
+
+  if (reason != POPT_CALLBACK_REASON_OPTION || !opt || opt->val < 1) return;
+
+  option = target->options[opt->val - 1];
+
+  /* Switches have no argument */
+  value = arg ? (char*)arg : "1";
+
+  switch (option->type) {
+    case LRC_INT:
+      status = LRC_str2int(value, &i);
+      break;
+    case LRC_LONG:
+      status = LRC_str2long(value, &l);
+      break;
+    case LRC_FLOAT:
+      status = LRC_str2float(value, &f);
+      break;
+    case LRC_DOUBLE:
+      status = LRC_str2double(value, &d);
+      break;
+    default:
+      break;
+  }
+
+  if (status == LRC_NUMBER_OK) {
+    if (target->layers) {
+      status = LRC_layerSet(target->layers, LRC_LAYER_CLI,
+          target->spaces[opt->val - 1]->space, option->name, value);
+    } else {
+      status = LRC_storeValue(option, value, option->type);
+      if (status == 0) LRC_changed(target->head, target->spaces[opt->val - 1]->space, option);
+    }
+  }
+
+  if (status != LRC_NUMBER_OK) {
+    LRC_report(target->layers ? target->layers->defaults : target->head, LRC_ERR_WRONG_INPUT, 0, 0,
+        target->spaces[opt->val - 1]->space, option->name, (char*)opt->longName);
+    target->errors++;
+  }
+}
+
+/**
+ * @fn struct poptOption* LRC_poptBuild(LRC_configDefaults* cd, LRC_configIndex* index, LRC_configLayers* layers)
+ * @brief Builds the popt table for the options of the index.
+ *
+ * The table, the target of the callback and the long names are allocated as
+ * one block.
+ *
+ * @return
+ *  The table or NULL on failure, also if the config has no option for one of
+ *  the defaults (reported)
+ */
+struct poptOption* LRC_poptBuild(LRC_configDefaults* cd, LRC_configIndex* index, LRC_configLayers* layers){
+
+  struct poptOption* table = NULL;
+  struct poptOption* entry = NULL;
+  LRC_poptTarget* target = NULL;
+  char* names;
+  size_t n, i, slot, size, namelen = 0;
+
+  n = (size_t)LRC_countDefaultOptions(cd);
+
+  for (i = 0; i < n; i++) {
+    namelen += strlen(cd[i].space) + strlen(cd[i].name) + 2;
+  }
+
+  size = (n + 2)*sizeof(struct poptOption) + sizeof(LRC_poptTarget)
+    + n*(sizeof(LRC_configNamespace*) + sizeof(LRC_configOptions*)) + namelen;
+
+  table = calloc(1, size);
+  if (!table) {
+    perror("LRC_poptTable: alloc failed");
+    return NULL;
+  }
+
+  target = (LRC_poptTarget*)(table + n + 2);
+  target->head = index->head;
+  target->layers = layers;
+  target->spaces = (LRC_configNamespace**)(target + 1);
+  target->options = (LRC_configOptions**)(target->spaces + n);
+  names = (char*)(target->options + n);
+
+  /* The callback of the table comes first, the data is the target */
+  table[0].argInfo = POPT_ARG_CALLBACK;
+  table[0].arg = (void*)LRC_poptCallback;
+  table[0].descrip = (const char*)target;
+
+  for (i = 0; i < n; i++) {
+    /* The config may lack some of the defaults, i.e. an older one */
+    slot = LRC_indexSlot(index, cd[i].space, cd[i].name);
+    if (!index->options[slot]) {
+      LRC_report(index->head, LRC_ERR_CONFIG_SYNTAX, 0, 0, cd[i].space, cd[i].name,
+          LRC_MSG_UNKNOWN_VAR);
+      free(table);
+      return NULL;
+    }
+    target->spaces[i] = index->spaces[slot];
+    target->options[i] = index->options[slot];
+
+    entry = &table[i + 1];
+    entry->longName = names;
+    names += sprintf(names, "%s-%s", cd[i].space, cd[i].name) + 1;
+    entry->shortName = cd[i].shortName;
+    entry->val = (int)(i + 1);
+    entry->descrip = cd[i].description[0] != LRC_NULL ? cd[i].description : NULL;
+
+    switch (cd[i].type) {
+      case LRC_VAL:
+        entry->argInfo = POPT_ARG_NONE;
+        break;
+      case LRC_INT:
+        entry->argInfo = POPT_ARG_STRING;
+        entry->argDescrip = "INT";
+        break;
+      case LRC_LONG:
+        entry->argInfo = POPT_ARG_STRING;
+        entry->argDescrip = "LONG";
+        break;
+      case LRC_FLOAT:
+      case LRC_DOUBLE:
+        entry->argInfo = POPT_ARG_STRING;
+        entry->argDescrip = "NUMBER";
+        break;
+      case LRC_INT_ARRAY:
+      case LRC_DOUBLE_ARRAY:
+        entry->argInfo = POPT_ARG_STRING;
+        entry->argDescrip = "LIST";
+        break;
+      default:
+        entry->argInfo = POPT_ARG_STRING;
+        entry->argDescrip = "STRING";
+        break;
+    }
+  }
+
+  /* The last entry is zeroed, POPT_TABLEEND */
+
+  return table;
+}
+
+/**
+ * @fn struct poptOption* LRC_poptTable(LRC_configDefaults* cd, LRC_configNamespace* head)
+ * @brief Builds the popt table of the defaults, which stores the arguments
+ * in the config.
+ *
+ * Options of the LRC_VAL type are switches (they are set to 1), all others
+ * take the value as the argument, in the format of the config file.
+ *
+ * @param cd
+ *   The defaults (the same as for LRC_assignDefaults()).
+ *
+ * @param head
+ *   The config created from the defaults.
+ *
+ * @return
+ *  The table (free with free() after the popt context is freed) or NULL on
+ *  failure
+ */
+struct poptOption* LRC_poptTable(LRC_configDefaults* cd, LRC_configNamespace* head){
+
+  struct poptOption* table = NULL;
+  LRC_configIndex* index = NULL;
+
+  if (!cd || !head) {
+    perror("LRC_poptTable: no config assigned");
+    return NULL;
+  }
+
+  index = LRC_indexConfig(head);
+  if (!index) return NULL;
+
+  table = LRC_poptBuild(cd, index, NULL);
+
+  LRC_freeIndex(index);
+
+  return table;
+}
+
+/**
+ * @fn struct poptOption* LRC_poptLayerTable(LRC_configDefaults* cd, LRC_configLayers* layers)
+ * @brief Builds the popt table of the defaults, which stores the arguments
+ * in the LRC_LAYER_CLI layer.
+ *
+ * @return
+ *  The table (free with free() after the popt context is freed) or NULL on
+ *  failure
+ */
+struct poptOption* LRC_poptLayerTable(LRC_configDefaults* cd, LRC_configLayers* layers){
+
+  if (!cd || !layers) {
+    perror("LRC_poptLayerTable: no config assigned");
+    return NULL;
+  }
+
+  return LRC_poptBuild(cd, layers->index, layers);
+}
+
+/**
+ * @fn int LRC_poptErrors(struct poptOption* table)
+ * @brief Number of wrong arguments met by the table so far.
+ */
+int LRC_poptErrors(struct poptOption* table){
+
+  if (!table) return 0;
+
+  return ((LRC_poptTarget*)table[0].descrip)->errors;
+}
@@ -0,0 +1,227 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_stats.c
+ * @brief Instrumentation counters and phase timers.
+ *
+ * The counters are compiled in with LRC_STATS only (cmake -DBUILD_STATS=ON),
+ * otherwise the instrumentation macros expand to nothing and LRC_getStats()
+ * returns zeros.
+ *
+ * Each namespace keeps its own counters, allocated on first use, so the code
+ * which gets only a namespace (i.e. LRC_findOption()) can count as well.
+ * LRC_getStats() sums them over the config. Everything is also counted in the
+ * global statistics, which include the work with no config at hand, i.e. the
+ * buffers of the writers. The global counters are updated with relaxed atomic
+ * additions (with GCC and Clang), so they stay exact when several threads
+ * count at once, i.e. the workers of lrc-check or LRC_loadAsync(). The
+ * counters of a namespace belong to its config, which is used by one thread
+ * at a time.
+ */
+
+/* clock_gettime */
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+LRC_stats LRC_globalStats;
+
+static char* phases[] = {"read", "tokenize", "lookup", "store", "write", "HDF5"};
+
+/**
+ * @fn LRC_stats* LRC_statsOf(LRC_configNamespace* space)
+ * @brief Counters of the namespace, allocated on first use.
+ *
+ * @return
+ *  The counters or NULL (no namespace, or the allocation failed)
+ */
+LRC_stats* LRC_statsOf(LRC_configNamespace* space){
+
+  if (!space) return NULL;
+
+  if (!space->stats) space->stats = calloc(1, sizeof(LRC_stats));
+
+  return space->stats;
+}
+
+/**
+ * @fn uint64_t LRC_statsClock(void)
+ * @brief Monotonic clock, in nanoseconds.
+ */
+uint64_t LRC_statsClock(void){
+
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @fn uint64_t LRC_statsPhase(LRC_configNamespace* space, int phase, uint64_t start)
+ * @brief Adds the time since start to the phase.
+ *
+ * @return
+ *  The current time, the start of the next phase
+ */
+uint64_t LRC_statsPhase(LRC_configNamespace* space, int phase, uint64_t start){
+
+  LRC_stats* stats = NULL;
+  uint64_t now;
+
+  now = LRC_statsClock();
+
+  LRC_ATOMIC_ADD(LRC_globalStats.time[phase], now - start);
+  stats = LRC_statsOf(space);
+  if (stats) stats->time[phase] += now - start;
+
+  return now;
+}
+
+/**
+ * @fn LRC_stats LRC_getStats(LRC_configNamespace* head)
+ * @brief Statistics of the config.
+ *
+ * @param head
+ *  First namespace in the options list, or NULL for the global statistics (all
+ *  the configs, the parsers and the writers of the process)
+ *
+ * @return
+ *  The counters summed over the namespaces (zeros if the library is built
+ *  without LRC_STATS)
+ */
+LRC_stats LRC_getStats(LRC_configNamespace* head){
+
+  LRC_configNamespace* current = NULL;
+  LRC_stats stats;
+  LRC_stats* s;
+  int i;
+
+  memset(&stats, 0, sizeof(LRC_stats));
+
+  /* Each counter is read atomically, the set is not a single snapshot */
+  if (!head) {
+    stats.lines = LRC_ATOMIC_LOAD(LRC_globalStats.lines);
+    stats.bytes = LRC_ATOMIC_LOAD(LRC_globalStats.bytes);
+    stats.allocations = LRC_ATOMIC_LOAD(LRC_globalStats.allocations);
+    stats.allocated = LRC_ATOMIC_LOAD(LRC_globalStats.allocated);
+    stats.lookups = LRC_ATOMIC_LOAD(LRC_globalStats.lookups);
+    stats.probes = LRC_ATOMIC_LOAD(LRC_globalStats.probes);
+    stats.conversions = LRC_ATOMIC_LOAD(LRC_globalStats.conversions);
+    for (i = 0; i < LRC_PHASES; i++) stats.time[i] = LRC_ATOMIC_LOAD(LRC_globalStats.time[i]);
+    return stats;
+  }
+
+  for (current = head; current; current = current->next) {
+    s = current->stats;
+    if (!s) continue;
+
+    stats.lines += s->lines;
+    stats.bytes += s->bytes;
+    stats.allocations += s->allocations;
+    stats.allocated += s->allocated;
+    stats.lookups += s->lookups;
+    stats.probes += s->probes;
+    stats.conversions += s->conversions;
+    for (i = 0; i < LRC_PHASES; i++) stats.time[i] += s->time[i];
+  }
+
+  return stats;
+}
+
+/**
+ * @fn void LRC_resetStats(LRC_configNamespace* head)
+ * @brief Zeroes the statistics of the config (NULL for the global ones).
+ */
+void LRC_resetStats(LRC_configNamespace* head){
+
+  LRC_configNamespace* current = NULL;
+  int i;
+
+  if (!head) {
+    LRC_ATOMIC_STORE(LRC_globalStats.lines, 0);
+    LRC_ATOMIC_STORE(LRC_globalStats.bytes, 0);
+    LRC_ATOMIC_STORE(LRC_globalStats.allocations, 0);
+    LRC_ATOMIC_STORE(LRC_globalStats.allocated, 0);
+    LRC_ATOMIC_STORE(LRC_globalStats.lookups, 0);
+    LRC_ATOMIC_STORE(LRC_globalStats.probes, 0);
+    LRC_ATOMIC_STORE(LRC_globalStats.conversions, 0);
+    for (i = 0; i < LRC_PHASES; i++) LRC_ATOMIC_STORE(LRC_globalStats.time[i], 0);
+    return;
+  }
+
+  for (current = head; current; current = current->next) {
+    if (current->stats) memset(current->stats, 0, sizeof(LRC_stats));
+  }
+}
+
+/**
+ * @fn char* LRC_phaseName(int phase)
+ * @brief Name of the phase ("read", "tokenize", "lookup", "store", "write",
+ * "HDF5").
+ */
+char* LRC_phaseName(int phase){
+
+  if (phase < 0 || phase >= LRC_PHASES) return NULL;
+
+  return phases[phase];
+}
+
+/**
+ * @fn void LRC_printStats(LRC_stats* stats)
+ * @brief Prints the statistics.
+ */
+void LRC_printStats(LRC_stats* stats){
+
+  int i;
+
+  if (!stats) return;
+
+  printf("lines: %" PRIu64 "\n", stats->lines);
+  printf("bytes read: %" PRIu64 "\n", stats->bytes);
+  printf("allocations: %" PRIu64 " (%" PRIu64 " bytes)\n", stats->allocations, stats->allocated);
+  printf("lookups: %" PRIu64 " (average probe length %.2f)\n", stats->lookups,
+      stats->lookups > 0 ? (double)stats->probes / (double)stats->lookups : 0.0);
+  printf("conversions: %" PRIu64 "\n", stats->conversions);
+  for (i = 0; i < LRC_PHASES; i++) {
+    printf("%s: %.6f s\n", phases[i], (double)stats->time[i] / 1e9);
+  }
+}
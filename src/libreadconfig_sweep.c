@@ -0,0 +1,1035 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file libreadconfig_sweep.c
+ * @brief Columnar store of parameter sweeps.
+ *
+ * A sweep holds N tasks which share the base config and differ in a few
+ * options. Every such option is a column: one contiguous array of N values of
+ * the type of the option (int, long, float or double). String values are kept
+ * once in the dictionary of the sweep, and the column holds their codes.
+ *
+ * Columns are scanned with simple loops over the arrays, which the compiler
+ * vectorizes, and the whole sweep is exported to HDF5 as a single table.
+ */
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @fn size_t LRC_sweepElement(int type)
+ * @brief Size of the element of the column.
+ */
+size_t LRC_sweepElement(int type){
+
+  switch (type) {
+    case LRC_LONG: return sizeof(long);
+    case LRC_FLOAT: return sizeof(float);
+    case LRC_DOUBLE: return sizeof(double);
+    default: return sizeof(int);
+  }
+}
+
+/**
+ * @fn int LRC_sweepCode(LRC_configSweep* sweep, char* str)
+ * @brief Finds the string in the dictionary.
+ *
+ * @return
+ *  The code of the string or -1 if it is not there
+ */
+int LRC_sweepCode(LRC_configSweep* sweep, char* str){
+
+  size_t slot;
+
+  if (sweep->nslots == 0) return -1;
+
+  slot = (size_t)LRC_hashKey("", str) & (sweep->nslots - 1);
+  while (sweep->slots[slot] >= 0) {
+    if (strcmp(sweep->strings[sweep->slots[slot]], str) == 0) return sweep->slots[slot];
+    slot = (slot + 1) & (sweep->nslots - 1);
+  }
+
+  return -1;
+}
+
+/**
+ * @fn int LRC_sweepIntern(LRC_configSweep* sweep, char* str)
+ * @brief Finds or adds the string in the dictionary.
+ *
+ * @return
+ *  The code of the string or -1 on failure
+ */
+int LRC_sweepIntern(LRC_configSweep* sweep, char* str){
+
+  char** strings = NULL;
+  int* slots = NULL;
+  size_t slot, size, i;
+  int code;
+
+  code = LRC_sweepCode(sweep, str);
+  if (code >= 0) return code;
+
+  /* The slots table is at most half full */
+  if (2*(sweep->nstrings + 1) > sweep->nslots) {
+    size = sweep->nslots ? 2*sweep->nslots : 16;
+
+    slots = malloc(size * sizeof(int));
+    strings = realloc(sweep->strings, size/2 * sizeof(char*));
+    if (!slots || !strings) {
+      perror("LRC_sweepIntern: alloc failed");
+      if (slots) free(slots);
+      if (strings) sweep->strings = strings;
+      return -1;
+    }
+    sweep->strings = strings;
+
+    for (i = 0; i < size; i++) slots[i] = -1;
+    for (i = 0; i < sweep->nstrings; i++) {
+      slot = (size_t)LRC_hashKey("", sweep->strings[i]) & (size - 1);
+      while (slots[slot] >= 0) slot = (slot + 1) & (size - 1);
+      slots[slot] = (int)i;
+    }
+
+    if (sweep->slots) free(sweep->slots);
+    sweep->slots = slots;
+    sweep->nslots = size;
+  }
+
+  slot = (size_t)LRC_hashKey("", str) & (sweep->nslots - 1);
+  while (sweep->slots[slot] >= 0) slot = (slot + 1) & (sweep->nslots - 1);
+
+  sweep->strings[sweep->nstrings] = malloc(strlen(str) + 1);
+  if (!sweep->strings[sweep->nstrings]) {
+    perror("LRC_sweepIntern: alloc failed");
+    return -1;
+  }
+  strcpy(sweep->strings[sweep->nstrings], str);
+
+  sweep->slots[slot] = (int)sweep->nstrings;
+
+  return (int)sweep->nstrings++;
+}
+
+/**
+ * @fn LRC_configSweep* LRC_newSweep(LRC_configIndex* base, size_t ntasks)
+ * @brief Creates the sweep of ntasks tasks, without any columns.
+ *
+ * @param base
+ *   The index of the base config, see LRC_indexConfig().
+ *
+ * @return
+ *  The sweep or NULL on failure
+ */
+LRC_configSweep* LRC_newSweep(LRC_configIndex* base, size_t ntasks){
+
+  LRC_configSweep* sweep = NULL;
+
+  if (!base) {
+    perror("LRC_newSweep: no config assigned");
+    return NULL;
+  }
+
+  sweep = calloc(1, sizeof(LRC_configSweep));
+  if (!sweep) {
+    perror("LRC_newSweep: alloc failed");
+    return NULL;
+  }
+
+  sweep->base = base;
+  sweep->ntasks = ntasks;
+
+  return sweep;
+}
+
+/**
+ * @fn int LRC_sweepFind(LRC_configSweep* sweep, char* space, char* var)
+ * @brief Finds the column of the option.
+ *
+ * @return
+ *  The column or -1 if the option is not swept
+ */
+int LRC_sweepFind(LRC_configSweep* sweep, char* space, char* var){
+
+  LRC_configOptions* option = NULL;
+  size_t i;
+
+  if (!sweep) return -1;
+
+  option = LRC_indexFind(sweep->base, space, var);
+  if (!option) return -1;
+
+  for (i = 0; i < sweep->ncolumns; i++) {
+    if (sweep->columns[i].option == option) return (int)i;
+  }
+
+  return -1;
+}
+
+/**
+ * @fn int LRC_sweepAddColumn(LRC_configSweep* sweep, char* space, char* var)
+ * @brief Adds the column of the option, filled with the base value.
+ *
+ * If the base value does not convert to the type of the option (e.g. it is the
+ * sweep range, see LRC_newSweepIterator()), the column is filled with zeros.
+ *
+ * @return
+ *  The column or -1 on failure (unknown option or array option)
+ */
+int LRC_sweepAddColumn(LRC_configSweep* sweep, char* space, char* var){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  LRC_sweepColumn* columns = NULL;
+  LRC_sweepColumn* column = NULL;
+  size_t i, size;
+  int c;
+
+  if (!sweep) return -1;
+
+  c = LRC_sweepFind(sweep, space, var);
+  if (c >= 0) return c;
+
+  option = LRC_indexFind(sweep->base, space, var);
+  if (!option || LRC_isArray(option->type)) return -1;
+  current = LRC_findNamespace(space, sweep->base->head);
+
+  columns = realloc(sweep->columns, (sweep->ncolumns + 1) * sizeof(LRC_sweepColumn));
+  if (!columns) {
+    perror("LRC_sweepAddColumn: alloc failed");
+    return -1;
+  }
+  sweep->columns = columns;
+
+  column = &sweep->columns[sweep->ncolumns];
+  column->space = current;
+  column->option = option;
+  switch (option->type) {
+    case LRC_LONG:
+    case LRC_FLOAT:
+    case LRC_DOUBLE:
+    case LRC_STRING:
+      column->type = option->type;
+      break;
+    default:
+      column->type = LRC_INT;
+      break;
+  }
+
+  size = LRC_sweepElement(column->type);
+  if (sweep->ntasks > SIZE_MAX / size) {
+    LRC_message(0, LRC_ERR_WRONG_INPUT, "Too many tasks");
+    return -1;
+  }
+
+  column->data = malloc(sweep->ntasks > 0 ? sweep->ntasks * size : 1);
+  if (!column->data) {
+    perror("LRC_sweepAddColumn: alloc failed");
+    return -1;
+  }
+
+  sweep->ncolumns++;
+
+  /* The base value goes to the first task and is copied to the others */
+  if (sweep->ntasks > 0) {
+    if (LRC_sweepSet(sweep, 0, (int)sweep->ncolumns - 1, option->value) < 0) {
+      if (column->type == LRC_STRING) {
+        sweep->ncolumns--;
+        free(column->data);
+        return -1;
+      }
+      memset(column->data, 0, size);
+    }
+    for (i = 1; i < sweep->ntasks; i++) {
+      memcpy((char*)column->data + i*size, column->data, size);
+    }
+  }
+
+  return (int)sweep->ncolumns - 1;
+}
+
+/**
+ * @fn int LRC_sweepSet(LRC_configSweep* sweep, size_t task, int column, char* value)
+ * @brief Sets the value of the task, converted to the type of the column.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_sweepSet(LRC_configSweep* sweep, size_t task, int column, char* value){
+
+  LRC_sweepColumn* c = NULL;
+  int status = LRC_NUMBER_OK, code;
+
+  if (!sweep || column < 0 || (size_t)column >= sweep->ncolumns || task >= sweep->ntasks) return -1;
+
+  c = &sweep->columns[column];
+
+  switch (c->type) {
+    case LRC_LONG:
+      status = LRC_str2long(value, (long*)c->data + task);
+      break;
+    case LRC_FLOAT:
+      status = LRC_str2float(value, (float*)c->data + task);
+      break;
+    case LRC_DOUBLE:
+      status = LRC_str2double(value, (double*)c->data + task);
+      break;
+    case LRC_STRING:
+      if (strlen(value) >= LRC_CONFIG_LEN) return -1;
+      code = LRC_sweepIntern(sweep, value);
+      if (code < 0) return -1;
+      ((int*)c->data)[task] = code;
+      break;
+    default:
+      status = LRC_str2int(value, (int*)c->data + task);
+      break;
+  }
+
+  return status == LRC_NUMBER_OK ? 0 : -1;
+}
+
+/**
+ * @fn void* LRC_sweepColumnData(LRC_configSweep* sweep, int column, int* type)
+ * @brief The contiguous values of the column, one per task.
+ *
+ * The array may be read and written directly. For string columns it holds
+ * the codes of the strings, see LRC_sweepString().
+ *
+ * @param type
+ *   If not NULL, the type of the column is stored there (LRC_INT, LRC_LONG,
+ *   LRC_FLOAT, LRC_DOUBLE or LRC_STRING).
+ *
+ * @return
+ *  The array or NULL if the column does not exist
+ */
+void* LRC_sweepColumnData(LRC_configSweep* sweep, int column, int* type){
+
+  if (!sweep || column < 0 || (size_t)column >= sweep->ncolumns) return NULL;
+
+  if (type) *type = sweep->columns[column].type;
+
+  return sweep->columns[column].data;
+}
+
+/**
+ * @fn char* LRC_sweepString(LRC_configSweep* sweep, int code)
+ * @brief The string of the dictionary code.
+ */
+char* LRC_sweepString(LRC_configSweep* sweep, int code){
+
+  if (!sweep || code < 0 || (size_t)code >= sweep->nstrings) return NULL;
+
+  return sweep->strings[code];
+}
+
+/**
+ * @fn int LRC_sweepFormat(LRC_configSweep* sweep, size_t task, int column, char* str)
+ * @brief Formats the value of the task (str holds at least LRC_CONFIG_LEN bytes).
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_sweepFormat(LRC_configSweep* sweep, size_t task, int column, char* str){
+
+  LRC_sweepColumn* c = NULL;
+
+  if (!sweep || column < 0 || (size_t)column >= sweep->ncolumns || task >= sweep->ntasks) return -1;
+
+  c = &sweep->columns[column];
+
+  switch (c->type) {
+    case LRC_LONG:
+      sprintf(str, "%ld", ((long*)c->data)[task]);
+      break;
+    case LRC_FLOAT:
+      LRC_float2str(str, ((float*)c->data)[task]);
+      break;
+    case LRC_DOUBLE:
+      LRC_double2str(str, ((double*)c->data)[task]);
+      break;
+    case LRC_STRING:
+      strcpy(str, sweep->strings[((int*)c->data)[task]]);
+      break;
+    default:
+      sprintf(str, "%d", ((int*)c->data)[task]);
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * @fn LRC_configOverlay* LRC_sweepTask(LRC_configSweep* sweep, size_t task)
+ * @brief The config of the task, as the overlay of the base config.
+ *
+ * @return
+ *  The overlay (free with LRC_freeOverlay()) or NULL on failure
+ */
+LRC_configOverlay* LRC_sweepTask(LRC_configSweep* sweep, size_t task){
+
+  LRC_configOverlay* overlay = NULL;
+  char value[LRC_CONFIG_LEN];
+  size_t i;
+
+  if (!sweep || task >= sweep->ntasks) return NULL;
+
+  overlay = LRC_newOverlay(sweep->base);
+  if (!overlay) return NULL;
+
+  for (i = 0; i < sweep->ncolumns; i++) {
+    LRC_sweepFormat(sweep, task, (int)i, value);
+
+    if (LRC_overlaySet(overlay, sweep->columns[i].space->space, sweep->columns[i].option->name,
+          value, sweep->columns[i].option->type) < 0) goto failure;
+  }
+
+  return overlay;
+
+failure:
+  LRC_freeOverlay(overlay);
+  return NULL;
+}
+
+/**
+ * @fn size_t LRC_sweepSelect(LRC_configSweep* sweep, int column, int op, double x, size_t* tasks)
+ * @brief Finds the tasks whose value in the numeric column compares to x.
+ *
+ * The values are compared as doubles (long values beyond 2^53 are rounded).
+ *
+ * @param op
+ *   One of LRC_SWEEP_LT, LRC_SWEEP_LE, LRC_SWEEP_GT, LRC_SWEEP_GE, LRC_SWEEP_EQ,
+ *   LRC_SWEEP_NE.
+ *
+ * @param tasks
+ *   The indices of the matching tasks, in ascending order (room for all tasks
+ *   is needed). May be NULL to only count them.
+ *
+ * @return
+ *  Number of matching tasks
+ */
+size_t LRC_sweepSelect(LRC_configSweep* sweep, int column, int op, double x, size_t* tasks){
+
+  LRC_sweepColumn* c = NULL;
+  unsigned char* match = NULL;
+  size_t i, n = 0, ntasks;
+  double v;
+
+  if (!sweep || column < 0 || (size_t)column >= sweep->ncolumns) return 0;
+
+  c = &sweep->columns[column];
+  ntasks = sweep->ntasks;
+  if (c->type == LRC_STRING || ntasks == 0) return 0;
+
+  match = malloc(ntasks);
+  if (!match) {
+    perror("LRC_sweepSelect: alloc failed");
+    return 0;
+  }
+
+  /* Branch-free compare of the whole column, one type at a time */
+#define LRC_SWEEP_SCAN(T) \
+  do { \
+    T* data = (T*)c->data; \
+    switch (op) { \
+      case LRC_SWEEP_LT: for (i = 0; i < ntasks; i++) { v = (double)data[i]; match[i] = v < x; } break; \
+      case LRC_SWEEP_LE: for (i = 0; i < ntasks; i++) { v = (double)data[i]; match[i] = v <= x; } break; \
+      case LRC_SWEEP_GT: for (i = 0; i < ntasks; i++) { v = (double)data[i]; match[i] = v > x; } break; \
+      case LRC_SWEEP_GE: for (i = 0; i < ntasks; i++) { v = (double)data[i]; match[i] = v >= x; } break; \
+      case LRC_SWEEP_EQ: for (i = 0; i < ntasks; i++) { v = (double)data[i]; match[i] = v == x; } break; \
+      default: for (i = 0; i < ntasks; i++) { v = (double)data[i]; match[i] = v != x; } break; \
+    } \
+  } while (0)
+
+  switch (c->type) {
+    case LRC_LONG: LRC_SWEEP_SCAN(long); break;
+    case LRC_FLOAT: LRC_SWEEP_SCAN(float); break;
+    case LRC_DOUBLE: LRC_SWEEP_SCAN(double); break;
+    default: LRC_SWEEP_SCAN(int); break;
+  }
+
+#undef LRC_SWEEP_SCAN
+
+  for (i = 0; i < ntasks; i++) {
+    if (tasks) tasks[n] = i;
+    n += match[i];
+  }
+
+  free(match);
+
+  return n;
+}
+
+/**
+ * @fn size_t LRC_sweepSelectString(LRC_configSweep* sweep, int column, char* value, size_t* tasks)
+ * @brief Finds the tasks with the given value of the string column.
+ *
+ * @return
+ *  Number of matching tasks
+ */
+size_t LRC_sweepSelectString(LRC_configSweep* sweep, int column, char* value, size_t* tasks){
+
+  int* data;
+  int code;
+  size_t i, n = 0;
+
+  if (!sweep || column < 0 || (size_t)column >= sweep->ncolumns) return 0;
+  if (sweep->columns[column].type != LRC_STRING) return 0;
+
+  code = LRC_sweepCode(sweep, value);
+  if (code < 0) return 0;
+
+  data = (int*)sweep->columns[column].data;
+  for (i = 0; i < sweep->ntasks; i++) {
+    if (tasks) tasks[n] = i;
+    n += (data[i] == code);
+  }
+
+  return n;
+}
+
+/**
+ * @fn void LRC_freeSweep(LRC_configSweep* sweep)
+ * @brief Frees the sweep (the base config is not touched).
+ */
+void LRC_freeSweep(LRC_configSweep* sweep){
+
+  size_t i;
+
+  if (!sweep) return;
+
+  for (i = 0; i < sweep->ncolumns; i++) free(sweep->columns[i].data);
+  for (i = 0; i < sweep->nstrings; i++) free(sweep->strings[i]);
+
+  if (sweep->columns) free(sweep->columns);
+  if (sweep->strings) free(sweep->strings);
+  if (sweep->slots) free(sweep->slots);
+  free(sweep);
+}
+
+#if HAVE_HDF5_H
+/**
+ * @fn int LRC_HDF5SweepWriter(hid_t file, char* name, LRC_configSweep* sweep)
+ * @brief Writes the sweep as a single table (one row per task).
+ *
+ * The table is the config/name dataset of compound type, with one field per
+ * column, named namespace.name, of the native type of the column (variable
+ * length strings for string columns).
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_HDF5SweepWriter(hid_t file, char* name, LRC_configSweep* sweep){
+
+  hid_t master_group = -1, dataset = -1, dataspace = -1, row_tid = -1, str_tid = -1, field;
+  hsize_t dims[1];
+  herr_t status;
+  htri_t cctt;
+  size_t* offsets = NULL;
+  size_t rowsize = 0, size, i, t;
+  char* rows = NULL;
+  char field_name[2*LRC_CONFIG_LEN];
+  LRC_sweepColumn* c = NULL;
+
+  if (!sweep) {
+    perror("LRC_HDF5SweepWriter: no sweep assigned");
+    return -1;
+  }
+
+  offsets = malloc((sweep->ncolumns + 1) * sizeof(size_t));
+  if (!offsets) {
+    perror("LRC_HDF5SweepWriter: alloc failed");
+    goto failure;
+  }
+
+  /* Lay out the row, every field aligned to 8 bytes */
+  for (i = 0; i < sweep->ncolumns; i++) {
+    offsets[i] = rowsize;
+    size = sweep->columns[i].type == LRC_STRING ? sizeof(char*) : LRC_sweepElement(sweep->columns[i].type);
+    rowsize += (size + 7) & ~(size_t)7;
+  }
+  if (rowsize == 0) rowsize = 8;
+
+  str_tid = H5Tcopy(H5T_C_S1);
+  status = H5Tset_size(str_tid, H5T_VARIABLE);
+  if (status < 0) goto failure;
+
+  row_tid = H5Tcreate(H5T_COMPOUND, rowsize);
+  if (row_tid < 0) goto failure;
+
+  for (i = 0; i < sweep->ncolumns; i++) {
+    c = &sweep->columns[i];
+    switch (c->type) {
+      case LRC_LONG: field = H5T_NATIVE_LONG; break;
+      case LRC_FLOAT: field = H5T_NATIVE_FLOAT; break;
+      case LRC_DOUBLE: field = H5T_NATIVE_DOUBLE; break;
+      case LRC_STRING: field = str_tid; break;
+      default: field = H5T_NATIVE_INT; break;
+    }
+
+    snprintf(field_name, sizeof(field_name), "%s.%s", c->space->space, c->option->name);
+    status = H5Tinsert(row_tid, field_name, offsets[i], field);
+    if (status < 0) goto failure;
+  }
+
+  rows = calloc(sweep->ntasks > 0 ? sweep->ntasks : 1, rowsize);
+  if (!rows) {
+    perror("LRC_HDF5SweepWriter: alloc failed");
+    goto failure;
+  }
+
+  /* Transpose the columns into rows */
+  for (i = 0; i < sweep->ncolumns; i++) {
+    c = &sweep->columns[i];
+    if (c->type == LRC_STRING) {
+      for (t = 0; t < sweep->ntasks; t++) {
+        *(char**)(rows + t*rowsize + offsets[i]) = sweep->strings[((int*)c->data)[t]];
+      }
+    } else {
+      size = LRC_sweepElement(c->type);
+      for (t = 0; t < sweep->ntasks; t++) {
+        memcpy(rows + t*rowsize + offsets[i], (char*)c->data + t*size, size);
+      }
+    }
+  }
+
+  cctt = H5Lexists(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  if (!cctt) {
+    master_group = H5Gcreate(file, LRC_CONFIG_GROUP, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  } else {
+    master_group = H5Gopen(file, LRC_CONFIG_GROUP, H5P_DEFAULT);
+  }
+  if (master_group < 0) goto failure;
+
+  dims[0] = (hsize_t)sweep->ntasks;
+  dataspace = H5Screate_simple(1, dims, NULL);
+
+  dataset = H5Dcreate(master_group, name, row_tid, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (dataset < 0) goto failure;
+
+  if (sweep->ntasks > 0 && sweep->ncolumns > 0) {
+    status = H5Dwrite(dataset, row_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rows);
+    if (status < 0) goto failure;
+  }
+
+  H5Dclose(dataset);
+  H5Sclose(dataspace);
+  H5Gclose(master_group);
+  H5Tclose(row_tid);
+  H5Tclose(str_tid);
+  free(rows);
+  free(offsets);
+
+  return 0;
+
+failure:
+  if (dataset >= 0) H5Dclose(dataset);
+  if (dataspace >= 0) H5Sclose(dataspace);
+  if (master_group >= 0) H5Gclose(master_group);
+  if (row_tid >= 0) H5Tclose(row_tid);
+  if (str_tid >= 0) H5Tclose(str_tid);
+  if (rows) free(rows);
+  if (offsets) free(offsets);
+  return -1;
+}
+#endif
+
+/**
+ * @fn int LRC_sweepDecimals(char* str)
+ * @brief Number of decimal places of the plain decimal number.
+ *
+ * @return
+ *  The number of decimal places or -1 if the number has the exponent
+ */
+int LRC_sweepDecimals(char* str){
+
+  char* dot;
+
+  if (strpbrk(str, "eExXpP")) return -1;
+
+  dot = strchr(str, '.');
+  if (!dot) return 0;
+
+  return (int)strspn(dot + 1, "0123456789");
+}
+
+/**
+ * @fn int LRC_sweepParse(LRC_configOptions* option, LRC_sweepDimension* dim)
+ * @brief Checks if the value of the option is the range or the list syntax.
+ *
+ * The range is start:stop[:step] (numeric options only, the stop is included if
+ * reached, the default step is 1). The list is {a, b, ...}.
+ *
+ * @return
+ *  1 if the value is a sweep dimension, 0 if not, -1 if the syntax is wrong
+ */
+int LRC_sweepParse(LRC_configOptions* option, LRC_sweepDimension* dim){
+
+  char text[LRC_CONFIG_LEN];
+  char* parts[3];
+  char* item;
+  char* p;
+  size_t len, n;
+  double x;
+  int k, i, numeric, status, decimals;
+
+  numeric = option->type == LRC_INT || option->type == LRC_LONG || option->type == LRC_VAL
+    || option->type == LRC_FLOAT || option->type == LRC_DOUBLE;
+
+  memset(dim, 0, sizeof(LRC_sweepDimension));
+  strcpy(text, option->value);
+  len = strlen(text);
+
+  if (len >= 2 && text[0] == '{' && text[len-1] == '}' && !LRC_isArray(option->type)) {
+
+    /* The list */
+    text[len-1] = LRC_NULL;
+    n = 1;
+    for (p = text + 1; *p; p++) if (*p == ',') n++;
+
+    dim->items = calloc(n, sizeof(char*));
+    if (!dim->items) {
+      perror("LRC_sweepParse: alloc failed");
+      return -1;
+    }
+
+    dim->kind = LRC_SWEEP_LIST;
+    item = text + 1;
+    for (i = 0; i < (int)n; i++) {
+      p = strchr(item, ',');
+      if (p) *p = LRC_NULL;
+      item = LRC_trim(item);
+
+      if (item[0] == LRC_NULL) goto failure;
+      if (numeric) {
+        if (option->type == LRC_INT || option->type == LRC_VAL) {
+          status = LRC_str2int(item, &k);
+        } else {
+          status = LRC_str2double(item, &x);
+        }
+        if (status != LRC_NUMBER_OK) goto failure;
+      }
+
+      dim->items[i] = malloc(strlen(item) + 1);
+      if (!dim->items[i]) {
+        perror("LRC_sweepParse: alloc failed");
+        goto failure;
+      }
+      strcpy(dim->items[i], item);
+      dim->count++;
+
+      if (p) item = p + 1;
+    }
+
+    return 1;
+  }
+
+  if (!numeric || !strchr(text, ':')) return 0;
+
+  /* The range */
+  n = 0;
+  parts[0] = text;
+  for (p = text; *p; p++) {
+    if (*p != ':') continue;
+    if (++n > 2) return -1;
+    *p = LRC_NULL;
+    parts[n] = p + 1;
+  }
+
+  dim->kind = LRC_SWEEP_RANGE;
+  dim->step = 1.0;
+
+  if (LRC_str2double(LRC_trim(parts[0]), &dim->start) != LRC_NUMBER_OK) return -1;
+  if (LRC_str2double(LRC_trim(parts[1]), &dim->stop) != LRC_NUMBER_OK) return -1;
+  if (n == 2 && LRC_str2double(LRC_trim(parts[2]), &dim->step) != LRC_NUMBER_OK) return -1;
+
+  if (dim->step == 0.0 || !isfinite(dim->start) || !isfinite(dim->stop)) return -1;
+
+  /* Values of decimal ranges are rounded to the decimal places of the bounds,
+   * so that 0.1:0.3:0.1 gives 0.3, not 0.30000000000000004 */
+  decimals = LRC_sweepDecimals(parts[0]);
+  k = (n == 2) ? LRC_sweepDecimals(parts[2]) : 0;
+  if (k > decimals || k < 0) decimals = k;
+  if (decimals >= 0 && decimals <= 15) dim->scale = pow(10.0, decimals);
+
+  x = (dim->stop - dim->start) / dim->step;
+  if (x < 0) return -1;
+
+  if (option->type == LRC_INT || option->type == LRC_LONG || option->type == LRC_VAL) {
+    if (dim->start != floor(dim->start) || dim->step != floor(dim->step)) return -1;
+    x = floor(x);
+  } else {
+    /* Tolerate the rounding of the decimal bounds */
+    x = floor(x * (1.0 + 1e-12) + 1e-12);
+  }
+
+  if (x >= (double)SIZE_MAX) return -1;
+  dim->count = (size_t)x + 1;
+
+  return 1;
+
+failure:
+  for (i = 0; i < (int)dim->count; i++) free(dim->items[i]);
+  free(dim->items);
+  dim->items = NULL;
+  return -1;
+}
+
+/**
+ * @fn LRC_sweepIterator* LRC_newSweepIterator(LRC_configIndex* base)
+ * @brief Creates the iterator over the Cartesian product of the sweep
+ * dimensions of the config.
+ *
+ * Every option of the base config with the range (xres = 100:2000:10) or the
+ * list (epoch = {2003.0, 2507.23}) value is a dimension. Tasks are never
+ * expanded in memory: the task index is decomposed into the index of every
+ * dimension (the last dimension changes fastest), so any task is reached
+ * directly.
+ *
+ * @param base
+ *   The index of the base config, see LRC_indexConfig().
+ *
+ * @return
+ *  The iterator or NULL on failure (wrong syntax, or the number of tasks does
+ *  not fit size_t)
+ */
+LRC_sweepIterator* LRC_newSweepIterator(LRC_configIndex* base){
+
+  LRC_sweepIterator* it = NULL;
+  LRC_sweepDimension* dims = NULL;
+  LRC_sweepDimension dim;
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* currentOP = NULL;
+  int status;
+
+  if (!base) {
+    perror("LRC_newSweepIterator: no config assigned");
+    return NULL;
+  }
+
+  it = calloc(1, sizeof(LRC_sweepIterator));
+  if (!it) {
+    perror("LRC_newSweepIterator: alloc failed");
+    return NULL;
+  }
+
+  it->base = base;
+  it->ntasks = 1;
+
+  for (current = base->head; current; current = current->next) {
+    for (currentOP = current->options; currentOP; currentOP = currentOP->next) {
+      status = LRC_sweepParse(currentOP, &dim);
+      if (status == 0) continue;
+      if (status < 0) {
+        LRC_message(0, LRC_ERR_WRONG_INPUT, currentOP->name);
+        goto failure;
+      }
+
+      dims = realloc(it->dims, (it->ndims + 1) * sizeof(LRC_sweepDimension));
+      if (!dims) {
+        perror("LRC_newSweepIterator: alloc failed");
+        goto failure;
+      }
+
+      it->dims = dims;
+      dim.space = current;
+      dim.option = currentOP;
+      it->dims[it->ndims++] = dim;
+
+      if (it->ntasks > SIZE_MAX / dim.count) {
+        LRC_message(0, LRC_ERR_WRONG_INPUT, "Too many tasks");
+        goto failure;
+      }
+      it->ntasks *= dim.count;
+    }
+  }
+
+  it->view = LRC_newOverlay(base);
+  if (!it->view) goto failure;
+
+  return it;
+
+failure:
+  LRC_freeSweepIterator(it);
+  return NULL;
+}
+
+/**
+ * @fn int LRC_sweepValue(LRC_sweepIterator* it, size_t task, size_t dim, char* str)
+ * @brief Formats the value of the dimension for the task (str holds at least
+ * LRC_CONFIG_LEN bytes).
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_sweepValue(LRC_sweepIterator* it, size_t task, size_t dim, char* str){
+
+  LRC_sweepDimension* d = NULL;
+  size_t i, k;
+  double x;
+
+  if (!it || task >= it->ntasks || dim >= it->ndims) return -1;
+
+  /* Index of the dimension, the last one changes fastest */
+  for (i = it->ndims - 1; i > dim; i--) task /= it->dims[i].count;
+  k = task % it->dims[dim].count;
+
+  d = &it->dims[dim];
+
+  if (d->kind == LRC_SWEEP_LIST) {
+    strcpy(str, d->items[k]);
+    return 0;
+  }
+
+  x = d->start + (double)k * d->step;
+  if (d->scale > 0) x = round(x * d->scale) / d->scale;
+
+  switch (d->option->type) {
+    case LRC_FLOAT:
+      LRC_float2str(str, (float)x);
+      break;
+    case LRC_DOUBLE:
+      LRC_double2str(str, x);
+      break;
+    default:
+      sprintf(str, "%.0f", x);
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * @fn LRC_configOverlay* LRC_sweepSeek(LRC_sweepIterator* it, size_t task)
+ * @brief Moves the iterator to the task and returns its config.
+ *
+ * @return
+ *  The config of the task, owned by the iterator and valid until the next
+ *  call, or NULL if the task does not exist
+ */
+LRC_configOverlay* LRC_sweepSeek(LRC_sweepIterator* it, size_t task){
+
+  char value[LRC_CONFIG_LEN];
+  size_t i;
+
+  if (!it || task >= it->ntasks) return NULL;
+
+  for (i = 0; i < it->ndims; i++) {
+    LRC_sweepValue(it, task, i, value);
+    if (LRC_overlaySet(it->view, it->dims[i].space->space, it->dims[i].option->name,
+          value, it->dims[i].option->type) < 0) return NULL;
+  }
+
+  it->task = task + 1;
+
+  return it->view;
+}
+
+/**
+ * @fn LRC_configOverlay* LRC_sweepNext(LRC_sweepIterator* it)
+ * @brief The config of the next task.
+ *
+ * Iterates from the task of the last LRC_sweepSeek() (or from the first one).
+ * To split the tasks between MPI ranks, seek to the first task of the rank and
+ * call LRC_sweepNext() for the rest of its slice.
+ *
+ * @return
+ *  The config of the task, owned by the iterator and valid until the next
+ *  call, or NULL after the last task
+ */
+LRC_configOverlay* LRC_sweepNext(LRC_sweepIterator* it){
+
+  if (!it) return NULL;
+
+  return LRC_sweepSeek(it, it->task);
+}
+
+/**
+ * @fn LRC_configSweep* LRC_sweepExpand(LRC_sweepIterator* it, size_t first, size_t count)
+ * @brief Stores the slice of tasks in the columnar store.
+ *
+ * @return
+ *  The sweep of count tasks (one column per dimension) or NULL on failure
+ */
+LRC_configSweep* LRC_sweepExpand(LRC_sweepIterator* it, size_t first, size_t count){
+
+  LRC_configSweep* sweep = NULL;
+  char value[LRC_CONFIG_LEN];
+  size_t i, t;
+  int c;
+
+  if (!it || first > it->ntasks || count > it->ntasks - first) return NULL;
+
+  sweep = LRC_newSweep(it->base, count);
+  if (!sweep) return NULL;
+
+  for (i = 0; i < it->ndims; i++) {
+    c = LRC_sweepAddColumn(sweep, it->dims[i].space->space, it->dims[i].option->name);
+    if (c < 0) goto failure;
+
+    for (t = 0; t < count; t++) {
+      LRC_sweepValue(it, first + t, i, value);
+      if (LRC_sweepSet(sweep, t, c, value) < 0) goto failure;
+    }
+  }
+
+  return sweep;
+
+failure:
+  LRC_freeSweep(sweep);
+  return NULL;
+}
+
+/**
+ * @fn void LRC_freeSweepIterator(LRC_sweepIterator* it)
+ * @brief Frees the iterator (the base config is not touched).
+ */
+void LRC_freeSweepIterator(LRC_sweepIterator* it){
+
+  size_t i, k;
+
+  if (!it) return;
+
+  for (i = 0; i < it->ndims; i++) {
+    for (k = 0; k < it->dims[i].count && it->dims[i].items; k++) free(it->dims[i].items[k]);
+    if (it->dims[i].items) free(it->dims[i].items);
+  }
+
+  if (it->dims) free(it->dims);
+  LRC_freeOverlay(it->view);
+  free(it);
+}
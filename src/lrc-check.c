@@ -0,0 +1,860 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file lrc-check.c
+ * @brief Parallel validator of config files.
+ *
+ * Validates many config files against the defaults schema (see
+ * LRC_readDefaults()) on all cores:
+ *
+ *     lrc-check [-j threads] [-l list] [-s sep] [-c comm] [-m limit] [-q] schema [file|pattern]...
+ *
+ * The files are given as arguments, as quoted glob patterns (expanded here,
+ * so that 10^5 files do not hit the limit of the command line), or one per
+ * line in the list file (- for stdin).
+ *
+ * Each worker takes batches of files from the shared queue and reads the
+ * whole batch with one lio_listio() call. The next batch is submitted before
+ * the current one is parsed, so the reads overlap the parsing. The worker
+ * keeps one config tree (the defaults) for all its files and parses them with
+ * the reentrant LRC_ASCIIParser() in the collect mode. The values read are
+ * then checked against the types of the schema.
+ *
+ * All errors of a file are reported (up to the limit), sorted by line, as
+ *
+ *     path:line:column: message (namespace.name)
+ *
+ * in the order of the files, with "path: OK" for the valid ones (unless -q).
+ * The exit status is 0 if all files are valid, 1 if some are not and 2 on
+ * usage errors.
+ */
+
+/* pthreads, POSIX AIO, glob, fmemopen and open_memstream */
+#define _POSIX_C_SOURCE 200809L
+
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+#include <pthread.h>
+#include <aio.h>
+#include <glob.h>
+#include <sys/resource.h>
+
+/**
+ * @def LRC_CHECK_BATCH
+ * @brief Maximum number of files read with one lio_listio() call.
+ *
+ * @def LRC_CHECK_LIMIT
+ * @brief Default number of errors reported per file.
+ */
+#define LRC_CHECK_BATCH 64
+#define LRC_CHECK_LIMIT 10
+
+/**
+ * @var typedef struct LRC_checkFile
+ * @brief The file and the result of the check
+ */
+typedef struct{
+  char* path;
+  char* report;
+  int errors;
+} LRC_checkFile;
+
+/**
+ * @var typedef struct LRC_checkRead
+ * @brief Pending read of the file
+ */
+typedef struct{
+  LRC_checkFile* file;
+  char* data;
+  size_t size;
+  int fd;
+  int error;
+  int queued;
+  struct aiocb cb;
+} LRC_checkRead;
+
+/**
+ * @var typedef struct LRC_checkJob
+ * @brief The queue of the files, shared by the workers
+ */
+typedef struct{
+  LRC_checkFile* files;
+  size_t nfiles;
+  size_t next;
+  size_t batch;
+  pthread_mutex_t lock;
+  LRC_configDefaults* cd;
+  char* sep;
+  char* comm;
+  int limit;
+} LRC_checkJob;
+
+/**
+ * @var typedef struct LRC_checkEntry
+ * @brief Position of the error and of its line in the report
+ */
+typedef struct{
+  int line;
+  int column;
+  size_t seq;
+  long start;
+  long end;
+} LRC_checkEntry;
+
+/**
+ * @var typedef struct LRC_checkLog
+ * @brief The errors of the file, sorted by line before they are reported
+ */
+typedef struct{
+  FILE* out;
+  LRC_checkEntry* entries;
+  size_t n;
+  size_t size;
+} LRC_checkLog;
+
+/**
+ * @fn void LRC_checkDiagnostic(LRC_diagnostic* d, void* data)
+ * @brief Prints the error as path:line:column: message (namespace.name).
+ */
+void LRC_checkDiagnostic(LRC_diagnostic* d, void* data){
+
+  LRC_checkLog* log = (LRC_checkLog*)data;
+  LRC_checkEntry* tmp = NULL;
+  FILE* out = log->out;
+  long start;
+
+  start = ftell(out);
+
+  fprintf(out, "%s:", d->file ? d->file : "");
+  if (d->line > 0) fprintf(out, "%d:", d->line);
+  if (d->line > 0 && d->column > 0) fprintf(out, "%d:", d->column);
+  fprintf(out, " %s", d->message);
+
+  if (d->name) {
+    fprintf(out, " (%s%s%s)", d->space ? d->space : "", d->space ? "." : "", d->name);
+  } else if (d->space) {
+    fprintf(out, " ([%s])", d->space);
+  }
+
+  fprintf(out, "\n");
+
+  if (log->n == log->size) {
+    log->size = log->size ? 2 * log->size : 16;
+    tmp = realloc(log->entries, log->size * sizeof(LRC_checkEntry));
+    if (!tmp) {
+      perror("lrc-check: alloc failed");
+      exit(2);
+    }
+    log->entries = tmp;
+  }
+
+  log->entries[log->n].line = d->line;
+  log->entries[log->n].column = d->column;
+  log->entries[log->n].seq = log->n;
+  log->entries[log->n].start = start;
+  log->entries[log->n].end = ftell(out);
+  log->n++;
+}
+
+/**
+ * @fn int LRC_checkOrder(const void* a, const void* b)
+ * @brief Orders the errors by line and column, then as reported.
+ */
+int LRC_checkOrder(const void* a, const void* b){
+
+  const LRC_checkEntry* x = (const LRC_checkEntry*)a;
+  const LRC_checkEntry* y = (const LRC_checkEntry*)b;
+
+  if (x->line != y->line) return x->line < y->line ? -1 : 1;
+  if (x->column != y->column) return x->column < y->column ? -1 : 1;
+  if (x->seq != y->seq) return x->seq < y->seq ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @fn char* LRC_checkSort(LRC_checkLog* log, char* report, size_t* len, char* path, int limit)
+ * @brief Sorts the errors of the report by line and applies the limit.
+ *
+ * The parse errors and the type errors are found in two passes, so they are
+ * limited here, after sorting, and not by the diagnostics of the config.
+ *
+ * @return
+ *  The new report (the old one is freed), NULL on failure
+ */
+char* LRC_checkSort(LRC_checkLog* log, char* report, size_t* len, char* path, int limit){
+
+  char* sorted = NULL;
+  size_t i, n, k = 0, size;
+
+  n = log->n;
+  if (limit > 0 && n > (size_t)limit) n = (size_t)limit;
+
+  size = *len + strlen(path) + strlen(LRC_MSG_LIMIT) + 8;
+  sorted = malloc(size);
+  if (!sorted) {
+    perror("lrc-check: alloc failed");
+    free(report);
+    return NULL;
+  }
+
+  qsort(log->entries, log->n, sizeof(LRC_checkEntry), LRC_checkOrder);
+
+  for (i = 0; i < n; i++) {
+    memcpy(sorted + k, report + log->entries[i].start,
+        (size_t)(log->entries[i].end - log->entries[i].start));
+    k += (size_t)(log->entries[i].end - log->entries[i].start);
+  }
+
+  if (n < log->n) k += (size_t)snprintf(sorted + k, size - k, "%s: %s\n", path, LRC_MSG_LIMIT);
+  sorted[k] = LRC_NULL;
+
+  free(report);
+  *len = k;
+  return sorted;
+}
+
+/**
+ * @fn int LRC_checkGroup(LRC_configDefaults* cd, int n)
+ * @brief Groups the options by namespace, as LRC_assignDefaults() expects.
+ *
+ * The namespaces and the options keep the order of the first appearance.
+ *
+ * @return
+ *  0 on success, -1 on failure
+ */
+int LRC_checkGroup(LRC_configDefaults* cd, int n){
+
+  LRC_configDefaults* out = NULL;
+  char* done = NULL;
+  int i, j, k = 0;
+
+  out = malloc((n + 1) * sizeof(LRC_configDefaults));
+  done = calloc(n + 1, sizeof(char));
+  if (!out || !done) {
+    perror("lrc-check: alloc failed");
+    if (out) free(out);
+    if (done) free(done);
+    return -1;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (done[i]) continue;
+    for (j = i; j < n; j++) {
+      if (done[j] || strcmp(cd[j].space, cd[i].space) != 0) continue;
+      out[k++] = cd[j];
+      done[j] = 1;
+    }
+  }
+
+  memcpy(cd, out, n * sizeof(LRC_configDefaults));
+
+  free(out);
+  free(done);
+  return 0;
+}
+
+/**
+ * @fn size_t LRC_checkClaim(LRC_checkJob* job, LRC_checkFile** files)
+ * @brief Takes the next batch of files from the queue.
+ *
+ * @return
+ *  Number of files in the batch, 0 if the queue is empty
+ */
+size_t LRC_checkClaim(LRC_checkJob* job, LRC_checkFile** files){
+
+  size_t n;
+
+  pthread_mutex_lock(&job->lock);
+  n = job->nfiles - job->next;
+  if (n > job->batch) n = job->batch;
+  *files = job->files + job->next;
+  job->next += n;
+  pthread_mutex_unlock(&job->lock);
+
+  return n;
+}
+
+/**
+ * @fn void LRC_checkSubmit(LRC_checkRead* reads, LRC_checkFile* files, size_t n)
+ * @brief Opens the files of the batch and submits all reads at once.
+ *
+ * The files that are not regular (pipes, devices) are left to the stdio
+ * reader. The errors are kept for the report.
+ */
+void LRC_checkSubmit(LRC_checkRead* reads, LRC_checkFile* files, size_t n){
+
+  struct aiocb* list[LRC_CHECK_BATCH];
+  struct stat st;
+  size_t i;
+  int nlist = 0;
+
+  for (i = 0; i < n; i++) {
+    memset(&reads[i], 0, sizeof(LRC_checkRead));
+    reads[i].file = &files[i];
+    reads[i].fd = open(files[i].path, O_RDONLY);
+
+    if (reads[i].fd < 0) {
+      reads[i].error = errno;
+      continue;
+    }
+
+    if (fstat(reads[i].fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      close(reads[i].fd);
+      reads[i].fd = -1;
+      continue;
+    }
+
+    reads[i].size = (size_t)st.st_size;
+    reads[i].data = malloc(reads[i].size + 1);
+    if (!reads[i].data) {
+      reads[i].error = errno;
+      continue;
+    }
+
+    if (reads[i].size == 0) continue;
+
+    reads[i].cb.aio_fildes = reads[i].fd;
+    reads[i].cb.aio_buf = reads[i].data;
+    reads[i].cb.aio_nbytes = reads[i].size;
+    reads[i].cb.aio_offset = 0;
+    reads[i].cb.aio_lio_opcode = LIO_READ;
+    reads[i].cb.aio_sigevent.sigev_notify = SIGEV_NONE;
+    reads[i].queued = 1;
+    list[nlist++] = &reads[i].cb;
+  }
+
+  /* On failure the status of each read is checked in LRC_checkFinish() */
+  if (nlist > 0) lio_listio(LIO_NOWAIT, list, nlist, NULL);
+}
+
+/**
+ * @fn ssize_t LRC_checkWait(LRC_checkRead* read)
+ * @brief Waits for the read of the file.
+ *
+ * The reads that could not be queued are finished here, with pread().
+ *
+ * @return
+ *  Number of bytes read or -1 on failure (errno is set)
+ */
+ssize_t LRC_checkWait(LRC_checkRead* read){
+
+  const struct aiocb* list[1];
+  ssize_t got;
+  size_t done = 0;
+  int status;
+
+  list[0] = &read->cb;
+  while ((status = aio_error(&read->cb)) == EINPROGRESS) aio_suspend(list, 1, NULL);
+
+  /* The rest of a short read, or all of a read that was not queued */
+  got = aio_return(&read->cb);
+  if (status == 0 && got > 0) done = (size_t)got;
+
+  while (done < read->size) {
+    got = pread(read->fd, read->data + done, read->size - done, (off_t)done);
+    if (got < 0 && errno == EINTR) continue;
+    if (got < 0) return -1;
+    if (got == 0) break;
+    done += (size_t)got;
+  }
+
+  return (ssize_t)done;
+}
+
+/**
+ * @fn ssize_t LRC_checkSlurp(LRC_checkRead* read)
+ * @brief Reads the file that is not regular (pipe, device) with stdio.
+ *
+ * @return
+ *  Number of bytes read, -1 on failure (errno is kept for the report)
+ */
+ssize_t LRC_checkSlurp(LRC_checkRead* read){
+
+  FILE* in = NULL;
+  char* tmp = NULL;
+  size_t len = 0, got;
+
+  in = fopen(read->file->path, "r");
+  if (!in) {
+    read->error = errno;
+    return -1;
+  }
+
+  read->size = 4096;
+  read->data = malloc(read->size);
+
+  while (read->data) {
+    got = fread(read->data + len, 1, read->size - len, in);
+    len += got;
+    if (len < read->size) break;
+    read->size *= 2;
+    tmp = realloc(read->data, read->size);
+    if (!tmp) free(read->data);
+    read->data = tmp;
+  }
+
+  if (!read->data) read->error = ENOMEM;
+  else if (ferror(in)) read->error = errno ? errno : EIO;
+  fclose(in);
+
+  return read->error ? -1 : (ssize_t)len;
+}
+
+/**
+ * @fn int LRC_checkTypes(LRC_configNamespace* head, char* data, size_t len)
+ * @brief Checks the values read from the file against the types of the schema.
+ *
+ * The parser stores the scalar values as text, they are converted only by
+ * the getters. The position of the value is found in the data of the file.
+ *
+ * @return
+ *  Number of wrong values
+ */
+int LRC_checkTypes(LRC_configNamespace* head, char* data, size_t len){
+
+  LRC_configNamespace* current = NULL;
+  LRC_configOptions* option = NULL;
+  size_t i;
+  int status, errors = 0, line, column, k;
+  long l;
+  float f;
+  double d;
+
+  for (current = head; current; current = current->next) {
+    for (option = current->options; option; option = option->next) {
+      if (option->length == 0) continue;
+
+      switch (option->type) {
+        case LRC_INT:
+        case LRC_VAL:
+          status = LRC_str2int(option->value, &k);
+          break;
+        case LRC_LONG:
+          status = LRC_str2long(option->value, &l);
+          break;
+        case LRC_FLOAT:
+          status = LRC_str2float(option->value, &f);
+          break;
+        case LRC_DOUBLE:
+          status = LRC_str2double(option->value, &d);
+          break;
+        default:
+          status = LRC_NUMBER_OK;
+          break;
+      }
+
+      if (status == LRC_NUMBER_OK) continue;
+
+      line = 0;
+      column = 0;
+      if (data && (size_t)option->offset <= len) {
+        line = 1;
+        column = 1;
+        for (i = 0; i < (size_t)option->offset; i++) {
+          column++;
+          if (data[i] == '\n') {
+            line++;
+            column = 1;
+          }
+        }
+      }
+
+      LRC_report(head, LRC_ERR_CONFIG_SYNTAX, line, column, current->space, option->name,
+          LRC_MSG_WRONG_INPUT);
+      errors++;
+    }
+  }
+
+  return errors;
+}
+
+/**
+ * @fn void LRC_checkFinish(LRC_checkJob* job, LRC_configNamespace* head, LRC_checkRead* reads, size_t n)
+ * @brief Parses the files of the batch and keeps the reports.
+ */
+void LRC_checkFinish(LRC_checkJob* job, LRC_configNamespace* head, LRC_checkRead* reads, size_t n){
+
+  LRC_configDiag* diag = NULL;
+  LRC_checkFile* file = NULL;
+  LRC_checkLog log = {NULL, NULL, 0, 0};
+  FILE* out = NULL;
+  FILE* in = NULL;
+  char* report = NULL;
+  size_t len = 0, i;
+  ssize_t got = 0;
+
+  for (i = 0; i < n; i++) {
+    file = reads[i].file;
+
+    if (reads[i].queued) {
+      got = LRC_checkWait(&reads[i]);
+      if (got < 0) reads[i].error = errno;
+    } else if (!reads[i].error && !reads[i].data) {
+      got = LRC_checkSlurp(&reads[i]);
+    } else {
+      got = 0;
+    }
+
+    report = NULL;
+    len = 0;
+    out = open_memstream(&report, &len);
+    log.out = out;
+    log.n = 0;
+    if (!out || LRC_setDiagnostics(head, LRC_checkDiagnostic, &log, 0, LRC_DIAG_COLLECT) < 0) {
+      perror("lrc-check: alloc failed");
+      if (out) fclose(out);
+      if (report) free(report);
+      goto next;
+    }
+
+    diag = LRC_diagOf(head);
+    diag->file = file->path;
+
+    if (reads[i].error) {
+      fprintf(out, "%s: %s\n", file->path, strerror(reads[i].error));
+      file->errors = 1;
+    } else if (got > 0) {
+      in = fmemopen(reads[i].data, (size_t)got, "r");
+      if (in) {
+        LRC_ASCIIParser(in, job->sep, job->comm, head);
+        fclose(in);
+        LRC_checkTypes(head, reads[i].data, (size_t)got);
+        file->errors = LRC_diagnosticCount(head);
+      } else {
+        fprintf(out, "%s: %s\n", file->path, strerror(errno));
+        file->errors = 1;
+      }
+    } else {
+      file->errors = 0;
+    }
+
+    diag->file = NULL;
+
+    LRC_setDiagnostics(head, NULL, NULL, 0, 0);
+    fclose(out);
+
+    /* The type errors are found after the parse errors */
+    if (log.n > 0) report = LRC_checkSort(&log, report, &len, file->path, job->limit);
+
+    if (report && len > 0) {
+      file->report = report;
+    } else {
+      free(report);
+    }
+
+next:
+    if (reads[i].fd >= 0) close(reads[i].fd);
+    if (reads[i].data) free(reads[i].data);
+  }
+
+  if (log.entries) free(log.entries);
+}
+
+/**
+ * @fn void* LRC_checkWorker(void* arg)
+ * @brief Checks the batches of files until the queue is empty.
+ */
+void* LRC_checkWorker(void* arg){
+
+  LRC_checkJob* job = (LRC_checkJob*)arg;
+  LRC_configNamespace* head = NULL;
+  LRC_checkRead* reads[2] = {NULL, NULL};
+  LRC_checkFile* files = NULL;
+  size_t n[2] = {0, 0};
+  int current = 0;
+
+  head = LRC_assignDefaults(job->cd);
+  reads[0] = malloc(job->batch * sizeof(LRC_checkRead));
+  reads[1] = malloc(job->batch * sizeof(LRC_checkRead));
+
+  if (!head || !reads[0] || !reads[1]) {
+    perror("lrc-check: alloc failed");
+    goto finalize;
+  }
+
+  n[current] = LRC_checkClaim(job, &files);
+  LRC_checkSubmit(reads[current], files, n[current]);
+
+  /* The next batch is read while the current one is parsed */
+  while (n[current] > 0) {
+    n[!current] = LRC_checkClaim(job, &files);
+    LRC_checkSubmit(reads[!current], files, n[!current]);
+
+    LRC_checkFinish(job, head, reads[current], n[current]);
+    current = !current;
+  }
+
+finalize:
+  if (head) LRC_cleanup(head);
+  if (reads[0]) free(reads[0]);
+  if (reads[1]) free(reads[1]);
+
+  return NULL;
+}
+
+/**
+ * @fn int LRC_checkAdd(LRC_checkFile** files, size_t* n, size_t* size, char* path)
+ * @brief Adds the file to the queue.
+ *
+ * @return
+ *  0 on success, -1 on failure
+ */
+int LRC_checkAdd(LRC_checkFile** files, size_t* n, size_t* size, char* path){
+
+  LRC_checkFile* tmp = NULL;
+
+  if (*n == *size) {
+    *size = *size ? 2 * *size : 1024;
+    tmp = realloc(*files, *size * sizeof(LRC_checkFile));
+    if (!tmp) {
+      perror("lrc-check: alloc failed");
+      return -1;
+    }
+    *files = tmp;
+  }
+
+  (*files)[*n].path = strdup(path);
+  (*files)[*n].report = NULL;
+  (*files)[*n].errors = -1;
+  if (!(*files)[*n].path) {
+    perror("lrc-check: alloc failed");
+    return -1;
+  }
+
+  (*n)++;
+  return 0;
+}
+
+/**
+ * @fn int LRC_checkList(LRC_checkFile** files, size_t* n, size_t* size, char* path)
+ * @brief Adds the files listed one per line (- for stdin).
+ *
+ * @return
+ *  0 on success, -1 on failure
+ */
+int LRC_checkList(LRC_checkFile** files, size_t* n, size_t* size, char* path){
+
+  FILE* list = NULL;
+  char* line = NULL;
+  size_t lsize = 0;
+  ssize_t nread;
+  int status = 0;
+
+  list = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+  if (!list) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, path);
+    return -1;
+  }
+
+  while ((nread = getline(&line, &lsize, list)) >= 0) {
+    while (nread > 0 && (line[nread-1] == '\n' || line[nread-1] == '\r')) line[--nread] = LRC_NULL;
+    if (nread == 0) continue;
+
+    status = LRC_checkAdd(files, n, size, line);
+    if (status < 0) break;
+  }
+
+  if (line) free(line);
+  if (list != stdin) fclose(list);
+
+  return status;
+}
+
+/**
+ * @fn int LRC_checkPattern(LRC_checkFile** files, size_t* n, size_t* size, char* pattern)
+ * @brief Adds the files matching the pattern (the pattern itself, if none).
+ *
+ * @return
+ *  0 on success, -1 on failure
+ */
+int LRC_checkPattern(LRC_checkFile** files, size_t* n, size_t* size, char* pattern){
+
+  glob_t g;
+  size_t i;
+  int status = 0;
+
+  if (!strpbrk(pattern, "*?[")) return LRC_checkAdd(files, n, size, pattern);
+
+  if (glob(pattern, GLOB_NOCHECK, NULL, &g) != 0) {
+    fprintf(stderr, "lrc-check: cannot expand %s\n", pattern);
+    return -1;
+  }
+
+  for (i = 0; i < g.gl_pathc && status == 0; i++) {
+    status = LRC_checkAdd(files, n, size, g.gl_pathv[i]);
+  }
+
+  globfree(&g);
+  return status;
+}
+
+/**
+ * @fn void LRC_checkUsage(char* name)
+ * @brief Prints the usage.
+ */
+void LRC_checkUsage(char* name){
+  fprintf(stderr, "Usage: %s [-j threads] [-l list] [-s sep] [-c comm] [-m limit] [-q] "
+      "schema [file|pattern]...\n", name);
+}
+
+int main(int argc, char** argv){
+
+  LRC_checkJob job;
+  LRC_checkFile* files = NULL;
+  pthread_t* threads = NULL;
+  struct rlimit rl;
+  FILE* in = NULL;
+  size_t n = 0, size = 0, failed = 0, i;
+  long nthreads = 0, started = 0, fds;
+  int quiet = 0, status = 2, c;
+
+  memset(&job, 0, sizeof(LRC_checkJob));
+  job.sep = "=";
+  job.comm = "#";
+  job.limit = LRC_CHECK_LIMIT;
+
+  while ((c = getopt(argc, argv, "j:l:s:c:m:q")) != -1) {
+    switch (c) {
+      case 'j':
+        nthreads = atol(optarg);
+        break;
+      case 'l':
+        if (LRC_checkList(&files, &n, &size, optarg) < 0) goto finalize;
+        break;
+      case 's':
+        job.sep = optarg;
+        break;
+      case 'c':
+        job.comm = optarg;
+        break;
+      case 'm':
+        job.limit = atoi(optarg);
+        break;
+      case 'q':
+        quiet = 1;
+        break;
+      default:
+        LRC_checkUsage(argv[0]);
+        goto finalize;
+    }
+  }
+
+  if (optind >= argc) {
+    LRC_checkUsage(argv[0]);
+    goto finalize;
+  }
+
+  in = fopen(argv[optind], "r");
+  if (!in) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, argv[optind]);
+    goto finalize;
+  }
+
+  c = LRC_readDefaults(in, &job.cd);
+  fclose(in);
+  if (c < 0 || LRC_checkGroup(job.cd, c) < 0) goto finalize;
+
+  if (c == 0) {
+    fprintf(stderr, "%s: no options in %s\n", argv[0], argv[optind]);
+    goto finalize;
+  }
+
+  for (i = (size_t)optind + 1; i < (size_t)argc; i++) {
+    if (LRC_checkPattern(&files, &n, &size, argv[i]) < 0) goto finalize;
+  }
+
+  if (nthreads <= 0) nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (nthreads <= 0) nthreads = 1;
+  if ((size_t)nthreads > n) nthreads = n > 0 ? (long)n : 1;
+
+  /* Two batches of open files per worker */
+  job.batch = LRC_CHECK_BATCH;
+  if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY) {
+    fds = ((long)rl.rlim_cur - 32) / (2 * nthreads);
+    if (fds < (long)job.batch) job.batch = fds > 0 ? (size_t)fds : 1;
+  }
+
+  job.files = files;
+  job.nfiles = n;
+  pthread_mutex_init(&job.lock, NULL);
+
+  threads = malloc(nthreads * sizeof(pthread_t));
+  if (!threads) {
+    perror("lrc-check: alloc failed");
+    goto finalize;
+  }
+
+  for (started = 0; started < nthreads; started++) {
+    if (pthread_create(&threads[started], NULL, LRC_checkWorker, &job) != 0) break;
+  }
+
+  /* Without any worker, the files are checked here */
+  if (started == 0) LRC_checkWorker(&job);
+
+  for (c = 0; c < started; c++) pthread_join(threads[c], NULL);
+  pthread_mutex_destroy(&job.lock);
+
+  for (i = 0; i < n; i++) {
+    if (files[i].report) fputs(files[i].report, stdout);
+
+    if (files[i].errors < 0) {
+      printf("%s: not checked\n", files[i].path);
+    } else if (files[i].errors == 0 && !quiet) {
+      printf("%s: OK\n", files[i].path);
+    }
+
+    if (files[i].errors != 0) failed++;
+  }
+
+  fflush(stdout);
+  fprintf(stderr, "lrc-check: %zu files, %zu failed\n", n, failed);
+
+  status = failed > 0 ? 1 : 0;
+
+finalize:
+  for (i = 0; i < n; i++) {
+    free(files[i].path);
+    if (files[i].report) free(files[i].report);
+  }
+  if (files) free(files);
+  if (threads) free(threads);
+  if (job.cd) free(job.cd);
+
+  return status;
+}
@@ -0,0 +1,732 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be
+ * useful. If you are going to use this code, or its parts, please consider referring
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of
+ *    its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file lrc-schema.c
+ * @brief Config schema code generator.
+ *
+ * Reads a schema (the LRC_configDefaults table in text form) and writes a C
+ * header with a typed struct of the options, a perfect hash of the keys and a
+ * parser and writer specialized for exactly these keys:
+ *
+ *     lrc-schema schema.txt prefix prefix_config.h
+ *
+ * The schema has one option per line, blank lines and lines starting with #
+ * are skipped:
+ *
+ *     # namespace  name     type    default
+ *     default      inidata  string  test.dat
+ *     default      nprocs   int     4
+ *     logs         period   double  23.47
+ *
+ * The types are int, long, float, double, string and val (stored as int). The
+ * default is the rest of the line and is validated, see LRC_readDefaults().
+ *
+ * The keys are placed with the hash-and-displace scheme: the hash of the key
+ * selects a bucket, and the seed of the bucket moves all its keys to free
+ * slots. The lookup is one hash of the key, one probe and one comparison, which
+ * also rejects the unknown keys.
+ */
+#include "libreadconfig.h"
+#include "libreadconfig_internals.h"
+
+/**
+ * @def LRC_SCHEMA_BUCKET
+ * @brief Average number of keys per bucket.
+ *
+ * @def LRC_SCHEMA_SEEDS
+ * @brief Number of seeds tried for a bucket, before the table grows.
+ */
+#define LRC_SCHEMA_BUCKET 4
+#define LRC_SCHEMA_SEEDS 65536
+
+/**
+ * @var typedef struct LRC_schemaOption
+ * @brief Option read from the schema
+ */
+typedef struct{
+  char space[LRC_CONFIG_LEN];
+  char name[LRC_CONFIG_LEN];
+  char field[2*LRC_CONFIG_LEN];
+  char value[LRC_CONFIG_LEN];
+  int type;
+  uint64_t hash;
+} LRC_schemaOption;
+
+/**
+ * @fn uint64_t LRC_schemaHash(const char* space, const char* name)
+ * @brief FNV-1a hash of the key (namespace, null character, name).
+ *
+ * The generated header contains the same function, keep them in sync.
+ */
+uint64_t LRC_schemaHash(const char* space, const char* name){
+
+  uint64_t h = 0xcbf29ce484222325ULL;
+
+  while (*space) {
+    h ^= (unsigned char)*space++;
+    h *= 0x100000001b3ULL;
+  }
+  h *= 0x100000001b3ULL;
+  while (*name) {
+    h ^= (unsigned char)*name++;
+    h *= 0x100000001b3ULL;
+  }
+
+  return h;
+}
+
+/**
+ * @fn uint64_t LRC_schemaMix(uint64_t h)
+ * @brief Bit mixer for the displaced hash of the key.
+ */
+uint64_t LRC_schemaMix(uint64_t h){
+
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+
+  return h;
+}
+
+/**
+ * @fn void LRC_schemaIdentifier(char* out, char* in)
+ * @brief Makes the C identifier of the name (invalid characters become '_').
+ */
+void LRC_schemaIdentifier(char* out, char* in){
+
+  if (isdigit((unsigned char)*in)) *out++ = '_';
+
+  for (; *in; in++) {
+    *out++ = (isalnum((unsigned char)*in) || *in == '_') ? *in : '_';
+  }
+
+  *out = LRC_NULL;
+}
+
+/**
+ * @fn int LRC_schemaRead(FILE* file, LRC_schemaOption** options)
+ * @brief Reads the schema, @see LRC_readDefaults().
+ *
+ * @return
+ *  Number of options or -1 on failure
+ */
+int LRC_schemaRead(FILE* file, LRC_schemaOption** options){
+
+  char field[2*LRC_CONFIG_LEN];
+  char msg[4*LRC_CONFIG_LEN];
+  LRC_configDefaults* cd = NULL;
+  LRC_schemaOption* op = NULL;
+  int n, i, k;
+
+  n = LRC_readDefaults(file, &cd);
+  if (n < 0) return -1;
+
+  op = calloc(n + 1, sizeof(LRC_schemaOption));
+  if (!op) {
+    perror("LRC_schemaRead: alloc failed");
+    goto failure;
+  }
+
+  for (i = 0; i < n; i++) {
+    strcpy(op[i].space, cd[i].space);
+    strcpy(op[i].name, cd[i].name);
+    strcpy(op[i].value, cd[i].value);
+    op[i].type = cd[i].type;
+    op[i].hash = LRC_schemaHash(cd[i].space, cd[i].name);
+
+    LRC_schemaIdentifier(field, cd[i].space);
+    strcat(field, "_");
+    LRC_schemaIdentifier(field + strlen(field), cd[i].name);
+    strcpy(op[i].field, field);
+
+    for (k = 0; k < i; k++) {
+      if (strcmp(op[k].field, field) == 0) {
+        snprintf(msg, sizeof(msg), "Duplicate option (%s.%s)", op[i].space, op[i].name);
+        LRC_message(0, LRC_ERR_CONFIG_SYNTAX, msg);
+        goto failure;
+      }
+      if (op[k].hash == op[i].hash) {
+        snprintf(msg, sizeof(msg), "Hash collision (%s.%s)", op[i].space, op[i].name);
+        LRC_message(0, LRC_ERR_CONFIG_SYNTAX, msg);
+        goto failure;
+      }
+    }
+  }
+
+  free(cd);
+  *options = op;
+  return n;
+
+failure:
+  if (op) free(op);
+  free(cd);
+  return -1;
+}
+
+/**
+ * @fn int LRC_schemaPlace(LRC_schemaOption* op, int n, int* slots, int nslots, uint32_t* seeds, int nbuckets)
+ * @brief Finds the seeds of the buckets, so that all keys get distinct slots.
+ *
+ * The largest buckets are placed first, while most of the slots are free.
+ *
+ * @return
+ *  0 on success, -1 if some bucket could not be placed
+ */
+int LRC_schemaPlace(LRC_schemaOption* op, int n, int* slots, int nslots, uint32_t* seeds, int nbuckets){
+
+  int* size = NULL;
+  int* order = NULL;
+  int* taken = NULL;
+  int i, j, k, b, t, s, ok;
+  uint32_t seed;
+
+  size = calloc(nbuckets, sizeof(int));
+  order = calloc(nbuckets, sizeof(int));
+  taken = calloc(n > 0 ? n : 1, sizeof(int));
+  if (!size || !order || !taken) {
+    perror("LRC_schemaPlace: alloc failed");
+    goto failure;
+  }
+
+  for (i = 0; i < nslots; i++) slots[i] = -1;
+  for (i = 0; i < nbuckets; i++) {
+    seeds[i] = 0;
+    order[i] = i;
+  }
+  for (i = 0; i < n; i++) size[(op[i].hash >> 32) % nbuckets]++;
+
+  /* Insertion sort by the size, descending */
+  for (i = 1; i < nbuckets; i++) {
+    b = order[i];
+    for (j = i; j > 0 && size[order[j-1]] < size[b]; j--) order[j] = order[j-1];
+    order[j] = b;
+  }
+
+  for (i = 0; i < nbuckets; i++) {
+    b = order[i];
+    if (size[b] == 0) break;
+
+    for (seed = 1; seed < LRC_SCHEMA_SEEDS; seed++) {
+      ok = 1;
+      t = 0;
+      for (k = 0; k < n && ok; k++) {
+        if ((int)((op[k].hash >> 32) % nbuckets) != b) continue;
+        s = (int)(LRC_schemaMix(op[k].hash ^ seed) & (uint64_t)(nslots - 1));
+        if (slots[s] >= 0) ok = 0;
+        for (j = 0; j < t && ok; j++) {
+          if (taken[j] == s) ok = 0;
+        }
+        taken[t++] = s;
+      }
+      if (ok) break;
+    }
+
+    if (seed == LRC_SCHEMA_SEEDS) goto failure;
+
+    seeds[b] = seed;
+    for (k = 0; k < n; k++) {
+      if ((int)((op[k].hash >> 32) % nbuckets) != b) continue;
+      slots[LRC_schemaMix(op[k].hash ^ seed) & (uint64_t)(nslots - 1)] = k;
+    }
+  }
+
+  free(size);
+  free(order);
+  free(taken);
+  return 0;
+
+failure:
+  if (size) free(size);
+  if (order) free(order);
+  if (taken) free(taken);
+  return -1;
+}
+
+/**
+ * @fn void LRC_schemaString(FILE* out, char* str)
+ * @brief Writes the C string literal.
+ */
+void LRC_schemaString(FILE* out, char* str){
+
+  fputc('"', out);
+  for (; *str; str++) {
+    if (*str == '"' || *str == '\\') fputc('\\', out);
+    fputc(*str, out);
+  }
+  fputc('"', out);
+}
+
+/**
+ * @fn void LRC_schemaDefault(FILE* out, LRC_schemaOption* op)
+ * @brief Writes the default value as the C expression.
+ */
+void LRC_schemaDefault(FILE* out, LRC_schemaOption* op){
+
+  char num[LRC_NUMBER_LEN];
+  double d = 0.0;
+  float f = 0.0;
+  long l = 0;
+  int i = 0;
+
+  switch (op->type) {
+    case LRC_INT:
+    case LRC_VAL:
+      LRC_str2int(op->value, &i);
+      if (i == INT_MIN) {
+        fprintf(out, "INT_MIN");
+      } else {
+        fprintf(out, "%d", i);
+      }
+      break;
+    case LRC_LONG:
+      LRC_str2long(op->value, &l);
+      if (l == LONG_MIN) {
+        fprintf(out, "LONG_MIN");
+      } else {
+        fprintf(out, "%ldL", l);
+      }
+      break;
+    case LRC_FLOAT:
+      LRC_str2float(op->value, &f);
+      if (isnan(f)) {
+        fprintf(out, "NAN");
+      } else if (isinf(f)) {
+        fprintf(out, "%sINFINITY", f < 0 ? "-" : "");
+      } else {
+        LRC_float2str(num, f);
+        fprintf(out, "%sf", num);
+      }
+      break;
+    case LRC_DOUBLE:
+      LRC_str2double(op->value, &d);
+      if (isnan(d)) {
+        fprintf(out, "NAN");
+      } else if (isinf(d)) {
+        fprintf(out, "%sINFINITY", d < 0 ? "-" : "");
+      } else {
+        LRC_double2str(num, d);
+        fprintf(out, "%s", num);
+      }
+      break;
+    default:
+      LRC_schemaString(out, op->value);
+      break;
+  }
+}
+
+/**
+ * @fn const char* LRC_schemaCType(int type)
+ * @brief The C type of the struct member.
+ */
+const char* LRC_schemaCType(int type){
+
+  switch (type) {
+    case LRC_LONG: return "long";
+    case LRC_FLOAT: return "float";
+    case LRC_DOUBLE: return "double";
+    case LRC_STRING: return "char";
+    default: return "int";
+  }
+}
+
+/**
+ * @fn int LRC_schemaWrite(FILE* out, char* schema, char* prefix, LRC_schemaOption* op, int n, int* slots, int nslots, uint32_t* seeds, int nbuckets)
+ * @brief Writes the generated header.
+ *
+ * @return
+ *  0 on success, -1 otherwise
+ */
+int LRC_schemaWrite(FILE* out, char* schema, char* prefix, LRC_schemaOption* op, int n,
+    int* slots, int nslots, uint32_t* seeds, int nbuckets){
+
+  char upper[LRC_CONFIG_LEN];
+  char* space;
+  int i, k, first;
+
+  for (i = 0; prefix[i]; i++) upper[i] = (char)toupper((unsigned char)prefix[i]);
+  upper[i] = LRC_NULL;
+
+  fprintf(out, "/* Generated by lrc-schema from %s, do not edit */\n", schema);
+  fprintf(out, "#ifndef %s_CONFIG_H\n#define %s_CONFIG_H\n\n", upper, upper);
+  fprintf(out, "#include <libreadconfig.h>\n\n");
+  fprintf(out, "#define %s_OPTIONS %d\n", upper, n);
+  fprintf(out, "#define %s_SLOTS %d\n", upper, nslots);
+  fprintf(out, "#define %s_BUCKETS %d\n\n", upper, nbuckets);
+
+  /* The struct */
+  fprintf(out, "typedef struct {\n");
+  for (i = 0; i < n; i++) {
+    fprintf(out, "  %s %s%s;\n", LRC_schemaCType(op[i].type), op[i].field,
+        op[i].type == LRC_STRING ? "[LRC_CONFIG_LEN]" : "");
+  }
+  if (n == 0) fprintf(out, "  int unused;\n");
+  fprintf(out, "} %s_config;\n\n", prefix);
+
+  /* The keys */
+  fprintf(out, "enum {\n");
+  for (i = 0; i < n; i++) {
+    fprintf(out, "  %s_", upper);
+    for (k = 0; op[i].field[k]; k++) fputc(toupper((unsigned char)op[i].field[k]), out);
+    fprintf(out, " = %d,\n", i);
+  }
+  fprintf(out, "  %s_UNKNOWN = -1\n};\n\n", upper);
+
+  fprintf(out, "static const struct {\n  const char* space;\n  const char* name;\n  int type;\n} %s_keys[%d] = {\n",
+      prefix, n > 0 ? n : 1);
+  for (i = 0; i < n; i++) {
+    fprintf(out, "  {");
+    LRC_schemaString(out, op[i].space);
+    fprintf(out, ", ");
+    LRC_schemaString(out, op[i].name);
+    fprintf(out, ", %d}%s\n", op[i].type, i + 1 < n ? "," : "");
+  }
+  if (n == 0) fprintf(out, "  {\"\", \"\", 0}\n");
+  fprintf(out, "};\n\n");
+
+  fprintf(out, "static const uint32_t %s_seeds[%d] = {", prefix, nbuckets);
+  for (i = 0; i < nbuckets; i++) fprintf(out, "%s%s%u", i ? "," : "", i % 12 ? " " : "\n  ", seeds[i]);
+  fprintf(out, "\n};\n\n");
+
+  fprintf(out, "static const int %s_slots[%d] = {", prefix, nslots);
+  for (i = 0; i < nslots; i++) fprintf(out, "%s%s%d", i ? "," : "", i % 16 ? " " : "\n  ", slots[i]);
+  fprintf(out, "\n};\n\n");
+
+  /* Lookup */
+  fprintf(out,
+"/* Index of the option, or -1 for unknown keys */\n"
+"static inline int %s_lookup(const char* space, const char* name) {\n"
+"  const char* s = space;\n"
+"  uint64_t h = 0xcbf29ce484222325ULL, x;\n"
+"  int i;\n\n"
+"  while (*s) {\n"
+"    h ^= (unsigned char)*s++;\n"
+"    h *= 0x100000001b3ULL;\n"
+"  }\n"
+"  h *= 0x100000001b3ULL;\n"
+"  for (s = name; *s; s++) {\n"
+"    h ^= (unsigned char)*s;\n"
+"    h *= 0x100000001b3ULL;\n"
+"  }\n\n"
+"  x = h ^ %s_seeds[(h >> 32) %% %s_BUCKETS];\n"
+"  x ^= x >> 30;\n"
+"  x *= 0xbf58476d1ce4e5b9ULL;\n"
+"  x ^= x >> 27;\n"
+"  x *= 0x94d049bb133111ebULL;\n"
+"  x ^= x >> 31;\n\n"
+"  i = %s_slots[x & (%s_SLOTS - 1)];\n"
+"  if (i < 0 || strcmp(%s_keys[i].name, name) != 0 || strcmp(%s_keys[i].space, space) != 0) return -1;\n\n"
+"  return i;\n"
+"}\n\n", prefix, prefix, upper, prefix, upper, prefix, prefix);
+
+  /* Defaults */
+  fprintf(out, "static inline void %s_defaults(%s_config* c) {\n", prefix, prefix);
+  for (i = 0; i < n; i++) {
+    if (op[i].type == LRC_STRING) {
+      fprintf(out, "  strcpy(c->%s, ", op[i].field);
+      LRC_schemaDefault(out, &op[i]);
+      fprintf(out, ");\n");
+    } else {
+      fprintf(out, "  c->%s = ", op[i].field);
+      LRC_schemaDefault(out, &op[i]);
+      fprintf(out, ";\n");
+    }
+  }
+  if (n == 0) fprintf(out, "  (void)c;\n");
+  fprintf(out, "}\n\n");
+
+  /* Conversion of a single value */
+  fprintf(out,
+"/* Converts the value of the option, returns one of LRC_NUMBER_* */\n"
+"static inline int %s_set(%s_config* c, int option, char* value) {\n"
+"  switch (option) {\n", prefix, prefix);
+  for (i = 0; i < n; i++) {
+    fprintf(out, "    case %d:\n", i);
+    switch (op[i].type) {
+      case LRC_INT:
+      case LRC_VAL:
+        fprintf(out, "      return LRC_str2int(value, &c->%s);\n", op[i].field);
+        break;
+      case LRC_LONG:
+        fprintf(out, "      return LRC_str2long(value, &c->%s);\n", op[i].field);
+        break;
+      case LRC_FLOAT:
+        fprintf(out, "      return LRC_str2float(value, &c->%s);\n", op[i].field);
+        break;
+      case LRC_DOUBLE:
+        fprintf(out, "      return LRC_str2double(value, &c->%s);\n", op[i].field);
+        break;
+      default:
+        fprintf(out, "      if (strlen(value) >= LRC_CONFIG_LEN) return LRC_NUMBER_RANGE;\n");
+        fprintf(out, "      strcpy(c->%s, value);\n", op[i].field);
+        fprintf(out, "      return LRC_NUMBER_OK;\n");
+        break;
+    }
+  }
+  fprintf(out,
+"    default:\n"
+"      (void)c;\n"
+"      (void)value;\n"
+"      return LRC_NUMBER_INVALID;\n"
+"  }\n"
+"}\n\n");
+
+  /* Parser */
+  fprintf(out,
+"/* Same syntax as LRC_ASCIIParser(), returns the number of namespaces or -1 */\n"
+"static inline int %s_parse(FILE* file, char* sep, char* comm, %s_config* c) {\n"
+"  char l[LRC_MAX_LINE_LENGTH];\n"
+"  char space[LRC_CONFIG_LEN];\n"
+"  char* line;\n"
+"  char* s;\n"
+"  char* value;\n"
+"  char* msg = NULL;\n"
+"  int j = 0, n = 0, option, status;\n\n"
+"  space[0] = LRC_NULL;\n\n"
+"  while (fgets(l, LRC_MAX_LINE_LENGTH, file)) {\n"
+"    j++;\n\n"
+"    if (!strchr(l, '\\n') && !feof(file)) {\n"
+"      msg = LRC_MSG_TOO_LONG;\n"
+"      goto failure;\n"
+"    }\n\n"
+"    l[strcspn(l, comm)] = LRC_NULL;\n"
+"    line = LRC_trim(l);\n"
+"    if (line[0] == LRC_NULL) continue;\n\n"
+"    if (line[0] == '[') {\n"
+"      s = strchr(line, ']');\n"
+"      if (!s || s[1] != LRC_NULL) {\n"
+"        msg = LRC_MSG_MISSING_BRACKET;\n"
+"        goto failure;\n"
+"      }\n"
+"      *s = LRC_NULL;\n"
+"      s = LRC_trim(line + 1);\n"
+"      if (strlen(s) >= LRC_CONFIG_LEN) {\n"
+"        msg = LRC_MSG_TOO_LONG;\n"
+"        goto failure;\n"
+"      }\n"
+"      strcpy(space, s);\n"
+"      n++;\n"
+"      continue;\n"
+"    }\n\n"
+"    if (space[0] == LRC_NULL) {\n"
+"      msg = LRC_MSG_NONAMESPACE;\n"
+"      goto failure;\n"
+"    }\n\n"
+"    s = strpbrk(line, sep);\n"
+"    if (!s) {\n"
+"      msg = LRC_MSG_MISSING_SEP;\n"
+"      goto failure;\n"
+"    }\n"
+"    if (strpbrk(s + 1, sep)) {\n"
+"      msg = LRC_MSG_TOOMANY_SEP;\n"
+"      goto failure;\n"
+"    }\n\n"
+"    *s = LRC_NULL;\n"
+"    value = LRC_trim(s + 1);\n"
+"    line = LRC_trim(line);\n"
+"    if (line[0] == LRC_NULL) {\n"
+"      msg = LRC_MSG_MISSING_VAR;\n"
+"      goto failure;\n"
+"    }\n"
+"    if (value[0] == LRC_NULL) {\n"
+"      msg = LRC_MSG_MISSING_VAL;\n"
+"      goto failure;\n"
+"    }\n\n"
+"    option = %s_lookup(space, line);\n"
+"    if (option < 0) {\n"
+"      msg = LRC_MSG_UNKNOWN_VAR;\n"
+"      goto failure;\n"
+"    }\n\n"
+"    status = %s_set(c, option, value);\n"
+"    if (status != LRC_NUMBER_OK) {\n"
+"      msg = (status == LRC_NUMBER_RANGE && %s_keys[option].type == LRC_STRING) ?\n"
+"        LRC_MSG_TOO_LONG : LRC_MSG_WRONG_INPUT;\n"
+"      goto failure;\n"
+"    }\n"
+"  }\n\n"
+"  return n;\n\n"
+"failure:\n"
+"  LRC_message(j, LRC_ERR_CONFIG_SYNTAX, msg);\n"
+"  return -1;\n"
+"}\n\n", prefix, prefix, prefix, prefix, prefix);
+
+  /* Writer, the namespaces in the order of the schema */
+  fprintf(out,
+"/* Same layout as LRC_ASCIIWriter(), returns 0 on success or -1 */\n"
+"static inline int %s_write(FILE* file, char* sep, char* comm, %s_config* c) {\n"
+"  char num[LRC_NUMBER_LEN];\n\n"
+"  (void)num;\n"
+"  (void)c;\n\n"
+"  fprintf(file, \"%%s Generated by %s_write\\n\", comm);\n", prefix, prefix, prefix);
+
+  for (i = 0; i < n; i++) {
+    space = op[i].space;
+    first = 1;
+    for (k = 0; k < i; k++) {
+      if (strcmp(op[k].space, space) == 0) first = 0;
+    }
+    if (!first) continue;
+
+    fprintf(out, "\n  fprintf(file, \"\\n[%%s]\\n\", ");
+    LRC_schemaString(out, space);
+    fprintf(out, ");\n");
+
+    for (k = i; k < n; k++) {
+      if (strcmp(op[k].space, space) != 0) continue;
+      switch (op[k].type) {
+        case LRC_INT:
+        case LRC_VAL:
+          fprintf(out, "  fprintf(file, \"%%s %%s %%d\\n\", ");
+          LRC_schemaString(out, op[k].name);
+          fprintf(out, ", sep, c->%s);\n", op[k].field);
+          break;
+        case LRC_LONG:
+          fprintf(out, "  fprintf(file, \"%%s %%s %%ld\\n\", ");
+          LRC_schemaString(out, op[k].name);
+          fprintf(out, ", sep, c->%s);\n", op[k].field);
+          break;
+        case LRC_FLOAT:
+          fprintf(out, "  LRC_float2str(num, c->%s);\n", op[k].field);
+          fprintf(out, "  fprintf(file, \"%%s %%s %%s\\n\", ");
+          LRC_schemaString(out, op[k].name);
+          fprintf(out, ", sep, num);\n");
+          break;
+        case LRC_DOUBLE:
+          fprintf(out, "  LRC_double2str(num, c->%s);\n", op[k].field);
+          fprintf(out, "  fprintf(file, \"%%s %%s %%s\\n\", ");
+          LRC_schemaString(out, op[k].name);
+          fprintf(out, ", sep, num);\n");
+          break;
+        default:
+          fprintf(out, "  fprintf(file, \"%%s %%s %%s\\n\", ");
+          LRC_schemaString(out, op[k].name);
+          fprintf(out, ", sep, c->%s);\n", op[k].field);
+          break;
+      }
+    }
+  }
+
+  fprintf(out, "\n  return ferror(file) ? -1 : 0;\n}\n\n");
+  fprintf(out, "#endif\n");
+
+  return ferror(out) ? -1 : 0;
+}
+
+int main(int argc, char** argv){
+
+  LRC_schemaOption* op = NULL;
+  FILE* in = NULL;
+  FILE* out = NULL;
+  uint32_t* seeds = NULL;
+  int* slots = NULL;
+  int n, i, nslots, nbuckets;
+
+  if (argc != 4) {
+    fprintf(stderr, "Usage: %s schema prefix output.h\n", argv[0]);
+    return 1;
+  }
+
+  for (i = 0; argv[2][i]; i++) {
+    if (!(isalnum((unsigned char)argv[2][i]) || argv[2][i] == '_')) break;
+  }
+
+  if (i == 0 || argv[2][i] != LRC_NULL || isdigit((unsigned char)argv[2][0])) {
+    fprintf(stderr, "%s: the prefix must be a C identifier\n", argv[0]);
+    return 1;
+  }
+
+  in = fopen(argv[1], "r");
+  if (!in) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, argv[1]);
+    return 1;
+  }
+
+  n = LRC_schemaRead(in, &op);
+  fclose(in);
+  if (n < 0) return 1;
+
+  nbuckets = n / LRC_SCHEMA_BUCKET + 1;
+  for (nslots = 1; nslots < n; nslots *= 2);
+
+  seeds = calloc(nbuckets, sizeof(uint32_t));
+  if (!seeds) {
+    perror("lrc-schema: alloc failed");
+    goto failure;
+  }
+
+  while (1) {
+    slots = calloc(nslots, sizeof(int));
+    if (!slots) {
+      perror("lrc-schema: alloc failed");
+      goto failure;
+    }
+
+    if (LRC_schemaPlace(op, n, slots, nslots, seeds, nbuckets) == 0) break;
+
+    free(slots);
+    slots = NULL;
+    nslots *= 2;
+  }
+
+  out = fopen(argv[3], "w");
+  if (!out) {
+    LRC_message(0, LRC_ERR_FILE_OPEN, argv[3]);
+    goto failure;
+  }
+
+  if (LRC_schemaWrite(out, argv[1], argv[2], op, n, slots, nslots, seeds, nbuckets) < 0
+      || fclose(out) != 0) {
+    out = NULL;
+    remove(argv[3]);
+    goto failure;
+  }
+
+  free(op);
+  free(seeds);
+  free(slots);
+  return 0;
+
+failure:
+  if (out) fclose(out);
+  if (op) free(op);
+  if (seeds) free(seeds);
+  if (slots) free(slots);
+  return 1;
+}
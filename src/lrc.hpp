@@ -0,0 +1,437 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be
+ * useful. If you are going to use this code, or its parts, please consider referring
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of
+ *    its contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file lrc.hpp
+ * @brief Header-only C++17 binding.
+ *
+ * The tree is owned by lrc::config (move-only, released with LRC_cleanup()).
+ * Options are addressed by lrc::key, which hashes the namespace and the name at
+ * compile time when declared constexpr:
+ *
+ *     static constexpr lrc::key period{"logs", "period"};
+ *
+ *     lrc::config cfg(defaults);
+ *     cfg.parse("sim.cfg");
+ *     double p = cfg.get<double>(period);
+ *     std::string_view f = cfg.get<std::string_view>("default", "inidata");
+ *
+ *     for (auto space : cfg)
+ *       for (auto option : space)
+ *         std::cout << option.name() << " = " << option.value() << "\n";
+ *
+ * The lookup goes through a hash index of the tree, built once, since the set
+ * of options does not change after LRC_assignDefaults(). The string views
+ * point into the tree and are valid until the option is modified or the
+ * config is destroyed.
+ *
+ * After LRC_interpolate(), get() returns the expanded values (see
+ * LRC_getOptionValue()), while option::value() is the text as written.
+ *
+ * Errors are reported with lrc::error.
+ */
+#ifndef LRC_HPP
+#define LRC_HPP
+
+extern "C" {
+#include "libreadconfig.h"
+}
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lrc {
+
+/**
+ * @brief Error thrown by the binding.
+ */
+class error : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief FNV-1a hash of the key (namespace, null character, name), the same as
+ * used by lrc-schema.
+ */
+constexpr std::uint64_t hash(std::string_view space, std::string_view name) noexcept {
+  std::uint64_t h = 0xcbf29ce484222325ULL;
+
+  for (char c : space) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ULL;
+  }
+  h *= 0x100000001b3ULL;
+  for (char c : name) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ULL;
+  }
+
+  return h;
+}
+
+/**
+ * @brief The option key, hashed on construction.
+ */
+struct key {
+  std::string_view space;
+  std::string_view name;
+  std::uint64_t hash;
+
+  constexpr key(std::string_view s, std::string_view n) noexcept
+    : space(s), name(n), hash(lrc::hash(s, n)) {}
+};
+
+/**
+ * @brief View of a single option.
+ */
+class option {
+  public:
+    explicit option(LRC_configOptions* op) noexcept : op_(op) {}
+
+    std::string_view name() const noexcept { return op_->name; }
+    /** The text as written (the references are not expanded) */
+    std::string_view value() const noexcept { return op_->value; }
+    int type() const noexcept { return op_->type; }
+    LRC_configOptions* get() const noexcept { return op_; }
+
+  private:
+    LRC_configOptions* op_;
+};
+
+/**
+ * @brief Forward iterator over a linked list of the tree.
+ */
+template <class Node, class View>
+class list_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = View;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = View;
+
+    list_iterator() noexcept : node_(nullptr) {}
+    explicit list_iterator(Node* node) noexcept : node_(node) {}
+
+    View operator*() const noexcept { return View(node_); }
+
+    list_iterator& operator++() noexcept {
+      node_ = node_->next;
+      return *this;
+    }
+
+    list_iterator operator++(int) noexcept {
+      list_iterator it = *this;
+      node_ = node_->next;
+      return it;
+    }
+
+    bool operator==(const list_iterator& other) const noexcept { return node_ == other.node_; }
+    bool operator!=(const list_iterator& other) const noexcept { return node_ != other.node_; }
+
+  private:
+    Node* node_;
+};
+
+using option_iterator = list_iterator<LRC_configOptions, option>;
+
+/**
+ * @brief View of a namespace, a range of its options.
+ */
+class space {
+  public:
+    explicit space(LRC_configNamespace* ns) noexcept : ns_(ns) {}
+
+    std::string_view name() const noexcept { return ns_->space; }
+    option_iterator begin() const noexcept { return option_iterator(ns_->options); }
+    option_iterator end() const noexcept { return option_iterator(); }
+    LRC_configNamespace* get() const noexcept { return ns_; }
+
+  private:
+    LRC_configNamespace* ns_;
+};
+
+using space_iterator = list_iterator<LRC_configNamespace, space>;
+
+/**
+ * @brief Owner of the config tree.
+ */
+class config {
+  public:
+    config() noexcept : head_(nullptr) {}
+
+    /** Creates the tree from the defaults (LRC_assignDefaults()) */
+    explicit config(LRC_configDefaults* defaults) : head_(LRC_assignDefaults(defaults)) {
+      if (!head_) throw error("LRC_assignDefaults failed");
+      index();
+    }
+
+    /** Takes the ownership of the tree */
+    static config adopt(LRC_configNamespace* head) {
+      config c;
+      c.head_ = head;
+      c.index();
+      return c;
+    }
+
+    ~config() { reset(); }
+
+    config(const config&) = delete;
+    config& operator=(const config&) = delete;
+
+    config(config&& other) noexcept
+      : head_(std::exchange(other.head_, nullptr)), index_(std::move(other.index_)) {}
+
+    config& operator=(config&& other) noexcept {
+      if (this != &other) {
+        reset();
+        head_ = std::exchange(other.head_, nullptr);
+        index_ = std::move(other.index_);
+      }
+      return *this;
+    }
+
+    /** Deep copy, only on request (LRC_copyConfig()) */
+    config clone() const {
+      LRC_configNamespace* copy = LRC_copyConfig(head_);
+      if (head_ && !copy) throw error("LRC_copyConfig failed");
+      return adopt(copy);
+    }
+
+    /** Releases the ownership of the tree */
+    LRC_configNamespace* release() noexcept {
+      index_.clear();
+      return std::exchange(head_, nullptr);
+    }
+
+    LRC_configNamespace* get() const noexcept { return head_; }
+    explicit operator bool() const noexcept { return head_ != nullptr; }
+
+    /** Reads the ASCII config file (LRC_ASCIIParser()) */
+    int parse(const std::string& path, const char* sep = "=", const char* comm = "#") {
+      FILE* file = std::fopen(path.c_str(), "r");
+      if (!file) throw error("Cannot open " + path);
+
+      int n = LRC_ASCIIParser(file, const_cast<char*>(sep), const_cast<char*>(comm), head_);
+      std::fclose(file);
+      if (n < 0) throw error("Cannot parse " + path);
+
+      return n;
+    }
+
+    /** Writes the ASCII config file (LRC_ASCIIWriteFile()) */
+    void write(const std::string& path, const char* sep = "=", const char* comm = "#") const {
+      if (LRC_ASCIIWriteFile(const_cast<char*>(path.c_str()), const_cast<char*>(sep),
+            const_cast<char*>(comm), head_) < 0) {
+        throw error("Cannot write " + path);
+      }
+    }
+
+    /** The option or nullptr */
+    LRC_configOptions* find(const key& k) const noexcept {
+      auto it = index_.find(k.hash);
+      if (it == index_.end()) return nullptr;
+
+      LRC_configOptions* op = it->second.option;
+      if (op && k.name == op->name && k.space == it->second.space->space) return op;
+      if (op) return nullptr;
+
+      /* Colliding hashes, search the tree */
+      std::string s(k.space), n(k.name);
+      LRC_configNamespace* ns = LRC_findNamespace(s.data(), head_);
+      return ns ? LRC_findOption(n.data(), ns) : nullptr;
+    }
+
+    bool contains(const key& k) const noexcept { return find(k) != nullptr; }
+
+    /**
+     * The value converted to T: int, long, float, double, long double,
+     * std::string, std::string_view (no copy), std::vector<int> or
+     * std::vector<double> (array options).
+     */
+    template <class T>
+    T get(const key& k) const {
+      LRC_configOptions* op = lookup(k);
+      return convert<T>(op, text(k, op));
+    }
+
+    template <class T>
+    T get(std::string_view space, std::string_view name) const {
+      return get<T>(key(space, name));
+    }
+
+    /** The value, or the fallback if the option does not exist */
+    template <class T>
+    T get_or(const key& k, T fallback) const {
+      LRC_configOptions* op = find(k);
+      return op ? convert<T>(op, text(k, op)) : fallback;
+    }
+
+    /** Sets the value (with the type of T) */
+    template <class T>
+    void set(const key& k, const T& value) {
+      LRC_configOptions* op = lookup(k);
+      std::string s(k.space), n(k.name);
+      LRC_configOptions* r = nullptr;
+
+      if constexpr (std::is_same_v<T, int>) {
+        r = LRC_setInt(s.data(), n.data(), value, head_);
+      } else if constexpr (std::is_same_v<T, long>) {
+        r = LRC_setLong(s.data(), n.data(), value, head_);
+      } else if constexpr (std::is_same_v<T, float>) {
+        r = LRC_setFloat(s.data(), n.data(), value, head_);
+      } else if constexpr (std::is_same_v<T, double>) {
+        r = LRC_setDouble(s.data(), n.data(), value, head_);
+      } else if constexpr (std::is_same_v<T, long double>) {
+        r = LRC_setLdouble(s.data(), n.data(), value, head_);
+      } else if constexpr (std::is_same_v<T, std::vector<int>>) {
+        r = LRC_setIntArray(s.data(), n.data(), const_cast<int*>(value.data()), value.size(), head_);
+      } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+        r = LRC_setDoubleArray(s.data(), n.data(), const_cast<double*>(value.data()), value.size(), head_);
+      } else {
+        static_assert(std::is_convertible_v<T, std::string_view>, "unsupported type");
+        std::string v{std::string_view(value)};
+        r = LRC_modifyOption(s.data(), n.data(), v.data(), op->type, head_);
+      }
+
+      if (!r) throw error("Cannot set " + s + "." + n);
+    }
+
+    template <class T>
+    void set(std::string_view space, std::string_view name, const T& value) {
+      set<T>(key(space, name), value);
+    }
+
+    space_iterator begin() const noexcept { return space_iterator(head_); }
+    space_iterator end() const noexcept { return space_iterator(); }
+
+  private:
+    struct entry {
+      LRC_configNamespace* space;
+      LRC_configOptions* option;
+    };
+
+    /* The keys are already hashed */
+    struct identity {
+      std::size_t operator()(std::uint64_t h) const noexcept { return static_cast<std::size_t>(h); }
+    };
+
+    LRC_configNamespace* head_;
+    std::unordered_map<std::uint64_t, entry, identity> index_;
+
+    void reset() noexcept {
+      if (head_) LRC_cleanup(head_);
+      head_ = nullptr;
+      index_.clear();
+    }
+
+    void index() {
+      index_.clear();
+      for (LRC_configNamespace* ns = head_; ns; ns = ns->next) {
+        for (LRC_configOptions* op = ns->options; op; op = op->next) {
+          auto r = index_.emplace(lrc::hash(ns->space, op->name), entry{ns, op});
+          if (!r.second) r.first->second.option = nullptr;
+        }
+      }
+    }
+
+    LRC_configOptions* lookup(const key& k) const {
+      LRC_configOptions* op = find(k);
+      if (!op) throw error("Unknown option " + std::string(k.space) + "." + std::string(k.name));
+      return op;
+    }
+
+    /* The value, expanded if the config is interpolated */
+    const char* text(const key& k, LRC_configOptions* op) const {
+      if (!head_->interp) return op->value;
+
+      std::string s(k.space), n(k.name);
+      const char* value = LRC_getOptionValue(s.data(), n.data(), head_);
+      if (!value) throw error("Unresolved references of " + s + "." + n);
+
+      return value;
+    }
+
+    template <class T>
+    static T convert(LRC_configOptions* op, const char* text) {
+      int status = LRC_NUMBER_OK;
+      T value{};
+
+      if constexpr (std::is_same_v<T, std::string_view>) {
+        return std::string_view(text);
+      } else if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(text);
+      } else if constexpr (std::is_same_v<T, std::vector<int>> || std::is_same_v<T, std::vector<double>>) {
+        using E = typename T::value_type;
+        int type = std::is_same_v<E, int> ? LRC_INT_ARRAY : LRC_DOUBLE_ARRAY;
+        if (op->type != type) throw error(std::string("Not an array of this type: ") + op->name);
+        const E* data = static_cast<const E*>(op->array);
+        return T(data, data + op->count);
+      } else {
+        if constexpr (std::is_same_v<T, int>) {
+          status = LRC_str2int(const_cast<char*>(text), &value);
+        } else if constexpr (std::is_same_v<T, long>) {
+          status = LRC_str2long(const_cast<char*>(text), &value);
+        } else if constexpr (std::is_same_v<T, float>) {
+          status = LRC_str2float(const_cast<char*>(text), &value);
+        } else if constexpr (std::is_same_v<T, double>) {
+          status = LRC_str2double(const_cast<char*>(text), &value);
+        } else if constexpr (std::is_same_v<T, long double>) {
+          status = LRC_str2Ldouble(const_cast<char*>(text), &value);
+        } else {
+          static_assert(!std::is_same_v<T, T>, "unsupported type");
+        }
+
+        if (status != LRC_NUMBER_OK) throw error(std::string("Wrong value of ") + op->name);
+        return value;
+      }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file arrays.c
+ * @brief Test of the array options: parsing, the getters and setters, and
+ * the arrays longer than the value string through the writer and the parser.
+ */
+
+#include "test.h"
+
+#define BIG 10000
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "ints", 0, "1, 2, 3", "", LRC_INT_ARRAY, 0},
+    {"default", "dbl", 0, "0.5 1e3", "", LRC_DOUBLE_ARRAY, 0},
+    {"default", "big", 0, "", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_configNamespace* read = NULL;
+  FILE* file = NULL;
+  double* big = NULL;
+  double dv[4];
+  int iv[4], set[2] = {10, 20};
+  size_t i;
+
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+
+  CHECK(LRC_getIntArray("default", "ints", iv, 4, head) == 3);
+  CHECK(iv[0] == 1 && iv[1] == 2 && iv[2] == 3);
+  CHECK(LRC_getDoubleArray("default", "dbl", dv, 4, head) == 2);
+  CHECK(dv[0] == 0.5 && dv[1] == 1e3);
+  CHECK(LRC_getDoubleArray("default", "big", NULL, 0, head) == 0);
+
+  /* Wrong types and elements */
+  CHECK(LRC_getIntArray("default", "dbl", iv, 4, head) == -1);
+  CHECK(LRC_getIntArray("default", "missing", iv, 4, head) == -1);
+  CHECK(LRC_modifyOption("default", "ints", "1, x", LRC_INT_ARRAY, head) == NULL);
+  CHECK(LRC_modifyOption("default", "ints", "1, 99999999999", LRC_INT_ARRAY, head) == NULL);
+  CHECK(LRC_getIntArray("default", "ints", iv, 4, head) == 3);
+
+  /* Commas, white spaces and comments separate the elements */
+  file = fopen("arrays.cfg", "w");
+  CHECK(file != NULL);
+  fprintf(file, "[default]\nints = 4,5 , 6   7 # comment\ndbl = -0.1, 2.5e-3,\t3\nbig = ");
+  for (i = 0; i < BIG; i++) fprintf(file, "%s%.17g", i ? ", " : "", i * 0.1);
+  fprintf(file, "\n");
+  CHECK(fclose(file) == 0);
+
+  CHECK(LRC_ASCIIParseFile("arrays.cfg", "=", "#", head) >= 0);
+  CHECK(LRC_getIntArray("default", "ints", iv, 4, head) == 4);
+  CHECK(iv[0] == 4 && iv[1] == 5 && iv[2] == 6 && iv[3] == 7);
+  CHECK(LRC_getDoubleArray("default", "dbl", dv, 2, head) == 3);
+  CHECK(dv[0] == -0.1 && dv[1] == 2.5e-3);
+
+  big = malloc(BIG * sizeof(double));
+  CHECK(big != NULL);
+  CHECK(LRC_getDoubleArray("default", "big", big, BIG, head) == BIG);
+  for (i = 0; i < BIG; i++) CHECK(big[i] == i * 0.1);
+
+  /* The setters and the writer keep every element */
+  CHECK(LRC_setIntArray("default", "ints", set, 2, head) != NULL);
+  CHECK_VALUE(head, "default", "ints", "10, 20");
+
+  CHECK(LRC_ASCIIWriteFile("arrays-out.cfg", "=", "#", head) == 0);
+  read = LRC_assignDefaults(ct);
+  CHECK(LRC_ASCIIParseFile("arrays-out.cfg", "=", "#", read) >= 0);
+  CHECK(LRC_getIntArray("default", "ints", iv, 4, read) == 2);
+  CHECK(iv[0] == 10 && iv[1] == 20);
+  CHECK(LRC_getDoubleArray("default", "big", big, BIG, read) == BIG);
+  for (i = 0; i < BIG; i++) CHECK(big[i] == i * 0.1);
+  LRC_cleanup(read);
+
+  /* The copy has its own elements */
+  read = LRC_copyConfig(head);
+  CHECK(read != NULL);
+  CHECK(LRC_getDoubleArray("default", "big", NULL, 0, read) == BIG);
+  LRC_cleanup(read);
+
+  free(big);
+  LRC_cleanup(head);
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file async.c
+ * @brief Test of the loading of the config in the background.
+ */
+
+#include "test.h"
+#if HAVE_HDF5_H
+#include "libreadconfig_hdf5.h"
+#endif
+
+static int errors = 0;
+
+/**
+ * @fn static void count(LRC_diagnostic* diagnostic, void* data)
+ * @brief Counts the errors of the loading threads.
+ */
+static void count(LRC_diagnostic* diagnostic, void* data){
+
+  (void)diagnostic;
+  (void)data;
+
+  errors++;
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"logs", "dump", 0, "100", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_configLoad* load = NULL;
+  int status;
+#if HAVE_HDF5_H
+  hid_t file;
+#endif
+
+  /* The errors of the threads go to the global diagnostics */
+  LRC_setDiagnostics(NULL, count, NULL, 0, 0);
+
+  test_write("async.cfg", "[default]\ninidata = run.dat\n[logs]\ndump = 200\n");
+
+  load = LRC_loadAsync("async.cfg", "=", "#", ct);
+  CHECK(load != NULL);
+  head = LRC_wait(load);
+  CHECK(head != NULL);
+  CHECK_VALUE(head, "default", "inidata", "run.dat");
+  CHECK_VALUE(head, "logs", "dump", "200");
+  CHECK_VALUE(head, "logs", "period", "23.47");
+
+#if HAVE_HDF5_H
+  file = H5Fcreate("async.h5", H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  CHECK(file >= 0);
+  CHECK(LRC_HDF5Writer(file, LRC_CONFIG_GROUP, head) >= 0);
+  CHECK(H5Fclose(file) >= 0);
+#endif
+  LRC_cleanup(head);
+
+  /* Polled until it is loaded */
+  load = LRC_loadAsync("async.cfg", "=", "#", ct);
+  CHECK(load != NULL);
+  while ((status = LRC_tryGet(load, &head)) == 0) {
+    CHECK(head == NULL);
+  }
+  CHECK(status == 1 && head != NULL);
+  CHECK_VALUE(head, "logs", "dump", "200");
+  LRC_cleanup(head);
+  remove("async.cfg");
+
+  /* Failures are reported, no config */
+  CHECK(errors == 0);
+  head = LRC_wait(LRC_loadAsync("async-missing.cfg", "=", "#", ct));
+  CHECK(head == NULL && errors == 1);
+  test_write("async.cfg", "[default]\nthreads = 2\n");
+  load = LRC_loadAsync("async.cfg", "=", "#", ct);
+  while ((status = LRC_tryGet(load, &head)) == 0);
+  CHECK(status == -1 && head == NULL && errors == 2);
+  remove("async.cfg");
+
+#if HAVE_HDF5_H
+  load = LRC_loadAsyncHDF5("async.h5", LRC_CONFIG_GROUP, ct);
+  CHECK(load != NULL);
+  head = LRC_wait(load);
+  CHECK(head != NULL);
+  CHECK_VALUE(head, "default", "inidata", "run.dat");
+  CHECK_VALUE(head, "logs", "dump", "200");
+  LRC_cleanup(head);
+  remove("async.h5");
+#endif
+
+  LRC_setDiagnostics(NULL, NULL, NULL, 0, 0);
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file atomic.c
+ * @brief Test of the atomic ASCII writer: the file is replaced as a whole,
+ * keeps its permissions, and a failed write leaves no temporary file.
+ */
+
+/* chmod, mkdir */
+#define _POSIX_C_SOURCE 200809L
+
+#include "test.h"
+
+/* Number of the files in the directory which start with the prefix */
+static int leftovers(char* prefix){
+
+  DIR* dir = NULL;
+  struct dirent* entry = NULL;
+  int n = 0;
+
+  dir = opendir(".");
+  CHECK(dir != NULL);
+  while ((entry = readdir(dir)) != NULL) {
+    if (strncmp(entry->d_name, prefix, strlen(prefix)) == 0) n++;
+  }
+  closedir(dir);
+
+  return n;
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"logs", "dump", 0, "100", "", LRC_INT, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_configNamespace* read = NULL;
+  struct stat st;
+
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+  LRC_modifyOption("logs", "dump", "200", LRC_INT, head);
+
+  remove("atomic.cfg");
+  CHECK(LRC_ASCIIWriteFile("atomic.cfg", "=", "#", head) == 0);
+
+  read = LRC_assignDefaults(ct);
+  CHECK(LRC_ASCIIParseFile("atomic.cfg", "=", "#", read) >= 0);
+  CHECK_VALUE(read, "logs", "dump", "200");
+  LRC_cleanup(read);
+
+  /* The replaced file keeps its permissions */
+  CHECK(chmod("atomic.cfg", 0640) == 0);
+  LRC_modifyOption("logs", "dump", "300", LRC_INT, head);
+  CHECK(LRC_ASCIIWriteFile("atomic.cfg", "=", "#", head) == 0);
+  CHECK(stat("atomic.cfg", &st) == 0);
+  CHECK((st.st_mode & 07777) == 0640);
+
+  read = LRC_assignDefaults(ct);
+  CHECK(LRC_ASCIIParseFile("atomic.cfg", "=", "#", read) >= 0);
+  CHECK_VALUE(read, "logs", "dump", "300");
+  LRC_cleanup(read);
+
+  /* The rename over a directory fails, the temporary file is removed */
+  mkdir("atomic.dir", 0755);
+  test_write("atomic.dir/keep", "keep");
+  CHECK(LRC_ASCIIWriteFile("atomic.dir", "=", "#", head) == -1);
+  CHECK(stat("atomic.dir", &st) == 0 && S_ISDIR(st.st_mode));
+  CHECK(leftovers("atomic.dir.") == 0);
+  CHECK(leftovers("atomic.cfg.") == 0);
+
+  /* Nothing is written into a missing directory */
+  CHECK(LRC_ASCIIWriteFile("atomic.missing/atomic.cfg", "=", "#", head) == -1);
+
+  LRC_cleanup(head);
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file binding.cpp
+ * @brief Test of the C++ binding: typed access by hashed keys, the iteration
+ * and the ownership of the config.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "lrc.hpp"
+#include "test.h"
+
+static constexpr lrc::key period{"logs", "period"};
+static_assert(period.hash == lrc::hash("logs", "period"));
+
+int main(){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "1 2 3", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  bool thrown;
+
+  lrc::config c(ct);
+  CHECK(c.get<double>(period) == 23.47);
+  CHECK(c.get<int>("default", "nprocs") == 4);
+  CHECK(c.get<std::string_view>("default", "inidata") == "test.dat");
+  CHECK(c.get<std::vector<double>>("logs", "v").size() == 3);
+
+  c.set("logs", "period", 1.5);
+  c.set("default", "inidata", "x.dat");
+  c.set("logs", "v", std::vector<double>{4, 5});
+  CHECK(c.get<double>(period) == 1.5);
+  CHECK(c.get<std::string>("default", "inidata") == "x.dat");
+  CHECK(c.get<std::vector<double>>("logs", "v") == (std::vector<double>{4, 5}));
+  CHECK(c.get_or<int>({"missing", "key"}, 7) == 7);
+
+  /* The file reads back through the same binding */
+  c.write("binding.cfg");
+  lrc::config d(ct);
+  CHECK(d.parse("binding.cfg") == 2);
+  CHECK(d.get<double>(period) == 1.5);
+
+  /* Moves and clones */
+  lrc::config e = std::move(c);
+  CHECK(!c && e);
+  lrc::config f = e.clone();
+  f.set("logs", "period", 2.5);
+  CHECK(e.get<double>(period) == 1.5 && f.get<double>(period) == 2.5);
+  CHECK(std::count_if(f.begin(), f.end(), [](lrc::space s){ return s.name() == "logs"; }) == 1);
+
+  /* Unknown options and wrong types throw */
+  thrown = false;
+  try { e.get<int>("logs", "nope"); } catch (lrc::error&) { thrown = true; }
+  CHECK(thrown);
+
+  thrown = false;
+  try { e.get<int>("default", "inidata"); } catch (lrc::error&) { thrown = true; }
+  CHECK(thrown);
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file diag.c
+ * @brief Test of the diagnostics: handlers, limit, deduplication and the
+ * collect mode.
+ */
+
+#include "test.h"
+
+#define RECORDS 8
+
+/**
+ * @var typedef struct record
+ * @brief Copy of the diagnostic record (empty strings for NULL).
+ */
+typedef struct{
+  int code;
+  int line;
+  int column;
+  char file[LRC_CONFIG_LEN];
+  char space[LRC_CONFIG_LEN];
+  char name[LRC_CONFIG_LEN];
+  char message[LRC_CONFIG_LEN];
+} record;
+
+static record records[RECORDS];
+static int nrecords = 0;
+
+/**
+ * @fn static void collect(LRC_diagnostic* diagnostic, void* data)
+ * @brief Keeps a copy of the record, which is valid during the call only.
+ */
+static void collect(LRC_diagnostic* diagnostic, void* data){
+
+  record* r = &records[nrecords < RECORDS ? nrecords : RECORDS - 1];
+
+  (void)data;
+
+  r->code = diagnostic->code;
+  r->line = diagnostic->line;
+  r->column = diagnostic->column;
+  strcpy(r->file, diagnostic->file ? diagnostic->file : "");
+  strcpy(r->space, diagnostic->space ? diagnostic->space : "");
+  strcpy(r->name, diagnostic->name ? diagnostic->name : "");
+  strcpy(r->message, diagnostic->message ? diagnostic->message : "");
+  nrecords++;
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_diagnostic d;
+  FILE* file = NULL;
+  char* text;
+
+  head = LRC_assignDefaults(ct);
+  CHECK(LRC_setDiagnostics(head, collect, NULL, 0, 0) == 0);
+
+  /* The record tells where the error is */
+  test_write("diag.cfg", "[default]\nnprocs = 8\n  missing = 1\n[logs]\nperiod = 1.5\n");
+  CHECK(LRC_ASCIIParseFile("diag.cfg", "=", "#", head) == -1);
+  CHECK(nrecords == 1 && LRC_diagnosticCount(head) == 1);
+  CHECK(records[0].code == LRC_ERR_CONFIG_SYNTAX && records[0].line == 3 && records[0].column == 3);
+  CHECK(strcmp(records[0].file, "diag.cfg") == 0);
+  CHECK(strcmp(records[0].space, "default") == 0 && strcmp(records[0].name, "missing") == 0);
+  CHECK(strcmp(records[0].message, LRC_MSG_UNKNOWN_VAR) == 0);
+
+  d.code = LRC_ERR_CONFIG_SYNTAX;
+  d.message = LRC_MSG_UNKNOWN_VAR;
+  d.file = "diag.cfg";
+  d.line = 3;
+  d.column = 3;
+  d.space = "default";
+  d.name = "missing";
+  file = fopen("diag.txt", "w");
+  CHECK(file != NULL);
+  LRC_printDiagnostic(&d, file);
+  fclose(file);
+  text = test_read("diag.txt");
+  CHECK(strcmp(text, LRC_MSG_CONFIG_SYNTAX " at line 3, column 3 of diag.cfg: "
+        LRC_MSG_UNKNOWN_VAR " (default.missing)\n") == 0);
+  free(text);
+  remove("diag.txt");
+
+  /* All errors of the file in one pass, the same problem once */
+  test_write("diag.cfg", "[default]\nmissing = 1\nmissing = 2\nnprocs = 8\n[logs]\nperiod 1.5\n");
+  nrecords = 0;
+  CHECK(LRC_setDiagnostics(head, collect, NULL, 0, LRC_DIAG_DEDUP | LRC_DIAG_COLLECT) == 0);
+  CHECK(LRC_ASCIIParseFile("diag.cfg", "=", "#", head) == -1);
+  CHECK(nrecords == 2 && LRC_diagnosticCount(head) == 3);
+  CHECK(records[0].line == 2 && records[1].line == 6);
+  CHECK(strcmp(records[1].message, LRC_MSG_MISSING_SEP) == 0);
+
+  /* The first suppressed error is reported as the limit */
+  nrecords = 0;
+  CHECK(LRC_setDiagnostics(head, collect, NULL, 1, LRC_DIAG_COLLECT) == 0);
+  CHECK(LRC_ASCIIParseFile("diag.cfg", "=", "#", head) == -1);
+  CHECK(nrecords == 2 && LRC_diagnosticCount(head) == 3);
+  CHECK(records[0].line == 2 && records[1].code == LRC_ERR_LIMIT);
+  remove("diag.cfg");
+
+  /* Errors with no config go to the global handler */
+  nrecords = 0;
+  CHECK(LRC_setDiagnostics(NULL, collect, NULL, 0, 0) == 0);
+  LRC_message(7, LRC_ERR_WRONG_INPUT, "global");
+  CHECK(nrecords == 1 && records[0].line == 7 && strcmp(records[0].message, "global") == 0);
+  CHECK(records[0].file[0] == LRC_NULL && records[0].space[0] == LRC_NULL);
+
+  /* The global handler is the default of the configs */
+  nrecords = 0;
+  CHECK(LRC_setDiagnostics(head, NULL, NULL, 0, 0) == 0);
+  CHECK(LRC_ASCIIParseFile("diag-missing.cfg", "=", "#", head) == -1);
+  CHECK(nrecords == 1 && records[0].code == LRC_ERR_FILE_OPEN);
+  LRC_setDiagnostics(NULL, NULL, NULL, 0, 0);
+
+  LRC_cleanup(head);
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file diff.c
+ * @brief Test of the diff and patch of configs, and of the patch format.
+ */
+
+#include "test.h"
+
+int main(void){
+
+  LRC_configDefaults ca[] = {
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"default", "name", 0, "base", "", LRC_STRING, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "0, 1", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configDefaults cb[] = {
+    {"default", "nprocs", 0, "8", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.470", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "-0.0, 1.0", "", LRC_DOUBLE_ARRAY, 0},
+    {"farm", "xres", 0, "100", "", LRC_LONG, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* a = NULL;
+  LRC_configNamespace* b = NULL;
+  LRC_configDiff* diff = NULL;
+  LRC_configDiff* copy = NULL;
+  LRC_configDiff twice;
+  LRC_diffEntry entries[2];
+  char* buf = NULL;
+  size_t len, i;
+
+  a = LRC_assignDefaults(ca);
+  b = LRC_assignDefaults(cb);
+
+  /* Values are compared by type, not by spelling (-0.0 == 0.0) */
+  diff = LRC_diff(a, b);
+  CHECK(diff != NULL && diff->count == 3);
+  CHECK(diff->entries[0].op == LRC_DIFF_CHANGED && strcmp(diff->entries[0].name, "nprocs") == 0);
+  CHECK(strcmp(diff->entries[0].value, "8") == 0);
+  CHECK(diff->entries[1].op == LRC_DIFF_REMOVED && strcmp(diff->entries[1].name, "name") == 0);
+  CHECK(diff->entries[2].op == LRC_DIFF_ADDED && strcmp(diff->entries[2].space, "farm") == 0);
+  CHECK(diff->entries[2].type == LRC_LONG && strcmp(diff->entries[2].value, "100") == 0);
+
+  /* The patch format keeps the entries */
+  buf = LRC_diffPack(diff, &len);
+  CHECK(buf != NULL);
+  copy = LRC_diffUnpack(buf, len);
+  CHECK(copy != NULL && copy->count == diff->count);
+  for (i = 0; i < diff->count; i++) {
+    CHECK(copy->entries[i].op == diff->entries[i].op);
+    CHECK(copy->entries[i].type == diff->entries[i].type || diff->entries[i].op == LRC_DIFF_REMOVED);
+    CHECK(strcmp(copy->entries[i].space, diff->entries[i].space) == 0);
+    CHECK(strcmp(copy->entries[i].name, diff->entries[i].name) == 0);
+    CHECK(strcmp(copy->entries[i].value, diff->entries[i].value) == 0);
+  }
+  LRC_freeDiff(copy);
+
+  /* Truncated patches are rejected */
+  for (len = len - 1; len > 0; len--) {
+    CHECK(LRC_diffUnpack(buf, len) == NULL);
+  }
+  free(buf);
+
+  CHECK(LRC_diffWriteFile("diff.patch", diff) == 0);
+  copy = LRC_diffReadFile("diff.patch");
+  remove("diff.patch");
+  CHECK(copy != NULL && copy->count == 3);
+
+  /* Applied patch gives the second config */
+  CHECK(LRC_applyPatch(a, copy) == 3);
+  LRC_freeDiff(copy);
+  CHECK_VALUE(a, "default", "nprocs", "8");
+  CHECK_VALUE(a, "farm", "xres", "100");
+  CHECK(LRC_getOptionValue("default", "name", a) == NULL);
+  copy = LRC_diff(a, b);
+  CHECK(copy != NULL && copy->count == 0);
+  LRC_freeDiff(copy);
+
+  /* A patch that does not fit is not applied at all */
+  CHECK(LRC_applyPatch(a, diff) == -1);
+  CHECK_VALUE(a, "default", "nprocs", "8");
+
+  /* Neither is an option added twice */
+  entries[0].op = LRC_DIFF_ADDED;
+  entries[0].type = LRC_INT;
+  entries[0].space = "farm";
+  entries[0].name = "yres";
+  entries[0].value = "1";
+  entries[1] = entries[0];
+  entries[1].value = "2";
+  twice.count = 2;
+  twice.size = 2;
+  twice.entries = entries;
+  CHECK(LRC_applyPatch(a, &twice) == -1);
+  CHECK(LRC_getOptionValue("farm", "yres", a) == NULL);
+  twice.count = 1;
+  CHECK(LRC_applyPatch(a, &twice) == 1);
+  CHECK_VALUE(a, "farm", "yres", "1");
+
+  LRC_freeDiff(diff);
+  LRC_cleanup(a);
+  LRC_cleanup(b);
+
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file format.c
+ * @brief Test of the number formatting: the shortest text that reads back to
+ * exactly the same value.
+ */
+
+#include "test.h"
+
+#define CHECK_DOUBLE(value, expected) \
+  do { \
+    CHECK(LRC_double2str(str, value) == (int)strlen(expected)); \
+    if (strcmp(str, expected) != 0) { \
+      fprintf(stderr, "%s:%d: %s is '%s', expected '%s'\n", __FILE__, __LINE__, \
+          #value, str, expected); \
+      exit(1); \
+    } \
+  } while (0)
+
+static unsigned long long seed = 12345;
+
+/* Deterministic pseudo-random bits */
+static unsigned long long random_bits(void){
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return seed;
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "x", 0, "0.0", "", LRC_DOUBLE, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  char str[LRC_NUMBER_LEN];
+  unsigned long long bits;
+  unsigned int fbits;
+  double d, back;
+  float f, fback;
+  int i;
+
+  CHECK_DOUBLE(0.1, "0.1");
+  CHECK_DOUBLE(7.0, "7.0");
+  CHECK_DOUBLE(-0.0, "-0.0");
+  CHECK_DOUBLE(123456.789, "123456.789");
+  CHECK_DOUBLE(1e-10, "1e-10");
+  CHECK_DOUBLE(6.6743e-11, "6.6743e-11");
+  CHECK_DOUBLE(1e22, "1e+22");
+  CHECK_DOUBLE(5e-324, "5e-324");
+  CHECK_DOUBLE(1.7976931348623157e308, "1.7976931348623157e+308");
+  CHECK_DOUBLE(0.3333333333333333, "0.3333333333333333");
+
+  CHECK(LRC_float2str(str, 0.1f) > 0 && strcmp(str, "0.1") == 0);
+  CHECK(LRC_float2str(str, 3.4028235e38f) > 0 && strcmp(str, "3.4028235e+38") == 0);
+
+  /* Any finite value reads back to the same bits */
+  for (i = 0; i < 100000; i++) {
+    bits = random_bits();
+    memcpy(&d, &bits, sizeof(d));
+    if (d != d || d - d != 0) continue;
+
+    LRC_double2str(str, d);
+    CHECK(LRC_str2double(str, &back) == LRC_NUMBER_OK);
+    CHECK(memcmp(&d, &back, sizeof(d)) == 0);
+
+    fbits = (unsigned int)(bits >> 32);
+    memcpy(&f, &fbits, sizeof(f));
+    if (f != f || f - f != 0) continue;
+
+    LRC_float2str(str, f);
+    CHECK(LRC_str2float(str, &fback) == LRC_NUMBER_OK);
+    CHECK(memcmp(&f, &fback, sizeof(f)) == 0);
+  }
+
+  /* The setters store the same text */
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+  CHECK(LRC_setDouble("default", "x", 0.1, head) != NULL);
+  CHECK_VALUE(head, "default", "x", "0.1");
+  CHECK(LRC_getDouble("default", "x", &back, head) == LRC_NUMBER_OK && back == 0.1);
+  LRC_cleanup(head);
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file hash.c
+ * @brief Test of the fingerprint: the same for the same values, whatever the
+ * spelling and the order, and kept up to date on changes.
+ */
+
+#include "test.h"
+
+int main(void){
+
+  LRC_configDefaults ca[] = {
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"default", "name", 0, "base", "", LRC_STRING, 0},
+    {"logs", "period", 0, "1.0", "", LRC_DOUBLE, 0},
+    {"logs", "origin", 0, "0.0", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "1, 2", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configDefaults cb[] = {
+    {"logs", "v", 0, "1.0,2.00", "", LRC_DOUBLE_ARRAY, 0},
+    {"logs", "origin", 0, "-0.0", "", LRC_DOUBLE, 0},
+    {"logs", "period", 0, "1.00", "", LRC_DOUBLE, 0},
+    {"default", "name", 0, "base", "", LRC_STRING, 0},
+    {"default", "nprocs", 0, "+4", "", LRC_INT, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* a = NULL;
+  LRC_configNamespace* b = NULL;
+  LRC_configNamespace* c = NULL;
+  uint64_t ha[2], hb[2], h;
+  FILE* file = NULL;
+
+  a = LRC_assignDefaults(ca);
+  b = LRC_assignDefaults(cb);
+
+  /* Same values, other spelling and order */
+  LRC_hash128(a, ha);
+  LRC_hash128(b, hb);
+  CHECK(ha[0] == hb[0] && ha[1] == hb[1]);
+  CHECK(LRC_hash(a) == ha[0]);
+
+  /* A change is seen at once, and undone */
+  h = LRC_hash(a);
+  CHECK(LRC_modifyOption("default", "name", "other", LRC_STRING, a) != NULL);
+  CHECK(LRC_hash(a) != h);
+  CHECK(LRC_modifyOption("default", "name", "base", LRC_STRING, a) != NULL);
+  CHECK(LRC_hash(a) == h);
+
+  /* The type is a part of the option */
+  CHECK(LRC_modifyOption("default", "nprocs", "4", LRC_LONG, a) != NULL);
+  CHECK(LRC_hash(a) != h);
+  CHECK(LRC_modifyOption("default", "nprocs", "4", LRC_INT, a) != NULL);
+  CHECK(LRC_hash(a) == h);
+
+  /* The kept sum is the one computed from scratch */
+  CHECK(LRC_modifyOption("logs", "v", "1, 2, 3", LRC_DOUBLE_ARRAY, a) != NULL);
+  test_write("hash.cfg", "[logs]\nv = 1, 2, 3\n");
+  file = fopen("hash.cfg", "r");
+  CHECK(file && LRC_ASCIIParser(file, "=", "#", b) == 1);
+  fclose(file);
+  remove("hash.cfg");
+  CHECK(LRC_hash(a) == LRC_hash(b) && LRC_hash(a) != h);
+
+  /* Other options, other fingerprint */
+  c = LRC_assignDefaults(ca);
+  CHECK(LRC_hash(c) == h);
+  CHECK(LRC_modifyOption("logs", "origin", "1e-300", LRC_DOUBLE, c) != NULL);
+  CHECK(LRC_hash(c) != h);
+  LRC_cleanup(c);
+  ca[4].space[0] = LRC_NULL;
+  c = LRC_assignDefaults(ca);
+  CHECK(LRC_hash(c) != h);
+  LRC_cleanup(c);
+
+  LRC_cleanup(a);
+  LRC_cleanup(b);
+
+  return 0;
+}
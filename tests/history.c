@@ -0,0 +1,109 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file history.c
+ * @brief Test of the config history: the records are appended and the config
+ * of any step is rebuilt from them.
+ */
+
+#include "test.h"
+#include "libreadconfig_hdf5.h"
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"logs", "dump", 0, "100", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_configNamespace* step = NULL;
+  hid_t file;
+
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+
+  file = H5Fcreate("history.h5", H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  CHECK(file >= 0);
+
+  /* The first record holds the whole config, the next ones only the changes */
+  CHECK(LRC_HDF5HistoryWriter(file, "history", 0, head) == 3);
+  CHECK(LRC_HDF5HistoryWriter(file, "history", 5, head) == 0);
+
+  LRC_modifyOption("logs", "dump", "200", LRC_INT, head);
+  CHECK(LRC_HDF5HistoryWriter(file, "history", 10, head) == 1);
+
+  LRC_modifyOption("logs", "period", "1.5", LRC_DOUBLE, head);
+  LRC_modifyOption("default", "inidata", "x.dat", LRC_STRING, head);
+  CHECK(LRC_HDF5HistoryWriter(file, "history", 20, head) == 2);
+
+  /* The steps only grow */
+  CHECK(LRC_HDF5HistoryWriter(file, "history", 15, head) == -1);
+
+  CHECK(H5Fclose(file) >= 0);
+
+  file = H5Fopen("history.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+  CHECK(file >= 0);
+
+  step = LRC_assignDefaults(ct);
+  CHECK(LRC_HDF5HistoryParser(file, "history", 9, step) == 3);
+  CHECK_VALUE(step, "logs", "dump", "100");
+  LRC_cleanup(step);
+
+  step = LRC_assignDefaults(ct);
+  CHECK(LRC_HDF5HistoryParser(file, "history", 19, step) == 4);
+  CHECK_VALUE(step, "logs", "dump", "200");
+  CHECK_VALUE(step, "logs", "period", "23.47");
+  LRC_cleanup(step);
+
+  step = LRC_assignDefaults(ct);
+  CHECK(LRC_HDF5HistoryParser(file, "history", 25, step) == 6);
+  CHECK_VALUE(step, "default", "inidata", "x.dat");
+  CHECK_VALUE(step, "logs", "dump", "200");
+  CHECK_VALUE(step, "logs", "period", "1.5");
+  LRC_cleanup(step);
+
+  CHECK(LRC_HDF5HistoryParser(file, "missing", 25, head) == -1);
+
+  CHECK(H5Fclose(file) >= 0);
+  LRC_cleanup(head);
+
+  return 0;
+}
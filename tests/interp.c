@@ -0,0 +1,112 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file interp.c
+ * @brief Test of the interpolation of the ${namespace.name} references.
+ */
+
+#include "test.h"
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "root", 0, "/data", "", LRC_STRING, 0},
+    {"default", "run", 0, "${default.root}/run", "", LRC_STRING, 0},
+    {"default", "name", 0, "test", "", LRC_STRING, 0},
+    {"default", "literal", 0, "$${default.root}", "", LRC_STRING, 0},
+    {"default", "escaped", 0, "<$$${default.name}>", "", LRC_STRING, 0},
+    {"default", "quoted", 0, "${default.literal}", "", LRC_STRING, 0},
+    {"logs", "file", 0, "${logs.dir}/${default.name}.log", "", LRC_STRING, 0},
+    {"logs", "dir", 0, "${default.run}/logs", "", LRC_STRING, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  FILE* file = NULL;
+  char* text;
+
+  head = LRC_assignDefaults(ct);
+  CHECK(LRC_interpolate(head) == 0);
+
+  /* References and chains of references, also to the later options */
+  CHECK_VALUE(head, "default", "run", "/data/run");
+  CHECK_VALUE(head, "logs", "dir", "/data/run/logs");
+  CHECK_VALUE(head, "logs", "file", "/data/run/logs/test.log");
+
+  /* $${ is a literal ${, also when it comes from a reference */
+  CHECK_VALUE(head, "default", "literal", "${default.root}");
+  CHECK_VALUE(head, "default", "escaped", "<$${default.name}>");
+  CHECK_VALUE(head, "default", "quoted", "${default.root}");
+
+  /* A change is seen by the dependents only */
+  CHECK(LRC_modifyOption("default", "root", "/scratch", LRC_STRING, head) != NULL);
+  CHECK_VALUE(head, "logs", "file", "/scratch/run/logs/test.log");
+  CHECK(LRC_modifyOption("default", "name", "next", LRC_STRING, head) != NULL);
+  CHECK_VALUE(head, "logs", "file", "/scratch/run/logs/next.log");
+  CHECK_VALUE(head, "logs", "dir", "/scratch/run/logs");
+
+  /* A new reference rebuilds the graph */
+  CHECK(LRC_modifyOption("default", "name", "${default.root}", LRC_STRING, head) != NULL);
+  CHECK_VALUE(head, "logs", "file", "/scratch/run/logs//scratch.log");
+
+  /* The writers keep the references */
+  file = fopen("interp.cfg", "w");
+  CHECK(file && LRC_ASCIIWriter(file, "=", "#", head) == 0);
+  fclose(file);
+  text = test_read("interp.cfg");
+  CHECK(text && strstr(text, "${logs.dir}/${default.name}.log"));
+  free(text);
+  remove("interp.cfg");
+
+  /* Cycles fail until they are broken */
+  CHECK(LRC_modifyOption("default", "root", "${logs.dir}", LRC_STRING, head) != NULL);
+  CHECK(LRC_getOptionValue("logs", "file", head) == NULL);
+  CHECK(LRC_getOptionValue("default", "name", head) == NULL);
+  CHECK(LRC_modifyOption("default", "root", "/home", LRC_STRING, head) != NULL);
+  CHECK_VALUE(head, "logs", "file", "/home/run/logs//home.log");
+  LRC_cleanup(head);
+
+  /* Unknown references fail */
+  strcpy(ct[1].value, "${default.missing}");
+  head = LRC_assignDefaults(ct);
+  CHECK(LRC_interpolate(head) == -1);
+  CHECK(LRC_getOptionValue("default", "run", head) == NULL);
+  LRC_cleanup(head);
+
+  return 0;
+}
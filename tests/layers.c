@@ -0,0 +1,130 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file layers.c
+ * @brief Test of the layered config: the precedence of the layers and the
+ * source of the values.
+ */
+
+/* setenv, unsetenv */
+#define _POSIX_C_SOURCE 200809L
+
+#include "test.h"
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    {"farm", "x-res", 0, "100", "", LRC_LONG, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configLayers* layers = NULL;
+  LRC_configNamespace* head = NULL;
+  char* value;
+  double d;
+  float f;
+  long l;
+  int k, layer;
+
+  layers = LRC_newLayers(ct);
+  CHECK(layers != NULL);
+
+  /* Only the defaults */
+  value = LRC_layerGet(layers, "default", "nprocs", &layer);
+  CHECK(value && strcmp(value, "4") == 0 && layer == LRC_LAYER_DEFAULTS);
+  CHECK(LRC_layerGet(layers, "default", "missing", &layer) == NULL);
+  CHECK(LRC_layerSource(layers, "default", "missing") == -1);
+
+  /* A missing file is an empty layer */
+  CHECK(LRC_layerFile(layers, LRC_LAYER_SYSTEM, "layers-missing.cfg", "=", "#") == 0);
+
+  test_write("layers-sys.cfg", "[default]\nnprocs = 8\ninidata = sys.dat\n[logs]\nperiod = 1.5\n");
+  test_write("layers-user.cfg", "[default]\nnprocs = 16\n");
+  CHECK(LRC_layerFile(layers, LRC_LAYER_SYSTEM, "layers-sys.cfg", "=", "#") == 3);
+  CHECK(LRC_layerFile(layers, LRC_LAYER_USER, "layers-user.cfg", "=", "#") == 1);
+  remove("layers-sys.cfg");
+  remove("layers-user.cfg");
+
+  /* Wrong values and unknown options are rejected */
+  test_write("layers-bad.cfg", "[default]\nnprocs = many\n");
+  CHECK(LRC_layerFile(layers, LRC_LAYER_USER, "layers-bad.cfg", "=", "#") == -1);
+  remove("layers-bad.cfg");
+  CHECK(LRC_layerSet(layers, LRC_LAYER_CLI, "default", "nprocs", "many") == -1);
+  CHECK(LRC_layerSet(layers, LRC_LAYER_CLI, "default", "missing", "1") == -1);
+  CHECK(LRC_layerSource(layers, "default", "nprocs") == LRC_LAYER_USER);
+
+  /* The environment overrides the files, the command line overrides all */
+  setenv("LRC_FARM_X_RES", "200", 1);
+  setenv("LRC_DEFAULT_NPROCS", "32", 1);
+  CHECK(LRC_layerEnv(layers) == 2);
+  unsetenv("LRC_FARM_X_RES");
+  unsetenv("LRC_DEFAULT_NPROCS");
+  CHECK(LRC_layerSource(layers, "default", "nprocs") == LRC_LAYER_ENV);
+  CHECK(LRC_layerSet(layers, LRC_LAYER_CLI, "default", "nprocs", "64") == 0);
+
+  value = LRC_layerGet(layers, "default", "nprocs", &layer);
+  CHECK(value && strcmp(value, "64") == 0 && layer == LRC_LAYER_CLI);
+  value = LRC_layerGet(layers, "farm", "x-res", &layer);
+  CHECK(value && strcmp(value, "200") == 0 && layer == LRC_LAYER_ENV);
+  value = LRC_layerGet(layers, "default", "inidata", &layer);
+  CHECK(value && strcmp(value, "sys.dat") == 0 && layer == LRC_LAYER_SYSTEM);
+  CHECK(strcmp(LRC_layerName(LRC_LAYER_SYSTEM), "system file") == 0);
+  CHECK(strcmp(LRC_layerName(LRC_LAYER_CLI), "command line") == 0);
+
+  CHECK(LRC_layerGetInt(layers, "default", "nprocs", &k) == LRC_NUMBER_OK && k == 64);
+  CHECK(LRC_layerGetLong(layers, "farm", "x-res", &l) == LRC_NUMBER_OK && l == 200);
+  CHECK(LRC_layerGetDouble(layers, "logs", "period", &d) == LRC_NUMBER_OK && d == 1.5);
+  CHECK(LRC_layerGetFloat(layers, "logs", "period", &f) == LRC_NUMBER_OK && f == 1.5f);
+
+  /* The merged config, the defaults are left untouched */
+  head = LRC_layers2config(layers);
+  CHECK(head != NULL);
+  CHECK_VALUE(head, "default", "nprocs", "64");
+  CHECK_VALUE(head, "default", "inidata", "sys.dat");
+  CHECK_VALUE(head, "logs", "period", "1.5");
+  CHECK_VALUE(head, "farm", "x-res", "200");
+  CHECK_VALUE(layers->defaults, "default", "nprocs", "4");
+  LRC_cleanup(head);
+
+  LRC_freeLayers(layers);
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file mpi.c
+ * @brief Test of the distribution of the config and of the consistency check
+ * (run with mpiexec).
+ */
+
+#include "test.h"
+#include "libreadconfig_mpi.h"
+
+static int mismatches = 0;
+
+/**
+ * @fn static void count(LRC_diagnostic* diagnostic, void* data)
+ * @brief Counts the options reported by LRC_MPI_Verify().
+ */
+static void count(LRC_diagnostic* diagnostic, void* data){
+
+  (void)data;
+
+  if (diagnostic->code == LRC_ERR_MPI && diagnostic->name && strcmp(diagnostic->name, "dump") == 0) {
+    mismatches++;
+  }
+}
+
+int main(int argc, char** argv){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"logs", "dump", 0, "100", "", LRC_INT, 0},
+    {"logs", "grid", 0, "1, 2, 3", "", LRC_INT_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  int grid[3];
+  int rank;
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  head = LRC_assignDefaults(ct);
+
+  /* The config of the root reaches all ranks */
+  if (rank == 1) {
+    LRC_modifyOption("default", "inidata", "root.dat", LRC_STRING, head);
+    LRC_modifyOption("logs", "grid", "4, 5, 6", LRC_INT_ARRAY, head);
+  }
+  CHECK(LRC_MPI_Bcast(MPI_COMM_WORLD, 1, head) == 0);
+  CHECK_VALUE(head, "default", "inidata", "root.dat");
+  CHECK(LRC_getIntArray("logs", "grid", grid, 3, head) == 3);
+  CHECK(grid[0] == 4 && grid[1] == 5 && grid[2] == 6);
+
+  /* Once per node */
+  if (rank == 0) LRC_modifyOption("logs", "dump", "200", LRC_INT, head);
+  CHECK(LRC_MPI_NodeBcast(MPI_COMM_WORLD, 0, head) == 0);
+  CHECK_VALUE(head, "logs", "dump", "200");
+  CHECK_VALUE(head, "default", "inidata", "root.dat");
+
+  /* The same config on all ranks */
+  CHECK(LRC_MPI_Verify(MPI_COMM_WORLD, head) == 0);
+
+  /* The rank with the other value reports it, all ranks fail */
+  LRC_setDiagnostics(head, count, NULL, 0, 0);
+  if (rank == 2) LRC_modifyOption("logs", "dump", "300", LRC_INT, head);
+  CHECK(LRC_MPI_Verify(MPI_COMM_WORLD, head) == -1);
+  CHECK(mismatches == (rank == 2 ? 1 : 0));
+
+  /* Spelling is not a difference */
+  if (rank == 2) LRC_modifyOption("logs", "dump", "+200", LRC_INT, head);
+  CHECK(LRC_MPI_Verify(MPI_COMM_WORLD, head) == 0);
+
+  LRC_cleanup(head);
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file overlay.c
+ * @brief Test of the index and of the overlays: sparse overrides on top of a
+ * shared base config.
+ */
+
+#include "test.h"
+
+#define OPTIONS 1000
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"default", "name", 0, "base", "", LRC_STRING, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "1, 2", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configDefaults* many = NULL;
+  LRC_configNamespace* head = NULL;
+  LRC_configNamespace* copy = NULL;
+  LRC_configIndex* index = NULL;
+  LRC_configOverlay* a = NULL;
+  LRC_configOverlay* b = NULL;
+  double d;
+  int i, k, type;
+
+  /* The index finds every option of a large config */
+  many = calloc(OPTIONS + 1, sizeof(LRC_configDefaults));
+  CHECK(many != NULL);
+  for (i = 0; i < OPTIONS; i++) {
+    sprintf(many[i].space, "space%d", i / 10);
+    sprintf(many[i].name, "option%d", i);
+    sprintf(many[i].value, "%d", i);
+    many[i].type = LRC_INT;
+  }
+  head = LRC_assignDefaults(many);
+  index = LRC_indexConfig(head);
+  CHECK(index != NULL);
+  for (i = 0; i < OPTIONS; i++) {
+    CHECK(LRC_indexFind(index, many[i].space, many[i].name) != NULL);
+    CHECK(atoi(LRC_indexFind(index, many[i].space, many[i].name)->value) == i);
+  }
+  CHECK(LRC_indexFind(index, "space0", "option10") == NULL);
+  CHECK(LRC_indexFind(index, "nospace", "option0") == NULL);
+  LRC_freeIndex(index);
+  LRC_cleanup(head);
+  free(many);
+
+  head = LRC_assignDefaults(ct);
+  index = LRC_indexConfig(head);
+  a = LRC_newOverlay(index);
+  b = LRC_newOverlay(index);
+  CHECK(a != NULL && b != NULL);
+
+  /* The overrides are private to the overlay */
+  CHECK(LRC_overlaySet(a, "default", "nprocs", "16", LRC_INT) == 0);
+  CHECK(LRC_overlaySet(a, "logs", "v", "3, 4, 5", LRC_DOUBLE_ARRAY) == 0);
+  CHECK(LRC_overlaySet(b, "default", "name", "task", LRC_STRING) == 0);
+
+  CHECK(LRC_overlayGetInt(a, "default", "nprocs", &k) == LRC_NUMBER_OK && k == 16);
+  CHECK(LRC_overlayGetInt(b, "default", "nprocs", &k) == LRC_NUMBER_OK && k == 4);
+  CHECK(strcmp(LRC_overlayGet(b, "default", "name", &type), "task") == 0 && type == LRC_STRING);
+  CHECK(strcmp(LRC_overlayGet(a, "default", "name", NULL), "base") == 0);
+  CHECK(LRC_overlayGetDouble(a, "logs", "period", &d) == LRC_NUMBER_OK && d == 23.47);
+  CHECK(LRC_overlayGetInt(a, "logs", "missing", &k) == LRC_NUMBER_INVALID);
+  CHECK_VALUE(head, "default", "nprocs", "4");
+
+  /* Unknown options, type changes and wrong values are rejected */
+  CHECK(LRC_overlaySet(a, "logs", "missing", "1", LRC_INT) == -1);
+  CHECK(LRC_overlaySet(a, "default", "nprocs", "16", LRC_STRING) == -1);
+  CHECK(LRC_overlaySet(a, "default", "nprocs", "abc", LRC_INT) == -1);
+  CHECK(LRC_overlaySet(a, "default", "nprocs", "99999999999", LRC_INT) == -1);
+  CHECK(LRC_overlaySet(a, "logs", "v", "1, x", LRC_DOUBLE_ARRAY) == -1);
+  CHECK(LRC_overlayGetInt(a, "default", "nprocs", &k) == LRC_NUMBER_OK && k == 16);
+
+  /* The full config of the overlay */
+  copy = LRC_overlay2config(a);
+  CHECK(copy != NULL);
+  CHECK_VALUE(copy, "default", "nprocs", "16");
+  CHECK_VALUE(copy, "default", "name", "base");
+  CHECK(LRC_getDoubleArray("logs", "v", NULL, 0, copy) == 3);
+  LRC_cleanup(copy);
+
+  LRC_freeOverlay(a);
+  LRC_freeOverlay(b);
+  LRC_freeIndex(index);
+  LRC_cleanup(head);
+
+  return 0;
+}
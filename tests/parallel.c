@@ -0,0 +1,107 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file parallel.c
+ * @brief Test of the collective HDF5 writer and parser (run with mpiexec).
+ *
+ * The config of rank 0 is written to the file and read back on all ranks.
+ * Without parallel HDF5 the test is skipped.
+ */
+
+#include "test.h"
+#include "libreadconfig_hdf5.h"
+
+#ifdef H5_HAVE_PARALLEL
+int main(int argc, char** argv){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"logs", "dump", 0, "100", "", LRC_INT, 0},
+    {"logs", "grid", 0, "1, 2, 3", "", LRC_INT_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  int grid[3];
+  int rank;
+  hid_t fapl, file;
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+
+  /* Only the config of rank 0 is stored */
+  if (rank == 0) {
+    LRC_modifyOption("logs", "dump", "200", LRC_INT, head);
+    LRC_modifyOption("logs", "grid", "4, 5, 6", LRC_INT_ARRAY, head);
+  }
+
+  fapl = H5Pcreate(H5P_FILE_ACCESS);
+  CHECK(fapl >= 0);
+  CHECK(H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL) >= 0);
+
+  file = H5Fcreate("parallel.h5", H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+  CHECK(file >= 0);
+  CHECK(LRC_HDF5ParallelWriter(file, LRC_CONFIG_GROUP, MPI_COMM_WORLD, head) == 0);
+  CHECK(H5Fclose(file) >= 0);
+  LRC_cleanup(head);
+
+  head = LRC_assignDefaults(ct);
+  file = H5Fopen("parallel.h5", H5F_ACC_RDONLY, fapl);
+  CHECK(file >= 0);
+  CHECK(LRC_HDF5ParallelParser(file, LRC_CONFIG_GROUP, MPI_COMM_WORLD, head) == 2);
+  CHECK(H5Fclose(file) >= 0);
+
+  CHECK_VALUE(head, "default", "inidata", "test.dat");
+  CHECK_VALUE(head, "logs", "dump", "200");
+  CHECK(LRC_getIntArray("logs", "grid", grid, 3, head) == 3);
+  CHECK(grid[0] == 4 && grid[1] == 5 && grid[2] == 6);
+
+  H5Pclose(fapl);
+  LRC_cleanup(head);
+  MPI_Finalize();
+
+  return 0;
+}
+#else
+int main(void){
+  return LRC_TEST_SKIP;
+}
+#endif
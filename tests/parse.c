@@ -0,0 +1,125 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file parse.c
+ * @brief Test of the number parsers: correctly rounded, independent of the
+ * locale, with the errors of strtod() and strtol() reported as the status.
+ */
+
+#include "test.h"
+
+#define CHECK_STATUS(str, status, expected) \
+  do { \
+    double value_; \
+    CHECK(LRC_str2double(str, &value_) == status); \
+    CHECK(value_ == expected); \
+  } while (0)
+
+static unsigned long long seed = 12345;
+
+/* Deterministic pseudo-random bits */
+static unsigned long long random_bits(void){
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return seed >> 11;
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "n", 0, "12abc", "", LRC_INT, 0},
+    {"default", "x", 0, "2.5", "", LRC_DOUBLE, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  char str[LRC_NUMBER_LEN];
+  char* locales[] = {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "pl_PL.UTF-8", NULL};
+  double d, expected;
+  float f;
+  long l;
+  int i, k;
+
+  CHECK_STATUS("  -2.5e3  ", LRC_NUMBER_OK, -2500.0);
+  CHECK_STATUS(".5", LRC_NUMBER_OK, 0.5);
+  CHECK_STATUS("+7", LRC_NUMBER_OK, 7.0);
+  CHECK_STATUS("1,5", LRC_NUMBER_INVALID, 0.0);
+  CHECK_STATUS("1e", LRC_NUMBER_INVALID, 0.0);
+  CHECK_STATUS("", LRC_NUMBER_INVALID, 0.0);
+  CHECK_STATUS("1e-400", LRC_NUMBER_RANGE, 0.0);
+  CHECK_STATUS("1e400", LRC_NUMBER_RANGE, HUGE_VAL);
+
+  /* The halfway cases are rounded correctly */
+  CHECK_STATUS("2.2250738585072011e-308", LRC_NUMBER_OK, 2.2250738585072011e-308);
+  CHECK_STATUS("0.1000000000000000055511151231257827021181583404541015625", LRC_NUMBER_OK, 0.1);
+  CHECK_STATUS("9007199254740993", LRC_NUMBER_OK, 9007199254740992.0);
+
+  CHECK(LRC_str2float("1e39", &f) == LRC_NUMBER_RANGE);
+  CHECK(LRC_str2int("2147483648", &k) == LRC_NUMBER_RANGE && k == INT_MAX);
+  CHECK(LRC_str2long("-9223372036854775808", &l) == LRC_NUMBER_OK && l == LONG_MIN);
+  CHECK(LRC_str2long("12abc", &l) == LRC_NUMBER_INVALID);
+
+  /* The same values as strtod() in the C locale */
+  for (i = 0; i < 100000; i++) {
+    sprintf(str, "%llu.%llue%d", random_bits() % 100000000, random_bits(),
+        (int)(random_bits() % 600) - 300);
+    expected = strtod(str, NULL);
+    CHECK(LRC_str2double(str, &d) == LRC_NUMBER_OK);
+    if (d != expected) {
+      fprintf(stderr, "%s: %.17g, expected %.17g\n", str, d, expected);
+      return 1;
+    }
+  }
+
+  /* A decimal comma in the locale of the program changes nothing */
+  for (i = 0; locales[i]; i++) {
+    if (setlocale(LC_ALL, locales[i])) break;
+  }
+  CHECK_STATUS("1.5", LRC_NUMBER_OK, 1.5);
+  CHECK(LRC_double2str(str, 1.5) > 0 && strcmp(str, "1.5") == 0);
+  setlocale(LC_ALL, "C");
+
+  /* The converters take the number at the beginning, the getters report the rest */
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+  CHECK(LRC_option2int("default", "n", head) == 12);
+  CHECK(LRC_getInt("default", "n", &k, head) == LRC_NUMBER_INVALID);
+  CHECK(LRC_option2double("default", "x", head) == 2.5);
+  LRC_cleanup(head);
+
+  return 0;
+}
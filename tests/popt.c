@@ -0,0 +1,133 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file popt.c
+ * @brief Test of the popt tables generated from the defaults.
+ */
+
+#include "test.h"
+
+/**
+ * @fn static int parse(struct poptOption* lrc, int argc, const char** argv)
+ * @brief Parses the command line with the table included, as a program does.
+ *
+ * @return
+ *  The last code of poptGetNextOpt() (-1 when all arguments were read)
+ */
+static int parse(struct poptOption* lrc, int argc, const char** argv){
+
+  struct poptOption table[] = {
+    {NULL, '\0', POPT_ARG_INCLUDE_TABLE, NULL, 0, "Config options:", NULL},
+    POPT_TABLEEND
+  };
+  poptContext context;
+  int rc;
+
+  table[0].arg = lrc;
+  context = poptGetContext(NULL, argc, argv, table, 0);
+  while ((rc = poptGetNextOpt(context)) > 0);
+  poptFreeContext(context);
+
+  return rc;
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "nprocs", 'n', "4", "Number of processes", LRC_INT, 0},
+    {"default", "name", 0, "base", "", LRC_STRING, 0},
+    {"default", "verbose", 0, "0", "", LRC_VAL, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "1, 2", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  const char* args[] = {"test-popt", "--default-name=run", "--logs-period", "1.5",
+    "--default-verbose", "-n", "16", "--logs-v=3, 4, 5"};
+  const char* wrong[] = {"test-popt", "--default-nprocs=many", "--logs-period=1.5.1"};
+  const char* cli[] = {"test-popt", "--default-nprocs=32"};
+  LRC_configNamespace* head = NULL;
+  LRC_configLayers* layers = NULL;
+  struct poptOption* table = NULL;
+  int k;
+
+  /* The arguments are stored in the config */
+  head = LRC_assignDefaults(ct);
+  table = LRC_poptTable(ct, head);
+  CHECK(table != NULL);
+  CHECK(strcmp(table[1].longName, "default-nprocs") == 0 && table[1].shortName == 'n');
+  CHECK(strcmp(table[1].descrip, "Number of processes") == 0);
+
+  CHECK(parse(table, 8, args) == -1);
+  CHECK(LRC_poptErrors(table) == 0);
+  CHECK_VALUE(head, "default", "nprocs", "16");
+  CHECK_VALUE(head, "default", "name", "run");
+  CHECK_VALUE(head, "default", "verbose", "1");
+  CHECK_VALUE(head, "logs", "period", "1.5");
+  CHECK(LRC_getDoubleArray("logs", "v", NULL, 0, head) == 3);
+
+  /* Wrong numbers are counted and leave the config untouched */
+  CHECK(parse(table, 3, wrong) == -1);
+  CHECK(LRC_poptErrors(table) == 2);
+  CHECK_VALUE(head, "default", "nprocs", "16");
+  CHECK_VALUE(head, "logs", "period", "1.5");
+  free(table);
+
+  /* The config must have all of the defaults */
+  ct[1].type = LRC_INT;
+  strcpy(ct[1].name, "missing");
+  CHECK(LRC_poptTable(ct, head) == NULL);
+  strcpy(ct[1].name, "name");
+  ct[1].type = LRC_STRING;
+  LRC_cleanup(head);
+
+  /* The arguments go to the command line layer */
+  layers = LRC_newLayers(ct);
+  table = LRC_poptLayerTable(ct, layers);
+  CHECK(table != NULL);
+  CHECK(parse(table, 2, cli) == -1);
+  CHECK(LRC_poptErrors(table) == 0);
+  CHECK(LRC_layerSource(layers, "default", "nprocs") == LRC_LAYER_CLI);
+  CHECK(LRC_layerGetInt(layers, "default", "nprocs", &k) == LRC_NUMBER_OK && k == 32);
+  CHECK(LRC_layerSource(layers, "default", "name") == LRC_LAYER_DEFAULTS);
+  CHECK_VALUE(layers->defaults, "default", "nprocs", "4");
+  free(table);
+  LRC_freeLayers(layers);
+
+  return 0;
+}
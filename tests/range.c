@@ -0,0 +1,132 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file range.c
+ * @brief Test of the lazy sweep expansion from the range and list syntax.
+ */
+
+#include "test.h"
+
+static LRC_sweepIterator* iterator(char* text, LRC_configDefaults* ct,
+    LRC_configNamespace** head, LRC_configIndex** index){
+
+  test_write("range.cfg", text);
+  *head = LRC_assignDefaults(ct);
+  CHECK(LRC_ASCIIParseFile("range.cfg", "=", "#", *head) >= 0);
+  *index = LRC_indexConfig(*head);
+  CHECK(*index != NULL);
+
+  return LRC_newSweepIterator(*index);
+}
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    {"farm", "xres", 0, "100", "", LRC_INT, 0},
+    {"farm", "yres", 0, "0.1", "", LRC_FLOAT, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_configIndex* index = NULL;
+  LRC_sweepIterator* it = NULL;
+  LRC_configOverlay* task = NULL;
+  LRC_configSweep* sweep = NULL;
+  char str[LRC_CONFIG_LEN];
+  size_t n;
+  double period;
+  int xres;
+
+  it = iterator("[farm]\nxres = 100:2000:10\nyres = 0.1:0.3:0.1\n[logs]\nperiod = {1.5, 2.5,3}\n",
+      ct, &head, &index);
+  CHECK(it != NULL);
+
+  /* period (3) x xres (191) x yres (3), the last dimension changes fastest */
+  CHECK(it->ndims == 3 && it->ntasks == 1719);
+
+  task = LRC_sweepSeek(it, 4);
+  CHECK(task != NULL);
+  CHECK(LRC_overlayGetDouble(task, "logs", "period", &period) == LRC_NUMBER_OK && period == 1.5);
+  CHECK(LRC_overlayGetInt(task, "farm", "xres", &xres) == LRC_NUMBER_OK && xres == 110);
+  CHECK(strcmp(LRC_overlayGet(task, "farm", "yres", NULL), "0.2") == 0);
+  CHECK(strcmp(LRC_overlayGet(task, "default", "inidata", NULL), "test.dat") == 0);
+
+  task = LRC_sweepSeek(it, it->ntasks - 1);
+  CHECK(task != NULL);
+  CHECK(LRC_overlayGetDouble(task, "logs", "period", &period) == LRC_NUMBER_OK && period == 3.0);
+  CHECK(LRC_overlayGetInt(task, "farm", "xres", &xres) == LRC_NUMBER_OK && xres == 2000);
+  CHECK(LRC_sweepSeek(it, it->ntasks) == NULL);
+
+  CHECK(LRC_sweepValue(it, 1718, 2, str) == 0 && strcmp(str, "0.3") == 0);
+  CHECK(LRC_sweepValue(it, 0, 3, str) == -1);
+
+  /* The iteration goes from the task after the last one reached */
+  CHECK(LRC_sweepSeek(it, 0) != NULL);
+  for (n = 0; LRC_sweepNext(it); n++);
+  CHECK(n == it->ntasks - 1);
+
+  /* The expanded tasks are the same, the period changes at the task 573 */
+  sweep = LRC_sweepExpand(it, 570, 10);
+  CHECK(sweep != NULL && sweep->ntasks == 10);
+  CHECK(LRC_sweepFormat(sweep, 0, LRC_sweepFind(sweep, "farm", "xres"), str) == 0);
+  task = LRC_sweepSeek(it, 570);
+  CHECK(strcmp(str, LRC_overlayGet(task, "farm", "xres", NULL)) == 0);
+  CHECK(LRC_sweepSelect(sweep, LRC_sweepFind(sweep, "logs", "period"), LRC_SWEEP_EQ, 1.5, NULL) == 3);
+  CHECK(LRC_sweepSelect(sweep, LRC_sweepFind(sweep, "logs", "period"), LRC_SWEEP_EQ, 2.5, NULL) == 7);
+  LRC_freeSweep(sweep);
+
+  LRC_freeSweepIterator(it);
+  LRC_freeIndex(index);
+  LRC_cleanup(head);
+
+  /* Wrong syntax and too many tasks */
+  it = iterator("[farm]\nxres = 100:x\n", ct, &head, &index);
+  CHECK(it == NULL);
+  LRC_freeIndex(index);
+  LRC_cleanup(head);
+
+  it = iterator("[farm]\nxres = 0:2000000000\nyres = 0:2000000000:0.5\n[logs]\nperiod = 0:1e12\n",
+      ct, &head, &index);
+  CHECK(it == NULL);
+  LRC_freeIndex(index);
+  LRC_cleanup(head);
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file schema.c
+ * @brief Test of the parser and writer generated by lrc-schema from
+ * schema.schema.
+ */
+
+#include "test.h"
+#include "schema_config.h"
+
+/* The last reported error */
+static LRC_diagnostic last;
+
+static void collect(LRC_diagnostic* diagnostic, void* data){
+  (void)data;
+  last = *diagnostic;
+}
+
+static int parse(char* path, schema_config* c){
+
+  FILE* file = NULL;
+  int status;
+
+  file = fopen(path, "r");
+  CHECK(file != NULL);
+  status = schema_parse(file, "=", "#", c);
+  fclose(file);
+
+  return status;
+}
+
+int main(void){
+
+  schema_config c, d;
+  FILE* file = NULL;
+
+  LRC_setDiagnostics(NULL, collect, NULL, 0, 0);
+
+  schema_defaults(&c);
+  CHECK(strcmp(c.default_inidata, "test.dat") == 0);
+  CHECK(c.default_nprocs == 4 && c.logs_period == 23.47 && c.farm_xres == 100);
+
+  CHECK(schema_lookup("logs", "dump") == SCHEMA_LOGS_DUMP);
+  CHECK(schema_lookup("logs", "nprocs") == SCHEMA_UNKNOWN);
+
+  test_write("schema.cfg", "[default]\nnprocs = 16 # comment\n\n[logs]\nperiod = 0.5\n");
+  CHECK(parse("schema.cfg", &c) == 2);
+  CHECK(c.default_nprocs == 16 && c.logs_period == 0.5 && c.logs_dump == 2000);
+
+  /* The written file reads back to the same values */
+  file = fopen("schema-out.cfg", "w");
+  CHECK(file != NULL);
+  CHECK(schema_write(file, "=", "#", &c) == 0);
+  CHECK(fclose(file) == 0);
+
+  schema_defaults(&d);
+  CHECK(parse("schema-out.cfg", &d) == 3);
+  CHECK(strcmp(c.default_inidata, d.default_inidata) == 0);
+  CHECK(c.default_nprocs == d.default_nprocs && c.logs_period == d.logs_period);
+  CHECK(c.logs_dump == d.logs_dump && c.farm_xres == d.farm_xres && c.farm_yres == d.farm_yres);
+
+  /* The errors go to the diagnostics */
+  test_write("schema.cfg", "[default]\nnprocs = 4\nbogus = 1\n");
+  CHECK(parse("schema.cfg", &c) == -1);
+  CHECK(last.code == LRC_ERR_CONFIG_SYNTAX && last.line == 3);
+  CHECK(strcmp(last.message, LRC_MSG_UNKNOWN_VAR) == 0);
+
+  test_write("schema.cfg", "[logs]\ndump = 1.5\n");
+  CHECK(parse("schema.cfg", &c) == -1);
+  CHECK(last.line == 2 && strcmp(last.message, LRC_MSG_WRONG_INPUT) == 0);
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file stats.c
+ * @brief Test of the statistics: the counters of the config and the global
+ * ones, or zeros without LRC_STATS.
+ */
+
+#include "test.h"
+
+#define TEXT "[default]\nnprocs = 8\n\n[logs]\nperiod = 1.5\n"
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "nprocs", 0, "4", "", LRC_INT, 0},
+    {"logs", "period", 0, "23.47", "", LRC_DOUBLE, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_stats stats, global;
+  FILE* file = NULL;
+  int k;
+
+  LRC_resetStats(NULL);
+  head = LRC_assignDefaults(ct);
+  LRC_resetStats(head);
+
+  test_write("stats.cfg", TEXT);
+  file = fopen("stats.cfg", "r");
+  CHECK(file && LRC_ASCIIParser(file, "=", "#", head) == 2);
+  fclose(file);
+  remove("stats.cfg");
+  CHECK(LRC_getInt("default", "nprocs", &k, head) == LRC_NUMBER_OK && k == 8);
+
+  stats = LRC_getStats(head);
+  global = LRC_getStats(NULL);
+
+#ifdef LRC_STATS
+  CHECK(stats.lines == 5);
+  CHECK(stats.bytes == strlen(TEXT));
+  CHECK(stats.lookups > 0 && stats.probes >= stats.lookups);
+  CHECK(stats.conversions > 0);
+  CHECK(global.lines >= stats.lines && global.allocations > 0);
+#else
+  CHECK(stats.lines == 0 && stats.lookups == 0 && stats.conversions == 0);
+  CHECK(global.lines == 0 && global.allocations == 0);
+#endif
+  CHECK(strcmp(LRC_phaseName(LRC_PHASE_READ), "read") == 0);
+
+  /* Reset zeroes the counters */
+  LRC_resetStats(head);
+  stats = LRC_getStats(head);
+  CHECK(stats.lines == 0 && stats.bytes == 0 && stats.time[LRC_PHASE_READ] == 0);
+
+  LRC_cleanup(head);
+
+  return 0;
+}
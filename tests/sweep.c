@@ -0,0 +1,137 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file sweep.c
+ * @brief Test of the columnar sweeps: typed columns, the string dictionary,
+ * the selections and the overlays of the tasks.
+ */
+
+/* SIZE_MAX */
+#include <stdint.h>
+
+#include "test.h"
+
+#define TASKS 100
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "inidata", 0, "test.dat", "", LRC_STRING, 0},
+    {"farm", "xres", 0, "100", "", LRC_INT, 0},
+    {"logs", "period", 0, "0.5", "", LRC_DOUBLE, 0},
+    {"logs", "v", 0, "1, 2", "", LRC_DOUBLE_ARRAY, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+  LRC_configIndex* index = NULL;
+  LRC_configSweep* sweep = NULL;
+  LRC_configOverlay* task = NULL;
+  size_t tasks[TASKS], i;
+  char str[LRC_CONFIG_LEN];
+  double* period = NULL;
+  int* codes = NULL;
+  int* xres = NULL;
+  int x, p, s, type, k;
+
+  head = LRC_assignDefaults(ct);
+  index = LRC_indexConfig(head);
+  sweep = LRC_newSweep(index, TASKS);
+  CHECK(sweep != NULL);
+
+  x = LRC_sweepAddColumn(sweep, "farm", "xres");
+  p = LRC_sweepAddColumn(sweep, "logs", "period");
+  s = LRC_sweepAddColumn(sweep, "default", "inidata");
+  CHECK(x >= 0 && p >= 0 && s >= 0);
+  CHECK(LRC_sweepAddColumn(sweep, "farm", "xres") == x);
+  CHECK(LRC_sweepFind(sweep, "logs", "period") == p);
+  CHECK(LRC_sweepAddColumn(sweep, "logs", "v") == -1);
+  CHECK(LRC_sweepAddColumn(sweep, "logs", "missing") == -1);
+
+  /* The columns start with the base values */
+  xres = LRC_sweepColumnData(sweep, x, &type);
+  CHECK(xres != NULL && type == LRC_INT);
+  period = LRC_sweepColumnData(sweep, p, &type);
+  CHECK(period != NULL && type == LRC_DOUBLE);
+  codes = LRC_sweepColumnData(sweep, s, &type);
+  CHECK(codes != NULL && type == LRC_STRING);
+  for (i = 0; i < TASKS; i++) {
+    CHECK(xres[i] == 100 && period[i] == 0.5);
+    CHECK(strcmp(LRC_sweepString(sweep, codes[i]), "test.dat") == 0);
+  }
+
+  for (i = 0; i < TASKS; i++) xres[i] = (int)i * 10;
+  CHECK(LRC_sweepSet(sweep, 3, p, "2.5") == 0);
+  CHECK(LRC_sweepSet(sweep, 3, x, "abc") == -1);
+  CHECK(LRC_sweepSet(sweep, TASKS, x, "1") == -1);
+  CHECK(LRC_sweepSet(sweep, 7, s, "a.dat") == 0);
+  CHECK(LRC_sweepSet(sweep, 9, s, "a.dat") == 0);
+  CHECK(codes[7] == codes[9] && codes[7] != codes[0]);
+
+  CHECK(LRC_sweepFormat(sweep, 3, p, str) == 0 && strcmp(str, "2.5") == 0);
+  CHECK(LRC_sweepFormat(sweep, 7, s, str) == 0 && strcmp(str, "a.dat") == 0);
+
+  /* Selections */
+  CHECK(LRC_sweepSelect(sweep, x, LRC_SWEEP_GE, 950, tasks) == 5);
+  CHECK(tasks[0] == 95 && tasks[4] == 99);
+  CHECK(LRC_sweepSelect(sweep, p, LRC_SWEEP_NE, 0.5, NULL) == 1);
+  CHECK(LRC_sweepSelectString(sweep, s, "a.dat", tasks) == 2);
+  CHECK(tasks[0] == 7 && tasks[1] == 9);
+  CHECK(LRC_sweepSelectString(sweep, s, "none", tasks) == 0);
+
+  /* The overlay of a task */
+  task = LRC_sweepTask(sweep, 7);
+  CHECK(task != NULL);
+  CHECK(LRC_overlayGetInt(task, "farm", "xres", &k) == LRC_NUMBER_OK && k == 70);
+  CHECK(strcmp(LRC_overlayGet(task, "default", "inidata", NULL), "a.dat") == 0);
+  LRC_freeOverlay(task);
+  CHECK(LRC_sweepTask(sweep, TASKS) == NULL);
+
+  LRC_freeSweep(sweep);
+
+  /* The size of the columns does not overflow */
+  sweep = LRC_newSweep(index, SIZE_MAX / 2);
+  CHECK(sweep != NULL);
+  CHECK(LRC_sweepAddColumn(sweep, "logs", "period") == -1);
+  LRC_freeSweep(sweep);
+
+  LRC_freeIndex(index);
+  LRC_cleanup(head);
+
+  return 0;
+}
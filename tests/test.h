@@ -0,0 +1,121 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file test.h
+ * @brief Helpers shared by the tests: checks and the files of the tests.
+ *
+ * The tests run in the build directory and exit with a non-zero status on
+ * the first failed check. A test which cannot run in the build (e.g. without
+ * parallel HDF5) exits with LRC_TEST_SKIP.
+ */
+
+#ifndef LRC_TEST_H
+#define LRC_TEST_H
+
+#include "libreadconfig.h"
+
+#define LRC_TEST_SKIP 77
+
+/* Stops the test when the condition does not hold */
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      exit(1); \
+    } \
+  } while (0)
+
+/* The option has the value (as text) */
+#define CHECK_VALUE(head, space, var, expected) \
+  do { \
+    char* value_ = LRC_getOptionValue(space, var, head); \
+    CHECK(value_ != NULL); \
+    if (strcmp(value_, expected) != 0) { \
+      fprintf(stderr, "%s:%d: %s.%s is '%s', expected '%s'\n", __FILE__, __LINE__, \
+          space, var, value_, expected); \
+      exit(1); \
+    } \
+  } while (0)
+
+/* Writes the text to the file */
+static inline void test_write(char* path, char* text){
+
+  FILE* file = fopen(path, "w");
+
+  CHECK(file != NULL);
+  CHECK(fputs(text, file) >= 0);
+  CHECK(fclose(file) == 0);
+}
+
+/* Reads the whole file (free the result) */
+static inline char* test_read(char* path){
+
+  FILE* file = NULL;
+  char* data = NULL;
+  long len;
+
+  file = fopen(path, "rb");
+  CHECK(file != NULL);
+  CHECK(fseek(file, 0, SEEK_END) == 0);
+  len = ftell(file);
+  CHECK(len >= 0);
+  rewind(file);
+
+  data = (char*)malloc((size_t)len + 1);
+  CHECK(data != NULL);
+  CHECK(fread(data, 1, (size_t)len, file) == (size_t)len);
+  data[len] = LRC_NULL;
+  fclose(file);
+
+  return data;
+}
+
+/* The file has the text */
+#define CHECK_FILE(path, expected) \
+  do { \
+    char* data_ = test_read(path); \
+    if (strcmp(data_, expected) != 0) { \
+      fprintf(stderr, "%s:%d: %s is:\n%s\nexpected:\n%s\n", __FILE__, __LINE__, \
+          path, data_, expected); \
+      exit(1); \
+    } \
+    free(data_); \
+  } while (0)
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * LIBREADCONFIG
+ *
+ * Copyright (c) 2010-2012, Mariusz Slonina (Nicolaus Copernicus University)
+ * All rights reserved.
+ *
+ * LIBREADCONFIG was created to help in handling config files by providing common
+ * tools and including HDF5 support. The code was released in in belief it will be 
+ * useful. If you are going to use this code, or its parts, please consider referring 
+ * to the authors either by the website or the user guide reference.
+ *
+ * See http://git.astri.umk.pl/projects/lrc
+ *
+ * Redistribution and use in source and binary forms,
+ * with or without modification, are permitted provided
+ * that the following conditions are met:
+ *
+ *  - Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ *  - Neither the name of the Nicolaus Copernicus University nor the names of 
+ *    its contributors may be used to endorse or promote products derived from 
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+ * IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, 
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, 
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+ * OF SUCH DAMAGE.
+ */
+
+/**
+ * @file update.c
+ * @brief Test of the in-place update: only the changed values of the file
+ * are rewritten, the comments and the layout are kept.
+ */
+
+#include "test.h"
+
+int main(void){
+
+  LRC_configDefaults ct[] = {
+    {"default", "name", 0, "none", "", LRC_STRING, 0},
+    {"default", "dump", 0, "0", "", LRC_INT, 0},
+    {"logs", "grid", 0, "0", "", LRC_INT_ARRAY, 0},
+    {"logs", "level", 0, "1", "", LRC_INT, 0},
+    LRC_OPTIONS_END
+  };
+  LRC_configNamespace* head = NULL;
+
+  test_write("update.cfg",
+      "# header comment\n"
+      "\n"
+      "[default]\n"
+      "name = first   # inline\n"
+      "dump=100\n"
+      "\n"
+      "[logs]\n"
+      "grid = 1, 2, 3\n");
+
+  head = LRC_assignDefaults(ct);
+  CHECK(head != NULL);
+  CHECK(LRC_ASCIIParseFile("update.cfg", "=", "#", head) >= 0);
+
+  /* Nothing changed, nothing written */
+  CHECK(LRC_ASCIIUpdateFile("update.cfg", head) == 0);
+
+  /* The same length is patched in place */
+  LRC_modifyOption("default", "dump", "200", LRC_INT, head);
+  CHECK(LRC_ASCIIUpdateFile("update.cfg", head) == 1);
+  CHECK_FILE("update.cfg",
+      "# header comment\n"
+      "\n"
+      "[default]\n"
+      "name = first   # inline\n"
+      "dump=200\n"
+      "\n"
+      "[logs]\n"
+      "grid = 1, 2, 3\n");
+
+  /* Other lengths rewrite the file, the spans follow the new text. The
+   * options missing in the file are not added */
+  LRC_modifyOption("default", "name", "second", LRC_STRING, head);
+  LRC_modifyOption("logs", "grid", "1, 2, 3, 4", LRC_INT_ARRAY, head);
+  LRC_modifyOption("logs", "level", "5", LRC_INT, head);
+  CHECK(LRC_ASCIIUpdateFile("update.cfg", head) == 2);
+  LRC_modifyOption("default", "dump", "7", LRC_INT, head);
+  CHECK(LRC_ASCIIUpdateFile("update.cfg", head) == 1);
+  CHECK_FILE("update.cfg",
+      "# header comment\n"
+      "\n"
+      "[default]\n"
+      "name = second   # inline\n"
+      "dump=7\n"
+      "\n"
+      "[logs]\n"
+      "grid = 1, 2, 3, 4\n");
+
+  /* The same elements in another form are not rewritten */
+  LRC_modifyOption("logs", "grid", "1,2,3,4", LRC_INT_ARRAY, head);
+  CHECK(LRC_ASCIIUpdateFile("update.cfg", head) == 0);
+
+  LRC_cleanup(head);
+
+  /* Two files: the update of the last one read does not use the spans of
+   * the first one */
+  test_write("update-sys.cfg", "[default]\nname = system\ndump = 1\n");
+  test_write("update-user.cfg", "[default]\n# comment line here\ndump = 5\n");
+
+  head = LRC_assignDefaults(ct);
+  CHECK(LRC_ASCIIParseFile("update-sys.cfg", "=", "#", head) >= 0);
+  CHECK(LRC_ASCIIParseFile("update-user.cfg", "=", "#", head) >= 0);
+  CHECK_VALUE(head, "default", "name", "system");
+  CHECK_VALUE(head, "default", "dump", "5");
+
+  LRC_modifyOption("default", "name", "changed", LRC_STRING, head);
+  LRC_modifyOption("default", "dump", "3", LRC_INT, head);
+  CHECK(LRC_ASCIIUpdateFile("update-user.cfg", head) == 1);
+  CHECK_FILE("update-user.cfg", "[default]\n# comment line here\ndump = 3\n");
+  CHECK_FILE("update-sys.cfg", "[default]\nname = system\ndump = 1\n");
+
+  LRC_cleanup(head);
+
+  return 0;
+}